@@ -453,7 +453,12 @@ install(TARGETS onnx_test_runner
         RUNTIME  DESTINATION ${CMAKE_INSTALL_BINDIR})
 
 if(onnxruntime_BUILD_BENCHMARKS AND (HAS_FILESYSTEM_H OR HAS_EXPERIMENTAL_FILESYSTEM_H))
-  add_executable(onnxruntime_benchmark ${TEST_SRC_DIR}/onnx/microbenchmark/main.cc ${TEST_SRC_DIR}/onnx/microbenchmark/modeltest.cc)
+  add_executable(onnxruntime_benchmark
+    ${TEST_SRC_DIR}/onnx/microbenchmark/main.cc
+    ${TEST_SRC_DIR}/onnx/microbenchmark/modeltest.cc
+    ${TEST_SRC_DIR}/onnx/microbenchmark/ops.cc
+    ${TEST_SRC_DIR}/onnx/microbenchmark/single_node_model.cc
+    ${TEST_SRC_DIR}/onnx/microbenchmark/single_node_model.h)
   target_include_directories(onnxruntime_benchmark PRIVATE ${ONNXRUNTIME_ROOT} ${onnxruntime_graph_header} benchmark)
   target_compile_options(onnxruntime_benchmark PRIVATE "/wd4141")
   target_link_libraries(onnxruntime_benchmark PRIVATE ${onnx_test_libs} onnx_test_runner_common benchmark)
@@ -569,3 +574,10 @@ add_executable(onnxruntime_mlas_test ${TEST_SRC_DIR}/mlas/unittest.cpp)
 target_include_directories(onnxruntime_mlas_test PRIVATE ${ONNXRUNTIME_ROOT}/core/mlas/inc)
 target_link_libraries(onnxruntime_mlas_test PRIVATE onnxruntime_mlas)
 set_target_properties(onnxruntime_mlas_test PROPERTIES FOLDER "ONNXRuntimeTest")
+
+if(onnxruntime_BUILD_BENCHMARKS)
+  add_executable(onnxruntime_mlas_benchmark ${TEST_SRC_DIR}/mlas/bench.cpp)
+  target_include_directories(onnxruntime_mlas_benchmark PRIVATE ${ONNXRUNTIME_ROOT}/core/mlas/inc benchmark)
+  target_link_libraries(onnxruntime_mlas_benchmark PRIVATE onnxruntime_mlas benchmark)
+  set_target_properties(onnxruntime_mlas_benchmark PROPERTIES FOLDER "ONNXRuntimeTest")
+endif()
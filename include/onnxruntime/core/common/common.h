@@ -142,6 +142,13 @@ std::vector<std::string> GetStackTrace();
     if ((!_status.IsOK())) return _status; \
   } while (0)
 
+// throw an exception with the message of the status if it's an error, for use where a status can't be returned.
+#define ORT_THROW_IF_ERROR(expr)               \
+  do {                                         \
+    auto _status = (expr);                     \
+    if ((!_status.IsOK())) ORT_THROW(_status); \
+  } while (0)
+
 // use this macro when cannot early return
 #define ORT_CHECK_AND_SET_RETVAL(expr) \
   do {                                 \
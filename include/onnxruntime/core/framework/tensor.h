@@ -171,6 +171,13 @@ class Tensor final {
     return shape_.Size() * dtype_->Size();
   }
 
+  /**
+     true if the buffer is released with the tensor, false if the tensor only refers to it.
+  */
+  bool OwnsBuffer() const noexcept {
+    return buffer_deleter_ != nullptr;
+  }
+
   // More API methods.
  private:
   void Init(MLDataType p_type,
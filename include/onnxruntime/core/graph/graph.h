@@ -700,6 +700,13 @@ class Graph {
   */
   Status InlineFunction(Node& node);
 
+  /**
+  Directly insert the nodes of all the function Nodes provided into this Graph, resolving it once at the end.
+  @param node_indexes Indexes of Nodes with a function body.
+  @returns Status indicating success or providing an error message.
+  */
+  Status InlineFunctions(const std::vector<NodeIndex>& node_indexes);
+
   /** Mark a NodeArg name as coming from the outer scope when programmatically constructing a Graph that will
   be used as a GraphProto attribute in another Node..
   e.g. when creating a Graph instance that will be used as a subgraph in a control flow operator, it is necessary to 
@@ -290,12 +290,75 @@ ORT_API(void, OrtDisableProfiling, _In_ OrtSessionOptions* options);
 ORT_API(void, OrtEnableMemPattern, _In_ OrtSessionOptions* options);
 ORT_API(void, OrtDisableMemPattern, _In_ OrtSessionOptions* options);
 
+// Generate the memory patterns for a set of input shapes while the session is initialized, by running the model
+// once with zero filled inputs. input_dims[i] holds input_dims_lengths[i] dims of the input named input_names[i].
+// Two sets that only differ in the symbolic dimensions of the inputs are enough to derive the patterns for any
+// other value of those dimensions. Session initialization runs inference once per set, and a run that fails, e.g.
+// because an op like Gather or Reshape can't handle the zero values, is logged as a warning and skipped.
+ORT_API(void, OrtAddMemPatternPrewarmShapes, _In_ OrtSessionOptions* options, _In_ const char* const* input_names,
+        _In_ const int64_t* const* input_dims, _In_ const size_t* input_dims_lengths, size_t input_len);
+
 // enable the memory arena on CPU
 // Arena may pre-allocate memory for future usage.
 // set this option to false if you don't want it.
 ORT_API(void, OrtEnableCpuMemArena, _In_ OrtSessionOptions* options);
 ORT_API(void, OrtDisableCpuMemArena, _In_ OrtSessionOptions* options);
 
+// store the initializers placed on CPU in a process wide cache, addressed by their content, so sessions of
+// models that have weights in common hold one copy of them. A tensor is held as long as a session uses it.
+// Disabled by default.
+ORT_API(void, OrtEnableSharedInitializerCache, _In_ OrtSessionOptions* options);
+ORT_API(void, OrtDisableSharedInitializerCache, _In_ OrtSessionOptions* options);
+
+// measure the convolution algorithms for each convolution shape on first use and run the fastest one.
+// The choices are cached for the process, and a session enabling this enables it for the process. Disabled by default.
+ORT_API(void, OrtEnableConvAutotuning, _In_ OrtSessionOptions* options);
+ORT_API(void, OrtDisableConvAutotuning, _In_ OrtSessionOptions* options);
+
+// fuse MatMul + Add into Gemm, and Gemm + activation into the CPU only FusedGemm when CPU is the only execution
+// provider of the session. Enabled by default.
+ORT_API(void, OrtEnableGemmFusion, _In_ OrtSessionOptions* options);
+ORT_API(void, OrtDisableGemmFusion, _In_ OrtSessionOptions* options);
+
+// run the convolutions and pooling of the graph on CPU in the blocked channel (NCHWc) layout of MLAS, with the
+// layout conversions inserted at the boundaries of the converted regions. Disabled by default.
+ORT_API(void, OrtEnableNchwcLayout, _In_ OrtSessionOptions* options);
+ORT_API(void, OrtDisableNchwcLayout, _In_ OrtSessionOptions* options);
+
+// keep the float16 weights of Gemm and 2-D MatMul nodes that run on CPU in float16, converting them to float as
+// they are packed for the multiply, which halves their memory. Disabled by default.
+ORT_API(void, OrtEnableKeepFloat16Weights, _In_ OrtSessionOptions* options);
+ORT_API(void, OrtDisableKeepFloat16Weights, _In_ OrtSessionOptions* options);
+
+/**
+ * Stats of the process wide shared initializer cache
+ * \param num_tensors distinct tensors held by the cache
+ * \param bytes_in_use bytes held by the cache
+ * \param bytes_saved bytes the sessions using the cache would take on top of bytes_in_use without it
+ */
+ORT_API(void, OrtGetSharedInitializerCacheStats, _Out_ size_t* num_tensors, _Out_ size_t* bytes_in_use,
+        _Out_ size_t* bytes_saved);
+
+typedef enum OrtArenaExtendStrategy {
+  OrtArenaExtendNextPowerOfTwo = 0,   // each region is twice as large as the previous one
+  OrtArenaExtendSameAsRequested = 1,  // a region covers exactly the request that did not fit
+  OrtArenaExtendFixedIncrement = 2,   // regions of extend_increment_bytes, or the request if that is larger
+} OrtArenaExtendStrategy;
+
+// How the CPU arena grows. initial_chunk_bytes is the size of its first region.
+ORT_API(void, OrtSetCpuMemArenaExtendStrategy, _In_ OrtSessionOptions* options, OrtArenaExtendStrategy strategy,
+        size_t initial_chunk_bytes, size_t extend_increment_bytes);
+
+// Hard limit of the memory held by the CPU arena. 0 means no limit.
+ORT_API(void, OrtSetCpuMemArenaMaxMemory, _In_ OrtSessionOptions* options, size_t max_mem);
+
+// Bytes each thread may keep in a private cache of small freed chunks of the CPU arena. 0 disables the caches.
+ORT_API(void, OrtSetCpuMemArenaThreadCacheSize, _In_ OrtSessionOptions* options, size_t thread_cache_bytes);
+
+// Return completely free regions of the CPU arena to the system once they add up to more than threshold_bytes,
+// or every interval_ms milliseconds. 0 disables the respective trigger.
+ORT_API(void, OrtSetCpuMemArenaShrinkPolicy, _In_ OrtSessionOptions* options, size_t threshold_bytes, int64_t interval_ms);
+
 ///< logger id to use for session output
 ORT_API(void, OrtSetSessionLogId, _In_ OrtSessionOptions* options, const char* logid);
 
@@ -361,6 +424,24 @@ ORT_API(void*, OrtAllocatorAlloc, _Inout_ OrtAllocator* ptr, size_t size);
 ORT_API(void, OrtAllocatorFree, _Inout_ OrtAllocator* ptr, void* p);
 ORT_API(const struct OrtAllocatorInfo*, OrtAllocatorGetInfo, _In_ const OrtAllocator* ptr);
 
+/**
+ * Runtime statistics of an arena allocator
+ */
+typedef struct OrtAllocatorStats {
+  int64_t num_allocs;              // number of allocations
+  int64_t bytes_in_use;            // bytes currently handed out, including bytes_in_thread_caches
+  int64_t total_allocated_bytes;   // bytes currently held from the device
+  int64_t max_bytes_in_use;        // peak of bytes_in_use
+  int64_t max_alloc_size;          // largest single allocation
+  int64_t bytes_limit;             // upper limit of total_allocated_bytes, 0 if unknown
+  int64_t num_thread_cache_hits;   // allocations served by per-thread caches
+  int64_t bytes_in_thread_caches;  // freed bytes parked in per-thread caches
+  int64_t num_regions_released;    // regions returned to the device
+  int64_t bytes_released;          // bytes returned to the device
+  int64_t num_extends;             // regions requested from the device
+  int64_t largest_free_block;      // size of the largest free chunk
+} OrtAllocatorStats;
+
 struct OrtEnv;
 typedef struct OrtEnv OrtEnv;
 
@@ -398,7 +479,6 @@ DEFINE_RUNTIME_CLASS(ONNXSession);
 //execution of OrtCreateInferenceSession, or does the ONNXSession retain a handle to the file/directory
 //and continue to access throughout the ONNXSession lifetime?
 // What sort of access is needed to model_path : read or read/write?
-//TODO:  allow loading from an in-memory byte-array
 #ifdef _WIN32
 ORT_API_STATUS(OrtCreateInferenceSession, _In_ OrtEnv* env, _In_ const wchar_t* model_path,
                _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out);
@@ -407,6 +487,28 @@ ORT_API_STATUS(OrtCreateInferenceSession, _In_ OrtEnv* env, _In_ const char* mod
                _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out);
 #endif
 
+/**
+ * \param model_data serialized ModelProto of the model. It's only read during this call.
+ */
+ORT_API_STATUS(OrtCreateInferenceSessionFromArray, _In_ OrtEnv* env, _In_ const void* model_data, size_t model_data_len,
+               _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out);
+
+/**
+ * A model parsed once, to create many sessions from. The sessions share the memory of the initializers
+ * they place on CPU. A session keeps what it uses alive, so the prepared model can be released once the
+ * sessions are created.
+ */
+DEFINE_RUNTIME_CLASS(OrtPreparedModel);
+
+/**
+ * \param model_data serialized ModelProto of the model. It's only read during this call.
+ */
+ORT_API_STATUS(OrtCreatePreparedModel, _In_ OrtEnv* env, _In_ const void* model_data, size_t model_data_len,
+               _Out_ OrtPreparedModel** out);
+
+ORT_API_STATUS(OrtCreateInferenceSessionFromPreparedModel, _In_ OrtEnv* env, _In_ const OrtPreparedModel* model,
+               _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out);
+
 DEFINE_RUNTIME_CLASS(ONNXValue);
 
 ///Call OrtReleaseObject to release the returned value
@@ -486,6 +588,13 @@ ORT_API_STATUS(OrtInferenceSessionGetInputName, _In_ const ONNXSession* sess, si
 ORT_API_STATUS(OrtInferenceSessionGetOutputName, _In_ const ONNXSession* sess, size_t index,
                _Inout_ OrtAllocator* allocator, _Out_ char** value);
 
+/**
+ * Get the statistics of the arena that backs the allocator identified by 'info' in the session.
+ * Fails if no execution provider of the session owns such an allocator or if it is not an arena.
+ */
+ORT_API_STATUS(OrtInferenceSessionGetAllocatorStats, _In_ const ONNXSession* sess, _In_ const OrtAllocatorInfo* info,
+               _Out_ OrtAllocatorStats* out);
+
 ORT_API_STATUS(OrtTensorProtoToONNXValue, _Inout_ OrtAllocator* allocator,
                _In_ const void* input, int input_len, _Out_ ONNXValue** out);
 
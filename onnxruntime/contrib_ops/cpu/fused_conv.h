@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/providers/cpu/nn/conv_impl.h"
+#include "core/providers/cpu/fused_activation.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -12,8 +13,7 @@ template <typename T>
 class FusedConv : public Conv<T> {
  public:
   FusedConv(const OpKernelInfo& info) : Conv<T>(info) {
-    Conv<T>::activation_ = info.GetAttrOrDefault<std::string>("activation", "");
-    Conv<T>::alpha_ = info.GetAttrOrDefault("alpha", 0.01f);
+    ORT_THROW_IF_ERROR(GetFusedActivationAttr(info, Conv<T>::activation_));
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cpu/math/gemm.h"
+#include "core/providers/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class FusedGemm : public Gemm<T, T, T, T> {
+ public:
+  FusedGemm(const OpKernelInfo& info) : Gemm<T, T, T, T>(info) {
+    ORT_THROW_IF_ERROR(GetFusedActivationAttr(info, Gemm<T, T, T, T>::activation_));
+  }
+
+  Status Compute(OpKernelContext* context) const override {
+    return Gemm<T, T, T, T>::Compute(context);
+  }
+};
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "nchwc_ops.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    ReorderInput,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    ReorderInput);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    ReorderOutput,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    ReorderOutput);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcConv);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcMaxPool,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcMaxPool);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NchwcAveragePool,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcAveragePool);
+
+namespace {
+Status ValidateBlockedShape(const TensorShape& shape) {
+  if (shape.NumDimensions() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Blocked tensors must be 4D. Shape: ", shape.ToString());
+  }
+  if (shape[1] % static_cast<int64_t>(MlasNchwcGetBlockSize()) != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Channel count ", shape[1],
+                           " is not a multiple of the block size ", MlasNchwcGetBlockSize());
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status ReorderInput::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  ORT_RETURN_IF_ERROR(ValidateBlockedShape(X->Shape()));
+  Tensor* Y = context->Output(0, X->Shape());
+  MlasReorderInput(X->Shape().GetDims().data(), X->template Data<float>(), Y->template MutableData<float>());
+  return Status::OK();
+}
+
+Status ReorderOutput::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  ORT_RETURN_IF_ERROR(ValidateBlockedShape(X->Shape()));
+  Tensor* Y = context->Output(0, X->Shape());
+  MlasReorderOutput(X->Shape().GetDims().data(), X->template Data<float>(), Y->template MutableData<float>());
+  return Status::OK();
+}
+
+NchwcConv::NchwcConv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {
+  ORT_ENFORCE(group_ == 1, "NchwcConv only supports group 1");
+
+  const Tensor* W;
+  ORT_ENFORCE(info.TryGetConstantInput(1, &W), "NchwcConv requires a constant filter");
+  // the output channels are blocked by the reordered filter, the input channels by ValidateBlockedShape
+  ORT_ENFORCE(ValidateBlockedShape(W->Shape()).IsOK() &&
+                  W->Shape()[0] % static_cast<int64_t>(MlasNchwcGetBlockSize()) == 0,
+              "NchwcConv filter channels must be multiples of the block size. Shape: ", W->Shape().ToString());
+
+  filter_shape_ = W->Shape();
+  reordered_filter_.reset(new float[filter_shape_.Size()]);
+  MlasReorderFilterOIHWBiBo(filter_shape_.GetDims().data(), W->template Data<float>(), reordered_filter_.get());
+}
+
+Status NchwcConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* B = OpKernel::Node().InputDefs().size() == 3 ? context->Input<Tensor>(2) : nullptr;
+  ORT_RETURN_IF_ERROR(ValidateBlockedShape(X->Shape()));
+
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1];
+  const int64_t M = filter_shape_[0];
+  if (C != filter_shape_[1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input channels C is not equal to kernel channels.",
+                           " C: ", C, " kernel channels: ", filter_shape_[1]);
+  }
+
+  std::vector<int64_t> kernel_shape = ComputeKernelShape(filter_shape_);
+  if (kernel_shape.size() != 2 || kernel_shape[0] != filter_shape_[2] || kernel_shape[1] != filter_shape_[3]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape is not compatible with W shape.",
+                           " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
+                           " W: ", filter_shape_.ToString().c_str());
+  }
+
+  std::vector<int64_t> pads(pads_);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  std::vector<int64_t> dilations(dilations_);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  std::vector<int64_t> strides(strides_);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  std::vector<int64_t> Y_dims({N, M});
+  TensorShape input_shape = X->Shape().Slice(2);
+  ORT_RETURN_IF_ERROR(InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  MlasNchwcConv(X->Shape().GetDims().data(),
+                kernel_shape.data(),
+                dilations.data(),
+                pads.data(),
+                strides.data(),
+                Y_dims.data(),
+                X->template Data<float>(),
+                reordered_filter_.get(),
+                B != nullptr ? B->template Data<float>() : nullptr,
+                Y->template MutableData<float>());
+
+  return Status::OK();
+}
+
+Status NchwcPoolBase::NchwcPool(OpKernelContext* context, MLAS_POOLING_KIND kind) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  ORT_RETURN_IF_ERROR(ValidateBlockedShape(X->Shape()));
+  ORT_RETURN_IF_NOT(kernel_shape_.size() == 2, "kernel_shape num_dims is not compatible with X num_dims.");
+
+  std::vector<int64_t> pads = pads_;
+  std::vector<int64_t> output_dims = PoolBase::SetOutputSize(X->Shape(), X->Shape()[1], &pads);
+  Tensor* Y = context->Output(0, TensorShape(output_dims));
+
+  MlasNchwcPool(kind,
+                X->Shape().GetDims().data(),
+                kernel_shape_.data(),
+                pads.data(),
+                strides_.data(),
+                output_dims.data(),
+                X->template Data<float>(),
+                Y->template MutableData<float>());
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/conv_base.h"
+#include "core/providers/cpu/nn/pool_base.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// The Nchwc operators work on 4D float tensors whose channels are stored in blocks of MlasNchwcGetBlockSize()
+// channels. A blocked tensor keeps the shape of the NCHW tensor it was reordered from, so the channel count must be
+// a multiple of the block size. Element wise operators with inputs of identical shapes can consume blocked tensors.
+
+// Reorders a NCHW tensor to the blocked layout.
+class ReorderInput final : public OpKernel {
+ public:
+  explicit ReorderInput(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+// Reorders a blocked tensor back to NCHW.
+class ReorderOutput final : public OpKernel {
+ public:
+  explicit ReorderOutput(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+// Conv of blocked tensors. The filter must be a constant initializer and is reordered once when the kernel is created.
+class NchwcConv final : public OpKernel, public ConvBase {
+ public:
+  explicit NchwcConv(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape filter_shape_;
+  std::unique_ptr<float[]> reordered_filter_;
+};
+
+class NchwcPoolBase : public OpKernel, public PoolBase {
+ protected:
+  explicit NchwcPoolBase(const OpKernelInfo& info) : OpKernel(info), PoolBase(info) {}
+
+  Status NchwcPool(OpKernelContext* context, MLAS_POOLING_KIND kind) const;
+};
+
+class NchwcMaxPool final : public NchwcPoolBase {
+ public:
+  explicit NchwcMaxPool(const OpKernelInfo& info) : NchwcPoolBase(info) {}
+
+  Status Compute(OpKernelContext* context) const override {
+    return NchwcPool(context, MlasMaximumPooling);
+  }
+};
+
+class NchwcAveragePool final : public NchwcPoolBase {
+ public:
+  explicit NchwcAveragePool(const OpKernelInfo& info) : NchwcPoolBase(info) {
+    // PoolBase only reads count_include_pad for AveragePool
+    count_include_pad_ = info.GetAttrOrDefault<int64_t>("count_include_pad", 0) != 0;
+  }
+
+  Status Compute(OpKernelContext* context) const override {
+    return NchwcPool(context, count_include_pad_ ? MlasAveragePoolingIncludePad : MlasAveragePoolingExcludePad);
+  }
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
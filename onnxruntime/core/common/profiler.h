@@ -40,6 +40,13 @@ class Profiler {
   */
   TimePoint StartTime() const;
 
+  /*
+  Whether events are being recorded.
+  */
+  bool IsEnabled() const {
+    return enabled_ || profile_with_logger_;
+  }
+
   /*
   Record a single event. Time is measured till the call of this function from
   the start_time.
@@ -4,6 +4,7 @@
 #include "core/framework/allocation_planner.h"
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <sstream>
 #include "core/common/exceptions.h"
@@ -14,6 +15,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
 #include "core/framework/utils.h"
+#include "core/graph/graph_utils.h"
 
 using namespace onnxruntime::common;
 using namespace ONNX_NAMESPACE;
@@ -57,7 +59,11 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
     if (0 <= index && static_cast<size_t>(index) < plan_size) {
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
-      if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.alloc_kind == AllocKind::kReuse) {
+        out << " " << elt_plan.reused_buffer;
+        if (elt_plan.reused_buffer_offset != 0) out << " +" << elt_plan.reused_buffer_offset;
+      }
+      if (elt_plan.allocate_early) out << ", allocate early";
 
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
@@ -149,6 +155,15 @@ class PlannerImpl {
   // they became free (more recently freed earlier in the list).
   std::list<FreeBufferInfo> freelist_;
 
+  // InPlaceConcatInput: a Concat input that is written directly into its slice of the
+  // Concat output (concat_output), starting at byte offset.
+  struct InPlaceConcatInput {
+    MLValueIndex concat_output;
+    size_t offset;
+  };
+  // in_place_concat_inputs_ is indexed by the MLValueIndex of the Concat input
+  std::unordered_map<MLValueIndex, InPlaceConcatInput> in_place_concat_inputs_;
+
   MLValueIndex Index(const MLValueName& name) {
     MLValueIndex result;
     auto status = mlvalue_name_idx_map_.GetIdx(name, result);
@@ -292,6 +307,119 @@ class PlannerImpl {
     return SameSize(*p_shape1, arg1.Type(), *p_shape2, arg2.Type());
   }
 
+  // Get the statically known dimensions of node_arg. Returns false if the shape is unknown
+  // or has a symbolic dimension.
+  bool GetStaticShape(const onnxruntime::NodeArg& node_arg, std::vector<int64_t>& dims) {
+    auto p_shape = context_.GetShape(node_arg);
+    if (nullptr == p_shape) return false;
+    dims.clear();
+    for (const auto& dim : p_shape->dim()) {
+      if (!dim.has_dim_value()) return false;
+      dims.push_back(dim.dim_value());
+    }
+    return true;
+  }
+
+  // A Concat along an axis whose outer dimensions are all 1 places each input in a
+  // contiguous slice of the output. If such an input is produced by a node of this graph
+  // and only consumed by the Concat, its producer can write it directly into that slice
+  // and the Concat does not need to copy it.
+  void PlanInPlaceConcat(const onnxruntime::Node& node, std::unordered_set<MLValueIndex>& produced) {
+    if (!utils::IsSupportedOptypeVersionAndDomain(node, "Concat", 4) ||
+        node.GetExecutionProviderType() != kCpuExecutionProvider)
+      return;
+
+    auto& graph_outputs = graph_viewer_.GetOutputs();
+    auto p_output = node.OutputDefs()[0];
+    if (!p_output->Exists() || IsNonTensor(*p_output) ||
+        std::find(graph_outputs.begin(), graph_outputs.end(), p_output) != graph_outputs.end())
+      return;
+
+    auto output_index = Index(p_output->Name());
+    // the output is freed through its own uses, which an unused output does not have
+    if (UseCount(output_index) == 0) return;
+
+    const TypeProto& output_type = ONNX_NAMESPACE::Utils::DataTypeUtils::ToTypeProto(p_output->Type());
+    if (output_type.tensor_type().elem_type() == TensorProto_DataType_STRING) return;
+
+    std::vector<int64_t> output_dims;
+    if (!GetStaticShape(*p_output, output_dims) || output_dims.empty()) return;
+
+    const auto& attributes = node.GetAttributes();
+    auto axis_attr = attributes.find("axis");
+    if (axis_attr == attributes.end()) return;
+    int64_t axis = axis_attr->second.i();
+    int64_t rank = static_cast<int64_t>(output_dims.size());
+    if (axis < 0) axis += rank;
+    if (axis < 0 || axis >= rank) return;
+    for (int64_t i = 0; i < axis; ++i) {
+      if (output_dims[i] != 1) return;
+    }
+
+    auto& output_location = AllocPlan(output_index).location;
+    size_t element_size = GetElementSize(p_output->Type());
+    size_t offset = 0;
+    std::vector<std::pair<MLValueIndex, InPlaceConcatInput>> in_place_inputs;
+    std::vector<std::vector<int64_t>> in_place_input_dims;
+
+    for (auto p_input : node.InputDefs()) {
+      std::vector<int64_t> input_dims;
+      if (!p_input->Exists() || !GetStaticShape(*p_input, input_dims) || input_dims.size() != output_dims.size())
+        return;
+
+      auto input_index = Index(p_input->Name());
+      if (produced.count(input_index) != 0 && UseCount(input_index) == 1 &&
+          AllocPlan(input_index).location == output_location &&
+          !AllocPlan(input_index).allocate_early &&
+          p_input->Type() == p_output->Type()) {
+        in_place_inputs.emplace_back(input_index, InPlaceConcatInput{output_index, offset});
+        in_place_input_dims.push_back(input_dims);
+      }
+
+      size_t input_bytes = element_size;
+      for (auto dim : input_dims) input_bytes *= static_cast<size_t>(dim);
+      offset += input_bytes;
+    }
+
+    size_t output_bytes = element_size;
+    for (auto dim : output_dims) output_bytes *= static_cast<size_t>(dim);
+    if (in_place_inputs.empty() || offset != output_bytes) return;
+
+    for (size_t i = 0; i < in_place_inputs.size(); ++i) {
+      in_place_concat_inputs_[in_place_inputs[i].first] = in_place_inputs[i].second;
+      auto& input_plan = AllocPlan(in_place_inputs[i].first);
+      input_plan.has_static_shape = true;
+      input_plan.static_shape = TensorShape(in_place_input_dims[i]);
+    }
+
+    auto& output_plan = AllocPlan(output_index);
+    output_plan.has_static_shape = true;
+    output_plan.static_shape = TensorShape(output_dims);
+    output_plan.allocate_early = true;
+  }
+
+  void PlanInPlaceConcats() {
+    // ml-values produced so far by nodes of this graph whose buffers may be placed elsewhere
+    std::unordered_set<MLValueIndex> produced;
+
+    for (const auto& step : plan_.execution_plan) {
+      auto pnode = graph_viewer_.GetNode(step.node_index);
+      PlanInPlaceConcat(*pnode, produced);
+
+      // an output the kernel must alias onto one of its inputs cannot be placed elsewhere
+      auto p_kernel_def = utils::GetKernelDef(kernel_registry_, *pnode);
+      const auto& alias_map = p_kernel_def->Alias();
+      int output_arg_num = 0;
+      for (auto node_output : pnode->OutputDefs()) {
+        if (node_output->Exists() && !IsNonTensor(*node_output) &&
+            std::none_of(alias_map.cbegin(), alias_map.cend(),
+                         [output_arg_num](const std::pair<int, int>& pair) { return pair.second == output_arg_num; }))
+          produced.insert(Index(node_output->Name()));
+        output_arg_num++;
+      }
+    }
+  }
+
   // Find if freelist contains a buffer of the same size as output_arg
   bool FindReusableTensor(const onnxruntime::NodeArg& output_arg, MLValueIndex* reusable_tensor) {
     auto p_required_buffer_shape = context_.GetShape(output_arg);
@@ -486,9 +614,18 @@ class PlannerImpl {
         auto current = Index(node_output->Name());
         AllocPlan(current).value_type = utils::GetMLDataType(*node_output);
         MLValueIndex reused;
+        auto in_place_concat_input = in_place_concat_inputs_.find(current);
         if (std::find(graph_outputs.begin(), graph_outputs.end(), node_output) != graph_outputs.end()) {
           // node_output is graph's output, so we can't reuse intermedia buffer
           AllocPlan(current).alloc_kind = AllocKind::kAllocateOutput;
+        } else if (AllocPlan(current).allocate_early) {
+          // other ml-values are placed inside this buffer before this node runs, so it must not
+          // reuse a buffer that may still be in use at that point
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
+        } else if (in_place_concat_input != in_place_concat_inputs_.end()) {
+          // write this output directly into its slice of the Concat output
+          Reuse(in_place_concat_input->second.concat_output, current);
+          AllocPlan(current).reused_buffer_offset = in_place_concat_input->second.offset;
         } else if (IsNonTensor(*node_output)) {
           // we do not try sharing-optimization for non-tensors
           AllocPlan(current).alloc_kind = AllocKind::kAllocate;
@@ -589,6 +726,11 @@ Status PlannerImpl::CreatePlan() {
   // compute use counts for all ml-values
   ORT_RETURN_IF_ERROR(ComputeUseCounts());
 
+  // place Concat inputs directly into the Concat output where possible. the Concat output
+  // is allocated before its inputs are produced, which the parallel executor cannot order.
+  if (!context_.EnableParallelExecution())
+    PlanInPlaceConcats();
+
   // determine sharing/reuse among ml-values
   ComputeReusePlan();
 
@@ -3,12 +3,105 @@
 
 #pragma once
 
+#include <sstream>
 #include <string>
 
 #include "core/common/common.h"
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
+// Runtime statistics collected by an allocator.
+struct AllocatorStats {
+  int64_t num_allocs;             // Number of allocations.
+  int64_t bytes_in_use;           // Number of bytes in use.
+  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
+  int64_t max_bytes_in_use;       // The maximum bytes in use.
+  int64_t max_alloc_size;         // The max single allocation seen.
+                                  // The upper limit what the allocator can allocate, if such a limit
+                                  // is known. Certain allocator may return 0 to indicate the limit is
+                                  // unknown.
+  int64_t bytes_limit;
+  int64_t num_thread_cache_hits;   // Allocations served from a per-thread cache without taking the lock.
+  int64_t bytes_in_thread_caches;  // Bytes parked in per-thread caches. Counted in bytes_in_use as well.
+  int64_t num_regions_released;    // Number of regions returned to the device allocator by Shrink.
+  int64_t bytes_released;          // Total bytes returned to the device allocator by Shrink.
+  int64_t num_extends;             // Number of regions requested from the device allocator.
+  int64_t largest_free_block;      // Size of the largest free chunk. Only filled in by GetStats.
+
+  AllocatorStats() { Clear(); }
+
+  void Clear() {
+    this->num_allocs = 0;
+    this->bytes_in_use = 0;
+    this->max_bytes_in_use = 0;
+    this->max_alloc_size = 0;
+    this->bytes_limit = 0;
+    this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->bytes_in_thread_caches = 0;
+    this->num_regions_released = 0;
+    this->bytes_released = 0;
+    this->num_extends = 0;
+    this->largest_free_block = 0;
+  }
+
+  // Share of the free bytes that can not be handed out as a single block, between 0 and 1.
+  double Fragmentation() const {
+    int64_t free_bytes = total_allocated_bytes - bytes_in_use;
+    return free_bytes > 0 ? 1.0 - static_cast<double>(largest_free_block) / free_bytes : 0.0;
+  }
+
+  std::string DebugString() const {
+    std::ostringstream ss;
+    ss << "Limit:           " << this->bytes_limit << "\n"
+       << "InUse:          " << this->bytes_in_use << "\n"
+       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
+       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
+       << "NumAllocs:      " << this->num_allocs << "\n"
+       << "MaxAllocSize:   " << this->max_alloc_size << "\n"
+       << "ThreadCacheHits: " << this->num_thread_cache_hits << "\n"
+       << "InThreadCaches: " << this->bytes_in_thread_caches << "\n"
+       << "RegionsReleased: " << this->num_regions_released << "\n"
+       << "BytesReleased:  " << this->bytes_released << "\n"
+       << "NumExtends:     " << this->num_extends << "\n"
+       << "LargestFree:    " << this->largest_free_block << "\n";
+    return ss.str();
+  }
+};
+
+// How an arena sizes a new region when a request does not fit into the existing ones.
+enum class ArenaExtendStrategy : int {
+  kNextPowerOfTwo = 0,   // each region is twice as large as the previous one
+  kSameAsRequested = 1,  // the region covers exactly the request that did not fit
+  kFixedIncrement = 2,   // the region is extend_increment_bytes large, or the request if that is larger
+};
+
+// Tuning knobs for arena allocators.
+struct ArenaConfig {
+  // Size of the first region.
+  size_t initial_chunk_bytes = 1 << 20;
+
+  ArenaExtendStrategy extend_strategy = ArenaExtendStrategy::kNextPowerOfTwo;
+
+  // Region size used by ArenaExtendStrategy::kFixedIncrement.
+  size_t extend_increment_bytes = 0;
+
+  // Hard limit of the memory held by the arena. 0 uses the limit of the device allocator registration.
+  size_t max_mem = 0;
+
+  // Upper bound of bytes each thread may keep in its private size-class cache.
+  // 0 disables the per-thread caches and every request goes through the arena lock.
+  size_t thread_cache_bytes = 0;
+
+  // Return fully free regions to the device allocator once they add up to more than this many bytes.
+  // 0 disables the threshold based shrinking.
+  size_t shrink_threshold_bytes = 0;
+
+  // Return all fully free regions to the device allocator if the last shrink is older than this.
+  // 0 disables the time based shrinking.
+  int64_t shrink_interval_ms = 0;
+};
+
 // The interface for arena which manage memory allocations
 // Arena will hold a pool of pre-allocate memories and manage their lifecycle.
 // Need an underline IResourceAllocator to allocate memories.
@@ -28,6 +121,21 @@ class IArenaAllocator : public IAllocator {
   virtual size_t Max() const = 0;
   const OrtAllocatorInfo& Info() const override = 0;
   // allocate host pinned memory?
+
+  // Fill 'stats' with the runtime statistics of the arena.
+  virtual void GetStats(AllocatorStats* stats) {
+    stats->Clear();
+  }
+
+  // Release any free memory the arena holds back to the device.
+  virtual void Shrink() {}
+
+  // Make sure a single request of 'size' bytes can be served without asking the device for more memory,
+  // e.g. to pre-size the arena for the buffer of a memory pattern. Returns false if the memory is not available.
+  virtual bool ReserveCapacity(size_t size) {
+    ORT_UNUSED_PARAMETER(size);
+    return true;
+  }
 };
 
 using ArenaPtr = std::shared_ptr<IArenaAllocator>;
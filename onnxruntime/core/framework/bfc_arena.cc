@@ -3,14 +3,74 @@
 
 #include "core/framework/bfc_arena.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace onnxruntime {
+// Chunks recycled by a single thread without taking the arena lock.
+//
+// A chunk handed out through a cache stays in use from the arena's point of view
+// and remembers its owner in Chunk::cache_owner. When the owner frees it, it is
+// parked in the free list of its size class. When another thread frees it, the
+// chunk goes back to the bins and the pointer is queued in remote_frees, so the
+// owner stops tracking it before the address can be handed out again.
+//
+// The owner thread holds 'mutex' while it uses the cache. It is only contended
+// when Shrink() flushes the caches of all threads.
+struct BFCArena::ThreadCache {
+  explicit ThreadCache(std::shared_ptr<ThreadCacheOwner> o) : owner(std::move(o)) {}
+  ~ThreadCache();
+
+  std::shared_ptr<ThreadCacheOwner> owner;
+  std::mutex mutex;
+
+  // Free chunks indexed by (rounded size / kMinAllocationSize) - 1.
+  std::array<std::vector<void*>, kNumThreadCacheClasses> free_lists;
+  size_t cached_bytes = 0;
+
+  // Pointers handed out by this cache and not freed yet. Chunk::requested_size is not updated
+  // when a chunk is handed out again without the arena lock, so the requested size is kept here.
+  struct OutstandingChunk {
+    size_t rounded_bytes;
+    size_t requested_bytes;
+  };
+  std::unordered_map<const void*, OutstandingChunk> outstanding;
+
+  // Pointers of 'outstanding' freed by other threads. Guarded by the arena lock.
+  std::vector<const void*> remote_frees;
+  std::atomic<bool> has_remote_frees{false};
+};
+
+BFCArena::ThreadCache::~ThreadCache() {
+  std::lock_guard<std::mutex> guard(owner->mutex);
+  owner->caches.erase(std::remove(owner->caches.begin(), owner->caches.end(), this), owner->caches.end());
+  if (owner->arena != nullptr) {
+    owner->arena->ReleaseThreadCache(*this);
+  }
+}
+
 BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
-                   size_t total_memory)
+                   size_t total_memory,
+                   const ArenaConfig& config)
     : device_allocator_(std::move(resource_allocator)),
       free_chunks_list_(kInvalidChunkHandle),
       next_allocation_id_(1),
-      info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
-  curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, size_t{1048576}));
+      info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator, device_allocator_->Info().id, device_allocator_->Info().mem_type),
+      extend_strategy_(config.extend_strategy),
+      extend_increment_bytes_(RoundedBytes(config.extend_increment_bytes)),
+      thread_cache_bytes_(config.thread_cache_bytes),
+      shrink_threshold_bytes_(config.shrink_threshold_bytes),
+      shrink_interval_(config.shrink_interval_ms),
+      last_shrink_time_(std::chrono::steady_clock::now()),
+      thread_cache_owner_(std::make_shared<ThreadCacheOwner>()) {
+  thread_cache_owner_->arena = this;
+
+  if (config.max_mem != 0) {
+    total_memory = std::min(total_memory, config.max_mem);
+  }
+
+  initial_chunk_bytes_ = RoundedBytes(std::min(total_memory, config.initial_chunk_bytes));
+  curr_region_allocation_bytes_ = initial_chunk_bytes_;
 
   // Allocate the requested amount of memory.
   memory_limit_ = total_memory;
@@ -35,6 +95,12 @@ BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
 }
 
 BFCArena::~BFCArena() {
+  {
+    // caches that are still alive in other threads must not touch the arena any more
+    std::lock_guard<std::mutex> guard(thread_cache_owner_->mutex);
+    thread_cache_owner_->arena = nullptr;
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -64,17 +130,27 @@ bool BFCArena::Extend(size_t rounded_bytes) {
     return false;
   }
 
-  // If curr_region_allocation_bytes_ is not enough to satisfy the
-  // allocation, keep multiplying by a power of two until that is
-  // sufficient.
   bool increased_allocation = false;
-  while (rounded_bytes > curr_region_allocation_bytes_) {
-    curr_region_allocation_bytes_ *= 2;
-    increased_allocation = true;
+  size_t bytes = 0;
+  if (extend_strategy_ == ArenaExtendStrategy::kNextPowerOfTwo) {
+    // If curr_region_allocation_bytes_ is not enough to satisfy the
+    // allocation, keep multiplying by a power of two until that is
+    // sufficient.
+    while (rounded_bytes > curr_region_allocation_bytes_) {
+      curr_region_allocation_bytes_ *= 2;
+      increased_allocation = true;
+    }
+    bytes = curr_region_allocation_bytes_;
+  } else if (region_manager_.regions().empty()) {
+    bytes = std::max(rounded_bytes, initial_chunk_bytes_);
+  } else if (extend_strategy_ == ArenaExtendStrategy::kFixedIncrement) {
+    bytes = std::max(rounded_bytes, extend_increment_bytes_);
+  } else {
+    bytes = rounded_bytes;
   }
 
   // Try allocating.
-  size_t bytes = std::min(curr_region_allocation_bytes_, available_bytes);
+  bytes = std::min(bytes, available_bytes);
   void* mem_addr = device_allocator_->Alloc(bytes);
   if (mem_addr == nullptr && !started_backpedal_) {
     // Only backpedal once.
@@ -94,7 +170,7 @@ bool BFCArena::Extend(size_t rounded_bytes) {
     return false;
   }
 
-  if (!increased_allocation) {
+  if (extend_strategy_ == ArenaExtendStrategy::kNextPowerOfTwo && !increased_allocation) {
     // Increase the region size of the next required allocation.
     curr_region_allocation_bytes_ *= 2;
   }
@@ -103,6 +179,7 @@ bool BFCArena::Extend(size_t rounded_bytes) {
                      << " bytes.";
 
   stats_.total_allocated_bytes += bytes;
+  ++stats_.num_extends;
   LOGS_DEFAULT(INFO) << "Total allocated bytes: "
                      << stats_.total_allocated_bytes;
 
@@ -160,7 +237,93 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
-  return AllocateRawInternal(size, false);
+  if (thread_cache_bytes_ == 0 || size == 0 || size > kMaxThreadCachedSize) {
+    return AllocateRawInternal(size, false, nullptr);
+  }
+
+  ThreadCache* cache = GetThreadCache();
+  std::lock_guard<std::mutex> cache_lock(cache->mutex);
+  DrainRemoteFrees(*cache);
+
+  size_t rounded_bytes = RoundedBytes(size);
+  auto& free_list = cache->free_lists[(rounded_bytes >> kMinAllocationBits) - 1];
+  if (free_list.empty()) {
+    return AllocateRawInternal(size, false, cache);
+  }
+
+  void* ptr = free_list.back();
+  free_list.pop_back();
+  cache->cached_bytes -= rounded_bytes;
+  cache->outstanding[ptr] = {rounded_bytes, size};
+  bytes_in_thread_caches_ -= static_cast<int64_t>(rounded_bytes);
+  ++num_thread_cache_hits_;
+  return ptr;
+}
+
+BFCArena::ThreadCache* BFCArena::GetThreadCache() {
+  static thread_local std::vector<std::unique_ptr<ThreadCache>> caches;
+  for (auto& cache : caches) {
+    if (cache->owner == thread_cache_owner_) {
+      return cache.get();
+    }
+  }
+
+  // drop the caches of arenas that have been destroyed
+  auto dead = std::remove_if(caches.begin(), caches.end(), [](const std::unique_ptr<ThreadCache>& cache) {
+    std::lock_guard<std::mutex> guard(cache->owner->mutex);
+    return cache->owner->arena == nullptr;
+  });
+  caches.erase(dead, caches.end());
+
+  caches.push_back(std::make_unique<ThreadCache>(thread_cache_owner_));
+  std::lock_guard<std::mutex> guard(thread_cache_owner_->mutex);
+  thread_cache_owner_->caches.push_back(caches.back().get());
+  return caches.back().get();
+}
+
+void BFCArena::DrainRemoteFrees(ThreadCache& cache) {
+  if (cache.has_remote_frees.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(lock_);
+    DrainRemoteFreesLocked(cache);
+  }
+}
+
+void BFCArena::DrainRemoteFreesLocked(ThreadCache& cache) {
+  for (const void* p : cache.remote_frees) {
+    cache.outstanding.erase(p);
+  }
+  cache.remote_frees.clear();
+  cache.has_remote_frees.store(false, std::memory_order_release);
+}
+
+void BFCArena::FlushThreadCacheLocked(ThreadCache& cache) {
+  for (auto& free_list : cache.free_lists) {
+    for (void* p : free_list) {
+      BFCArena::ChunkHandle h = region_manager_.get_handle(p);
+      ORT_ENFORCE(h != kInvalidChunkHandle);
+      ChunkFromHandle(h)->cache_owner = nullptr;
+      FreeAndMaybeCoalesce(h);
+    }
+    free_list.clear();
+  }
+  bytes_in_thread_caches_ -= static_cast<int64_t>(cache.cached_bytes);
+  cache.cached_bytes = 0;
+}
+
+void BFCArena::ReleaseThreadCache(ThreadCache& cache) {
+  std::lock_guard<std::mutex> lock(lock_);
+  DrainRemoteFreesLocked(cache);
+  FlushThreadCacheLocked(cache);
+
+  // chunks still in use will be freed through the lock
+  for (const auto& entry : cache.outstanding) {
+    BFCArena::ChunkHandle h = region_manager_.get_handle(entry.first);
+    ORT_ENFORCE(h != kInvalidChunkHandle);
+    Chunk* c = ChunkFromHandle(h);
+    c->cache_owner = nullptr;
+    c->requested_size = entry.second.requested_bytes;
+  }
+  cache.outstanding.clear();
 }
 
 void* BFCArena::Reserve(size_t size) {
@@ -180,6 +343,16 @@ void* BFCArena::Reserve(size_t size) {
 }
 
 size_t BFCArena::RequestedSize(const void* ptr) {
+  if (thread_cache_bytes_ > 0) {
+    ThreadCache* cache = GetThreadCache();
+    std::lock_guard<std::mutex> cache_lock(cache->mutex);
+    DrainRemoteFrees(*cache);
+    auto entry = cache->outstanding.find(ptr);
+    if (entry != cache->outstanding.end()) {
+      return entry->second.requested_bytes;
+    }
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -196,7 +369,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    ThreadCache* cache) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(WARNING) << "tried to allocate 0 bytes";
     return nullptr;
@@ -211,16 +385,20 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 
   std::lock_guard<std::mutex> lock(lock_);
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
-  if (ptr != nullptr) {
-    return ptr;
-  }
 
   // Try to extend
-  if (Extend(rounded_bytes)) {
+  if (ptr == nullptr && Extend(rounded_bytes)) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
-    if (ptr != nullptr) {
-      return ptr;
+  }
+
+  if (ptr != nullptr) {
+    if (cache != nullptr) {
+      // the address may still be tracked from before another thread freed it
+      DrainRemoteFreesLocked(*cache);
+      ChunkFromHandle(region_manager_.get_handle(ptr))->cache_owner = cache;
+      cache->outstanding[ptr] = {rounded_bytes, num_bytes};
     }
+    return ptr;
   }
 
   // We searched all bins for an existing free chunk to use and
@@ -238,6 +416,107 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+  stats->num_thread_cache_hits = num_thread_cache_hits_.load();
+  stats->num_allocs += stats->num_thread_cache_hits;
+  stats->bytes_in_thread_caches = bytes_in_thread_caches_.load();
+
+  // the bins are sorted by size, so the largest free chunk is the last one of the highest non-empty bin
+  stats->largest_free_block = 0;
+  for (BinNum b = kNumBins - 1; b >= 0; b--) {
+    const Bin* bin = BinFromIndex(b);
+    if (!bin->free_chunks.empty()) {
+      stats->largest_free_block = static_cast<int64_t>(ChunkFromHandle(*bin->free_chunks.rbegin())->size);
+      break;
+    }
+  }
+}
+
+bool BFCArena::ReserveCapacity(size_t size) {
+  if (size == 0) {
+    return true;
+  }
+
+  size_t rounded_bytes = RoundedBytes(size);
+  std::lock_guard<std::mutex> lock(lock_);
+  for (BinNum b = BinNumForSize(rounded_bytes); b < kNumBins; b++) {
+    const Bin* bin = BinFromIndex(b);
+    if (!bin->free_chunks.empty() && ChunkFromHandle(*bin->free_chunks.rbegin())->size >= rounded_bytes) {
+      return true;
+    }
+  }
+
+  return Extend(rounded_bytes);
+}
+
+void BFCArena::Shrink() {
+  {
+    // threads of a pool may not call into the arena again for a long time, so flush every cache
+    std::lock_guard<std::mutex> guard(thread_cache_owner_->mutex);
+    for (ThreadCache* cache : thread_cache_owner_->caches) {
+      std::lock_guard<std::mutex> cache_lock(cache->mutex);
+      std::lock_guard<std::mutex> lock(lock_);
+      DrainRemoteFreesLocked(*cache);
+      FlushThreadCacheLocked(*cache);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  ReleaseFreeRegionsLocked(0);
+}
+
+void BFCArena::ReleaseFreeRegionsLocked(size_t bytes_to_keep) {
+  last_shrink_time_ = std::chrono::steady_clock::now();
+  if (free_region_bytes_ <= bytes_to_keep) {
+    return;
+  }
+
+  // a region is completely free if it consists of a single chunk that is not in use
+  std::vector<ChunkHandle> free_regions;
+  size_t free_bytes = 0;
+  for (const auto& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    const Chunk* c = ChunkFromHandle(h);
+    if (!c->in_use() && c->next == kInvalidChunkHandle) {
+      free_regions.push_back(h);
+      free_bytes += c->size;
+    }
+  }
+
+  // release the largest regions first so small ones stay around for the next requests
+  std::sort(free_regions.begin(), free_regions.end(), [this](ChunkHandle a, ChunkHandle b) {
+    return ChunkFromHandle(a)->size > ChunkFromHandle(b)->size;
+  });
+
+  for (ChunkHandle h : free_regions) {
+    if (free_bytes <= bytes_to_keep) {
+      break;
+    }
+
+    Chunk* c = ChunkFromHandle(h);
+    void* ptr = c->ptr;
+    size_t bytes = c->size;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    region_manager_.RemoveAllocationRegion(ptr);
+    device_allocator_->Free(ptr);
+
+    LOGS_DEFAULT(INFO) << "Released region of " << bytes << " bytes at " << ptr;
+
+    free_bytes -= bytes;
+    stats_.total_allocated_bytes -= bytes;
+    ++stats_.num_regions_released;
+    stats_.bytes_released += bytes;
+  }
+}
+
+void BFCArena::MaybeShrinkLocked() {
+  if (shrink_interval_.count() > 0 &&
+      std::chrono::steady_clock::now() - last_shrink_time_ >= shrink_interval_) {
+    ReleaseFreeRegionsLocked(0);
+  } else if (shrink_threshold_bytes_ > 0 && free_region_bytes_ > shrink_threshold_bytes_) {
+    // only scan the regions when freeing actually pushed the completely free ones over the threshold
+    ReleaseFreeRegionsLocked(shrink_threshold_bytes_);
+  }
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -328,6 +607,26 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  ThreadCache* cache = nullptr;
+  std::unique_lock<std::mutex> cache_lock;
+  if (thread_cache_bytes_ > 0) {
+    cache = GetThreadCache();
+    cache_lock = std::unique_lock<std::mutex>(cache->mutex);
+    DrainRemoteFrees(*cache);
+    auto entry = cache->outstanding.find(p);
+    if (entry != cache->outstanding.end()) {
+      size_t rounded_bytes = entry->second.rounded_bytes;
+      cache->outstanding.erase(entry);
+      if (cache->cached_bytes + rounded_bytes <= thread_cache_bytes_) {
+        cache->free_lists[(rounded_bytes >> kMinAllocationBits) - 1].push_back(p);
+        cache->cached_bytes += rounded_bytes;
+        bytes_in_thread_caches_ += static_cast<int64_t>(rounded_bytes);
+        return;
+      }
+    }
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -336,15 +635,28 @@ void BFCArena::Free(void* p) {
     stats_.total_allocated_bytes -= it->second;
     reserved_chunks_.erase(it);
   } else {
-    DeallocateRawInternal(p);
+    DeallocateRawInternal(p, cache);
+    if (shrink_threshold_bytes_ > 0 || shrink_interval_.count() > 0) {
+      MaybeShrinkLocked();
+    }
   }
 }
 
-void BFCArena::DeallocateRawInternal(void* ptr) {
+void BFCArena::DeallocateRawInternal(void* ptr, ThreadCache* cache) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
 
+  Chunk* c = ChunkFromHandle(h);
+  if (c->cache_owner != nullptr) {
+    // freed by a thread other than the one that handed it out: let the owner forget about it
+    if (c->cache_owner != cache) {
+      c->cache_owner->remote_frees.push_back(ptr);
+      c->cache_owner->has_remote_frees.store(true, std::memory_order_release);
+    }
+    c->cache_owner = nullptr;
+  }
+
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
 }
@@ -395,6 +707,9 @@ void BFCArena::InsertFreeChunkIntoBin(BFCArena::ChunkHandle h) {
   Bin* new_bin = BinFromIndex(bin_num);
   c->bin_num = bin_num;
   new_bin->free_chunks.insert(h);
+  if (c->prev == kInvalidChunkHandle && c->next == kInvalidChunkHandle) {
+    free_region_bytes_ += c->size;
+  }
 }
 
 void BFCArena::RemoveFreeChunkIterFromBin(
@@ -405,6 +720,9 @@ void BFCArena::RemoveFreeChunkIterFromBin(
   ORT_ENFORCE(!c->in_use() && (c->bin_num != kInvalidBinNum));
   free_chunks->erase(citer);
   c->bin_num = kInvalidBinNum;
+  if (c->prev == kInvalidChunkHandle && c->next == kInvalidChunkHandle) {
+    free_region_bytes_ -= c->size;
+  }
 }
 
 void BFCArena::RemoveFreeChunkFromBin(BFCArena::ChunkHandle h) {
@@ -413,6 +731,9 @@ void BFCArena::RemoveFreeChunkFromBin(BFCArena::ChunkHandle h) {
   ORT_ENFORCE(BinFromIndex(c->bin_num)->free_chunks.erase(h) > 0,
               "Could not find chunk in bin");
   c->bin_num = kInvalidBinNum;
+  if (c->prev == kInvalidChunkHandle && c->next == kInvalidChunkHandle) {
+    free_region_bytes_ -= c->size;
+  }
 }
 
 void BFCArena::FreeAndMaybeCoalesce(BFCArena::ChunkHandle h) {
@@ -16,6 +16,8 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -36,41 +38,6 @@ namespace onnxruntime {
 #pragma GCC diagnostic ignored "-Wnull-dereference"
 #endif
 #endif
-// Runtime statistics collected by an allocator.
-struct AllocatorStats {
-  int64_t num_allocs;             // Number of allocations.
-  int64_t bytes_in_use;           // Number of bytes in use.
-  int64_t total_allocated_bytes;  // The total number of allocated bytes by the allocator.
-  int64_t max_bytes_in_use;       // The maximum bytes in use.
-  int64_t max_alloc_size;         // The max single allocation seen.
-                                  // The upper limit what the allocator can allocate, if such a limit
-                                  // is known. Certain allocator may return 0 to indicate the limit is
-                                  // unknown.
-  int64_t bytes_limit;
-
-  AllocatorStats() { Clear(); }
-
-  void Clear() {
-    this->num_allocs = 0;
-    this->bytes_in_use = 0;
-    this->max_bytes_in_use = 0;
-    this->max_alloc_size = 0;
-    this->bytes_limit = 0;
-    this->total_allocated_bytes = 0;
-  }
-
-  std::string DebugString() const {
-    std::ostringstream ss;
-    ss << "Limit:           " << this->bytes_limit << "\n"
-       << "InUse:          " << this->bytes_in_use << "\n"
-       << "TotalAllocated: " << this->total_allocated_bytes << "\n"
-       << "MaxInUse:       " << this->max_bytes_in_use << "\n"
-       << "NumAllocs:      " << this->num_allocs << "\n"
-       << "MaxAllocSize:   " << this->max_alloc_size << "\n";
-    return ss.str();
-  }
-};
-
 // A memory allocator that implements a 'best-fit with coalescing'
 // algorithm.  This is essentially a very simple version of Doug Lea's
 // malloc (dlmalloc).
@@ -79,9 +46,15 @@ struct AllocatorStats {
 // coalescing.  One assumption we make is that the process using this
 // allocator owns pretty much all of the memory, and that nearly
 // all requests to allocate memory go through this interface.
+//
+// Requests up to kMaxThreadCachedSize bytes can be served from a per-thread
+// cache of recently freed chunks (see ArenaConfig::thread_cache_bytes), and
+// regions that became completely free can be handed back to the device
+// allocator (see ArenaConfig::shrink_threshold_bytes/shrink_interval_ms).
 class BFCArena : public IArenaAllocator {
  public:
-  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory);
+  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory,
+           const ArenaConfig& config = ArenaConfig());
 
   ~BFCArena() override;
 
@@ -112,15 +85,51 @@ class BFCArena : public IArenaAllocator {
     return device_allocator_->CreateFence(session_state);
   }
 
-  void GetStats(AllocatorStats* stats);
+  void GetStats(AllocatorStats* stats) override;
+
+  // Flush the caches of all threads and return all completely free regions to the device allocator.
+  void Shrink() override;
+
+  bool ReserveCapacity(size_t size) override;
 
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
-  void DeallocateRawInternal(void* ptr);
+  struct ThreadCache;
+
+  // Shared by the arena and the thread caches created for it, so a cache destroyed at thread exit
+  // can tell whether the arena is still alive.
+  struct ThreadCacheOwner {
+    std::mutex mutex;
+    BFCArena* arena = nullptr;
+    // the live caches of all threads, guarded by mutex
+    std::vector<ThreadCache*> caches;
+  };
+
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure, ThreadCache* cache);
+  void DeallocateRawInternal(void* ptr, ThreadCache* cache);
+
+  // Returns the calling thread's cache for this arena, creating it on first use.
+  ThreadCache* GetThreadCache();
+
+  // Forget chunks of 'cache' that other threads have freed in the meantime.
+  void DrainRemoteFrees(ThreadCache& cache);
+  void DrainRemoteFreesLocked(ThreadCache& cache);
+
+  // Returns the chunks parked in 'cache' to the bins. Requires lock_.
+  void FlushThreadCacheLocked(ThreadCache& cache);
+
+  // Called when a thread exits. Flushes 'cache' and detaches the chunks it still tracks.
+  void ReleaseThreadCache(ThreadCache& cache);
+
+  // Returns completely free regions to the device allocator until at most 'bytes_to_keep' bytes of
+  // them remain. Requires lock_.
+  void ReleaseFreeRegionsLocked(size_t bytes_to_keep);
+
+  // Applies the shrink policy of the arena config after a chunk was freed. Requires lock_.
+  void MaybeShrinkLocked();
 
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
@@ -165,6 +174,9 @@ class BFCArena : public IArenaAllocator {
     // What bin are we in?
     BinNum bin_num = kInvalidBinNum;
 
+    // The thread cache that handed out this chunk and may recycle it without taking the lock.
+    ThreadCache* cache_owner = nullptr;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -218,6 +230,10 @@ class BFCArena : public IArenaAllocator {
   static const size_t kMinAllocationBits = 8;
   static const size_t kMinAllocationSize = 1 << kMinAllocationBits;
 
+  // Largest request that is served by the per-thread caches, and the number of size classes they use.
+  static const size_t kMaxThreadCachedSize = 64 << 10;
+  static const size_t kNumThreadCacheClasses = kMaxThreadCachedSize >> kMinAllocationBits;
+
   // AllocationRegion maps pointers to ChunkHandles for a single
   // contiguous memory region.
   //
@@ -304,6 +320,14 @@ class BFCArena : public IArenaAllocator {
       regions_.insert(entry, AllocationRegion(ptr, memory_size));
     }
 
+    void RemoveAllocationRegion(void* ptr) {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
+      ORT_ENFORCE(entry != regions_.end() && entry->ptr() == ptr,
+                  "Could not find Region for ", ptr);
+      regions_.erase(entry);
+    }
+
     ChunkHandle get_handle(const void* p) const {
       return RegionFor(p)->get_handle(p);
     }
@@ -478,6 +502,25 @@ class BFCArena : public IArenaAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  // Immutable after construction.
+  ArenaExtendStrategy extend_strategy_ = ArenaExtendStrategy::kNextPowerOfTwo;
+  size_t initial_chunk_bytes_ = 0;
+  size_t extend_increment_bytes_ = 0;
+  size_t thread_cache_bytes_ = 0;
+  size_t shrink_threshold_bytes_ = 0;
+  std::chrono::milliseconds shrink_interval_{0};
+
+  std::chrono::steady_clock::time_point last_shrink_time_;
+
+  // Bytes of the regions that consist of a single free chunk.
+  size_t free_region_bytes_ = 0;
+
+  std::shared_ptr<ThreadCacheOwner> thread_cache_owner_;
+
+  // Updated outside of lock_ by the per-thread caches.
+  std::atomic<int64_t> num_thread_cache_hits_{0};
+  std::atomic<int64_t> bytes_in_thread_caches_{0};
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
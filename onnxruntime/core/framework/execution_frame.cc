@@ -29,31 +29,19 @@ ExecutionFrame::ExecutionFrame(const std::unordered_map<std::string, MLValue>& f
   if (session_state.GetEnableMemoryPattern() &&
       session_state.GetExecutionPlan()) {
     std::vector<TensorShape> input_shapes;
-    bool all_tensors = true;
-    for (const auto& feed : feeds) {
-      if (!(feed.second.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-      auto& tensor = feed.second.Get<Tensor>();
-      input_shapes.push_back(tensor.Shape());
-    }
-    // if there is some traditional ml value type in inputs
-    // disable the memory pattern optimization.
-    if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
-      // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
-        planner_ = std::make_unique<MLValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
-        // pre-allocate the big chunk requested in memory pattern.
-        // all the internal kernel's input/output tensors will be allocated on these buffer.
-        for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
-          ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
-          AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
-          void* buffer = mem_patterns_->patterns[i].PeakSize() > 0 ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize()) : nullptr;
-          buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
-        }
+    session_state.GetMemoryPatternInputShapes(feeds, input_shapes);
+    mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
+    // if no existing patterns, generate one in this executionframe
+    if (!mem_patterns_) {
+      planner_ = std::make_unique<MLValuePatternPlanner>(*session_state.GetExecutionPlan());
+    } else {
+      // pre-allocate the big chunk requested in memory pattern.
+      // all the internal kernel's input/output tensors will be allocated on these buffer.
+      for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
+        ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
+        AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
+        void* buffer = mem_patterns_->patterns[i].PeakSize() > 0 ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize()) : nullptr;
+        buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
       }
     }
   }
@@ -121,7 +109,8 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(int mlvalue_inde
           return status;
         }
         if (block->size_ != size) {
-          LOGS_DEFAULT(WARNING) << "For mlvalue with index: " << mlvalue_index << ", block in memory pattern size is: "
+          mem_patterns_mismatch_ = true;
+          LOGS(session_state_.Logger(), WARNING) << "For mlvalue with index: " << mlvalue_index << ", block in memory pattern size is: "
                                 << block->size_ << " but the actually size is: " << size << ", fall back to default allocation behavior";
         } else if (it == buffers_.end()) {
           LOGS_DEFAULT(WARNING) << "For mlvalue with index: " << mlvalue_index << ", block not found in target loation. "
@@ -198,6 +187,46 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(int mlvalue_index_
   return AllocateTensorWithPreAllocateBufferHelper(p_mlvalue, reuse_buffer, element_type, location, shape);
 }
 
+// Place the MLValue at its planned offset inside the buffer of an allocate_early MLValue
+// (e.g. a Concat input written directly into the Concat output), allocating that buffer
+// first if this is the first MLValue placed inside it.
+Status ExecutionFrame::AllocateMLValueTensorInEarlyBuffer(int mlvalue_index,
+                                                          const SequentialExecutionPlan::AllocPlanPerValue& per_alloc_plan,
+                                                          const DataTypeImpl* element_type,
+                                                          const TensorShape& shape) {
+  // the placement is only valid for the planned shape. otherwise use a buffer of our own;
+  // the consumer copies the data as it would without the placement.
+  if (!per_alloc_plan.has_static_shape || per_alloc_plan.static_shape != shape) {
+    return AllocateMLValueTensorSelfOwnBuffer(mlvalue_index, element_type, per_alloc_plan.location, shape,
+                                              per_alloc_plan.create_fence_if_async);
+  }
+
+  int buffer_mlvalue_index = per_alloc_plan.reused_buffer;
+  const auto& buffer_alloc_plan = GetAllocationPlan(buffer_mlvalue_index);
+  MLValue* p_buffer_mlvalue = &all_values_[buffer_mlvalue_index];
+  if (!p_buffer_mlvalue->IsAllocated()) {
+    auto buffer_element_type = static_cast<const TensorTypeBase*>(buffer_alloc_plan.value_type)->GetElementType();
+    ORT_RETURN_IF_ERROR(AllocateMLValueTensorSelfOwnBuffer(buffer_mlvalue_index,
+                                                           buffer_element_type,
+                                                           buffer_alloc_plan.location,
+                                                           buffer_alloc_plan.static_shape,
+                                                           buffer_alloc_plan.create_fence_if_async));
+  }
+
+  auto* buffer_tensor = p_buffer_mlvalue->GetMutable<Tensor>();
+  size_t size;
+  if (!IAllocator::CalcMemSizeForArray(shape.Size(), element_type->Size(), &size) ||
+      per_alloc_plan.reused_buffer_offset + size > buffer_tensor->Size()) {
+    return AllocateMLValueTensorSelfOwnBuffer(mlvalue_index, element_type, per_alloc_plan.location, shape,
+                                              per_alloc_plan.create_fence_if_async);
+  }
+
+  MLValue* p_mlvalue = &all_values_[mlvalue_index];
+  p_mlvalue->ShareFenceWith(*p_buffer_mlvalue);
+  void* buffer = static_cast<char*>(buffer_tensor->MutableDataRaw()) + per_alloc_plan.reused_buffer_offset;
+  return AllocateTensorWithPreAllocateBufferHelper(p_mlvalue, buffer, element_type, per_alloc_plan.location, shape);
+}
+
 Status ExecutionFrame::AllocateTensorWithPreAllocateBufferHelper(MLValue* p_mlvalue,
                                                                  void* pBuffer,
                                                                  const DataTypeImpl* element_type,
@@ -290,6 +319,16 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(int mlvalue_index,
     }
     case AllocKind::kReuse: {
       int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
+      // only the ml-values the planner placed inside an allocate_early buffer carry a static shape.
+      // other ml-values reusing that buffer (e.g. in-place consumers, or later values taking it from
+      // the free list) reuse it like any other buffer.
+      if (alloc_plan[reuse_mlvalue_index].allocate_early && per_alloc_plan.has_static_shape) {
+        ORT_RETURN_IF_ERROR(AllocateMLValueTensorInEarlyBuffer(mlvalue_index,
+                                                               per_alloc_plan,
+                                                               ml_data_type,
+                                                               parameters.tensor_shape));
+        break;
+      }
       ORT_RETURN_IF_ERROR(AllocateMLValueTensorPreAllocateBuffer(mlvalue_index,
                                                                          reuse_mlvalue_index,
                                                                          ml_data_type,
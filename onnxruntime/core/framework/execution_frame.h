@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "core/common/common.h"
@@ -110,6 +111,11 @@ class ExecutionFrame {
     return planner_ != nullptr;
   }
 
+  // true if a block of the memory patterns used by this frame didn't have the size of the tensor placed in it.
+  bool HasMemoryPatternMismatch() const {
+    return mem_patterns_mismatch_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
@@ -125,6 +131,11 @@ class ExecutionFrame {
                                                   const TensorShape& shape,
                                                   bool create_fence);
 
+  Status AllocateMLValueTensorInEarlyBuffer(int mlvalue_index,
+                                            const SequentialExecutionPlan::AllocPlanPerValue& per_alloc_plan,
+                                            MLDataType element_type,
+                                            const TensorShape& shape);
+
   void Init(const onnxruntime::GraphViewer& graph,
             const std::unordered_map<std::string, MLValue>& feeds,
             const std::vector<std::string>& output_names,
@@ -168,6 +179,7 @@ class ExecutionFrame {
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
   const MemoryPatternGroup* mem_patterns_;
+  std::atomic<bool> mem_patterns_mismatch_{false};
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
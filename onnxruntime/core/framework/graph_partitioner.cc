@@ -61,11 +61,58 @@ Status GraphPartitioner::Partition(onnxruntime::Graph& graph) const {
   //fused_kernel_registry is prepareing the kernels created on the fly for fused sub graph.
   //It is only visiable for current session.
   std::shared_ptr<KernelRegistry> fused_kernel_registry = std::make_shared<KernelRegistry>();
+  std::unordered_map<std::string, int> fused_node_counts;
+
+  // Assign the nodes to providers, then inline all the function nodes no provider can run, and repeat
+  // for the nodes the functions were expanded to.
+  while (true) {
+    ORT_RETURN_IF_ERROR(AssignNodes(graph, *fused_kernel_registry, fused_node_counts));
+
+    std::vector<NodeIndex> functions_to_inline;
+    for (auto& node : graph.Nodes()) {
+      if (node.GetExecutionProviderType().empty() && node.GetFunctionBody() != nullptr) {
+        functions_to_inline.push_back(node.Index());
+      }
+    }
+    if (functions_to_inline.empty()) {
+      break;
+    }
+
+    // If the node has a functionbody with no kernel and cannot be inlined
+    // it is a invalid function
+    ORT_RETURN_IF_ERROR(graph.InlineFunctions(functions_to_inline));
+  }
+
+  //For some cases, like fp16 on cpu, right now we don't have any kernel support that.
+  //But we will insert cast op to run the model, so skip the error checking here.
+  //If after graph transform phase, the node still not assigned, we will report error
+  //during kernel creation phase.
+#ifdef COUNT_NON_CUDA_OPS
+  for (auto& node : graph.Nodes()) {
+    if (node.GetExecutionProviderType() != kCudaExecutionProvider &&
+        node.Domain() != kMLDomain &&
+        node.Domain() != kMSDomain)
+      non_cuda.AddOp(node.OpType());
+  }
+#endif
+
+  kernel_registry_mgr_.RegisterKernelRegistry(fused_kernel_registry, KernelRegistryPriority::HighPriority);
+
+  return Status::OK();
+}
+
+Status GraphPartitioner::AssignNodes(onnxruntime::Graph& graph, KernelRegistry& fused_kernel_registry,
+                                     std::unordered_map<std::string, int>& fused_node_counts) const {
   // Partitioning <graph> based on provider preference and their capabilities.
   auto kernel_registries = kernel_registry_mgr_.GetAllKernelRegistries();
+
+  // Assigning single nodes doesn't change the structure of the graph, so the viewer is only recreated after a
+  // provider fused a subgraph.
+  auto graph_viewer = std::make_unique<GraphViewer>(graph);
   for (auto& provider : providers_) {
-    auto capability_results = provider->GetCapability(GraphViewer(graph), kernel_registries);
-    int count = 0;
+    auto capability_results = provider->GetCapability(*graph_viewer, kernel_registries);
+    int& count = fused_node_counts[provider->Type()];
+    bool fused = false;
     for (auto& capability : capability_results) {
       if (nullptr == capability || nullptr == capability->sub_graph) {
         continue;
@@ -93,53 +140,18 @@ Status GraphPartitioner::Partition(onnxruntime::Graph& graph) const {
           // build the kernel definition on the fly, and register it to the fused_kernel_regisitry.
           KernelDefBuilder builder;
           BuildFusedKernelDef(builder, fused_node);
-          fused_kernel_registry->Register(builder, fused_kernel_func);
+          fused_kernel_registry.Register(builder, fused_kernel_func);
         }
+        fused = true;
       }
     }
-    // all done with this provider, resolve the graph before we move on to the next provider.
-    // This is needed since we create a new GraphViewer() that we pass into the next provider's GetCapability().
-    ORT_ENFORCE(graph.Resolve().IsOK());
-  }
 
-  // To see if the node with no provider can be inlined. If one such nodes can be
-  // successfully inlined, we re-run the partitioner on the modified graph.
-  bool inline_flag = false;
-  for (auto& node : graph.Nodes()) {
-    if (node.GetExecutionProviderType().empty()) {
-      auto node_func = node.GetFunctionBody();
-      if (nullptr == node_func) {
-        continue;
-      }
-      Status inliner_status = graph.InlineFunction(node);
-      // If the node has a functionbody with no kernel and cannot be inlined
-      // it is a invalid function
-      if (!inliner_status.IsOK()) return inliner_status;
-      // Set the flag for re-run graph partition after successful inlining
-      inline_flag = true;
-      break;
+    // the next provider's GetCapability needs the fused nodes in the graph and the viewer
+    if (fused) {
+      ORT_RETURN_IF_ERROR(graph.Resolve());
+      graph_viewer = std::make_unique<GraphViewer>(graph);
     }
   }
-  // Resolve and rerun graph partition
-  if (inline_flag) {
-    ORT_RETURN_IF_ERROR(graph.Resolve());
-    this->Partition(graph);
-  }
-
-  //For some cases, like fp16 on cpu, right now we don't have any kernel support that.
-  //But we will insert cast op to run the model, so skip the error checking here.
-  //If after graph transform phase, the node still not assigned, we will report error
-  //during kernel creation phase.
-#ifdef COUNT_NON_CUDA_OPS
-  for (auto& node : graph.Nodes()) {
-    if (node.GetExecutionProviderType() != kCudaExecutionProvider &&
-        node.Domain() != kMLDomain &&
-        node.Domain() != kMSDomain)
-      non_cuda.AddOp(node.OpType());
-  }
-#endif
-
-  kernel_registry_mgr_.RegisterKernelRegistry(fused_kernel_registry, KernelRegistryPriority::HighPriority);
 
   return Status::OK();
 }
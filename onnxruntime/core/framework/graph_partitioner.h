@@ -10,6 +10,7 @@
 namespace onnxruntime {
 
 class ExecutionProviders;
+class KernelRegistry;
 class KernelRegistryManager;
 
 class GraphPartitioner {
@@ -25,6 +26,10 @@ class GraphPartitioner {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphPartitioner);
 
+  // one pass of assigning the nodes without a provider to the providers, fusing the subgraphs they claim
+  Status AssignNodes(onnxruntime::Graph& graph, KernelRegistry& fused_kernel_registry,
+                     std::unordered_map<std::string, int>& fused_node_counts) const;
+
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
 };
@@ -3,6 +3,7 @@
 
 #include "core/framework/insert_cast_transformer.h"
 #include "core/framework/data_types.h"
+#include "core/graph/graph_utils.h"
 
 using namespace ONNX_NAMESPACE;
 using namespace ::onnxruntime::common;
@@ -89,6 +90,74 @@ Status ForceSingleNodeCPUFloat16ToFloat32(onnxruntime::Graph& graph) {
   return graph.Resolve();
 }
 
+Status InsertCastTransformer::KeepFloat16Weights(onnxruntime::Graph& graph, bool& modified) const {
+  std::vector<onnxruntime::NodeIndex> candidates;
+  for (auto& node : graph.Nodes()) {
+    if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
+      candidates.push_back(node.Index());
+    }
+  }
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : candidates) {
+    auto& node = *graph.GetNode(index);
+    bool is_gemm = utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", 7) ||
+                   utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", 9);
+    bool is_matmul = utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 1) ||
+                     utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 9);
+    if (!is_gemm && !is_matmul) {
+      continue;
+    }
+
+    // B must be a 2-D float16 initializer that only reaches this node through a Cast
+    const Node* cast_node = nullptr;
+    for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+      if (it->GetDstArgIndex() == 1) {
+        cast_node = &it->GetNode();
+      }
+    }
+    if (cast_node == nullptr || cast_node->OpType() != "Cast" || cast_node->GetOutputEdgesCount() != 1 ||
+        graph.IsNodeOutputsInGraphOutputs(*cast_node)) {
+      continue;
+    }
+    auto* weights = graph.GetNode(cast_node->Index())->MutableInputDefs()[0];
+    const TensorProto* weights_tensor = nullptr;
+    if (!graph.GetInitializedTensor(weights->Name(), weights_tensor) ||
+        weights_tensor->data_type() != TensorProto_DataType_FLOAT16 || weights_tensor->dims_size() != 2) {
+      continue;
+    }
+
+    // FusedGemm is 2-D only, which a MatMul must then be as well
+    auto& input_defs = node.MutableInputDefs();
+    if (is_matmul && (input_defs[0]->Shape() == nullptr || input_defs[0]->Shape()->dim_size() != 2)) {
+      continue;
+    }
+
+    std::vector<onnxruntime::NodeArg*> fused_inputs{input_defs[0], weights};
+    if (is_gemm) {
+      fused_inputs.push_back(input_defs[2]);
+    }
+    auto& fused_gemm = graph.AddNode(graph.GenerateNodeName(node.Name() + "_float16_weights"), "FusedGemm",
+                                     node.OpType() + " " + node.Name() + " with float16 weights",
+                                     fused_inputs, node.MutableOutputDefs(),
+                                     is_gemm ? &node.GetAttributes() : nullptr, kMSDomain);
+    fused_gemm.SetExecutionProviderType(kCpuExecutionProvider);
+
+    removed_nodes.push_back(node.Index());
+    removed_nodes.push_back(cast_node->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+
 Status InsertCastTransformer::Apply(onnxruntime::Graph& graph, bool& modified) const {
   ORT_RETURN_IF_ERROR(graph.Resolve());
   if (force_cpu_fp32_)
@@ -164,6 +233,9 @@ Status InsertCastTransformer::Apply(onnxruntime::Graph& graph, bool& modified) c
 
   //Resolve it to build the edges.
   ORT_RETURN_IF_ERROR(graph.Resolve());
+  if (keep_float16_weights_) {
+    ORT_RETURN_IF_ERROR(KeepFloat16Weights(graph, modified));
+  }
   std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> replacement_defs;
   std::vector<onnxruntime::NodeIndex> removed_nodes;
   for (auto& node : graph.Nodes()) {
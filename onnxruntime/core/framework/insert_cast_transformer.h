@@ -10,9 +10,10 @@
 namespace onnxruntime {
 class InsertCastTransformer : public onnxruntime::GraphTransformer {
  public:
-  InsertCastTransformer(const std::string& name)
+  InsertCastTransformer(const std::string& name, bool keep_float16_weights = false)
       : onnxruntime::GraphTransformer(name, "Transformer to insert cast node that casts float16 to float for cpu nodes"),
-        force_cpu_fp32_(true) {
+        force_cpu_fp32_(true),
+        keep_float16_weights_(keep_float16_weights) {
   }
 
   void AddKernelRegistries(const std::vector<const KernelRegistry*>& kernels) {
@@ -30,6 +31,7 @@ class InsertCastTransformer : public onnxruntime::GraphTransformer {
 
  private:
   bool NeedInsertCast(const onnxruntime::Node* node, const onnxruntime::NodeArg* input) const;
+  Status KeepFloat16Weights(onnxruntime::Graph& graph, bool& modified) const;
 
   std::vector<const KernelRegistry*> kernels_registries_;
   // Currently because we only have very few cpu kernels support float16, place those nodes on float16
@@ -37,5 +39,8 @@ class InsertCastTransformer : public onnxruntime::GraphTransformer {
   // A better solution is to have a cost model to evaluate does it works to place the node on float16.
   // Here for simplify, we only force the single-node-float16 sub-graph to float32
   bool force_cpu_fp32_;
+  // feed the float16 weights of Gemm and 2-D MatMul nodes on CPU to a FusedGemm that converts them while packing,
+  // instead of through a Cast that keeps a float copy of the weights.
+  bool keep_float16_weights_;
 };
 }  // namespace onnxruntime
@@ -14,6 +14,17 @@ struct MemoryBlock {
   MemoryBlock(size_t offset, size_t size) : offset_(offset), size_(size) {}
 };
 
+// A step of the allocation trace a memory pattern was generated from.
+struct MemoryTraceEvent {
+  int ml_value_idx_{-1};
+  size_t size_{0};
+  bool is_free_{false};
+
+  MemoryTraceEvent() = default;
+  MemoryTraceEvent(int ml_value_idx, size_t size, bool is_free)
+      : ml_value_idx_(ml_value_idx), size_(size), is_free_(is_free) {}
+};
+
 class MemoryPattern {
   friend class MemPatternPlanner;
 
@@ -22,11 +33,15 @@ class MemoryPattern {
 
   MemoryPattern(MemoryPattern&& rhs)
       : patterns_{std::move(rhs.patterns_)},
-        peak_size_{std::move(rhs.peak_size_)} {}
+        peak_size_{std::move(rhs.peak_size_)},
+        lower_bound_size_{std::move(rhs.lower_bound_size_)},
+        trace_{std::move(rhs.trace_)} {}
 
   MemoryPattern& operator=(MemoryPattern&& rhs) {
     patterns_ = std::move(rhs.patterns_);
     peak_size_ = std::move(rhs.peak_size_);
+    lower_bound_size_ = std::move(rhs.lower_bound_size_);
+    trace_ = std::move(rhs.trace_);
     return *this;
   }
 
@@ -42,12 +57,25 @@ class MemoryPattern {
     return &it->second;
   }
 
+  // the largest sum of the sizes of the allocations live at the same time.
+  // no assignment of offsets can have a peak size below it.
+  size_t LowerBoundSize() const {
+    return lower_bound_size_;
+  }
+
+  // allocations and frees, in order, the pattern was generated from
+  const std::vector<MemoryTraceEvent>& Trace() const {
+    return trace_;
+  }
+
  private:
   // allow move
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(MemoryPattern);
 
   std::unordered_map<int, MemoryBlock> patterns_;
   size_t peak_size_{0};
+  size_t lower_bound_size_{0};
+  std::vector<MemoryTraceEvent> trace_;
 };
 
 struct MemoryPatternGroup {
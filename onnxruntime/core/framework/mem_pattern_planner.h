@@ -18,7 +18,9 @@ limitations under the License.
 #pragma once
 #include "core/framework/mem_pattern.h"
 #include "core/framework/allocation_planner.h"
+#include <algorithm>
 #include <list>
+#include <numeric>
 
 namespace onnxruntime {
 // MemPatternPlanner is used to trace allocation/free steps
@@ -29,6 +31,7 @@ class MemPatternPlanner {
   MemPatternPlanner() = default;
 
   void TraceAllocation(int ml_value_idx, size_t size) {
+    trace_.emplace_back(ml_value_idx, size, false);
     if (size == 0) {
       allocs_.emplace_back(ml_value_idx, MemoryBlock(0, 0));
       return;
@@ -57,29 +60,114 @@ class MemPatternPlanner {
 
     allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size));
     buffer_size = std::max(buffer_size, best_offset + size);
-    blocks_.insert(best_fit_it, (static_cast<int>(allocs_.size()) - 1));
+    live_blocks_[ml_value_idx] = blocks_.insert(best_fit_it, (static_cast<int>(allocs_.size()) - 1));
   }
 
   void TraceFree(int ml_value_index) {
-    for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
-      if (allocs_[*it].index_ == ml_value_index) {
-        blocks_.erase(it);
-        break;
-      }
+    trace_.emplace_back(ml_value_index, 0, true);
+    auto it = live_blocks_.find(ml_value_index);
+    if (it != live_blocks_.end()) {
+      blocks_.erase(it->second);
+      live_blocks_.erase(it);
     }
   }
 
   MemoryPattern GenerateMemPattern() {
     MemoryPattern pattern;
-    pattern.peak_size_ = buffer_size;
-    for (auto& alloc : allocs_) {
-      pattern.patterns_[alloc.index_] = alloc.block_;
+    // the whole trace is known now, so plan the offsets again with the lifetimes of all the allocations.
+    // keep the offsets assigned while tracing if that doesn't need a smaller buffer.
+    std::vector<MemoryBlock> packed_blocks;
+    size_t packed_size = PackByLifetime(packed_blocks, pattern.lower_bound_size_);
+    bool use_packed = packed_size < buffer_size;
+
+    pattern.peak_size_ = use_packed ? packed_size : buffer_size;
+    for (size_t i = 0; i < allocs_.size(); i++) {
+      pattern.patterns_[allocs_[i].index_] = use_packed ? packed_blocks[i] : allocs_[i].block_;
     }
+    pattern.trace_ = trace_;
 
     return pattern;
   }
 
  protected:
+  // greedy by size offset assignment: the allocations are placed from the largest to the smallest,
+  // each one in the best fitting gap between the already placed allocations whose lifetime overlaps
+  // with its own. blocks gets the block of each entry of allocs_, and lower_bound the largest sum of
+  // the sizes of the allocations live at the same time. returns the size of the buffer needed.
+  size_t PackByLifetime(std::vector<MemoryBlock>& blocks, size_t& lower_bound) const {
+    // lifetime of each entry of allocs_ as [start, end) in trace steps
+    std::vector<std::pair<size_t, size_t>> lifetimes;
+    lifetimes.reserve(allocs_.size());
+    std::unordered_map<int, size_t> live;
+    size_t live_size = 0;
+    lower_bound = 0;
+    for (size_t step = 0; step < trace_.size(); step++) {
+      const auto& event = trace_[step];
+      if (!event.is_free_) {
+        live[event.ml_value_idx_] = lifetimes.size();
+        lifetimes.emplace_back(step, trace_.size());
+        live_size += event.size_;
+        lower_bound = std::max(lower_bound, live_size);
+      } else {
+        auto it = live.find(event.ml_value_idx_);
+        if (it != live.end()) {
+          lifetimes[it->second].second = step;
+          live_size -= allocs_[it->second].block_.size_;
+          live.erase(it);
+        }
+      }
+    }
+
+    std::vector<size_t> order(allocs_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+      return allocs_[lhs].block_.size_ > allocs_[rhs].block_.size_;
+    });
+
+    blocks.assign(allocs_.size(), MemoryBlock(0, 0));
+    std::vector<size_t> placed;
+    std::vector<const MemoryBlock*> overlapping;
+    size_t peak = 0;
+    for (size_t i : order) {
+      size_t size = allocs_[i].block_.size_;
+      if (size == 0) {
+        continue;
+      }
+
+      overlapping.clear();
+      for (size_t j : placed) {
+        if (lifetimes[j].first < lifetimes[i].second && lifetimes[i].first < lifetimes[j].second) {
+          overlapping.push_back(&blocks[j]);
+        }
+      }
+      std::sort(overlapping.begin(), overlapping.end(),
+                [](const MemoryBlock* lhs, const MemoryBlock* rhs) { return lhs->offset_ < rhs->offset_; });
+
+      size_t current = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      size_t best_offset = std::numeric_limits<size_t>::max();
+      for (const auto* block : overlapping) {
+        if (block->offset_ > current) {
+          auto gap = block->offset_ - current;
+          if (gap >= size && (gap - size) < waste_bytes) {
+            waste_bytes = gap - size;
+            best_offset = current;
+          }
+        }
+        current = std::max(current, block->offset_ + block->size_);
+      }
+      if (best_offset == std::numeric_limits<size_t>::max()) {
+        best_offset = current;
+      }
+
+      blocks[i] = MemoryBlock(best_offset, size);
+      peak = std::max(peak, best_offset + size);
+      placed.push_back(i);
+    }
+
+    return peak;
+  }
+
   struct MLValueAllocationBlock {
     int index_{-1};
     MemoryBlock block_;
@@ -91,7 +179,10 @@ class MemPatternPlanner {
   std::vector<MLValueAllocationBlock> allocs_;
   // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
   std::list<int> blocks_;
+  // position in blocks_ of the block of each live ml value
+  std::unordered_map<int, std::list<int>::iterator> live_blocks_;
   size_t buffer_size{0};
+  std::vector<MemoryTraceEvent> trace_;
 };
 
 }  // namespace onnxruntime
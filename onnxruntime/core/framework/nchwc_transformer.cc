@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <unordered_set>
+
+#include "core/framework/nchwc_transformer.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/mlas/inc/mlas.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+class NchwcTransformerImpl {
+ public:
+  explicit NchwcTransformerImpl(Graph& graph) noexcept
+      : graph_(graph), block_size_(static_cast<int64_t>(MlasNchwcGetBlockSize())) {}
+
+  void Transform(Node& node);
+  Status Finalize(bool& modified);
+
+ private:
+  bool IsCpuNode(const Node& node) const {
+    return node.GetExecutionProviderType().empty() || node.GetExecutionProviderType() == kCpuExecutionProvider;
+  }
+
+  bool IsBlocked(const NodeArg* arg) const {
+    return blocked_args_.find(arg) != blocked_args_.end();
+  }
+
+  // returns the blocked version of <input>, reordering it when it isn't blocked yet
+  NodeArg* BlockedInput(NodeArg* input);
+
+  // returns a new NodeArg to hold <output> in the blocked layout
+  NodeArg* BlockedOutput(NodeArg* output);
+
+  Node& AddNchwcNode(const Node& node, const std::string& op_type,
+                     const std::vector<NodeArg*>& inputs, const std::vector<NodeArg*>& outputs,
+                     const std::vector<std::string>& attribute_names);
+
+  void TransformConv(Node& node);
+  void TransformPool(Node& node, const std::string& op_type);
+  void TransformElementwise(Node& node);
+
+  Graph& graph_;
+  const int64_t block_size_;
+
+  // original NodeArg to the NodeArg holding the same tensor in the blocked layout
+  std::unordered_map<const NodeArg*, NodeArg*> blocked_args_;
+
+  // original NodeArgs whose producer now outputs the blocked layout instead
+  std::vector<NodeArg*> replaced_outputs_;
+
+  std::vector<NodeIndex> removed_nodes_;
+};
+
+NodeArg* NchwcTransformerImpl::BlockedInput(NodeArg* input) {
+  auto it = blocked_args_.find(input);
+  if (it != blocked_args_.end()) {
+    return it->second;
+  }
+
+  auto* blocked = &graph_.GetOrCreateNodeArg(graph_.GenerateNodeArgName(input->Name() + "_nchwc"), input->TypeAsProto());
+  graph_.AddNode(graph_.GenerateNodeName("ReorderInput"), "ReorderInput", "reorder " + input->Name() + " to NCHWc",
+                 std::vector<NodeArg*>{input}, std::vector<NodeArg*>{blocked}, nullptr, kMSDomain);
+  blocked_args_[input] = blocked;
+  return blocked;
+}
+
+NodeArg* NchwcTransformerImpl::BlockedOutput(NodeArg* output) {
+  auto* blocked = &graph_.GetOrCreateNodeArg(graph_.GenerateNodeArgName(output->Name() + "_nchwc"), output->TypeAsProto());
+  blocked_args_[output] = blocked;
+  replaced_outputs_.push_back(output);
+  return blocked;
+}
+
+Node& NchwcTransformerImpl::AddNchwcNode(const Node& node, const std::string& op_type,
+                                         const std::vector<NodeArg*>& inputs, const std::vector<NodeArg*>& outputs,
+                                         const std::vector<std::string>& attribute_names) {
+  Node& nchwc_node = graph_.AddNode(graph_.GenerateNodeName(node.Name() + "_nchwc"), op_type,
+                                    "NCHWc " + node.OpType() + " " + node.Name(), inputs, outputs, nullptr, kMSDomain);
+
+  // only copy the attributes the Nchwc schema knows, e.g. MaxPool's storage_order has no equivalent
+  const auto& attributes = node.GetAttributes();
+  for (const auto& name : attribute_names) {
+    auto it = attributes.find(name);
+    if (it != attributes.end()) {
+      nchwc_node.AddAttribute(name, it->second);
+    }
+  }
+
+  nchwc_node.SetExecutionProviderType(node.GetExecutionProviderType());
+  removed_nodes_.push_back(node.Index());
+  return nchwc_node;
+}
+
+void NchwcTransformerImpl::TransformConv(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+
+  const auto& attributes = node.GetAttributes();
+  auto group_attr = attributes.find("group");
+  if (group_attr != attributes.end() && group_attr->second.i() != 1) {
+    return;
+  }
+
+  // the filter is reordered once when the kernel is created, so it must be constant
+  const TensorProto* filter = nullptr;
+  if (!graph_.GetInitializedTensor(input_defs[1]->Name(), filter) || filter->dims_size() != 4 ||
+      filter->dims(0) % block_size_ != 0 || filter->dims(1) % block_size_ != 0) {
+    return;
+  }
+
+  std::vector<NodeArg*> inputs(input_defs);
+  inputs[0] = BlockedInput(input_defs[0]);
+  std::vector<NodeArg*> outputs{BlockedOutput(node.MutableOutputDefs()[0])};
+
+  AddNchwcNode(node, "NchwcConv", inputs, outputs,
+               {"auto_pad", "kernel_shape", "dilations", "strides", "pads", "group"});
+}
+
+void NchwcTransformerImpl::TransformPool(Node& node, const std::string& op_type) {
+  auto& input_defs = node.MutableInputDefs();
+  auto& output_defs = node.MutableOutputDefs();
+
+  // only pool tensors that are already blocked; a pool on its own doesn't pay for the reorders
+  if (!IsBlocked(input_defs[0])) {
+    return;
+  }
+
+  // the Indices output of MaxPool has no blocked equivalent
+  if (output_defs.size() > 1 && output_defs[1]->Exists()) {
+    return;
+  }
+
+  const auto& attributes = node.GetAttributes();
+  auto storage_order_attr = attributes.find("storage_order");
+  if (storage_order_attr != attributes.end() && storage_order_attr->second.i() != 0) {
+    return;
+  }
+  auto kernel_shape_attr = attributes.find("kernel_shape");
+  if (kernel_shape_attr == attributes.end() || kernel_shape_attr->second.ints_size() != 2) {
+    return;
+  }
+
+  std::vector<NodeArg*> inputs{BlockedInput(input_defs[0])};
+  std::vector<NodeArg*> outputs{BlockedOutput(output_defs[0])};
+
+  AddNchwcNode(node, op_type, inputs, outputs,
+               {"auto_pad", "kernel_shape", "strides", "pads", "count_include_pad"});
+}
+
+void NchwcTransformerImpl::TransformElementwise(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+
+  // the operator doesn't know about the layout, so every input must be blocked and no input may be broadcast
+  const TensorShapeProto* shape = nullptr;
+  for (const auto* input : input_defs) {
+    if (!IsBlocked(input)) {
+      return;
+    }
+    const auto* input_shape = input->Shape();
+    if (input_defs.size() > 1) {
+      if (input_shape == nullptr) {
+        return;
+      }
+      for (const auto& dim : input_shape->dim()) {
+        if (!dim.has_dim_value()) {
+          return;
+        }
+      }
+      if (shape != nullptr) {
+        if (shape->dim_size() != input_shape->dim_size()) {
+          return;
+        }
+        for (int i = 0; i < shape->dim_size(); ++i) {
+          if (shape->dim(i).dim_value() != input_shape->dim(i).dim_value()) {
+            return;
+          }
+        }
+      }
+      shape = input_shape;
+    }
+  }
+
+  for (auto& input : input_defs) {
+    input = BlockedInput(input);
+  }
+  auto& output_defs = node.MutableOutputDefs();
+  output_defs[0] = BlockedOutput(output_defs[0]);
+}
+
+void NchwcTransformerImpl::Transform(Node& node) {
+  if (!IsCpuNode(node)) {
+    return;
+  }
+
+  if (utils::IsSupportedOptypeVersionAndDomain(node, "Conv", 1)) {
+    TransformConv(node);
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", 1) ||
+             utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", 8)) {
+    TransformPool(node, "NchwcMaxPool");
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", 1) ||
+             utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", 7)) {
+    TransformPool(node, "NchwcAveragePool");
+  } else if (utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6) ||
+             utils::IsSupportedOptypeVersionAndDomain(node, "Add", 7) ||
+             utils::IsSupportedOptypeVersionAndDomain(node, "Sum", 6) ||
+             utils::IsSupportedOptypeVersionAndDomain(node, "Sum", 8)) {
+    TransformElementwise(node);
+  }
+}
+
+Status NchwcTransformerImpl::Finalize(bool& modified) {
+  if (replaced_outputs_.empty()) {
+    return Status::OK();
+  }
+
+  for (auto index : removed_nodes_) {
+    graph_.RemoveNode(index);
+  }
+
+  // reorder the blocked tensors back to NCHW for the remaining consumers of the original outputs
+  std::unordered_set<const NodeArg*> consumed_args(graph_.GetOutputs().begin(), graph_.GetOutputs().end());
+  for (const auto& node : graph_.Nodes()) {
+    consumed_args.insert(node.InputDefs().begin(), node.InputDefs().end());
+    consumed_args.insert(node.ImplicitInputDefs().begin(), node.ImplicitInputDefs().end());
+  }
+
+  for (auto* output : replaced_outputs_) {
+    if (consumed_args.find(output) != consumed_args.end()) {
+      graph_.AddNode(graph_.GenerateNodeName("ReorderOutput"), "ReorderOutput", "reorder " + output->Name() + " from NCHWc",
+                     std::vector<NodeArg*>{blocked_args_[output]}, std::vector<NodeArg*>{output}, nullptr, kMSDomain);
+    }
+  }
+
+  modified = true;
+  return graph_.Resolve();
+}
+
+}  // namespace
+
+Status NchwcTransformer::Apply(Graph& graph, bool& modified) const {
+  NchwcTransformerImpl impl(graph);
+  GraphViewer graph_viewer(graph);
+
+  for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
+    impl.Transform(*graph.GetNode(index));
+  }
+
+  return impl.Finalize(modified);
+}
+
+}  // namespace onnxruntime
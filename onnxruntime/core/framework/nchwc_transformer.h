@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Rewrites chains of Conv, MaxPool and AveragePool nodes to the Nchwc contrib operators, which keep the activations
+// in the blocked channel layout of MLAS. A ReorderInput node is inserted where a chain starts and a ReorderOutput
+// node where a blocked tensor is consumed by any other node or is a graph output. Relu, Add and Sum nodes between
+// the converted nodes stay on the blocked tensors.
+// Only 2D convolutions of group 1 with a constant filter and channel counts that are multiples of the block size
+// are converted.
+class NchwcTransformer : public onnxruntime::GraphTransformer {
+ public:
+  NchwcTransformer() noexcept : onnxruntime::GraphTransformer("NchwcTransformer", "Convert CNN subgraphs to the blocked channel layout") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -55,21 +55,15 @@ Status ParallelExecutor::Execute(const SessionState& session_state,
 
   if (root_frame_->HasPlan()) {
     std::vector<TensorShape> input_shapes;
-    bool all_tensors = true;
-    for (const auto& feed : feeds) {
-      if (!(feed.second.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-      auto& tensor = feed.second.Get<Tensor>();
-      input_shapes.push_back(tensor.Shape());
-    }
+    session_state.GetMemoryPatternInputShapes(feeds, input_shapes);
 
-    if (all_tensors) {
-      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-      ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
-    }
+    auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+    ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
+    ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+  } else if (root_frame_->HasMemoryPatternMismatch()) {
+    std::vector<TensorShape> input_shapes;
+    session_state.GetMemoryPatternInputShapes(feeds, input_shapes);
+    session_state.InvalidateMemoryPatternGroup(input_shapes);
   }
 
   session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp);
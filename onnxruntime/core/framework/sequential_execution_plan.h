@@ -6,6 +6,7 @@
 #include "core/graph/basic_types.h"
 #include "core/framework/alloc_kind.h"
 #include "core/framework/data_types.h"
+#include "core/framework/tensor_shape.h"
 
 namespace onnxruntime {
 // Every ml-value has a unique name and is assigned a unique integral number.
@@ -33,6 +34,18 @@ struct SequentialExecutionPlan {
     // reused_buffer is valid only if alloc_kind == kReuse. It indicates
     // which MLValue's buffer must be reused for this MLValue.
     MLValueIndex reused_buffer{0};
+    // reused_buffer_offset is valid only if alloc_kind == kReuse. It is the byte offset
+    // into reused_buffer at which this MLValue is placed, e.g. for a Concat input that
+    // is written directly into its slice of the Concat output.
+    size_t reused_buffer_offset{0};
+    // static_shape is the statically inferred shape of the MLValue, valid only if
+    // has_static_shape is set. An MLValue placed inside the buffer of an allocate_early
+    // MLValue is only placed there if its runtime shape matches static_shape.
+    bool has_static_shape{false};
+    TensorShape static_shape;
+    // if allocate_early is set, the buffer of this MLValue is shared by MLValues produced
+    // before it, so it is allocated (with static_shape) when the first of them is created.
+    bool allocate_early{false};
     // if the value is used in async kernel, a fence object would be created
     // note the fence object would be shared between MLValues reusing the same buffer
     bool create_fence_if_async{false};
@@ -3,10 +3,13 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/common/logging/logging.h"
+#include "core/framework/arena.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/utils.h"
 
 using namespace ::onnxruntime::common;
 namespace onnxruntime {
@@ -14,6 +17,17 @@ namespace onnxruntime {
 void SessionState::SetGraphViewer(std::unique_ptr<onnxruntime::GraphViewer> graph_viewer) {
   ORT_ENFORCE(nullptr != graph_viewer);
   graph_viewer_ = std::move(graph_viewer);
+
+  input_dim_params_.clear();
+  for (const auto* input : graph_viewer_->GetInputs()) {
+    std::vector<std::string> dim_params;
+    const auto* shape = input->Shape();
+    if (shape != nullptr) {
+      for (const auto& dim : shape->dim())
+        dim_params.push_back(dim.has_dim_param() ? dim.dim_param() : std::string());
+    }
+    input_dim_params_.push_back(std::move(dim_params));
+  }
 }
 
 const onnxruntime::GraphViewer* SessionState::GetGraphViewer() const {
@@ -78,14 +92,127 @@ static int64_t CalculateMemoryPatternsKey(const std::vector<TensorShape>& shapes
   return key;
 }
 
+// the shape a feed is keyed on. inputs that are not fed and non-tensor feeds such as sequences and maps get
+// placeholders that no tensor can have. the size of a tensor derived from a non-tensor feed isn't part of the
+// key, but a pattern that doesn't fit it is detected as a mismatch and invalidated.
+static TensorShape GetMemoryPatternFeedShape(const MLValue* feed) {
+  if (feed == nullptr)
+    return TensorShape(std::vector<int64_t>{-1});
+  if (!feed->IsTensor())
+    return TensorShape(std::vector<int64_t>{-2});
+  return feed->Get<Tensor>().Shape();
+}
+
+void SessionState::GetMemoryPatternInputShapes(const NameMLValMap& feeds,
+                                               std::vector<TensorShape>& input_shapes) const {
+  input_shapes.clear();
+
+  // graph inputs first, in graph order, so the shapes line up with input_dim_params_.
+  std::vector<const std::string*> other_feeds;
+  const auto& graph_inputs = graph_viewer_->GetInputs();
+  for (const auto* input : graph_inputs) {
+    auto feed = feeds.find(input->Name());
+    input_shapes.push_back(GetMemoryPatternFeedShape(feed != feeds.cend() ? &feed->second : nullptr));
+  }
+
+  // then the feeds overriding initializers, ordered by name
+  for (const auto& feed : feeds) {
+    if (std::none_of(graph_inputs.cbegin(), graph_inputs.cend(),
+                     [&feed](const NodeArg* input) { return input->Name() == feed.first; }))
+      other_feeds.push_back(&feed.first);
+  }
+  std::sort(other_feeds.begin(), other_feeds.end(),
+            [](const std::string* lhs, const std::string* rhs) { return *lhs < *rhs; });
+  for (const auto* name : other_feeds)
+    input_shapes.push_back(GetMemoryPatternFeedShape(&feeds.at(*name)));
+}
+
+bool SessionState::GetSymbolicShapeScale(const std::vector<TensorShape>& input_shapes,
+                                         int64_t& family_key, int64_t& scale) const {
+  std::unordered_map<std::string, int64_t> dim_values;
+  uint64_t key = 0;
+  auto combine = [&key](int64_t value) { key = key * 1000003 ^ static_cast<uint64_t>(value); };
+
+  for (size_t i = 0; i < input_shapes.size(); i++) {
+    const auto& dims = input_shapes[i].GetDims();
+    const std::vector<std::string>* dim_params = nullptr;
+    if (i < input_dim_params_.size() && input_dim_params_[i].size() == dims.size())
+      dim_params = &input_dim_params_[i];
+
+    combine(static_cast<int64_t>(dims.size()));
+    for (size_t j = 0; j < dims.size(); j++) {
+      if (dim_params == nullptr || (*dim_params)[j].empty()) {
+        combine(dims[j]);
+        continue;
+      }
+
+      // the same symbol must have the same value everywhere
+      auto entry = dim_values.emplace((*dim_params)[j], dims[j]);
+      if (!entry.second && entry.first->second != dims[j])
+        return false;
+      combine(-1);
+    }
+  }
+
+  if (dim_values.empty())
+    return false;
+
+  scale = 1;
+  for (const auto& dim_value : dim_values)
+    scale *= dim_value.second;
+  family_key = static_cast<int64_t>(key);
+  return true;
+}
+
+void SessionState::ReserveMemoryPatterns(const MemoryPatternGroup& mem_patterns) const {
+  // pre-size the arenas so the pattern buffers of the next runs don't need to grow them
+  for (size_t i = 0; i < mem_patterns.locations.size(); i++) {
+    auto* arena = dynamic_cast<IArenaAllocator*>(utils::GetAllocator(*this, mem_patterns.locations[i]).get());
+    if (arena != nullptr && !arena->ReserveCapacity(mem_patterns.patterns[i].PeakSize())) {
+      LOGS(Logger(), WARNING) << "Could not reserve " << mem_patterns.patterns[i].PeakSize()
+                              << " bytes for memory pattern in " << mem_patterns.locations[i].name;
+    }
+  }
+}
+
 const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const {
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
   int64_t key = CalculateMemoryPatternsKey(input_shapes);
   auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end())
+  if (it != mem_patterns_.end())
+    return it->second.get();
+
+  int64_t family_key = 0;
+  int64_t scale = 0;
+  if (!GetSymbolicShapeScale(input_shapes, family_key, scale))
     return nullptr;
 
-  return it->second.get();
+  auto family = symbolic_mem_patterns_.find(family_key);
+  if (family == symbolic_mem_patterns_.end() || !family->second.symbolic)
+    return nullptr;
+
+  auto mem_patterns = family->second.symbolic->Instantiate(scale);
+  ReserveMemoryPatterns(*mem_patterns);
+  const MemoryPatternGroup* result = mem_patterns.get();
+  mem_patterns_[key] = std::move(mem_patterns);
+  derived_mem_pattern_keys_.insert(key);
+  return result;
+}
+
+void SessionState::InvalidateMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const {
+  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+
+  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+  if (derived_mem_pattern_keys_.erase(key) == 0)
+    return;
+
+  auto it = mem_patterns_.find(key);
+  if (it == mem_patterns_.end() || !it->second)
+    return;
+
+  LOGS(Logger(), INFO) << "Memory pattern derived for input shapes with key " << key
+                       << " does not match the allocations of the run, tracing it again";
+  retired_mem_patterns_.push_back(std::move(it->second));
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<TensorShape>& input_shape,
@@ -94,8 +221,33 @@ Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<TensorShape
 
   std::lock_guard<std::mutex> lock(mem_patterns_lock_);
   auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  if (it == mem_patterns_.end() || !it->second) {
+    for (size_t i = 0; i < mem_patterns->locations.size(); i++) {
+      LOGS(Logger(), VERBOSE) << "Memory pattern for " << mem_patterns->locations[i].name << ": "
+                              << mem_patterns->patterns[i].PeakSize() << " bytes, lower bound "
+                              << mem_patterns->patterns[i].LowerBoundSize() << " bytes";
+    }
+
+    ReserveMemoryPatterns(*mem_patterns);
+    const MemoryPatternGroup* traced = mem_patterns.get();
     mem_patterns_[key] = std::move(mem_patterns);
+
+    // two traces of different sizes of a shape family make its patterns symbolic
+    int64_t family_key = 0;
+    int64_t scale = 0;
+    if (GetSymbolicShapeScale(input_shape, family_key, scale)) {
+      auto& family = symbolic_mem_patterns_[family_key];
+      if (family.traced == nullptr) {
+        family.traced = traced;
+        family.traced_scale = scale;
+      } else if (!family.symbolic) {
+        if (family.traced_scale != scale)
+          family.symbolic = SymbolicMemoryPatternGroup::Create(*family.traced, family.traced_scale, *traced, scale);
+      } else if (!family.symbolic->Refine(*traced, scale)) {
+        // the allocations of the family don't follow the same sequence, stop deriving patterns for it
+        family.symbolic.reset();
+      }
+    }
   }
 
   return Status::OK();
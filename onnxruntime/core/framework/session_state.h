@@ -6,6 +6,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "gsl/gsl_util"
 
@@ -14,10 +15,12 @@
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_providers.h"
+#include "core/framework/framework_common.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/mlvalue_name_idx_map.h"
+#include "core/framework/symbolic_mem_pattern.h"
 #include "core/graph/graph_viewer.h"
 
 namespace onnxruntime {
@@ -93,7 +96,14 @@ class SessionState {
   profiling::Profiler& Profiler() const;
 
   /**
-  Get cached memory pattern based on input shapes
+  Get the input shapes memory patterns are keyed on from the feeds of a run.
+  Inputs that are not fed and feeds that are not tensors get placeholder shapes.
+  */
+  void GetMemoryPatternInputShapes(const NameMLValMap& feeds, std::vector<TensorShape>& input_shapes) const;
+
+  /**
+  Get cached memory pattern based on input shapes.
+  If there is none, a pattern is derived from the symbolic patterns of the input shapes family if available.
   */
   const MemoryPatternGroup* GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const;
 
@@ -104,6 +114,13 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(const std::vector<TensorShape>& input_shape,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  /**
+  Drop the memory pattern derived from the symbolic patterns for the input shapes after it didn't match a run,
+  so the next run with these input shapes traces its allocations again.
+  Patterns traced from a run with the same input shapes are kept.
+  */
+  void InvalidateMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const;
+
   /**
   Set enable memory pattern flag
   */
@@ -151,6 +168,12 @@ class SessionState {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
+  // get the key of the family of input shapes that only differ in their symbolic dimensions,
+  // and the product of the symbolic dimension values. returns false if there are no symbolic dimensions.
+  bool GetSymbolicShapeScale(const std::vector<TensorShape>& input_shapes, int64_t& family_key, int64_t& scale) const;
+
+  void ReserveMemoryPatterns(const MemoryPatternGroup& mem_patterns) const;
+
   // cache of the constructed kernels to avoid spending construction
   // time per executor
   std::unordered_map<onnxruntime::NodeIndex, std::unique_ptr<OpKernel>> session_kernels_;
@@ -164,14 +187,30 @@ class SessionState {
   std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan_ = nullptr;
 
   const logging::Logger* logger_;
-  profiling::Profiler* profiler_;
+  profiling::Profiler* profiler_ = nullptr;
 
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_ = true;
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
+  // a null entry means the pattern was invalidated and the next run is traced.
   mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  // keys of the patterns in mem_patterns_ derived from the symbolic patterns
+  mutable std::unordered_set<int64_t> derived_mem_pattern_keys_;
+  // invalidated patterns, kept alive as the frames of concurrent runs may still use them
+  mutable std::vector<std::unique_ptr<MemoryPatternGroup>> retired_mem_patterns_;
+
+  struct SymbolicMemoryPatternFamily {
+    // first traced pattern of the family, owned by mem_patterns_
+    const MemoryPatternGroup* traced = nullptr;
+    int64_t traced_scale = 0;
+    std::unique_ptr<SymbolicMemoryPatternGroup> symbolic;
+  };
+  // symbolic memory patterns. key is calculated based on the input shapes with the symbolic dimensions masked.
+  mutable std::map<int64_t, SymbolicMemoryPatternFamily> symbolic_mem_patterns_;
+  // symbolic dimension names of the graph inputs, empty for fixed dimensions
+  std::vector<std::vector<std::string>> input_dim_params_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -19,6 +19,7 @@
 #include "core/framework/mlvalue_name_idx_map.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_initialized_tensors.h"
 #include "core/framework/tensorutils.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/transformer_memcpy.h"
@@ -30,7 +31,8 @@ static common::Status TransformGraph(onnxruntime::Graph& graph,
                                      const onnxruntime::GraphTransformerManager& graph_transformer_mgr,
                                      const ExecutionProviders& exec_providers,
                                      KernelRegistryManager& kernel_registry_manager,
-                                     const InsertCastTransformer& insert_cast_transformer);
+                                     const InsertCastTransformer& insert_cast_transformer,
+                                     profiling::Profiler& profiler);
 
 static common::Status SaveMLValueNameIndexMapping(const onnxruntime::Graph& graph,
                                                   MLValueNameIdxMap& mlvalue_name_idx_map,
@@ -44,6 +46,8 @@ static common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                              const ExecutionProviders& exec_providers,
                                              const MLValueNameIdxMap& mlvalue_name_idx_map,
                                              std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                             const SharedInitializedTensors* shared_initializers,
+                                             std::vector<SharedInitializedTensors::Reference>* cached_initializers,
                                              const SaveTensorFunc& save_tensor_func,
                                              const logging::Logger& logger);
 
@@ -72,9 +76,12 @@ common::Status SessionStateInitializer::CreatePlan(const onnxruntime::GraphTrans
                                                    const InsertCastTransformer& insert_cast_transformer,
                                                    const std::vector<NodeArg*>& outer_scope_node_args,
                                                    bool enable_sequential_execution) {
+  auto& profiler = session_state_.Profiler();
   ORT_RETURN_IF_ERROR(TransformGraph(graph_, graph_transformation_manager,
                                      execution_providers_, kernel_registry_manager_,
-                                     insert_cast_transformer));
+                                     insert_cast_transformer, profiler));
+
+  auto tp = profiler.StartTime();
 
   // After transformation/partitioning, the graph now is fixed and graph viewer is created and set for execution.
   session_state_.SetGraphViewer(std::make_unique<onnxruntime::GraphViewer>(graph_));
@@ -113,12 +120,15 @@ common::Status SessionStateInitializer::CreatePlan(const onnxruntime::GraphTrans
 
     session_state_.SetExecutionPlan(std::move(exec_plan));
   }
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "execution_planning", tp);
 
   return Status::OK();
 }
 
 common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pattern,
-                                                          std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers) {
+                                                          std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                                          const SharedInitializedTensors* shared_initializers,
+                                                          std::vector<SharedInitializedTensors::Reference>* cached_initializers) {
   const auto* exec_plan_ptr = session_state_.GetExecutionPlan();
   ORT_ENFORCE(exec_plan_ptr, "Execution plan was not found in SessionState. CreatePlan must be called first.");
 
@@ -130,13 +140,19 @@ common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pat
     session_state_.AddInitializedTensor(idx, value);
   };
 
+  auto& profiler = session_state_.Profiler();
+  auto tp = profiler.StartTime();
   ORT_RETURN_IF_ERROR(SaveInitializedTensors(graph_, enable_memory_pattern, exec_plan,
                                              execution_providers_, mlvalue_name_idx_map, weights_buffers,
-                                             add_initialized_tensor, logger_));
+                                             shared_initializers, cached_initializers, add_initialized_tensor,
+                                             logger_));
 
   graph_.CleanAllInitializedTensors();  // remove weights from the graph now to save memory
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "initializer_loading", tp);
 
+  tp = profiler.StartTime();
   ORT_RETURN_IF_ERROR(SaveKernels(execution_providers_, session_state_, kernel_registry_manager_, logger_));
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "kernel_creation", tp);
   ORT_RETURN_IF_ERROR(SaveInputOutputNamesToNodeMapping(graph_, kernel_registry_manager_, session_state_));
 
   return Status::OK();
@@ -146,7 +162,8 @@ common::Status TransformGraph(onnxruntime::Graph& graph,
                               const onnxruntime::GraphTransformerManager& graph_transformer_mgr,
                               const ExecutionProviders& providers,
                               KernelRegistryManager& kernel_registry_manager,
-                              const InsertCastTransformer& insert_cast_transformer) {
+                              const InsertCastTransformer& insert_cast_transformer,
+                              profiling::Profiler& profiler) {
   // The transformer order:
   // 1. built-in graph rewriter
   // 2. each execution provider's transformer
@@ -155,13 +172,17 @@ common::Status TransformGraph(onnxruntime::Graph& graph,
   // 5. insert cast nodes.
 
   // first apply the default/system/basic graph to graph optimizations.
+  auto tp = profiler.StartTime();
   ORT_RETURN_IF_ERROR(graph_transformer_mgr.ApplyAll(graph));
-
-  auto kernels{kernel_registry_manager.GetAllKernelRegistries()};
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_transformation", tp);
 
   // Do partitioning based on execution providers' capability.
+  tp = profiler.StartTime();
   GraphPartitioner partitioner(kernel_registry_manager, providers);
   ORT_RETURN_IF_ERROR(partitioner.Partition(graph));
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_partitioning", tp);
+
+  tp = profiler.StartTime();
 
   // Insert copy nodes.
   for (auto& provider : providers) {
@@ -178,6 +199,7 @@ common::Status TransformGraph(onnxruntime::Graph& graph,
   ORT_RETURN_IF_ERROR(insert_cast_transformer.Apply(graph, modified));
 
   ORT_RETURN_IF_ERROR(graph.Resolve());
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_resolve", tp);
 
   return common::Status::OK();
 }
@@ -284,6 +306,35 @@ common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_
   return common::Status::OK();
 }
 
+// get the tensor to use for an initializer if it's shared with other sessions, otherwise shared_tensor is set to
+// nullptr. only initializers placed on CPU are shared, and not string ones.
+static common::Status GetSharedTensor(const SharedInitializedTensors* shared_initializers,
+                                      std::vector<SharedInitializedTensors::Reference>* cached_initializers,
+                                      const OrtAllocatorInfo& location,
+                                      const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                      const MLValue*& shared_tensor) {
+  shared_tensor = nullptr;
+  if (strcmp(location.name, CPU) != 0 || location.mem_type != OrtMemTypeDefault) {
+    return Status::OK();
+  }
+
+  if (shared_initializers != nullptr) {
+    shared_tensor = shared_initializers->Find(tensor_proto);
+  }
+
+  if (shared_tensor == nullptr && cached_initializers != nullptr) {
+    // looked up by content, so the initializer is only deserialized if no session holds it yet
+    SharedInitializedTensors::Reference reference;
+    ORT_RETURN_IF_ERROR(SharedInitializedTensors::GetProcessWide()->Acquire(tensor_proto, reference));
+    if (reference != nullptr) {
+      cached_initializers->push_back(std::move(reference));
+      shared_tensor = cached_initializers->back().get();
+    }
+  }
+
+  return Status::OK();
+}
+
 static common::Status PlanTensor(MLValuePatternPlanner& planner, const MLValueNameIdxMap& mlvalue_name_idx_map, const std::string& name, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
   int mlvalue_index;
   ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
@@ -299,6 +350,8 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
                                                     const ExecutionProviders& exec_providers,
                                                     const MLValueNameIdxMap& mlvalue_name_idx_map,
                                                     std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                                    const SharedInitializedTensors* shared_initializers,
+                                                    std::vector<SharedInitializedTensors::Reference>* cached_initializers,
                                                     const SaveTensorFunc& save_tensor_func,
                                                     const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
@@ -309,7 +362,19 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
 
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
+  std::unordered_map<std::string, const MLValue*> shared_tensors;
   for (const auto& entry : initialized_tensor_set) {
+    int mlvalue_index;
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(entry.first, mlvalue_index));
+    const MLValue* shared_tensor;
+    ORT_RETURN_IF_ERROR(GetSharedTensor(shared_initializers, cached_initializers,
+                                        execution_plan.allocation_plan[mlvalue_index].location,
+                                        *entry.second, shared_tensor));
+    if (shared_tensor != nullptr) {
+      shared_tensors[entry.first] = shared_tensor;
+      continue;
+    }
+
     //string/complex64/complex128 tensors will be skipped
     ORT_RETURN_IF_ERROR(PlanTensor(planner, mlvalue_name_idx_map, entry.first, *entry.second));
   }
@@ -338,6 +403,13 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
     ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
     const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
+    auto shared_tensor = shared_tensors.find(name);
+    if (shared_tensor != shared_tensors.end()) {
+      save_tensor_func(mlvalue_index, *shared_tensor->second);
+      VLOGS(logger, 1) << "Added shared weight with name : " << name << " with index: " << mlvalue_index;
+      continue;
+    }
+
     auto& location = execution_plan.allocation_plan[mlvalue_index].location;
     auto it = weights_buffers.find(location);
     if (it == weights_buffers.end())
@@ -381,6 +453,8 @@ common::Status SaveInitializedTensorsWithSeperateBuffer(const onnxruntime::Graph
                                                         const SequentialExecutionPlan& execution_plan,
                                                         const ExecutionProviders& exec_providers,
                                                         const MLValueNameIdxMap& mlvalue_name_idx_map,
+                                                        const SharedInitializedTensors* shared_initializers,
+                                                        std::vector<SharedInitializedTensors::Reference>* cached_initializers,
                                                         const SaveTensorFunc& save_tensor_func,
                                                         const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
@@ -394,6 +468,15 @@ common::Status SaveInitializedTensorsWithSeperateBuffer(const onnxruntime::Graph
     ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
     VLOGS(logger, 1) << "About to add weight with name: " << name << " and index: " << mlvalue_index;
     auto& location = execution_plan.allocation_plan[mlvalue_index].location;
+    const MLValue* shared_tensor;
+    ORT_RETURN_IF_ERROR(GetSharedTensor(shared_initializers, cached_initializers, location, *entry.second,
+                                        shared_tensor));
+    if (shared_tensor != nullptr) {
+      save_tensor_func(mlvalue_index, *shared_tensor);
+      VLOGS(logger, 1) << "Added shared weight with name : " << name << " with index: " << mlvalue_index;
+      continue;
+    }
+
     MLValue mlvalue;
     ORT_RETURN_IF_ERROR(DeserializeTensorProto(*(entry.second), location, exec_providers, mlvalue, nullptr, 0));
     save_tensor_func(mlvalue_index, mlvalue);
@@ -410,17 +493,20 @@ common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                       const ExecutionProviders& exec_providers,
                                       const MLValueNameIdxMap& mlvalue_name_idx_map,
                                       std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                      const SharedInitializedTensors* shared_initializers,
+                                      std::vector<SharedInitializedTensors::Reference>* cached_initializers,
                                       const SaveTensorFunc& save_tensor_func,
                                       const logging::Logger& logger) {
   // if we enable the memory pattern and already have the execution plan
   // go with mem pattern approach, which will allocate a big chunk for all
   // the weights.
   if (enable_memory_pattern) {
-    return SaveInitializedTensorsWithMemPattern(graph, execution_plan, exec_providers,
-                                                mlvalue_name_idx_map, weights_buffers, save_tensor_func, logger);
+    return SaveInitializedTensorsWithMemPattern(graph, execution_plan, exec_providers, mlvalue_name_idx_map,
+                                                weights_buffers, shared_initializers, cached_initializers,
+                                                save_tensor_func, logger);
   }
-  return SaveInitializedTensorsWithSeperateBuffer(graph, execution_plan, exec_providers,
-                                                  mlvalue_name_idx_map, save_tensor_func, logger);
+  return SaveInitializedTensorsWithSeperateBuffer(graph, execution_plan, exec_providers, mlvalue_name_idx_map,
+                                                  shared_initializers, cached_initializers, save_tensor_func, logger);
 }
 
 static common::Status CreateOpKernelInternal(const onnxruntime::Node& node,
@@ -5,6 +5,7 @@
 #include <map>
 
 #include "core/framework/allocator.h"
+#include "core/framework/shared_initialized_tensors.h"
 #include "core/framework/tensor.h"
 
 namespace onnxruntime {
@@ -36,8 +37,13 @@ class SessionStateInitializer {
 
   // initialize tensors, and save. save kernels and input/output node mappings
   // @param enable_memory_pattern
+  // @param shared_initializers if given, CPU initializers found in it are used instead of being deserialized
+  // @param cached_initializers if given, the other CPU initializers are shared through the process wide
+  //        SharedInitializedTensors and the references to them are added to it.
   common::Status InitializeAndSave(bool enable_memory_pattern,
-                                   std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers);
+                                   std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                   const SharedInitializedTensors* shared_initializers = nullptr,
+                                   std::vector<SharedInitializedTensors::Reference>* cached_initializers = nullptr);
 
  private:
   onnxruntime::Graph& graph_;
@@ -0,0 +1,334 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initialized_tensors.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+// size of an element of a shared tensor of the data type, 0 if tensors of it are not shared
+static size_t SharedElementSize(int32_t data_type) {
+  switch (data_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+      return 1;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      return 2;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT32:
+      return 4;
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename TField, typename Func>
+static void VisitFieldElements(const google::protobuf::RepeatedField<TField>& field, size_t element_size,
+                               Func& func) {
+  for (const TField& value : field) {
+    uint64_t element = 0;
+    memcpy(&element, &value, element_size);
+    func(element);
+  }
+}
+
+// call func with each element of the payload of tensor_proto, as the element_size bytes the deserialized tensor
+// holds for it, so a payload in raw_data and the same payload in a typed field are visited the same way.
+// returns false if raw_data doesn't hold whole elements.
+template <typename Func>
+static bool VisitPayload(const ONNX_NAMESPACE::TensorProto& tensor_proto, size_t element_size, Func func) {
+  if (tensor_proto.has_raw_data()) {
+    const auto& raw_data = tensor_proto.raw_data();
+    if (raw_data.size() % element_size != 0) {
+      return false;
+    }
+
+    for (size_t i = 0; i < raw_data.size(); i += element_size) {
+      uint64_t element = 0;
+      memcpy(&element, raw_data.data() + i, element_size);
+      func(element);
+    }
+    return true;
+  }
+
+  switch (tensor_proto.data_type()) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+      VisitFieldElements(tensor_proto.float_data(), element_size, func);
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+      VisitFieldElements(tensor_proto.double_data(), element_size, func);
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+      VisitFieldElements(tensor_proto.int64_data(), element_size, func);
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT32:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+      VisitFieldElements(tensor_proto.uint64_data(), element_size, func);
+      break;
+    default:
+      VisitFieldElements(tensor_proto.int32_data(), element_size, func);
+      break;
+  }
+  return true;
+}
+
+// FNV-1a over the element type, shape and elements of tensor_proto.
+// returns false if tensor_proto can't be shared.
+static bool HashTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_proto, uint64_t& hash) {
+  const size_t element_size = SharedElementSize(tensor_proto.data_type());
+  if (element_size == 0) {
+    return false;
+  }
+
+  const uint64_t prime = 1099511628211ULL;
+  hash = 14695981039346656037ULL;
+  auto mix = [&hash, prime](uint64_t v) { hash = (hash ^ v) * prime; };
+
+  mix(static_cast<uint64_t>(tensor_proto.data_type()));
+  mix(static_cast<uint64_t>(tensor_proto.dims_size()));
+  for (auto dim : tensor_proto.dims()) {
+    mix(static_cast<uint64_t>(dim));
+  }
+
+  return VisitPayload(tensor_proto, element_size, mix);
+}
+
+// whether tensor holds the content of tensor_proto
+static bool HoldsTensor(const ONNX_NAMESPACE::TensorProto& tensor_proto, const Tensor& tensor) {
+  const auto& dims = tensor.Shape().GetDims();
+  if (tensor_proto.data_type() != utils::GetTensorProtoType(tensor) ||
+      !std::equal(tensor_proto.dims().begin(), tensor_proto.dims().end(), dims.begin(), dims.end())) {
+    return false;
+  }
+
+  const auto* data = static_cast<const uint8_t*>(tensor.DataRaw());
+  if (tensor_proto.has_raw_data()) {
+    return tensor_proto.raw_data().size() == tensor.Size() &&
+           memcmp(tensor_proto.raw_data().data(), data, tensor.Size()) == 0;
+  }
+
+  const size_t element_size = tensor.DataType()->Size();
+  size_t offset = 0;
+  bool same = true;
+  VisitPayload(tensor_proto, element_size, [&](uint64_t element) {
+    if (!same || offset + element_size > tensor.Size()) {
+      same = false;
+      return;
+    }
+
+    uint64_t value = 0;
+    memcpy(&value, data + offset, element_size);
+    same = value == element;
+    offset += element_size;
+  });
+
+  return same && offset == tensor.Size();
+}
+
+// call func with the initializers of graph_proto and of its subgraphs, always in the same order
+template <typename Func>
+static void ForEachInitializer(ONNX_NAMESPACE::GraphProto& graph_proto, Func& func) {
+  for (auto& tensor_proto : *graph_proto.mutable_initializer()) {
+    func(tensor_proto);
+  }
+
+  for (auto& node : *graph_proto.mutable_node()) {
+    for (auto& attribute : *node.mutable_attribute()) {
+      if (attribute.has_g()) {
+        ForEachInitializer(*attribute.mutable_g(), func);
+      }
+
+      for (auto& subgraph : *attribute.mutable_graphs()) {
+        ForEachInitializer(subgraph, func);
+      }
+    }
+  }
+}
+
+// the process wide instance. it's only held by the references to its tensors, so it goes away with the
+// last session that uses it rather than with the static objects of the process.
+static std::mutex process_wide_mutex;
+static std::weak_ptr<SharedInitializedTensors> process_wide_instance;
+
+SharedInitializedTensors::SharedInitializedTensors() : allocator_(std::make_shared<CPUAllocator>()) {
+}
+
+common::Status SharedInitializedTensors::Create(ONNX_NAMESPACE::GraphProto& graph_proto,
+                                                std::shared_ptr<SharedInitializedTensors>& shared_tensors) {
+  std::shared_ptr<SharedInitializedTensors> result(new SharedInitializedTensors());
+
+  size_t index = 0;
+  auto share = [&result, &index](ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    const size_t current = index++;
+
+    // tensors that can't be shared or deserialized are left to the sessions
+    uint64_t hash;
+    MLValue value;
+    if (!HashTensorProto(tensor_proto, hash) ||
+        !utils::TensorProtoToMLValue(tensor_proto, result->allocator_, nullptr, 0, value).IsOK()) {
+      return;
+    }
+
+    // not shared with other threads yet, but AddReferenceLocked expects the lock
+    std::lock_guard<std::mutex> lock(result->mutex_);
+    Entry& entry = result->AddReferenceLocked(hash, result->FindLocked(hash, tensor_proto), &value);
+    result->cleared_initializers_.emplace_back(current, &entry.value);
+
+    // the tensor holds the weights from now on
+    tensor_proto.clear_raw_data();
+    tensor_proto.clear_float_data();
+    tensor_proto.clear_int32_data();
+    tensor_proto.clear_int64_data();
+    tensor_proto.clear_double_data();
+    tensor_proto.clear_uint64_data();
+  };
+  ForEachInitializer(graph_proto, share);
+
+  shared_tensors = std::move(result);
+  return Status::OK();
+}
+
+std::shared_ptr<SharedInitializedTensors> SharedInitializedTensors::GetProcessWide() {
+  std::lock_guard<std::mutex> lock(process_wide_mutex);
+  auto instance = process_wide_instance.lock();
+  if (!instance) {
+    instance.reset(new SharedInitializedTensors());
+    process_wide_instance = instance;
+  }
+
+  return instance;
+}
+
+SharedInitializedTensors::Stats SharedInitializedTensors::GetProcessWideStats() {
+  std::lock_guard<std::mutex> lock(process_wide_mutex);
+  auto instance = process_wide_instance.lock();
+  return instance ? instance->GetStats() : Stats();
+}
+
+void SharedInitializedTensors::RestorePayloads(ONNX_NAMESPACE::GraphProto& graph_proto) const {
+  size_t index = 0;
+  auto next = cleared_initializers_.cbegin();
+  auto restore = [this, &index, &next](ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    if (next == cleared_initializers_.cend() || next->first != index++) {
+      return;
+    }
+
+    const auto& tensor = next->second->Get<Tensor>();
+    tensor_proto.set_raw_data(tensor.DataRaw(), tensor.Size());
+    ++next;
+  };
+  ForEachInitializer(graph_proto, restore);
+}
+
+const MLValue* SharedInitializedTensors::Find(const ONNX_NAMESPACE::TensorProto& tensor_proto) const {
+  uint64_t hash;
+  if (!HashTensorProto(tensor_proto, hash)) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Entry* entry = FindLocked(hash, tensor_proto);
+  return entry != nullptr ? &entry->value : nullptr;
+}
+
+common::Status SharedInitializedTensors::Acquire(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                 Reference& reference) {
+  reference = nullptr;
+
+  uint64_t hash;
+  if (!HashTensorProto(tensor_proto, hash)) {
+    return Status::OK();
+  }
+
+  // the entry isn't erased before its last reference is released, so it's safe to point to it
+  auto make_reference = [this, hash](Entry& entry) {
+    auto self = shared_from_this();
+    return Reference(&entry.value, [self, hash](const MLValue* p) { self->Release(hash, p); });
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* entry = FindLocked(hash, tensor_proto);
+    if (entry != nullptr) {
+      reference = make_reference(AddReferenceLocked(hash, entry, nullptr));
+      return Status::OK();
+    }
+  }
+
+  // deserialize without holding the lock. if another session added the tensor meanwhile, this copy is dropped.
+  MLValue value;
+  ORT_RETURN_IF_ERROR(utils::TensorProtoToMLValue(tensor_proto, allocator_, nullptr, 0, value));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  reference = make_reference(AddReferenceLocked(hash, FindLocked(hash, tensor_proto), &value));
+  return Status::OK();
+}
+
+SharedInitializedTensors::Entry* SharedInitializedTensors::FindLocked(
+    uint64_t hash, const ONNX_NAMESPACE::TensorProto& tensor_proto) const {
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (HoldsTensor(tensor_proto, it->second.value.Get<Tensor>())) {
+      return &it->second;
+    }
+  }
+
+  return nullptr;
+}
+
+SharedInitializedTensors::Entry& SharedInitializedTensors::AddReferenceLocked(uint64_t hash, Entry* entry,
+                                                                              const MLValue* value) {
+  if (entry == nullptr) {
+    entry = &entries_.emplace(hash, Entry{*value, 0})->second;
+    ++stats_.num_tensors;
+    stats_.bytes_in_use += entry->value.Get<Tensor>().Size();
+  } else {
+    stats_.bytes_saved += entry->value.Get<Tensor>().Size();
+  }
+
+  ++entry->num_references;
+  ++stats_.num_references;
+  return *entry;
+}
+
+void SharedInitializedTensors::Release(uint64_t hash, const MLValue* value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    Entry& entry = it->second;
+    if (&entry.value != value) {
+      continue;
+    }
+
+    const size_t size = entry.value.Get<Tensor>().Size();
+    --stats_.num_references;
+    if (--entry.num_references == 0) {
+      --stats_.num_tensors;
+      stats_.bytes_in_use -= size;
+      entries_.erase(it);
+    } else {
+      stats_.bytes_saved -= size;
+    }
+    return;
+  }
+}
+
+SharedInitializedTensors::Stats SharedInitializedTensors::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+}  // namespace onnxruntime
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ml_value.h"
+
+namespace ONNX_NAMESPACE {
+class GraphProto;
+class TensorProto;
+}  // namespace ONNX_NAMESPACE
+
+namespace onnxruntime {
+/**
+Initialized tensors deserialized once on CPU and shared by many sessions, addressed by their content.
+The key of a tensor is a hash of the element type, shape and elements of its TensorProto, so an initializer
+is looked up before it's deserialized, whatever its name or the graph or subgraph it's in. Initializers changed
+by the graph transformers of a session don't match and are not shared.
+
+There are two kinds of instances:
+- the one of a PreparedModel (see Create), holding the initializers of the model for the sessions loaded from it.
+  The tensors hold the only copy of the weights: Create clears the payloads of the initializers it deserialized
+  from the graph proto, and RestorePayloads puts them back into the copy of the graph proto a session loads.
+- the process wide one (see GetProcessWide) of the sessions that enable SessionOptions::enable_shared_initializer_cache,
+  so sessions of models that have weights in common hold one copy of them. A tensor is held as long as a session
+  references it, and the instance as long as one of its tensors is referenced.
+String tensors are not shared.
+*/
+class SharedInitializedTensors : public std::enable_shared_from_this<SharedInitializedTensors> {
+ public:
+  struct Stats {
+    size_t num_tensors = 0;     // distinct tensors held
+    size_t num_references = 0;  // references to them
+    size_t bytes_in_use = 0;    // bytes held by the distinct tensors
+    size_t bytes_saved = 0;     // bytes the references would take on top of bytes_in_use without sharing
+  };
+
+  // a reference to a tensor of the process wide instance, released when the last copy is destroyed.
+  using Reference = std::shared_ptr<const MLValue>;
+
+  // deserialize the initializers of graph_proto and its subgraphs, and clear the payloads of the ones that were
+  // deserialized.
+  static common::Status Create(ONNX_NAMESPACE::GraphProto& graph_proto,
+                               std::shared_ptr<SharedInitializedTensors>& shared_tensors);
+
+  // the instance shared by the sessions of the process, created if there is none.
+  static std::shared_ptr<SharedInitializedTensors> GetProcessWide();
+
+  // stats of the process wide instance, all zero if there is none.
+  static Stats GetProcessWideStats();
+
+  // put the payloads Create cleared back into a copy of its graph proto.
+  void RestorePayloads(ONNX_NAMESPACE::GraphProto& graph_proto) const;
+
+  // the tensor with the content of tensor_proto, or nullptr if there is none.
+  const MLValue* Find(const ONNX_NAMESPACE::TensorProto& tensor_proto) const;
+
+  // get a reference to the tensor with the content of tensor_proto, deserializing it if there is none.
+  // reference is set to nullptr if tensor_proto can't be shared.
+  common::Status Acquire(const ONNX_NAMESPACE::TensorProto& tensor_proto, Reference& reference);
+
+  Stats GetStats() const;
+
+ private:
+  SharedInitializedTensors();
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializedTensors);
+
+  struct Entry {
+    MLValue value;
+    size_t num_references;
+  };
+
+  Entry* FindLocked(uint64_t hash, const ONNX_NAMESPACE::TensorProto& tensor_proto) const;
+  // add a reference to entry, or to a new entry holding value if entry is nullptr
+  Entry& AddReferenceLocked(uint64_t hash, Entry* entry, const MLValue* value);
+  void Release(uint64_t hash, const MLValue* value);
+
+  const AllocatorPtr allocator_;
+
+  mutable std::mutex mutex_;
+  mutable std::unordered_multimap<uint64_t, Entry> entries_;  // GUARDED_BY(mutex_)
+  Stats stats_;                                               // GUARDED_BY(mutex_)
+
+  // the initializers Create cleared: their index in the order ForEachInitializer visits them, and their tensor.
+  std::vector<std::pair<size_t, const MLValue*>> cleared_initializers_;
+};
+}  // namespace onnxruntime
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/symbolic_mem_pattern.h"
+
+#include <unordered_set>
+
+#include "core/framework/mem_pattern_planner.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<SymbolicMemoryPatternGroup> SymbolicMemoryPatternGroup::Create(const MemoryPatternGroup& group1,
+                                                                               int64_t scale1,
+                                                                               const MemoryPatternGroup& group2,
+                                                                               int64_t scale2) {
+  if (scale1 == scale2 || group1.locations.size() != group2.locations.size())
+    return nullptr;
+
+  std::unique_ptr<SymbolicMemoryPatternGroup> symbolic(new SymbolicMemoryPatternGroup());
+  const int64_t scale_delta = scale2 - scale1;
+  for (size_t i = 0; i < group1.locations.size(); i++) {
+    const MemoryPattern* pattern2 = group2.GetPatterns(group1.locations[i]);
+    if (pattern2 == nullptr)
+      return nullptr;
+
+    const auto& trace1 = group1.patterns[i].Trace();
+    const auto& trace2 = pattern2->Trace();
+    if (trace1.size() != trace2.size())
+      return nullptr;
+
+    std::vector<SymbolicTraceEvent> trace;
+    trace.reserve(trace1.size());
+    for (size_t j = 0; j < trace1.size(); j++) {
+      const auto& event1 = trace1[j];
+      const auto& event2 = trace2[j];
+      if (event1.ml_value_idx_ != event2.ml_value_idx_ || event1.is_free_ != event2.is_free_)
+        return nullptr;
+
+      SymbolicTraceEvent event{event1.ml_value_idx_, event1.is_free_, true, 0, 0};
+      if (!event1.is_free_) {
+        const int64_t size1 = static_cast<int64_t>(event1.size_);
+        const int64_t size_delta = static_cast<int64_t>(event2.size_) - size1;
+        event.is_affine = size_delta % scale_delta == 0;
+        if (event.is_affine) {
+          event.slope = size_delta / scale_delta;
+          event.base = size1 - event.slope * scale1;
+        }
+      }
+      trace.push_back(event);
+    }
+
+    symbolic->locations_.push_back(group1.locations[i]);
+    symbolic->traces_.push_back(std::move(trace));
+  }
+
+  return symbolic;
+}
+
+bool SymbolicMemoryPatternGroup::Refine(const MemoryPatternGroup& group, int64_t scale) {
+  if (group.locations.size() != locations_.size())
+    return false;
+
+  for (size_t i = 0; i < locations_.size(); i++) {
+    const MemoryPattern* pattern = group.GetPatterns(locations_[i]);
+    if (pattern == nullptr)
+      return false;
+
+    const auto& trace = pattern->Trace();
+    auto& symbolic_trace = traces_[i];
+    if (trace.size() != symbolic_trace.size())
+      return false;
+
+    for (size_t j = 0; j < trace.size(); j++) {
+      auto& event = symbolic_trace[j];
+      if (trace[j].ml_value_idx_ != event.ml_value_idx || trace[j].is_free_ != event.is_free)
+        return false;
+
+      if (!event.is_free && event.is_affine &&
+          event.base + event.slope * scale != static_cast<int64_t>(trace[j].size_))
+        event.is_affine = false;
+    }
+  }
+
+  return true;
+}
+
+std::unique_ptr<MemoryPatternGroup> SymbolicMemoryPatternGroup::Instantiate(int64_t scale) const {
+  auto group = std::make_unique<MemoryPatternGroup>();
+  for (size_t i = 0; i < locations_.size(); i++) {
+    MemPatternPlanner planner;
+    std::unordered_set<int> planned;
+    for (const auto& event : traces_[i]) {
+      if (event.is_free) {
+        if (planned.count(event.ml_value_idx) > 0)
+          planner.TraceFree(event.ml_value_idx);
+        continue;
+      }
+
+      const int64_t size = event.base + event.slope * scale;
+      if (!event.is_affine || size < 0)
+        continue;
+
+      planner.TraceAllocation(event.ml_value_idx, static_cast<size_t>(size));
+      planned.insert(event.ml_value_idx);
+    }
+
+    group->locations.push_back(locations_[i]);
+    group->patterns.push_back(planner.GenerateMemPattern());
+  }
+
+  return group;
+}
+
+}  // namespace onnxruntime
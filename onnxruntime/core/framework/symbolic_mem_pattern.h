@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/framework/mem_pattern.h"
+
+namespace onnxruntime {
+// SymbolicMemoryPatternGroup derives memory patterns for input shapes that were never traced.
+// It covers a family of input shapes that only differ in their symbolic dimensions (e.g. batch size
+// or sequence length). The size of each traced allocation is modelled as an affine function
+// size = base + slope * scale, where scale is the product of the symbolic dimension values, and is
+// fitted from the traces of two runs of the family. A pattern for another scale is generated by
+// replaying the trace with the predicted sizes, so the offsets follow the symbolic dimensions too.
+// Two traces can't tell a non-linear size apart from an affine one, so the fit is checked against
+// the traces of later runs of the family (see Refine). Allocations that don't fit the model are left
+// out of the generated patterns and are served by the allocator at run time.
+class SymbolicMemoryPatternGroup {
+ public:
+  // returns nullptr if the two groups were not traced from the same sequence of allocations.
+  static std::unique_ptr<SymbolicMemoryPatternGroup> Create(const MemoryPatternGroup& group1, int64_t scale1,
+                                                            const MemoryPatternGroup& group2, int64_t scale2);
+
+  // checks the predicted sizes against the trace of another run of the family. allocations whose size
+  // was mispredicted are left out of the patterns instantiated from now on.
+  // returns false if the group was not traced from the same sequence of allocations.
+  bool Refine(const MemoryPatternGroup& group, int64_t scale);
+
+  std::unique_ptr<MemoryPatternGroup> Instantiate(int64_t scale) const;
+
+ private:
+  struct SymbolicTraceEvent {
+    int ml_value_idx;
+    bool is_free;
+    bool is_affine;
+    int64_t base;
+    int64_t slope;
+  };
+
+  SymbolicMemoryPatternGroup() = default;
+
+  std::vector<OrtAllocatorInfo> locations_;
+  std::vector<std::vector<SymbolicTraceEvent>> traces_;
+};
+}  // namespace onnxruntime
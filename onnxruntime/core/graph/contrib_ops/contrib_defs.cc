@@ -74,6 +74,11 @@ activation.)DOC")
           "",
           AttributeProto::FLOAT,
           OPTIONAL)
+      .Attr(
+          "activation_params",
+          "Parameters of the activation: [alpha] for LeakyRelu, [min, max] for Clip.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
       .Input(
           0,
           "X",
@@ -95,6 +100,50 @@ activation.)DOC")
         ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, false, true);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedGemm)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+The fused Gemm operator schema is the same as Gemm besides it includes the attributes activation and
+activation_params. The activation is applied to Y = alpha * A' * B' + beta * C.
+B may be stored in float16, in which case it is converted to float as it is packed for the multiply, and C
+may be omitted.)DOC")
+      .Attr("transA", "Whether A should be transposed", AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("transB", "Whether B should be transposed", AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("alpha", "Scalar multiplier for the product of input tensors A * B.", AttributeProto::FLOAT, 1.0f)
+      .Attr("beta", "Scalar multiplier for input tensor C.", AttributeProto::FLOAT, 1.0f)
+      .Attr("activation", "The op type of the activation: Relu, LeakyRelu, Sigmoid, Tanh or Clip.", AttributeProto::STRING, OPTIONAL)
+      .Attr(
+          "activation_params",
+          "Parameters of the activation: [alpha] for LeakyRelu, [min, max] for Clip.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Input(0, "A", "Input tensor A of shape (M, K), or (K, M) if transA is non-zero.", "T")
+      .Input(1, "B", "Input tensor B of shape (K, N), or (N, K) if transB is non-zero.", "TB")
+      .Input(2, "C", "Input tensor C, unidirectionally broadcastable to (M, N).", "T", OpSchema::Optional)
+      .Output(0, "Y", "Output tensor of shape (M, N).", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("TB", {"tensor(float)", "tensor(float16)"}, "Constrain B to float or float16 tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+          return;
+        }
+        auto& a_shape = getInputShape(ctx, 0);
+        auto& b_shape = getInputShape(ctx, 1);
+        if (a_shape.dim_size() != 2 || b_shape.dim_size() != 2) {
+          fail_shape_inference("First and second inputs must be 2D tensors");
+        }
+        auto* trans_a = ctx.getAttribute("transA");
+        auto* trans_b = ctx.getAttribute("transB");
+        bool trans_a_set = trans_a != nullptr && trans_a->i() != 0;
+        bool trans_b_set = trans_b != nullptr && trans_b->i() != 0;
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        *output_shape.add_dim() = a_shape.dim(trans_a_set ? 1 : 0);
+        *output_shape.add_dim() = b_shape.dim(trans_b_set ? 0 : 1);
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ExpandDims)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -588,6 +637,81 @@ The bounding box coordinates corresponding to the selected indices can then be o
         output_elem_type->set_elem_type(ONNX_NAMESPACE::TensorProto::STRING);
       })
       .SetDoc(R"DOC([optional] Step1: Remove elements in X if they match any of the stop words so that the output tensor will not contain any stop words. This operator only accepts [C]- and [1, C]-tensors. If all elements in X are dropped, the output will be the default value of string tensor with shape [1] if input shape is [C] and shape [1, 1] if input shape is [1, C].)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ReorderInput)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Reorders a 4D NCHW tensor to the blocked channel layout used by the Nchwc operators. The output keeps the shape of the
+input. The channel count must be a multiple of the block size.)DOC")
+      .Input(0, "X", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ReorderOutput)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Reorders a 4D tensor in the blocked channel layout back to NCHW.)DOC")
+      .Input(0, "X", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(NchwcConv)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+For internal use. Conv of tensors in the blocked channel layout. The attributes are the same as Conv; only group 1 is
+supported and the filter must be a constant initializer in OIHW layout.)DOC")
+      .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+      .Attr("kernel_shape", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("dilations", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("strides", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("pads", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("group", "", AttributeProto::INT, static_cast<int64_t>(1))
+      .Input(0, "X", "", "T")
+      .Input(1, "W", "", "T")
+      .Input(2, "B", "", "T", OpSchema::Optional)
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, true, false);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(NchwcMaxPool)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+For internal use. MaxPool of tensors in the blocked channel layout.)DOC")
+      .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+      .Attr("kernel_shape", "", AttributeProto::INTS)
+      .Attr("strides", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("pads", "", AttributeProto::INTS, OPTIONAL)
+      .Input(0, "X", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, false, true);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(NchwcAveragePool)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+For internal use. AveragePool of tensors in the blocked channel layout.)DOC")
+      .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+      .Attr("kernel_shape", "", AttributeProto::INTS)
+      .Attr("strides", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("pads", "", AttributeProto::INTS, OPTIONAL)
+      .Attr("count_include_pad", "", AttributeProto::INT, static_cast<int64_t>(0))
+      .Input(0, "X", "", "T")
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, false, true);
+      });
 }
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -9,12 +9,6 @@ using namespace onnx;
 using namespace ::onnxruntime::common;
 namespace onnxruntime {
 
-namespace {
-bool IsFusableActivation(const Node& node) {
-  return utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", 6);
-}
-}  // namespace
-
 Status ConvActivationFusion::Apply(Graph& graph, bool& modified) const {
   GraphViewer graph_viewer(graph);
   const auto& order = graph_viewer.GetNodesInTopologicalOrder();
@@ -26,7 +20,7 @@ Status ConvActivationFusion::Apply(Graph& graph, bool& modified) const {
       continue;
     }
     const Node& next_node = *(node->OutputNodesBegin());
-    if (!IsFusableActivation(next_node) || graph.IsNodeOutputsInGraphOutputs(next_node)) {
+    if (!utils::IsFusableActivation(next_node) || graph.IsNodeOutputsInGraphOutputs(next_node)) {
       continue;
     }
 
@@ -41,15 +35,11 @@ Status ConvActivationFusion::Apply(Graph& graph, bool& modified) const {
                                      &conv_node->GetAttributes(),
                                      "com.microsoft");
 
-    //Add a new attribute to specify the activation type
-    fused_conv.AddAttribute("activation", "string");
-
-    //Add optional attributes for activations
-    if (act_node.OpType() == "LeakyRelu") {
-      const NodeAttributes attrs = act_node.GetAttributes();
-      for (auto it = attrs.begin(); it != attrs.end(); ++it) {
-        fused_conv.AddAttribute(it->first, it->second);
-      }
+    // the activation is identified by its op type, with its attributes folded into activation_params
+    fused_conv.AddAttribute("activation", act_node.OpType());
+    auto activation_params = utils::GetActivationParams(act_node);
+    if (!activation_params.empty()) {
+      fused_conv.AddAttribute("activation_params", activation_params);
     }
 
     // Replace the input of the node following activation node
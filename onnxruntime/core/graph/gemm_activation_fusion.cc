@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/gemm_activation_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+Status GemmActivationFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if (!utils::IsSupportedOptypeVersionAndDomain(*node, "Gemm", 7) &&
+        !utils::IsSupportedOptypeVersionAndDomain(*node, "Gemm", 9)) {
+      continue;
+    }
+    // FusedGemm is only implemented by the CPU provider
+    if (!node->GetExecutionProviderType().empty() && node->GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+    if (node->GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+    const Node& act_node = *(node->OutputNodesBegin());
+    if (!utils::IsFusableActivation(act_node)) {
+      continue;
+    }
+
+    Node* gemm_node = node;
+
+    // the fused node takes over the output of the activation, so the consumers need no rewiring
+    Node& fused_gemm = graph.AddNode(graph.GenerateNodeName("fused " + gemm_node->Name()), "FusedGemm",
+                                     "fused Gemm " + gemm_node->Name() + " with activation " + act_node.OpType(),
+                                     gemm_node->MutableInputDefs(),
+                                     graph.GetNode(act_node.Index())->MutableOutputDefs(),
+                                     &gemm_node->GetAttributes(),
+                                     kMSDomain);
+
+    fused_gemm.AddAttribute("activation", act_node.OpType());
+    auto activation_params = utils::GetActivationParams(act_node);
+    if (!activation_params.empty()) {
+      fused_gemm.AddAttribute("activation_params", activation_params);
+    }
+    fused_gemm.SetExecutionProviderType(gemm_node->GetExecutionProviderType());
+
+    removed_nodes.push_back(act_node.Index());
+    removed_nodes.push_back(gemm_node->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,18 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Fuses a Gemm followed by Relu, LeakyRelu, Sigmoid, Tanh or Clip into a FusedGemm, which applies the activation
+// to each block of the output as the GEMM completes it.
+class GemmActivationFusion : public onnxruntime::GraphTransformer {
+ public:
+  GemmActivationFusion() noexcept : onnxruntime::GraphTransformer("GemmActivationFusion", "Fusing Activation into Gemm") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
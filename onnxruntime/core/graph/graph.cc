@@ -2497,16 +2497,25 @@ Node& Graph::FuseSubGraph(std::unique_ptr<::onnxruntime::IndexedSubGraph> sub_gr
 }
 
 Status Graph::InlineFunction(Node& node) {
-  // Remove the function node, add the nodes in function's subgraph into the
-  // main graph.
-  const Graph& subgraph = node.GetFunctionBody()->Body();
-  auto output_edges = node.GetRelationships().output_edges;
-  for (auto output_edge : output_edges) {
-    RemoveEdge(node.Index(), output_edge.GetNode().Index(), output_edge.GetSrcArgIndex(), output_edge.GetDstArgIndex());
-  }
-  RemoveNode(node.Index());
-  for (const auto& subgraph_node : subgraph.Nodes()) {
-    AddNode(subgraph_node);
+  return InlineFunctions({node.Index()});
+}
+
+Status Graph::InlineFunctions(const std::vector<NodeIndex>& node_indexes) {
+  // Remove the function nodes, add the nodes in the functions' subgraphs into the
+  // main graph. The edges of the new nodes are created by the single Resolve at the end.
+  for (auto node_index : node_indexes) {
+    Node* node = GetNode(node_index);
+    ORT_RETURN_IF_NOT(node != nullptr && node->GetFunctionBody() != nullptr,
+                      "Node ", node_index, " is not a function node.");
+    const Graph& subgraph = node->GetFunctionBody()->Body();
+    auto output_edges = node->GetRelationships().output_edges;
+    for (auto output_edge : output_edges) {
+      RemoveEdge(node->Index(), output_edge.GetNode().Index(), output_edge.GetSrcArgIndex(), output_edge.GetDstArgIndex());
+    }
+    RemoveNode(node->Index());
+    for (const auto& subgraph_node : subgraph.Nodes()) {
+      AddNode(subgraph_node);
+    }
   }
   ORT_RETURN_IF_ERROR(this->Resolve());
   return Status::OK();
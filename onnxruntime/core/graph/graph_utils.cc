@@ -1,6 +1,8 @@
 
 #include "core/graph/graph_utils.h"
 
+#include <limits>
+
 namespace onnxruntime {
 
 namespace utils {
@@ -16,6 +18,28 @@ namespace utils {
     }
     return true;
   }
+
+  bool IsFusableActivation(const Node& node) {
+    return IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", 6) || IsSupportedOptypeVersionAndDomain(node, "Relu", 6) ||
+           IsSupportedOptypeVersionAndDomain(node, "Sigmoid", 6) || IsSupportedOptypeVersionAndDomain(node, "Tanh", 6) ||
+           IsSupportedOptypeVersionAndDomain(node, "Clip", 6);
+  }
+
+  std::vector<float> GetActivationParams(const Node& act_node) {
+    const auto& attrs = act_node.GetAttributes();
+    auto get_float = [&attrs](const std::string& name, float default_value) {
+      auto it = attrs.find(name);
+      return it != attrs.end() ? it->second.f() : default_value;
+    };
+
+    if (act_node.OpType() == "LeakyRelu") {
+      return {get_float("alpha", 0.01f)};
+    }
+    if (act_node.OpType() == "Clip") {
+      return {get_float("min", std::numeric_limits<float>::lowest()), get_float("max", std::numeric_limits<float>::max())};
+    }
+    return {};
+  }
 }
 
 }  // namespace onnxruntime
\ No newline at end of file
@@ -13,6 +13,13 @@ namespace utils {
                                          const std::string& op_type,
                                          ONNX_NAMESPACE::OperatorSetVersion version,
                                          const std::string& domain = kOnnxDomainAlias);
+
+  // whether node is an activation the fused Conv and Gemm kernels can apply to their output
+  bool IsFusableActivation(const Node& node);
+
+  // the parameters of the activation act_node, in the order expected by the activation_params attribute of the
+  // fused kernels
+  std::vector<float> GetActivationParams(const Node& act_node);
 }
 
 }
\ No newline at end of file
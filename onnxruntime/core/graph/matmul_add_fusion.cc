@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/graph/matmul_add_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// returns true and the dimensions if the shape is fully known
+bool GetKnownShape(const NodeArg& arg, std::vector<int64_t>& dims) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+  dims.clear();
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value()) {
+      return false;
+    }
+    dims.push_back(dim.dim_value());
+  }
+  return true;
+}
+}  // namespace
+
+Status MatMulAddFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if ((!utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 1) &&
+         !utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 9)) ||
+        node->GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+    const Node& add_node = *(node->OutputNodesBegin());
+    // both inputs of an Add may come from MatMul nodes, but only one of them can be fused
+    if (std::find(removed_nodes.begin(), removed_nodes.end(), add_node.Index()) != removed_nodes.end() ||
+        !utils::IsSupportedOptypeVersionAndDomain(add_node, "Add", 7) ||
+        add_node.GetExecutionProviderType() != node->GetExecutionProviderType()) {
+      continue;
+    }
+
+    // Gemm only handles matrices, so both operands of the MatMul must be 2-D
+    Node* matmul_node = node;
+    auto& matmul_inputs = matmul_node->MutableInputDefs();
+    std::vector<int64_t> a_dims, b_dims;
+    if (!GetKnownShape(*matmul_inputs[0], a_dims) || a_dims.size() != 2 ||
+        !GetKnownShape(*matmul_inputs[1], b_dims) || b_dims.size() != 2) {
+      continue;
+    }
+
+    // the other operand of the Add must broadcast as a row of N elements, which Gemm adds to each row of A*B
+    const NodeArg* matmul_output = matmul_node->OutputDefs()[0];
+    const auto& add_inputs = add_node.InputDefs();
+    NodeArg* bias_arg = const_cast<NodeArg*>(add_inputs[0] == matmul_output ? add_inputs[1] : add_inputs[0]);
+    std::vector<int64_t> bias_dims;
+    if (!GetKnownShape(*bias_arg, bias_dims) ||
+        !((bias_dims.size() == 1 && bias_dims[0] == b_dims[1]) ||
+          (bias_dims.size() == 2 && bias_dims[0] == 1 && bias_dims[1] == b_dims[1]))) {
+      continue;
+    }
+
+    Node& gemm_node = graph.AddNode(graph.GenerateNodeName("gemm " + matmul_node->Name()), "Gemm",
+                                    "fused MatMul " + matmul_node->Name() + " and Add " + add_node.Name(),
+                                    {matmul_inputs[0], matmul_inputs[1], bias_arg},
+                                    graph.GetNode(add_node.Index())->MutableOutputDefs());
+    gemm_node.SetExecutionProviderType(matmul_node->GetExecutionProviderType());
+
+    removed_nodes.push_back(add_node.Index());
+    removed_nodes.push_back(matmul_node->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
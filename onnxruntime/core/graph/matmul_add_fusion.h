@@ -0,0 +1,18 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+// Rewrites a 2-D MatMul followed by the Add of a row vector into a Gemm, so that the bias is added in the
+// epilogue of the matrix multiply instead of in a separate pass over the output.
+class MatMulAddFusion : public onnxruntime::GraphTransformer {
+ public:
+  MatMulAddFusion() noexcept : onnxruntime::GraphTransformer("MatMulAddFusion", "Fusing MatMul and Add into Gemm") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
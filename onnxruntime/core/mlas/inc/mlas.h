@@ -44,7 +44,78 @@ typedef enum { CblasLeft=141, CblasRight=142} CBLAS_SIDE;
 #endif
 
 //
-// Single precision matrix/matrix multiply routine.
+// Half-precision floating-point type, stored as the IEEE binary16 bit pattern.
+//
+
+typedef unsigned short MLAS_FP16;
+
+//
+// Activation routines.
+//
+
+enum MLAS_ACTIVATION_KIND {
+    MlasIdentityActivation,
+    MlasReluActivation,
+    MlasLeakyReluActivation,
+    MlasTanhActivation,
+    MlasLogisticActivation,
+    MlasClipActivation,
+    MlasEluActivation,
+    MlasSeluActivation,
+    MlasHardSigmoidActivation,
+    MlasSoftsignActivation,
+    MlasThresholdedReluActivation,
+};
+
+struct MLAS_ACTIVATION {
+    MLAS_ACTIVATION_KIND ActivationKind;
+    union {
+        struct {
+            float alpha;
+        } LeakyRelu;
+        struct {
+            float minimum;
+            float maximum;
+        } Clip;
+        struct {
+            float alpha;
+        } Elu;
+        struct {
+            float alpha;
+            float gamma;
+        } Selu;
+        struct {
+            float alpha;
+            float beta;
+        } HardSigmoid;
+        struct {
+            float alpha;
+        } ThresholdedRelu;
+    } Parameters;
+};
+
+void
+MLASCALL
+MlasActivation(
+    const MLAS_ACTIVATION* Activation,
+    float* Buffer,
+    const float* Bias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    );
+
+void
+MLASCALL
+MlasComputeActivation(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+//
+// Single precision matrix/matrix multiply routines.
 //
 
 void
@@ -65,6 +136,46 @@ MlasSgemm(
     size_t ldc
     );
 
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    const MLAS_ACTIVATION* Activation
+    );
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    const MLAS_ACTIVATION* Activation
+    );
+
 //
 // Convolution routines.
 //
@@ -73,6 +184,8 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmDepthwise,
+    MlasConvAlgorithmWinograd,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -90,6 +203,7 @@ struct MLAS_CONV_PARAMETERS {
     size_t InputSize;
     size_t OutputSize;
     size_t K;
+    const MLAS_ACTIVATION* Activation;
     MLAS_CONV_ALGORITHM Algorithm;
     union {
         struct {
@@ -99,6 +213,14 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TargetThreadCount;
+        } Depthwise;
+        struct {
+            size_t TileStride;
+            size_t TargetThreadCount;
+            const float* TransformedFilter;
+        } Winograd;
     } u;
 };
 
@@ -117,6 +239,7 @@ MlasConvPrepare(
     const int64_t* StrideShape,
     const int64_t* OutputShape,
     size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize
     );
 
@@ -131,6 +254,88 @@ MlasConv(
     float* Output
     );
 
+size_t
+MLASCALL
+MlasConvGetTransformedFilterSize(
+    const MLAS_CONV_PARAMETERS* Parameters
+    );
+
+void
+MLASCALL
+MlasConvTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    );
+
+void
+MLASCALL
+MlasConvSetTransformedFilter(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedFilter,
+    size_t* WorkingBufferSize
+    );
+
+void
+MLASCALL
+MlasConvSetAutotuning(
+    bool Enabled
+    );
+
+//
+// Transposed convolution routines.
+//
+
+struct MLAS_CONV_TRANSPOSE_PARAMETERS {
+    size_t Dimensions;
+    size_t BatchCount;
+    size_t GroupCount;
+    size_t InputChannels;
+    size_t InputShape[3];
+    size_t KernelShape[3];
+    size_t DilationShape[3];
+    size_t Padding[3];
+    size_t StrideShape[3];
+    size_t FilterCount;
+    size_t OutputShape[3];
+    size_t InputSize;
+    size_t OutputSize;
+    size_t KernelSize;
+    size_t K;
+    const MLAS_ACTIVATION* Activation;
+    size_t TargetThreadCount;
+};
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize
+    );
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    );
+
 //
 // Pooling routines.
 //
@@ -155,6 +360,68 @@ MlasPool(
     float* Output
     );
 
+//
+// Blocked channel (NCHWc) layout routines.
+//
+
+size_t
+MLASCALL
+MlasNchwcGetBlockSize(
+    void
+    );
+
+void
+MLASCALL
+MlasNchwcConv(
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasNchwcPool(
+    MLAS_POOLING_KIND PoolingKind,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasReorderInput(
+    const int64_t* InputShape,
+    const float* S,
+    float* D
+    );
+
+void
+MLASCALL
+MlasReorderOutput(
+    const int64_t* OutputShape,
+    const float* S,
+    float* D
+    );
+
+void
+MLASCALL
+MlasReorderFilterOIHWBiBo(
+    const int64_t* FilterShape,
+    const float* S,
+    float* D
+    );
+
 //
 // Bias addition routine.
 //
@@ -189,6 +456,30 @@ MlasComputeTanh(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeLog(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -0,0 +1,643 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    activate.cpp
+
+Abstract:
+
+    This module implements the fused bias addition and activation routines.
+
+    These routines are applied as an epilogue to a block of an output matrix
+    right after the block has been computed, while the block is still in the
+    cache, instead of as separate passes over the whole output.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the activation functors. Each functor supplies a vector and a
+// scalar form of the activation.
+//
+
+struct MLAS_IDENTITY_FUNCTOR
+{
+    MLAS_IDENTITY_FUNCTOR(const MLAS_ACTIVATION* Activation)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        return Value;
+    }
+
+    float Activate(float Value)
+    {
+        return Value;
+    }
+};
+
+struct MLAS_RELU_FUNCTOR
+{
+    const MLAS_FLOAT32X4 ZeroVector;
+
+    MLAS_RELU_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : ZeroVector(MlasZeroFloat32x4())
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        return MlasMaximumFloat32x4(ZeroVector, Value);
+    }
+
+    float Activate(float Value)
+    {
+        return (std::max)(0.0f, Value);
+    }
+};
+
+struct MLAS_LEAKY_RELU_FUNCTOR
+{
+    const MLAS_FLOAT32X4 ZeroVector;
+    const MLAS_FLOAT32X4 AlphaBroadcast;
+    const float Alpha;
+
+    MLAS_LEAKY_RELU_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : ZeroVector(MlasZeroFloat32x4()),
+          AlphaBroadcast(MlasBroadcastFloat32x4(Activation->Parameters.LeakyRelu.alpha)),
+          Alpha(Activation->Parameters.LeakyRelu.alpha)
+    {
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        //
+        // Compute max(x, 0) + alpha * min(x, 0), which avoids a compare and
+        // blend sequence.
+        //
+
+        MLAS_FLOAT32X4 ValueTimesAlpha = MlasMultiplyFloat32x4(MlasMinimumFloat32x4(ZeroVector, Value), AlphaBroadcast);
+
+        return MlasAddFloat32x4(MlasMaximumFloat32x4(ZeroVector, Value), ValueTimesAlpha);
+    }
+
+    float Activate(float Value)
+    {
+        return (Value >= 0.0f) ? Value : Value * Alpha;
+    }
+};
+
+struct MLAS_CLIP_FUNCTOR
+{
+    const MLAS_FLOAT32X4 MinimumBroadcast;
+    const MLAS_FLOAT32X4 MaximumBroadcast;
+    const float Minimum;
+    const float Maximum;
+
+    MLAS_CLIP_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : MinimumBroadcast(MlasBroadcastFloat32x4(Activation->Parameters.Clip.minimum)),
+          MaximumBroadcast(MlasBroadcastFloat32x4(Activation->Parameters.Clip.maximum)),
+          Minimum(Activation->Parameters.Clip.minimum),
+          Maximum(Activation->Parameters.Clip.maximum)
+    {
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        return MlasMinimumFloat32x4(MlasMaximumFloat32x4(Value, MinimumBroadcast), MaximumBroadcast);
+    }
+
+    float Activate(float Value)
+    {
+        return (std::min)((std::max)(Value, Minimum), Maximum);
+    }
+};
+
+struct MLAS_ELU_FUNCTOR
+{
+    const MLAS_FLOAT32X4 ZeroVector;
+    const MLAS_FLOAT32X4 OneVector;
+    const MLAS_FLOAT32X4 AlphaBroadcast;
+
+    MLAS_ELU_FUNCTOR(float Alpha)
+        : ZeroVector(MlasZeroFloat32x4()),
+          OneVector(MlasBroadcastFloat32x4(1.0f)),
+          AlphaBroadcast(MlasBroadcastFloat32x4(Alpha))
+    {
+    }
+
+    MLAS_ELU_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : MLAS_ELU_FUNCTOR(Activation->Parameters.Elu.alpha)
+    {
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        //
+        // Compute max(x, 0) + alpha * (exp(min(x, 0)) - 1). The exponential
+        // is exactly one for non-negative inputs.
+        //
+
+        MLAS_FLOAT32X4 ExpValue = MlasComputeExpFloat32x4(MlasMinimumFloat32x4(ZeroVector, Value));
+        MLAS_FLOAT32X4 NegativeValue = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(ExpValue, OneVector), AlphaBroadcast);
+
+        return MlasAddFloat32x4(MlasMaximumFloat32x4(ZeroVector, Value), NegativeValue);
+    }
+
+    float Activate(float Value)
+    {
+        return MlasExtractLaneFloat32x4<0>(Activate(MlasBroadcastFloat32x4(Value)));
+    }
+};
+
+struct MLAS_SELU_FUNCTOR
+{
+    MLAS_ELU_FUNCTOR EluFunctor;
+    const MLAS_FLOAT32X4 GammaBroadcast;
+
+    MLAS_SELU_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : EluFunctor(Activation->Parameters.Selu.alpha),
+          GammaBroadcast(MlasBroadcastFloat32x4(Activation->Parameters.Selu.gamma))
+    {
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        return MlasMultiplyFloat32x4(EluFunctor.Activate(Value), GammaBroadcast);
+    }
+
+    float Activate(float Value)
+    {
+        return MlasExtractLaneFloat32x4<0>(Activate(MlasBroadcastFloat32x4(Value)));
+    }
+};
+
+struct MLAS_HARD_SIGMOID_FUNCTOR
+{
+    const MLAS_FLOAT32X4 ZeroVector;
+    const MLAS_FLOAT32X4 OneVector;
+    const MLAS_FLOAT32X4 AlphaBroadcast;
+    const MLAS_FLOAT32X4 BetaBroadcast;
+    const float Alpha;
+    const float Beta;
+
+    MLAS_HARD_SIGMOID_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : ZeroVector(MlasZeroFloat32x4()),
+          OneVector(MlasBroadcastFloat32x4(1.0f)),
+          AlphaBroadcast(MlasBroadcastFloat32x4(Activation->Parameters.HardSigmoid.alpha)),
+          BetaBroadcast(MlasBroadcastFloat32x4(Activation->Parameters.HardSigmoid.beta)),
+          Alpha(Activation->Parameters.HardSigmoid.alpha),
+          Beta(Activation->Parameters.HardSigmoid.beta)
+    {
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        Value = MlasMultiplyAddFloat32x4(Value, AlphaBroadcast, BetaBroadcast);
+
+        return MlasMaximumFloat32x4(MlasMinimumFloat32x4(Value, OneVector), ZeroVector);
+    }
+
+    float Activate(float Value)
+    {
+        return (std::max)((std::min)(Value * Alpha + Beta, 1.0f), 0.0f);
+    }
+};
+
+struct MLAS_SOFTSIGN_FUNCTOR
+{
+    const MLAS_FLOAT32X4 OneVector;
+    const MLAS_INT32X4 AbsoluteMask;
+
+    MLAS_SOFTSIGN_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : OneVector(MlasBroadcastFloat32x4(1.0f)),
+          AbsoluteMask(MlasBroadcastInt32x4(0x7FFFFFFF))
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        MLAS_FLOAT32X4 AbsValue = MlasReinterpretAsFloat32x4(MlasAndInt32x4(MlasReinterpretAsInt32x4(Value), AbsoluteMask));
+
+        return MlasDivideFloat32x4(Value, MlasAddFloat32x4(AbsValue, OneVector));
+    }
+
+    float Activate(float Value)
+    {
+        return Value / (((Value < 0.0f) ? -Value : Value) + 1.0f);
+    }
+};
+
+struct MLAS_THRESHOLDED_RELU_FUNCTOR
+{
+    const MLAS_FLOAT32X4 ZeroVector;
+    const MLAS_FLOAT32X4 AlphaBroadcast;
+    const float Alpha;
+
+    MLAS_THRESHOLDED_RELU_FUNCTOR(const MLAS_ACTIVATION* Activation)
+        : ZeroVector(MlasZeroFloat32x4()),
+          AlphaBroadcast(MlasBroadcastFloat32x4(Activation->Parameters.ThresholdedRelu.alpha)),
+          Alpha(Activation->Parameters.ThresholdedRelu.alpha)
+    {
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        return MlasBlendFloat32x4(ZeroVector, Value, MlasCompareGreaterThanFloat32x4(Value, AlphaBroadcast));
+    }
+
+    float Activate(float Value)
+    {
+        return (Value > Alpha) ? Value : 0.0f;
+    }
+};
+
+template<typename ActivationFunctor>
+void
+MlasActivationKernel(
+    const MLAS_ACTIVATION* Activation,
+    float* Buffer,
+    const float* RowBias,
+    const float* ColumnBias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the optional bias vectors to the output matrix and then
+    applies an elementwise activation.
+
+Arguments:
+
+    Activation - Supplies the parameters for the activation.
+
+    Buffer - Supplies the output matrix.
+
+    RowBias - Optionally supplies the bias vector of M elements, where
+        element m is added to each element of row m.
+
+    ColumnBias - Optionally supplies the bias vector of N elements, which is
+        added to each row.
+
+    M - Supplies the number of rows of the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    ActivationFunctor Functor(Activation);
+
+    while (M-- > 0) {
+
+        float* buffer = Buffer;
+        const float* bias = ColumnBias;
+        size_t n = N;
+
+        float RowBiasValue = (RowBias != nullptr) ? *RowBias++ : 0.0f;
+        MLAS_FLOAT32X4 RowBiasBroadcast = MlasBroadcastFloat32x4(RowBiasValue);
+
+        if (bias != nullptr) {
+
+            while (n >= 4) {
+                MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(buffer), MlasLoadFloat32x4(bias));
+                MlasStoreFloat32x4(buffer, Functor.Activate(MlasAddFloat32x4(Vector, RowBiasBroadcast)));
+                buffer += 4;
+                bias += 4;
+                n -= 4;
+            }
+
+            while (n > 0) {
+                *buffer = Functor.Activate(*buffer + *bias++ + RowBiasValue);
+                buffer += 1;
+                n -= 1;
+            }
+
+        } else {
+
+            while (n >= 4) {
+                MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(buffer), RowBiasBroadcast);
+                MlasStoreFloat32x4(buffer, Functor.Activate(Vector));
+                buffer += 4;
+                n -= 4;
+            }
+
+            while (n > 0) {
+                *buffer = Functor.Activate(*buffer + RowBiasValue);
+                buffer += 1;
+                n -= 1;
+            }
+        }
+
+        Buffer += ldc;
+    }
+}
+
+void
+MlasActivationWithBias(
+    const MLAS_ACTIVATION* Activation,
+    float* Buffer,
+    const float* RowBias,
+    const float* ColumnBias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the optional bias vectors to the output matrix and then
+    applies the activation in a single pass over the matrix.
+
+Arguments:
+
+    Activation - Optionally supplies the parameters for the activation. If
+        nullptr, no activation is applied.
+
+    Buffer - Supplies the output matrix.
+
+    RowBias - Optionally supplies the bias vector of M elements, where
+        element m is added to each element of row m.
+
+    ColumnBias - Optionally supplies the bias vector of N elements, which is
+        added to each row.
+
+    M - Supplies the number of rows of the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_ACTIVATION_KIND ActivationKind =
+        (Activation != nullptr) ? Activation->ActivationKind : MlasIdentityActivation;
+
+    switch (ActivationKind) {
+
+        case MlasIdentityActivation:
+        {
+            if (RowBias != nullptr || ColumnBias != nullptr) {
+                MlasActivationKernel<MLAS_IDENTITY_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            }
+            break;
+        }
+
+        case MlasReluActivation:
+        {
+            MlasActivationKernel<MLAS_RELU_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasLeakyReluActivation:
+        {
+            MlasActivationKernel<MLAS_LEAKY_RELU_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasClipActivation:
+        {
+            MlasActivationKernel<MLAS_CLIP_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasEluActivation:
+        {
+            MlasActivationKernel<MLAS_ELU_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasSeluActivation:
+        {
+            MlasActivationKernel<MLAS_SELU_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasHardSigmoidActivation:
+        {
+            MlasActivationKernel<MLAS_HARD_SIGMOID_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasSoftsignActivation:
+        {
+            MlasActivationKernel<MLAS_SOFTSIGN_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasThresholdedReluActivation:
+        {
+            MlasActivationKernel<MLAS_THRESHOLDED_RELU_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            break;
+        }
+
+        case MlasLogisticActivation:
+        case MlasTanhActivation:
+        {
+            //
+            // Reuse the existing vectorized kernels for the transcendental
+            // activations, one row at a time after the bias is added.
+            //
+
+            if (RowBias != nullptr || ColumnBias != nullptr) {
+                MlasActivationKernel<MLAS_IDENTITY_FUNCTOR>(Activation, Buffer, RowBias, ColumnBias, M, N, ldc);
+            }
+
+            for (size_t m = 0; m < M; m++) {
+
+                float* buffer = Buffer + m * ldc;
+
+                if (ActivationKind == MlasLogisticActivation) {
+                    MlasComputeLogistic(buffer, buffer, N);
+                } else {
+                    MlasComputeTanh(buffer, buffer, N);
+                }
+            }
+
+            break;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasActivation(
+    const MLAS_ACTIVATION* Activation,
+    float* Buffer,
+    const float* Bias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the optional bias vector to the output matrix and then
+    applies the activation in a single pass over the matrix.
+
+Arguments:
+
+    Activation - Optionally supplies the parameters for the activation. If
+        nullptr, no activation is applied.
+
+    Buffer - Supplies the output matrix.
+
+    Bias - Optionally supplies the bias vector of M elements, where element m
+        is added to each element of row m.
+
+    M - Supplies the number of rows of the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasActivationWithBias(Activation, Buffer, Bias, nullptr, M, N, ldc);
+}
+
+void
+MLASCALL
+MlasLogisticElementwiseKernel(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(Activation);
+
+    MlasComputeLogistic(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasTanhElementwiseKernel(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(Activation);
+
+    MlasComputeTanh(Input, Output, N);
+}
+
+void
+MLASCALL
+MlasComputeActivation(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine applies an elementwise activation to a buffer. Large buffers
+    are split into chunks that are computed in parallel.
+
+Arguments:
+
+    Activation - Supplies the parameters for the activation.
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The output buffer may be the same as
+        the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    PMLAS_ELEMENTWISE_KERNEL_ROUTINE KernelRoutine;
+
+    switch (Activation->ActivationKind) {
+
+        case MlasIdentityActivation:
+        {
+            if (Input != Output) {
+                std::copy_n(Input, N, Output);
+            }
+            return;
+        }
+
+        case MlasReluActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_RELU_FUNCTOR>;
+            break;
+
+        case MlasLeakyReluActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_LEAKY_RELU_FUNCTOR>;
+            break;
+
+        case MlasClipActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_CLIP_FUNCTOR>;
+            break;
+
+        case MlasEluActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_ELU_FUNCTOR>;
+            break;
+
+        case MlasSeluActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_SELU_FUNCTOR>;
+            break;
+
+        case MlasHardSigmoidActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_HARD_SIGMOID_FUNCTOR>;
+            break;
+
+        case MlasSoftsignActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_SOFTSIGN_FUNCTOR>;
+            break;
+
+        case MlasThresholdedReluActivation:
+            KernelRoutine = MlasElementwiseKernel<MLAS_THRESHOLDED_RELU_FUNCTOR>;
+            break;
+
+        case MlasLogisticActivation:
+            KernelRoutine = MlasLogisticElementwiseKernel;
+            break;
+
+        case MlasTanhActivation:
+            KernelRoutine = MlasTanhElementwiseKernel;
+            break;
+
+        default:
+            return;
+    }
+
+    MlasExecuteElementwise(KernelRoutine, Activation, Input, Output, N);
+}
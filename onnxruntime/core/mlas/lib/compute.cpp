@@ -0,0 +1,488 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.cpp
+
+Abstract:
+
+    This module implements routines to compute the exponential, natural
+    logarithm and error functions and the support to compute elementwise
+    functions in parallel.
+
+    The exponential and logarithm use the range reduction and polynomial
+    coefficients found in the Cephes library. The error function uses a
+    piecewise polynomial approximation that is accurate to about one ulp.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+extern "C" const MLAS_EXP_CONSTANTS MlasExpConstants = {
+    -103.9720840454f,
+    88.7762626647950f,
+    12582912.0f,
+    1.44269504088896341f,
+    -0.693359375f,
+    2.12194440e-4f,
+    1.9875691500E-4f,
+    1.3981999507E-3f,
+    8.3334519073E-3f,
+    4.1665795894E-2f,
+    1.6666665459E-1f,
+    5.0000001201E-1f,
+    1.0f,
+    127,
+};
+
+extern "C" const struct {
+    float MinimumNormal;
+    float DenormalScale;
+    float DenormalExponent;
+    float SquareRootHalf;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_5;
+    float poly_6;
+    float poly_7;
+    float poly_8;
+    float Log2High;
+    float Log2Low;
+    int32_t MantissaMask;
+    int32_t HalfExponent;
+    int32_t ExponentBias;
+} MlasLogConstants = {
+    1.17549435e-38f,
+    8388608.0f,
+    -23.0f,
+    0.707106781186547524f,
+    7.0376836292E-2f,
+    -1.1514610310E-1f,
+    1.1676998740E-1f,
+    -1.2420140846E-1f,
+    1.4249322787E-1f,
+    -1.6668057665E-1f,
+    2.0000714765E-1f,
+    -2.4999993993E-1f,
+    3.3333331174E-1f,
+    0.693359375f,
+    -2.12194440e-4f,
+    0x007FFFFF,
+    0x3F000000,
+    126,
+};
+
+extern "C" const struct {
+    float SplitPoint;
+    float UpperRange;
+    float small_0;
+    float small_1;
+    float small_2;
+    float small_3;
+    float small_4;
+    float small_5;
+    float large_0;
+    float large_1;
+    float large_2;
+    float large_3;
+    float large_4;
+    float large_5;
+    float large_6;
+    int32_t SignMask;
+} MlasErfConstants = {
+    0.927734375f,
+    4.0f,
+    -5.96761703e-4f,
+    4.99119423e-3f,
+    -2.67681349e-2f,
+    1.12819925e-1f,
+    -3.76125336e-1f,
+    1.28379166e-1f,
+    -1.72853470e-5f,
+    3.83197126e-4f,
+    -3.88396438e-3f,
+    2.42546219e-2f,
+    -1.06777877e-1f,
+    -6.34846687e-1f,
+    -1.28717512e-1f,
+    int32_t(0x80000000),
+};
+
+//
+// Define the elementwise function functors. Each functor supplies a vector
+// form of the function; the constructor signature matches the activation
+// functors so that the same kernel template can be used.
+//
+
+struct MLAS_EXP_FUNCTOR
+{
+    MLAS_EXP_FUNCTOR(const MLAS_ACTIVATION* Activation)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        return MlasComputeExpFloat32x4(Value);
+    }
+};
+
+struct MLAS_LOG_FUNCTOR
+{
+    MLAS_LOG_FUNCTOR(const MLAS_ACTIVATION* Activation)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        const MLAS_FLOAT32X4 ZeroVector = MlasZeroFloat32x4();
+        const MLAS_FLOAT32X4 OneVector = MlasBroadcastFloat32x4(1.0f);
+
+        //
+        // Scale denormal inputs into the normal range and account for the
+        // scale in the exponent.
+        //
+
+        MLAS_INT32X4 DenormalMask = MlasCompareLessThanFloat32x4(Value,
+            MlasBroadcastFloat32x4(MlasLogConstants.MinimumNormal));
+
+        MLAS_FLOAT32X4 x = MlasBlendFloat32x4(Value,
+            MlasMultiplyFloat32x4(Value, MlasBroadcastFloat32x4(MlasLogConstants.DenormalScale)), DenormalMask);
+        MLAS_FLOAT32X4 e = MlasBlendFloat32x4(ZeroVector,
+            MlasBroadcastFloat32x4(MlasLogConstants.DenormalExponent), DenormalMask);
+
+        //
+        // Split the input into an exponent and a mantissa in [0.5, 1).
+        //
+
+        MLAS_INT32X4 Bits = MlasReinterpretAsInt32x4(x);
+
+        e = MlasAddFloat32x4(e, MlasCastToFloat32x4(MlasSubtractInt32x4(MlasShiftRightInt32x4<23>(Bits),
+            MlasBroadcastInt32x4(MlasLogConstants.ExponentBias))));
+
+        x = MlasReinterpretAsFloat32x4(MlasOrInt32x4(MlasAndInt32x4(Bits,
+            MlasBroadcastInt32x4(MlasLogConstants.MantissaMask)), MlasBroadcastInt32x4(MlasLogConstants.HalfExponent)));
+
+        //
+        // Keep the mantissa within [sqrt(0.5), sqrt(2)) so that the
+        // polynomial argument is centered around zero.
+        //
+
+        MLAS_INT32X4 SmallMask = MlasCompareLessThanFloat32x4(x,
+            MlasBroadcastFloat32x4(MlasLogConstants.SquareRootHalf));
+
+        e = MlasSubtractFloat32x4(e, MlasBlendFloat32x4(ZeroVector, OneVector, SmallMask));
+        x = MlasAddFloat32x4(MlasSubtractFloat32x4(x, OneVector), MlasBlendFloat32x4(ZeroVector, x, SmallMask));
+
+        MLAS_FLOAT32X4 z = MlasMultiplyFloat32x4(x, x);
+
+        MLAS_FLOAT32X4 p;
+        p = MlasMultiplyAddFloat32x4(x, MlasBroadcastFloat32x4(MlasLogConstants.poly_0),
+            MlasBroadcastFloat32x4(MlasLogConstants.poly_1));
+        p = MlasMultiplyAddFloat32x4(p, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_2));
+        p = MlasMultiplyAddFloat32x4(p, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_3));
+        p = MlasMultiplyAddFloat32x4(p, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_4));
+        p = MlasMultiplyAddFloat32x4(p, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_5));
+        p = MlasMultiplyAddFloat32x4(p, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_6));
+        p = MlasMultiplyAddFloat32x4(p, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_7));
+        p = MlasMultiplyAddFloat32x4(p, x, MlasBroadcastFloat32x4(MlasLogConstants.poly_8));
+        p = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(p, x), z);
+
+        p = MlasMultiplyAddFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.Log2Low), p);
+        p = MlasMultiplyAddFloat32x4(z, MlasBroadcastFloat32x4(-0.5f), p);
+        x = MlasAddFloat32x4(x, p);
+        x = MlasMultiplyAddFloat32x4(e, MlasBroadcastFloat32x4(MlasLogConstants.Log2High), x);
+
+        //
+        // Handle the special cases: log(0) is -infinity, log(+infinity) is
+        // +infinity, and negative or NaN inputs produce NaN.
+        //
+
+        const MLAS_FLOAT32X4 InfinityVector = MlasBroadcastFloat32x4(std::numeric_limits<float>::infinity());
+
+        x = MlasBlendFloat32x4(x, MlasSubtractFloat32x4(ZeroVector, InfinityVector),
+            MlasCompareEqualFloat32x4(Value, ZeroVector));
+        x = MlasBlendFloat32x4(x, InfinityVector, MlasCompareEqualFloat32x4(Value, InfinityVector));
+        x = MlasBlendFloat32x4(MlasBroadcastFloat32x4(std::numeric_limits<float>::quiet_NaN()), x,
+            MlasCompareGreaterThanOrEqualFloat32x4(Value, ZeroVector));
+
+        return x;
+    }
+};
+
+struct MLAS_ERF_FUNCTOR
+{
+    MLAS_ERF_FUNCTOR(const MLAS_ACTIVATION* Activation)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 Activate(MLAS_FLOAT32X4 Value)
+    {
+        MLAS_INT32X4 SignMask = MlasBroadcastInt32x4(MlasErfConstants.SignMask);
+        MLAS_INT32X4 SignBits = MlasAndInt32x4(MlasReinterpretAsInt32x4(Value), SignMask);
+
+        MLAS_FLOAT32X4 AbsValue = MlasReinterpretAsFloat32x4(MlasSubtractInt32x4(
+            MlasReinterpretAsInt32x4(Value), SignBits));
+        MLAS_FLOAT32X4 ValueSquared = MlasMultiplyFloat32x4(Value, Value);
+
+        //
+        // Compute the odd polynomial used for small inputs.
+        //
+
+        MLAS_FLOAT32X4 SmallResult;
+        SmallResult = MlasMultiplyAddFloat32x4(ValueSquared, MlasBroadcastFloat32x4(MlasErfConstants.small_0),
+            MlasBroadcastFloat32x4(MlasErfConstants.small_1));
+        SmallResult = MlasMultiplyAddFloat32x4(SmallResult, ValueSquared, MlasBroadcastFloat32x4(MlasErfConstants.small_2));
+        SmallResult = MlasMultiplyAddFloat32x4(SmallResult, ValueSquared, MlasBroadcastFloat32x4(MlasErfConstants.small_3));
+        SmallResult = MlasMultiplyAddFloat32x4(SmallResult, ValueSquared, MlasBroadcastFloat32x4(MlasErfConstants.small_4));
+        SmallResult = MlasMultiplyAddFloat32x4(SmallResult, ValueSquared, MlasBroadcastFloat32x4(MlasErfConstants.small_5));
+        SmallResult = MlasMultiplyAddFloat32x4(SmallResult, Value, Value);
+
+        //
+        // Compute 1 - exp(q(|x|)) for large inputs, where erf(x) approaches one
+        // and the result is saturated beyond the upper range.
+        //
+
+        MLAS_FLOAT32X4 t = MlasMinimumFloat32x4(AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.UpperRange));
+        MLAS_FLOAT32X4 s = MlasMultiplyFloat32x4(t, t);
+
+        MLAS_FLOAT32X4 r;
+        MLAS_FLOAT32X4 u;
+        r = MlasMultiplyAddFloat32x4(t, MlasBroadcastFloat32x4(MlasErfConstants.large_0),
+            MlasBroadcastFloat32x4(MlasErfConstants.large_1));
+        u = MlasMultiplyAddFloat32x4(t, MlasBroadcastFloat32x4(MlasErfConstants.large_2),
+            MlasBroadcastFloat32x4(MlasErfConstants.large_3));
+        r = MlasMultiplyAddFloat32x4(r, s, u);
+        r = MlasMultiplyAddFloat32x4(r, t, MlasBroadcastFloat32x4(MlasErfConstants.large_4));
+        r = MlasMultiplyAddFloat32x4(r, t, MlasBroadcastFloat32x4(MlasErfConstants.large_5));
+        r = MlasMultiplyAddFloat32x4(r, t, MlasBroadcastFloat32x4(MlasErfConstants.large_6));
+        r = MlasSubtractFloat32x4(MlasMultiplyFloat32x4(r, t), t);
+        r = MlasSubtractFloat32x4(MlasBroadcastFloat32x4(1.0f), MlasComputeExpFloat32x4(r));
+
+        MLAS_FLOAT32X4 LargeResult = MlasReinterpretAsFloat32x4(MlasOrInt32x4(MlasReinterpretAsInt32x4(r), SignBits));
+
+        return MlasBlendFloat32x4(SmallResult, LargeResult, MlasCompareGreaterThanFloat32x4(AbsValue,
+            MlasBroadcastFloat32x4(MlasErfConstants.SplitPoint)));
+    }
+};
+
+struct MLAS_ELEMENTWISE_WORK_BLOCK {
+    PMLAS_ELEMENTWISE_KERNEL_ROUTINE KernelRoutine;
+    const MLAS_ACTIVATION* Activation;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t BlockSize;
+};
+
+void
+MlasElementwiseThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    elementwise function.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_ELEMENTWISE_WORK_BLOCK* WorkBlock = (MLAS_ELEMENTWISE_WORK_BLOCK*)Context;
+
+    const size_t Offset = size_t(Index) * WorkBlock->BlockSize;
+    const size_t Count = std::min(WorkBlock->BlockSize, WorkBlock->N - Offset);
+
+    WorkBlock->KernelRoutine(WorkBlock->Activation, WorkBlock->Input + Offset,
+        WorkBlock->Output + Offset, Count);
+}
+
+void
+MlasExecuteElementwise(
+    PMLAS_ELEMENTWISE_KERNEL_ROUTINE KernelRoutine,
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes an elementwise function over a buffer. Large buffers
+    are split into contiguous chunks that are computed in parallel.
+
+Arguments:
+
+    KernelRoutine - Supplies the kernel that computes the function over a
+        range of elements.
+
+    Activation - Optionally supplies the parameters for the function.
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The output buffer may be the same as
+        the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    int32_t TargetThreadCount;
+
+    if (N < size_t(MLAS_ELEMENTWISE_THREAD_ELEMENTS) * MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = int32_t(N / MLAS_ELEMENTWISE_THREAD_ELEMENTS) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount <= 1) {
+        KernelRoutine(Activation, Input, Output, N);
+        return;
+    }
+
+    //
+    // Round the chunk size up to a multiple of the cache line size so that
+    // threads do not share cache lines of the output buffer.
+    //
+
+    const size_t BlockAlignment = 64 / sizeof(float);
+
+    size_t BlockSize = (N + TargetThreadCount - 1) / TargetThreadCount;
+    BlockSize = (BlockSize + BlockAlignment - 1) & ~(BlockAlignment - 1);
+
+    MLAS_ELEMENTWISE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.KernelRoutine = KernelRoutine;
+    WorkBlock.Activation = Activation;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.BlockSize = BlockSize;
+
+    MlasExecuteThreaded(MlasElementwiseThreaded, &WorkBlock, int32_t((N + BlockSize - 1) / BlockSize));
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasExecuteElementwise(MlasElementwiseKernel<MLAS_EXP_FUNCTOR>, nullptr, Input, Output, N);
+}
+
+void
+MLASCALL
+MlasComputeLog(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasExecuteElementwise(MlasElementwiseKernel<MLAS_LOG_FUNCTOR>, nullptr, Input, Output, N);
+}
+
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasExecuteElementwise(MlasElementwiseKernel<MLAS_ERF_FUNCTOR>, nullptr, Input, Output, N);
+}
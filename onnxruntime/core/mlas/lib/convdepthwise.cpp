@@ -0,0 +1,403 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convdepthwise.cpp
+
+Abstract:
+
+    This module implements the depthwise convolution operation.
+
+    A depthwise convolution has a single input channel per group, so each
+    output plane is produced by sliding one small filter over one input plane.
+    Expanding the input and invoking a GEMM with a single row per group wastes
+    most of the work, so the output planes are instead computed directly.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t StrideWidth>
+inline
+MLAS_FLOAT32X4
+MlasConvDepthwiseLoadInput(
+    const float* Input
+    )
+/*++
+
+Routine Description:
+
+    This routine loads the inputs for four adjacent output positions.
+
+Arguments:
+
+    Input - Supplies the input for the first output position.
+
+Return Value:
+
+    Returns the vector of inputs.
+
+--*/
+{
+    static_assert(StrideWidth == 1 || StrideWidth == 2, "unsupported stride");
+
+    if (StrideWidth == 1) {
+        return MlasLoadFloat32x4(Input);
+    } else {
+        return MlasLoadStride2Float32x4(Input);
+    }
+}
+
+inline
+float
+MlasConvDepthwisePoint(
+    const float* Input,
+    const float* Filter,
+    float Bias,
+    size_t InputWidth,
+    size_t KernelWidth,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    ptrdiff_t InputOriginHeight,
+    ptrdiff_t InputOriginWidth,
+    size_t KernelStartHeight,
+    size_t KernelEndHeight
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a single output position, skipping the kernel
+    columns that fall in the padding.
+
+Arguments:
+
+    Input - Supplies the input plane.
+
+    Filter - Supplies the filter for the plane.
+
+    Bias - Supplies the bias for the plane.
+
+    InputWidth - Supplies the width of the input plane.
+
+    KernelWidth - Supplies the width of the filter.
+
+    DilationHeight - Supplies the dilation of the filter rows.
+
+    DilationWidth - Supplies the dilation of the filter columns.
+
+    InputOriginHeight - Supplies the input row of the first filter row, which
+        may be in the padding.
+
+    InputOriginWidth - Supplies the input column of the first filter column,
+        which may be in the padding.
+
+    KernelStartHeight - Supplies the first filter row inside the input.
+
+    KernelEndHeight - Supplies the filter row after the last one inside the
+        input.
+
+Return Value:
+
+    Returns the output value.
+
+--*/
+{
+    float Accumulator = Bias;
+
+    for (size_t kh = KernelStartHeight; kh < KernelEndHeight; kh++) {
+
+        const float* input = Input + (InputOriginHeight + ptrdiff_t(kh * DilationHeight)) * ptrdiff_t(InputWidth);
+        const float* filter = Filter + kh * KernelWidth;
+
+        for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+            ptrdiff_t iw = InputOriginWidth + ptrdiff_t(kw * DilationWidth);
+
+            if (size_t(iw) < InputWidth) {
+                Accumulator += input[iw] * filter[kw];
+            }
+        }
+    }
+
+    return Accumulator;
+}
+
+template<size_t StrideWidth, size_t KernelWidthTemplate>
+void
+MlasConvDepthwisePlane(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float Bias,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one output plane of a depthwise convolution.
+
+    The output columns whose receptive field is entirely inside the input
+    width are computed four or eight at a time. The remaining columns at the
+    edges are computed one at a time.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input plane.
+
+    Filter - Supplies the filter for the plane.
+
+    Bias - Supplies the bias for the plane.
+
+    Output - Supplies the output plane.
+
+Template Arguments:
+
+    StrideWidth - Supplies the stride of the filter columns, or zero if the
+        stride is neither 1 nor 2, in which case all output columns are
+        computed one at a time.
+
+    KernelWidthTemplate - Supplies the width of the filter, or zero if the
+        width is only known at runtime.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = (KernelWidthTemplate != 0) ? KernelWidthTemplate : Parameters->KernelShape[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideShapeWidth = (StrideWidth != 0) ? StrideWidth : Parameters->StrideShape[1];
+
+    //
+    // Compute the range of output columns where every filter column is inside
+    // the input width.
+    //
+
+    const size_t SpanWidth = (KernelWidth - 1) * DilationWidth + 1;
+
+    size_t OutputWidthStart = (PaddingLeft + StrideShapeWidth - 1) / StrideShapeWidth;
+    size_t OutputWidthEnd = 0;
+
+    if (InputWidth + PaddingLeft >= SpanWidth) {
+        OutputWidthEnd = (InputWidth + PaddingLeft - SpanWidth) / StrideShapeWidth + 1;
+    }
+
+    OutputWidthStart = std::min(OutputWidthStart, OutputWidth);
+    OutputWidthEnd = std::max(std::min(OutputWidthEnd, OutputWidth), OutputWidthStart);
+
+    if (StrideWidth == 0) {
+        OutputWidthEnd = OutputWidthStart;
+    }
+
+    const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias);
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+
+        //
+        // Compute the range of filter rows that are inside the input height.
+        //
+
+        const ptrdiff_t InputOriginHeight = ptrdiff_t(oh * StrideHeight) - ptrdiff_t(PaddingTop);
+
+        size_t KernelStartHeight = 0;
+        size_t KernelEndHeight = KernelHeight;
+
+        while (KernelStartHeight < KernelEndHeight &&
+               InputOriginHeight + ptrdiff_t(KernelStartHeight * DilationHeight) < 0) {
+            KernelStartHeight++;
+        }
+
+        while (KernelEndHeight > KernelStartHeight &&
+               InputOriginHeight + ptrdiff_t((KernelEndHeight - 1) * DilationHeight) >= ptrdiff_t(InputHeight)) {
+            KernelEndHeight--;
+        }
+
+        float* output = Output + oh * OutputWidth;
+        size_t ow = 0;
+
+        //
+        // Compute the output columns at the left edge.
+        //
+
+        for (; ow < OutputWidthStart; ow++) {
+            output[ow] = MlasConvDepthwisePoint(Input, Filter, Bias, InputWidth, KernelWidth,
+                DilationHeight, DilationWidth, InputOriginHeight,
+                ptrdiff_t(ow * StrideShapeWidth) - ptrdiff_t(PaddingLeft),
+                KernelStartHeight, KernelEndHeight);
+        }
+
+        //
+        // Compute the interior output columns with vectors.
+        //
+
+        if (StrideWidth != 0) {
+
+            const size_t VectorStride = (StrideWidth != 0) ? StrideWidth : 1;
+
+            for (; ow + 8 <= OutputWidthEnd; ow += 8) {
+
+                MLAS_FLOAT32X4 Accumulator0 = BiasVector;
+                MLAS_FLOAT32X4 Accumulator1 = BiasVector;
+
+                for (size_t kh = KernelStartHeight; kh < KernelEndHeight; kh++) {
+
+                    const float* input = Input + (InputOriginHeight + ptrdiff_t(kh * DilationHeight)) * ptrdiff_t(InputWidth) +
+                        (ow * VectorStride - PaddingLeft);
+                    const float* filter = Filter + kh * KernelWidth;
+
+                    for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                        MLAS_FLOAT32X4 FilterElement = MlasBroadcastFloat32x4(&filter[kw]);
+
+                        Accumulator0 = MlasMultiplyAddFloat32x4(MlasConvDepthwiseLoadInput<VectorStride>(input), FilterElement, Accumulator0);
+                        Accumulator1 = MlasMultiplyAddFloat32x4(MlasConvDepthwiseLoadInput<VectorStride>(input + 4 * VectorStride), FilterElement, Accumulator1);
+
+                        input += DilationWidth;
+                    }
+                }
+
+                MlasStoreFloat32x4(&output[ow], Accumulator0);
+                MlasStoreFloat32x4(&output[ow + 4], Accumulator1);
+            }
+
+            for (; ow + 4 <= OutputWidthEnd; ow += 4) {
+
+                MLAS_FLOAT32X4 Accumulator = BiasVector;
+
+                for (size_t kh = KernelStartHeight; kh < KernelEndHeight; kh++) {
+
+                    const float* input = Input + (InputOriginHeight + ptrdiff_t(kh * DilationHeight)) * ptrdiff_t(InputWidth) +
+                        (ow * VectorStride - PaddingLeft);
+                    const float* filter = Filter + kh * KernelWidth;
+
+                    for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                        MLAS_FLOAT32X4 FilterElement = MlasBroadcastFloat32x4(&filter[kw]);
+
+                        Accumulator = MlasMultiplyAddFloat32x4(MlasConvDepthwiseLoadInput<VectorStride>(input), FilterElement, Accumulator);
+
+                        input += DilationWidth;
+                    }
+                }
+
+                MlasStoreFloat32x4(&output[ow], Accumulator);
+            }
+        }
+
+        //
+        // Compute the remaining interior output columns and the output
+        // columns at the right edge.
+        //
+
+        for (; ow < OutputWidth; ow++) {
+            output[ow] = MlasConvDepthwisePoint(Input, Filter, Bias, InputWidth, KernelWidth,
+                DilationHeight, DilationWidth, InputOriginHeight,
+                ptrdiff_t(ow * StrideShapeWidth) - ptrdiff_t(PaddingLeft),
+                KernelStartHeight, KernelEndHeight);
+        }
+
+        //
+        // Apply the activation while the output row is in the cache.
+        //
+
+        if (Parameters->Activation != nullptr) {
+            MlasActivation(Parameters->Activation, output, nullptr, 1, OutputWidth, OutputWidth);
+        }
+    }
+}
+
+void
+MlasConvDepthwise(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t StartPlane,
+    size_t PlaneCount
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a range of output planes of a depthwise
+    convolution. Output plane p of the whole operation is computed from input
+    plane p / FilterCount.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    Output - Supplies the output tensor.
+
+    StartPlane - Supplies the first output plane to compute, where the planes
+        of all batches are numbered consecutively.
+
+    PlaneCount - Supplies the number of output planes to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t ChannelCount = Parameters->GroupCount * FilterCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+
+    //
+    // Select the routine specialized for the filter width and stride, which
+    // covers the common 3x3 and 5x5 filters.
+    //
+
+    void (*PlaneRoutine)(const MLAS_CONV_PARAMETERS*, const float*, const float*, float, float*);
+
+    if (StrideWidth == 1) {
+        PlaneRoutine = (KernelWidth == 3) ? MlasConvDepthwisePlane<1, 3> :
+                       (KernelWidth == 5) ? MlasConvDepthwisePlane<1, 5> : MlasConvDepthwisePlane<1, 0>;
+    } else if (StrideWidth == 2) {
+        PlaneRoutine = (KernelWidth == 3) ? MlasConvDepthwisePlane<2, 3> :
+                       (KernelWidth == 5) ? MlasConvDepthwisePlane<2, 5> : MlasConvDepthwisePlane<2, 0>;
+    } else {
+        PlaneRoutine = MlasConvDepthwisePlane<0, 0>;
+    }
+
+    for (size_t plane = StartPlane; plane < StartPlane + PlaneCount; plane++) {
+
+        const size_t channel = plane % ChannelCount;
+
+        PlaneRoutine(Parameters, Input + (plane / FilterCount) * InputSize, Filter + channel * K,
+            (Bias != nullptr) ? Bias[channel] : 0.0f, Output + plane * OutputSize);
+    }
+}
@@ -15,6 +15,13 @@ Abstract:
 --*/
 
 #include "mlasi.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 //
 // Define the number of working buffer elements required per thread.
@@ -23,6 +30,13 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the minimum number of input channels and filters per group for the
+// Winograd algorithm to be picked without autotuning.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS 16
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -574,6 +588,17 @@ Return Value:
         float beta = 0.0f;
         float* SegmentOutput = Output + SegmentStartN + n;
 
+        //
+        // Add the optional bias vector and apply the activation as the rows
+        // of the last slice along the K dimension are completed.
+        //
+
+        MLAS_SGEMM_EPILOGUE Epilogue;
+
+        Epilogue.Activation = Parameters->Activation;
+        Epilogue.RowBias = Bias;
+        Epilogue.ColumnBias = nullptr;
+
         for (size_t k = 0; k < K; k += CountK) {
 
             CountK = K - k;
@@ -592,18 +617,10 @@ Return Value:
 
             MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
                 CountK, 1.0f, Filter + k, K, ColumnBuffer, CountN, beta,
-                SegmentOutput, OutputSize);
+                SegmentOutput, OutputSize, (k + CountK == K) ? &Epilogue : nullptr);
 
             beta = 1.0f;
         }
-
-        //
-        // Add the optional bias vector.
-        //
-
-        if (Bias != nullptr) {
-            MlasBiasAdd(Bias, FilterCount, SegmentOutput, CountN, OutputSize);
-        }
     }
 }
 
@@ -715,21 +732,75 @@ Return Value:
         float* output = WorkBlock->Output + bg * OutputGroupSize;
 
         //
-        // Invoke the non-threaded GEMM directly with the input tensor.
+        // Invoke the non-threaded GEMM directly with the input tensor, adding
+        // the optional bias vector and applying the activation as the output
+        // is completed.
         //
 
+        MLAS_SGEMM_EPILOGUE Epilogue;
+
+        Epilogue.Activation = Parameters->Activation;
+        Epilogue.RowBias = (WorkBlock->Bias != nullptr) ? WorkBlock->Bias + group * FilterCount : nullptr;
+        Epilogue.ColumnBias = nullptr;
+
         MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
             OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, 0.0f,
-            output, OutputSize);
+            output, OutputSize, &Epilogue);
+    }
+}
 
-        //
-        // Add the optional bias vector.
-        //
+void
+MlasConvDepthwiseThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
 
-        if (WorkBlock->Bias != nullptr) {
-            MlasBiasAdd(WorkBlock->Bias + group * FilterCount, FilterCount, output, OutputSize, OutputSize);
-        }
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    depthwise convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Compute the range of output planes to use for this thread.
+    //
+
+    const size_t PlaneCount = Parameters->BatchCount * Parameters->GroupCount * Parameters->FilterCount;
+
+    const size_t TargetThreadCount = WorkBlock->TargetThreadCount;
+
+    const size_t PlaneCountPerThread = PlaneCount / TargetThreadCount;
+    const size_t PlaneCountExtra = PlaneCount % TargetThreadCount;
+
+    size_t PlaneStart;
+    size_t PlaneEnd;
+
+    if (uint32_t(Index) < PlaneCountExtra) {
+        PlaneStart = (PlaneCountPerThread + 1) * Index;
+        PlaneEnd = PlaneStart + PlaneCountPerThread + 1;
+    } else {
+        PlaneStart = PlaneCountPerThread * Index + PlaneCountExtra;
+        PlaneEnd = PlaneStart + PlaneCountPerThread;
     }
+
+    MlasConvDepthwise(Parameters, WorkBlock->Input, WorkBlock->Filter, WorkBlock->Bias,
+        WorkBlock->Output, PlaneStart, PlaneEnd - PlaneStart);
 }
 
 inline
@@ -890,6 +961,41 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // Compute the output planes of a depthwise convolution directly, with the
+    // planes of all batches and channels split across threads.
+    //
+
+    if (Algorithm == MlasConvAlgorithmDepthwise) {
+
+        const size_t PlaneCount = BatchCount * GroupCount * FilterCount;
+
+        int32_t TargetThreadCount = int32_t(Parameters->u.Depthwise.TargetThreadCount);
+
+        if (size_t(TargetThreadCount) >= PlaneCount) {
+            TargetThreadCount = int32_t(PlaneCount);
+        }
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = TargetThreadCount;
+
+        MlasExecuteThreaded(MlasConvDepthwiseThreaded, &WorkBlock, TargetThreadCount);
+
+        return;
+    }
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output);
+        return;
+    }
+
 #if defined(MLAS_HAS_THREADING_SUPPORT)
 
     //
@@ -934,6 +1040,12 @@ Return Value:
 
         for (size_t group = 0; group < GroupCount; group++) {
 
+            MLAS_SGEMM_EPILOGUE Epilogue;
+
+            Epilogue.Activation = Parameters->Activation;
+            Epilogue.RowBias = bias;
+            Epilogue.ColumnBias = nullptr;
+
             //
             // Dispatch the convolution.
             //
@@ -946,17 +1058,9 @@ Return Value:
                     // Invoke the threaded GEMM directly with the input tensor.
                     //
 
-                    MlasSgemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
+                    MlasSgemmWithEpilogue(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
                         OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb, 0.0f,
-                        Output, OutputSize);
-
-                    //
-                    // Add the optional bias vector.
-                    //
-
-                    if (bias != nullptr) {
-                        MlasBiasAdd(bias, FilterCount, Output, OutputSize, OutputSize);
-                    }
+                        Output, OutputSize, &Epilogue);
 
                     break;
                 }
@@ -974,16 +1078,8 @@ Return Value:
                         MlasConvVol2Col(Parameters, Input, WorkingBuffer, 0, K, 0, OutputSize);
                     }
 
-                    MlasSgemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
-                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize);
-
-                    //
-                    // Add the optional bias vector.
-                    //
-
-                    if (bias != nullptr) {
-                        MlasBiasAdd(bias, FilterCount, Output, OutputSize, OutputSize);
-                    }
+                    MlasSgemmWithEpilogue(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
+                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize, &Epilogue);
 
                     break;
                 }
@@ -1003,6 +1099,17 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmDepthwise:
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // These algorithms are dispatched above for all batches
+                    // and groups at once.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1020,6 +1127,327 @@ Return Value:
     }
 }
 
+//
+// Define the state of convolution autotuning. The parameters measured to be
+// fastest for a convolution shape are cached by the shape.
+//
+
+static std::atomic<bool> MlasConvAutotuningEnabled{false};
+
+struct MLAS_CONV_TUNED_PARAMETERS {
+    MLAS_CONV_ALGORITHM Algorithm;
+    size_t ThreadStrideN;
+    size_t WorkingBufferSize;
+};
+
+//
+// The key of a convolution shape: the dimension count, batch count, group
+// count, input channels, filter count and thread count, then the input
+// shape, kernel shape, dilation, leading and trailing padding and stride of
+// each dimension. The key has a fixed size so that looking up a shape doesn't
+// allocate.
+//
+
+typedef std::array<size_t, 6 + 6 * 3> MLAS_CONV_TUNING_KEY;
+
+//
+// The cache is read by every MlasConvPrepare call once autotuning is enabled,
+// and written once per shape, so lookups take a shared lock.
+//
+
+static std::shared_timed_mutex MlasConvTunedParametersLock;
+static std::map<MLAS_CONV_TUNING_KEY, MLAS_CONV_TUNED_PARAMETERS> MlasConvTunedParameters;
+
+void
+MLASCALL
+MlasConvSetAutotuning(
+    bool Enabled
+    )
+/*++
+
+Routine Description:
+
+    This routine enables or disables autotuning of the convolution operation.
+
+    When enabled, MlasConvPrepare measures the candidate algorithms and thread
+    strides for a convolution shape on first use and picks the fastest one,
+    instead of deriving them from the shape. The choice is cached for the
+    process, so later calls for the same shape don't measure again.
+
+Arguments:
+
+    Enabled - Supplies true to enable autotuning, else false.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasConvAutotuningEnabled = Enabled;
+}
+
+static
+double
+MlasConvMeasure(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine measures the time taken by a convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    WorkingBuffer - Supplies a working buffer large enough for the parameters.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    Returns the best time in seconds of a few iterations, after a warm up
+    iteration.
+
+--*/
+{
+    const int Iterations = 3;
+
+    MlasConv(Parameters, Input, Filter, nullptr, WorkingBuffer, Output);
+
+    double BestTime = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < Iterations; i++) {
+
+        auto Start = std::chrono::steady_clock::now();
+        MlasConv(Parameters, Input, Filter, nullptr, WorkingBuffer, Output);
+        std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+
+        BestTime = std::min(BestTime, Elapsed.count());
+    }
+
+    return BestTime;
+}
+
+static
+bool
+MlasConvWinogradSupported(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the Winograd algorithm can perform a
+    convolution operation, which requires a 2D 3x3 filter with unit stride
+    and dilation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+Return Value:
+
+    Returns true if the Winograd algorithm can be used, else false.
+
+--*/
+{
+    return Parameters->Dimensions == 2 &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        Parameters->StrideShape[0] == 1 && Parameters->StrideShape[1] == 1 &&
+        Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1;
+}
+
+static
+void
+MlasConvAutotune(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine replaces the algorithm and thread stride picked for a
+    convolution operation with the ones measured to be fastest on this host.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters, and receives the tuned algorithm and thread stride.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Dimensions = Parameters->Dimensions;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+    const int32_t MaximumThreadCount = std::min(MlasPlatform.GetMaximumThreadCount(), int32_t(MLAS_MAXIMUM_THREAD_COUNT));
+
+    //
+    // Build the key of the convolution shape. The thread count is part of
+    // the key as the best thread stride depends on it.
+    //
+
+    MLAS_CONV_TUNING_KEY Key{};
+
+    Key[0] = Dimensions;
+    Key[1] = Parameters->BatchCount;
+    Key[2] = Parameters->GroupCount;
+    Key[3] = Parameters->InputChannels;
+    Key[4] = Parameters->FilterCount;
+    Key[5] = size_t(MaximumThreadCount);
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+        size_t* DimensionKey = &Key[6 + dim * 6];
+        DimensionKey[0] = Parameters->InputShape[dim];
+        DimensionKey[1] = Parameters->KernelShape[dim];
+        DimensionKey[2] = Parameters->DilationShape[dim];
+        DimensionKey[3] = Parameters->Padding[dim];
+        DimensionKey[4] = Parameters->Padding[dim + Dimensions];
+        DimensionKey[5] = Parameters->StrideShape[dim];
+    }
+
+    MLAS_CONV_TUNED_PARAMETERS Tuned;
+    bool Found;
+
+    {
+        std::shared_lock<std::shared_timed_mutex> Lock(MlasConvTunedParametersLock);
+
+        auto it = MlasConvTunedParameters.find(Key);
+
+        Found = (it != MlasConvTunedParameters.end());
+
+        if (Found) {
+            Tuned = it->second;
+        }
+    }
+
+    if (!Found) {
+
+        //
+        // Measure the candidates without holding the lock, so that the
+        // convolutions of other shapes aren't blocked meanwhile. If another
+        // thread measures the same shape concurrently, the first result
+        // stored is kept.
+        //
+
+        //
+        // Build the candidates: the full expansion, the segmented expansion
+        // with the N dimension sliced for 1, 2, 4, ... threads, and the
+        // Winograd algorithm if the shape allows it.
+        //
+
+        std::vector<MLAS_CONV_TUNED_PARAMETERS> Candidates;
+
+        Candidates.push_back({MlasConvAlgorithmExpandThenGemm, 0, OutputSize * K});
+
+        for (int32_t ThreadCount = 1; ThreadCount <= MaximumThreadCount; ) {
+
+            size_t StrideN = (OutputSize + ThreadCount - 1) / ThreadCount;
+
+            if (ThreadCount > 1) {
+                StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+            }
+
+            const size_t SegmentCount = (OutputSize + StrideN - 1) / StrideN;
+
+            if (Candidates.back().ThreadStrideN != StrideN) {
+                Candidates.push_back({MlasConvAlgorithmExpandThenGemmSegmented, StrideN,
+                    SegmentCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD});
+            }
+
+            if (ThreadCount == MaximumThreadCount) {
+                break;
+            }
+
+            ThreadCount = std::min(ThreadCount * 2, MaximumThreadCount);
+        }
+
+        if (MlasConvWinogradSupported(Parameters)) {
+
+            MLAS_CONV_PARAMETERS WinogradParameters = *Parameters;
+            size_t WinogradWorkingBufferSize;
+
+            MlasConvWinogradPrepare(&WinogradParameters, &WinogradWorkingBufferSize);
+
+            Candidates.push_back({MlasConvAlgorithmWinograd, 0, WinogradWorkingBufferSize});
+        }
+
+        //
+        // Measure the candidates with scratch buffers.
+        //
+
+        size_t MaximumWorkingBufferSize = 0;
+
+        for (const auto& Candidate : Candidates) {
+            MaximumWorkingBufferSize = std::max(MaximumWorkingBufferSize, Candidate.WorkingBufferSize);
+        }
+
+        const size_t BatchGroupCount = Parameters->BatchCount * Parameters->GroupCount;
+
+        std::vector<float> Input(BatchGroupCount * Parameters->InputChannels * Parameters->InputSize);
+        std::vector<float> Filter(Parameters->GroupCount * Parameters->FilterCount * K);
+        std::vector<float> Output(BatchGroupCount * Parameters->FilterCount * OutputSize);
+        std::vector<float> WorkingBuffer(MaximumWorkingBufferSize);
+
+        MLAS_CONV_TUNED_PARAMETERS Best{Parameters->Algorithm,
+            Parameters->u.ExpandThenGemmSegmented.ThreadStrideN, *WorkingBufferSize};
+        double BestTime = std::numeric_limits<double>::max();
+
+        for (const auto& Candidate : Candidates) {
+
+            MLAS_CONV_PARAMETERS CandidateParameters = *Parameters;
+
+            if (Candidate.Algorithm == MlasConvAlgorithmWinograd) {
+                size_t WinogradWorkingBufferSize;
+                MlasConvWinogradPrepare(&CandidateParameters, &WinogradWorkingBufferSize);
+            } else {
+                CandidateParameters.Algorithm = Candidate.Algorithm;
+                CandidateParameters.u.ExpandThenGemmSegmented.ThreadStrideN = Candidate.ThreadStrideN;
+            }
+
+            double Time = MlasConvMeasure(&CandidateParameters, Input.data(), Filter.data(),
+                WorkingBuffer.data(), Output.data());
+
+            if (Time < BestTime) {
+                BestTime = Time;
+                Best = Candidate;
+            }
+        }
+
+        std::unique_lock<std::shared_timed_mutex> Lock(MlasConvTunedParametersLock);
+
+        Tuned = MlasConvTunedParameters.emplace(Key, Best).first->second;
+    }
+
+    if (Tuned.Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinogradPrepare(Parameters, WorkingBufferSize);
+    } else {
+        Parameters->Algorithm = Tuned.Algorithm;
+        Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = Tuned.ThreadStrideN;
+        *WorkingBufferSize = Tuned.WorkingBufferSize;
+    }
+}
+
 void
 MLASCALL
 MlasConvPrepare(
@@ -1035,6 +1463,7 @@ MlasConvPrepare(
     const int64_t* StrideShape,
     const int64_t* OutputShape,
     size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize
     )
 /*++
@@ -1050,7 +1479,7 @@ Arguments:
     Parameters - Supplies the structure that stores the provided and computed
         parameters for the convolution operation.
 
-    Dimensions - Supplies the number of dimensions (must be 2 or 3).
+    Dimensions - Supplies the number of dimensions (must be 1, 2 or 3).
 
     BatchCount - Supplies the number of batches to the processed.
 
@@ -1073,6 +1502,10 @@ Arguments:
 
     FilterCount - Supplies the number of rows of the filter matrix per group.
 
+    Activation - Optionally supplies the activation to apply to the output
+        tensor after the bias vector is added. The structure must remain valid
+        while the parameters are used.
+
     WorkingBufferSize - Receives the number of elements to allocate for the
         working buffer for intermediate results.
 
@@ -1082,6 +1515,27 @@ Return Value:
 
 --*/
 {
+    //
+    // Map a 1D convolution to a 2D convolution with a unit height so that it
+    // shares the 2D algorithms and kernels.
+    //
+
+    if (Dimensions == 1) {
+
+        const int64_t InputShape2D[2] = { 1, InputShape[0] };
+        const int64_t KernelShape2D[2] = { 1, KernelShape[0] };
+        const int64_t DilationShape2D[2] = { 1, DilationShape[0] };
+        const int64_t Padding2D[4] = { 0, Padding[0], 0, Padding[1] };
+        const int64_t StrideShape2D[2] = { 1, StrideShape[0] };
+        const int64_t OutputShape2D[2] = { 1, OutputShape[0] };
+
+        MlasConvPrepare(Parameters, 2, BatchCount, GroupCount, InputChannels,
+            InputShape2D, KernelShape2D, DilationShape2D, Padding2D, StrideShape2D,
+            OutputShape2D, FilterCount, Activation, WorkingBufferSize);
+
+        return;
+    }
+
     //
     // Save the convolution parameters.
     //
@@ -1091,6 +1545,7 @@ Return Value:
     Parameters->GroupCount = GroupCount;
     Parameters->InputChannels = InputChannels;
     Parameters->FilterCount = FilterCount;
+    Parameters->Activation = Activation;
 
     size_t InputSize = 1;
     size_t OutputSize = 1;
@@ -1129,6 +1584,37 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    //
+    // Detect a depthwise convolution, where each output channel is computed
+    // from a single input channel. Expanding the input for a GEMM with one
+    // row per group doesn't pay off, so compute the output directly instead.
+    //
+
+    if (Dimensions == 2 && InputChannels == 1 && GroupCount > 1) {
+
+        double Complexity = double(BatchCount) * double(GroupCount) * double(FilterCount) *
+            double(OutputSize) * double(K);
+
+        int32_t TargetThreadCount;
+
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        }
+
+        int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+        if (TargetThreadCount >= MaximumThreadCount) {
+            TargetThreadCount = MaximumThreadCount;
+        }
+
+        Parameters->Algorithm = MlasConvAlgorithmDepthwise;
+        Parameters->u.Depthwise.TargetThreadCount = size_t(TargetThreadCount);
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -1172,7 +1658,17 @@ Return Value:
         }
     }
 
-    if (FilterCount > OutputSize) {
+    if (MlasConvWinogradSupported(Parameters) && InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS) {
+
+        //
+        // Use the Winograd algorithm for 3x3 filters with enough channels for
+        // the GEMMs in the Winograd domain to be efficient.
+        //
+
+        MlasConvWinogradPrepare(Parameters, WorkingBufferSize);
+
+    } else if (FilterCount > OutputSize) {
 
         //
         // The filter count is larger than the output dimensions, so perform the
@@ -1235,4 +1731,124 @@ Return Value:
 
         *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
     }
+
+    //
+    // Replace the algorithm and thread stride derived from the shape with the
+    // ones measured to be fastest if autotuning is enabled.
+    //
+
+    if (MlasConvAutotuningEnabled) {
+        MlasConvAutotune(Parameters, WorkingBufferSize);
+    }
+}
+
+size_t
+MLASCALL
+MlasConvGetTransformedFilterSize(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the size of the filter transformed for the
+    algorithm picked by MlasConvPrepare.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+Return Value:
+
+    Returns the number of elements of the transformed filter, or zero if the
+    algorithm uses the filter as is.
+
+--*/
+{
+    if (Parameters->Algorithm == MlasConvAlgorithmWinograd) {
+        return MlasConvWinogradFilterSize(Parameters);
+    }
+
+    return 0;
+}
+
+void
+MLASCALL
+MlasConvTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter for the algorithm picked by
+    MlasConvPrepare, so that a constant filter can be transformed once
+    instead of on every call to MlasConv.
+
+    The transformed filter only depends on the filter and the group count,
+    so it can be reused for any input shape where MlasConvPrepare picks the
+    same algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor.
+
+    TransformedFilter - Supplies the buffer to receive the transformed
+        filter, sized to the number of elements returned by
+        MlasConvGetTransformedFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Parameters->Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinogradTransformFilter(Parameters, Filter, TransformedFilter);
+    }
+}
+
+void
+MLASCALL
+MlasConvSetTransformedFilter(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedFilter,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine supplies a filter transformed by MlasConvTransformFilter to
+    a convolution operation, which then ignores the filter passed to MlasConv.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedFilter - Supplies the transformed filter.
+
+    WorkingBufferSize - Supplies the number of elements of the working buffer
+        returned by MlasConvPrepare, and receives the smaller number of
+        elements required now that the working buffer doesn't hold the
+        transformed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Parameters->Algorithm == MlasConvAlgorithmWinograd &&
+        Parameters->u.Winograd.TransformedFilter == nullptr) {
+        Parameters->u.Winograd.TransformedFilter = TransformedFilter;
+        *WorkingBufferSize -= MlasConvWinogradFilterSize(Parameters);
+    }
 }
@@ -0,0 +1,579 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convtranspose.cpp
+
+Abstract:
+
+    This module implements the transposed convolution operation.
+
+    The filter is multiplied with the input image to produce a column buffer
+    with one row per output channel and kernel position. The column buffer is
+    then scattered and accumulated into the output image (col2im). Output
+    channels receive contributions from disjoint rows of the column buffer, so
+    the col2im step is split across threads by output channel.
+
+    One and two dimensional operations are mapped to the three dimensional
+    implementation by prepending unit dimensions.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of the col2im step on worker
+// threads.
+//
+
+struct MLAS_CONV_TRANSPOSE_WORK_BLOCK {
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters;
+    const float* ColumnBuffer;
+    const float* Bias;
+    float* Output;
+    int32_t TargetThreadCount;
+};
+
+inline
+void
+MlasConvTransposeComputeRange(
+    size_t InputExtent,
+    size_t OutputExtent,
+    size_t Stride,
+    size_t KernelOffset,
+    size_t Padding,
+    size_t* InputBegin,
+    size_t* InputEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of input indices that map to a valid
+    output index for one kernel position along one dimension. The output
+    index for an input index i is (i * Stride + KernelOffset - Padding).
+
+Arguments:
+
+    InputExtent - Supplies the number of input elements along the dimension.
+
+    OutputExtent - Supplies the number of output elements along the dimension.
+
+    Stride - Supplies the stride along the dimension.
+
+    KernelOffset - Supplies the kernel index scaled by the dilation.
+
+    Padding - Supplies the leading padding along the dimension.
+
+    InputBegin - Receives the first valid input index.
+
+    InputEnd - Receives the index past the last valid input index.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t Begin = 0;
+
+    if (KernelOffset < Padding) {
+        Begin = (Padding - KernelOffset + Stride - 1) / Stride;
+    }
+
+    size_t End = 0;
+
+    if (OutputExtent + Padding > KernelOffset) {
+        End = (OutputExtent + Padding - KernelOffset + Stride - 1) / Stride;
+    }
+
+    End = std::min(End, InputExtent);
+
+    *InputBegin = std::min(Begin, End);
+    *InputEnd = End;
+}
+
+void
+MlasConvTransposeCol2Im(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* ColumnBuffer,
+    const float* Bias,
+    float* Output,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the rows of the column buffer into the output
+    image for a range of output channels. Each output channel is initialized
+    with its bias, so the bias addition does not need a separate pass.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    ColumnBuffer - Supplies the rows of the column buffer for the first output
+        channel of the range.
+
+    Bias - Optionally supplies the bias vector for the range of output
+        channels.
+
+    Output - Supplies the output image for the first output channel of the
+        range.
+
+    FilterCount - Supplies the number of output channels to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputDepth = Parameters->InputShape[0];
+    const size_t InputHeight = Parameters->InputShape[1];
+    const size_t InputWidth = Parameters->InputShape[2];
+
+    const size_t OutputDepth = Parameters->OutputShape[0];
+    const size_t OutputHeight = Parameters->OutputShape[1];
+    const size_t OutputWidth = Parameters->OutputShape[2];
+
+    const size_t KernelDepth = Parameters->KernelShape[0];
+    const size_t KernelHeight = Parameters->KernelShape[1];
+    const size_t KernelWidth = Parameters->KernelShape[2];
+
+    const size_t StrideDepth = Parameters->StrideShape[0];
+    const size_t StrideHeight = Parameters->StrideShape[1];
+    const size_t StrideWidth = Parameters->StrideShape[2];
+
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        //
+        // Initialize the output channel with the bias.
+        //
+
+        MLAS_FLOAT32X4 BiasBroadcast = MlasBroadcastFloat32x4((Bias != nullptr) ? Bias[f] : 0.0f);
+
+        float* output = Output;
+        size_t n = OutputSize;
+
+        while (n >= 4) {
+            MlasStoreFloat32x4(output, BiasBroadcast);
+            output += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+            MlasStoreLaneFloat32x4<0>(output, BiasBroadcast);
+            output += 1;
+            n -= 1;
+        }
+
+        //
+        // Accumulate each kernel position of the column buffer.
+        //
+
+        for (size_t kd = 0; kd < KernelDepth; kd++) {
+
+            const size_t OffsetD = kd * Parameters->DilationShape[0];
+
+            size_t BeginD;
+            size_t EndD;
+
+            MlasConvTransposeComputeRange(InputDepth, OutputDepth, StrideDepth,
+                OffsetD, Parameters->Padding[0], &BeginD, &EndD);
+
+            for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+                const size_t OffsetH = kh * Parameters->DilationShape[1];
+
+                size_t BeginH;
+                size_t EndH;
+
+                MlasConvTransposeComputeRange(InputHeight, OutputHeight, StrideHeight,
+                    OffsetH, Parameters->Padding[1], &BeginH, &EndH);
+
+                for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                    const size_t OffsetW = kw * Parameters->DilationShape[2];
+
+                    size_t BeginW;
+                    size_t EndW;
+
+                    MlasConvTransposeComputeRange(InputWidth, OutputWidth, StrideWidth,
+                        OffsetW, Parameters->Padding[2], &BeginW, &EndW);
+
+                    const size_t CountW = EndW - BeginW;
+                    const size_t OutputBeginW = BeginW * StrideWidth + OffsetW - Parameters->Padding[2];
+
+                    for (size_t id = BeginD; id < EndD; id++) {
+
+                        const size_t od = id * StrideDepth + OffsetD - Parameters->Padding[0];
+
+                        for (size_t ih = BeginH; ih < EndH; ih++) {
+
+                            const size_t oh = ih * StrideHeight + OffsetH - Parameters->Padding[1];
+
+                            const float* col = &ColumnBuffer[(id * InputHeight + ih) * InputWidth + BeginW];
+                            float* out = &Output[(od * OutputHeight + oh) * OutputWidth + OutputBeginW];
+
+                            size_t c = CountW;
+
+                            if (StrideWidth == 1) {
+
+                                while (c >= 4) {
+                                    MlasStoreFloat32x4(out, MlasAddFloat32x4(MlasLoadFloat32x4(out), MlasLoadFloat32x4(col)));
+                                    out += 4;
+                                    col += 4;
+                                    c -= 4;
+                                }
+
+                                while (c > 0) {
+                                    *out++ += *col++;
+                                    c -= 1;
+                                }
+
+                            } else {
+
+                                while (c > 0) {
+                                    *out += *col++;
+                                    out += StrideWidth;
+                                    c -= 1;
+                                }
+                            }
+                        }
+                    }
+
+                    ColumnBuffer += InputSize;
+                }
+            }
+        }
+
+        //
+        // Apply the activation to the completed output channel.
+        //
+
+        if (Parameters->Activation != nullptr) {
+            MlasActivation(Parameters->Activation, Output, nullptr, 1, OutputSize, OutputSize);
+        }
+
+        Output += OutputSize;
+    }
+}
+
+void
+MlasConvTransposeCol2ImThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of the
+    col2im step of a transposed convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK* WorkBlock = (MLAS_CONV_TRANSPOSE_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Partition the output channels across the threads.
+    //
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t TargetThreadCount = size_t(WorkBlock->TargetThreadCount);
+
+    const size_t FilterCountPerThread = FilterCount / TargetThreadCount;
+    const size_t FilterCountExtra = FilterCount % TargetThreadCount;
+
+    size_t FilterStart;
+    size_t FilterEnd;
+
+    if (size_t(Index) < FilterCountExtra) {
+        FilterStart = (FilterCountPerThread + 1) * size_t(Index);
+        FilterEnd = FilterStart + FilterCountPerThread + 1;
+    } else {
+        FilterStart = FilterCountPerThread * size_t(Index) + FilterCountExtra;
+        FilterEnd = FilterStart + FilterCountPerThread;
+    }
+
+    const float* Bias = WorkBlock->Bias;
+
+    MlasConvTransposeCol2Im(Parameters,
+        WorkBlock->ColumnBuffer + FilterStart * Parameters->KernelSize * Parameters->InputSize,
+        (Bias != nullptr) ? Bias + FilterStart : nullptr,
+        WorkBlock->Output + FilterStart * Parameters->OutputSize,
+        FilterEnd - FilterStart);
+}
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the transposed convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the transposed
+        convolution parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor, in the layout of the ONNX
+        ConvTranspose operator: input channels, then output channels per
+        group, then the kernel dimensions.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvTransposePrepare.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    const size_t InputGroupSize = InputChannels * InputSize;
+    const size_t OutputGroupSize = FilterCount * OutputSize;
+    const size_t FilterGroupSize = InputChannels * K;
+
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.ColumnBuffer = WorkingBuffer;
+    WorkBlock.TargetThreadCount = int32_t(Parameters->TargetThreadCount);
+
+    for (size_t batch = 0; batch < Parameters->BatchCount; batch++) {
+
+        const float* filter = Filter;
+        const float* bias = Bias;
+
+        for (size_t group = 0; group < Parameters->GroupCount; group++) {
+
+            //
+            // Compute the column buffer as the transposed filter multiplied
+            // by the input image. The packed SGEMM is internally threaded.
+            //
+
+            MlasSgemm(CblasTrans, CblasNoTrans, K, InputSize, InputChannels, 1.0f,
+                filter, K, Input, InputSize, 0.0f, WorkingBuffer, InputSize);
+
+            //
+            // Accumulate the column buffer into the output image.
+            //
+
+            WorkBlock.Bias = bias;
+            WorkBlock.Output = Output;
+
+            MlasExecuteThreaded(MlasConvTransposeCol2ImThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+
+            //
+            // Advance the buffer pointers to the next group.
+            //
+
+            if (bias != nullptr) {
+                bias += FilterCount;
+            }
+
+            filter += FilterGroupSize;
+            Input += InputGroupSize;
+            Output += OutputGroupSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a transposed convolution operation by computing
+    required parameters including the required working buffer size for
+    intermediate results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the transposed convolution operation.
+
+    Dimensions - Supplies the number of dimensions (must be between 1 and 3).
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of padding elements at the edge of the
+        output tensor, leading edges followed by the trailing edges. Only the
+        leading edges are used, as the output shape determines the trailing
+        edges.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    Activation - Optionally supplies the parameters for the activation to
+        apply to the output.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Save the transposed convolution parameters.
+    //
+
+    Parameters->Dimensions = Dimensions;
+    Parameters->BatchCount = BatchCount;
+    Parameters->GroupCount = GroupCount;
+    Parameters->InputChannels = InputChannels;
+    Parameters->FilterCount = FilterCount;
+    Parameters->Activation = Activation;
+
+    //
+    // Map the operation to three dimensions by prepending unit dimensions.
+    //
+
+    const size_t DimensionOffset = 3 - Dimensions;
+
+    size_t InputSize = 1;
+    size_t OutputSize = 1;
+    size_t KernelSize = 1;
+
+    for (size_t dim = 0; dim < 3; dim++) {
+
+        if (dim < DimensionOffset) {
+
+            Parameters->InputShape[dim] = 1;
+            Parameters->OutputShape[dim] = 1;
+            Parameters->KernelShape[dim] = 1;
+            Parameters->DilationShape[dim] = 1;
+            Parameters->Padding[dim] = 0;
+            Parameters->StrideShape[dim] = 1;
+
+        } else {
+
+            const size_t src = dim - DimensionOffset;
+
+            Parameters->InputShape[dim] = size_t(InputShape[src]);
+            Parameters->OutputShape[dim] = size_t(OutputShape[src]);
+            Parameters->KernelShape[dim] = size_t(KernelShape[src]);
+            Parameters->DilationShape[dim] = size_t(DilationShape[src]);
+            Parameters->Padding[dim] = size_t(Padding[src]);
+            Parameters->StrideShape[dim] = size_t(StrideShape[src]);
+        }
+
+        InputSize *= Parameters->InputShape[dim];
+        OutputSize *= Parameters->OutputShape[dim];
+        KernelSize *= Parameters->KernelShape[dim];
+    }
+
+    Parameters->InputSize = InputSize;
+    Parameters->OutputSize = OutputSize;
+    Parameters->KernelSize = KernelSize;
+    Parameters->K = FilterCount * KernelSize;
+
+    //
+    // Compute the number of threads to use for the col2im step based on the
+    // number of elements to accumulate.
+    //
+
+    double Complexity = double(Parameters->K) * double(InputSize) + double(FilterCount) * double(OutputSize);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= FilterCount) {
+        TargetThreadCount = int32_t(FilterCount);
+    }
+
+    if (TargetThreadCount < 1) {
+        TargetThreadCount = 1;
+    }
+
+    Parameters->TargetThreadCount = size_t(TargetThreadCount);
+
+    *WorkingBufferSize = Parameters->K * InputSize;
+}
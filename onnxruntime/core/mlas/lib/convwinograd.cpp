@@ -0,0 +1,780 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convwinograd.cpp
+
+Abstract:
+
+    This module implements the Winograd F(2x2,3x3) convolution algorithm.
+
+    The output is split into 2x2 tiles, each computed from a 4x4 tile of the
+    input. The input tiles and the 3x3 filters are transformed to 4x4 tiles
+    in the Winograd domain, where the convolution becomes an element wise
+    product summed over the input channels. For each of the 16 elements of a
+    tile, this sum is a GEMM of the transformed filters and the transformed
+    input tiles. The products are transformed back to 2x2 output tiles.
+
+    This replaces the 36 multiplies of a direct 2x2 output tile with 16.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of elements of a transformed tile.
+//
+
+#define MLAS_WINOGRAD_TILE_ELEMENTS                 16
+
+//
+// Define the number of elements of the per-thread buffer that holds the
+// transformed input and output tiles of a segment.
+//
+
+#define MLAS_WINOGRAD_WORKING_BUFFER_ELEMENTS       (256 * 1024)
+
+//
+// Define the padding between the matrices of the transformed input and
+// output tiles. The 16 matrices are written together by the transforms, so
+// they must not be a multiple of the page size apart or they alias in the
+// cache.
+//
+
+#define MLAS_WINOGRAD_MATRIX_PADDING                16
+
+//
+// Define the parameters to execute segments of a Winograd convolution
+// operation on worker threads.
+//
+
+struct MLAS_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* TransformedFilter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    int32_t TargetThreadCount;
+};
+
+size_t
+MlasConvWinogradFilterSize(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements of the transformed filter.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+Return Value:
+
+    Returns the number of elements.
+
+--*/
+{
+    return Parameters->GroupCount * MLAS_WINOGRAD_TILE_ELEMENTS *
+        Parameters->FilterCount * Parameters->InputChannels;
+}
+
+inline
+size_t
+MlasConvWinogradThreadBufferSize(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    size_t TileStride
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements of the buffer that holds the
+    transformed input and output tiles of a segment.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TileStride - Supplies the number of tiles per segment.
+
+Return Value:
+
+    Returns the number of elements.
+
+--*/
+{
+    return MLAS_WINOGRAD_TILE_ELEMENTS *
+        ((Parameters->InputChannels + Parameters->FilterCount) * TileStride + 2 * MLAS_WINOGRAD_MATRIX_PADDING);
+}
+
+void
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters to the Winograd domain by
+    computing G * g * G^T for each filter g, where:
+
+        G = | 1    0    0   |
+            | 1/2  1/2  1/2 |
+            | 1/2 -1/2  1/2 |
+            | 0    0    1   |
+
+    The transformed filter is stored as [GroupCount][16][FilterCount]
+    [InputChannels], so that each element of a tile is the row major matrix
+    A of a GEMM.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t ElementStride = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter;
+                float t[4][3];
+
+                for (size_t j = 0; j < 3; j++) {
+                    t[0][j] = g[j];
+                    t[1][j] = 0.5f * (g[j] + g[3 + j] + g[6 + j]);
+                    t[2][j] = 0.5f * (g[j] - g[3 + j] + g[6 + j]);
+                    t[3][j] = g[6 + j];
+                }
+
+                float* u = TransformedFilter + f * InputChannels + c;
+
+                for (size_t i = 0; i < 4; i++) {
+                    u[(i * 4 + 0) * ElementStride] = t[i][0];
+                    u[(i * 4 + 1) * ElementStride] = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+                    u[(i * 4 + 2) * ElementStride] = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+                    u[(i * 4 + 3) * ElementStride] = t[i][2];
+                }
+
+                Filter += 9;
+            }
+        }
+
+        TransformedFilter += MLAS_WINOGRAD_TILE_ELEMENTS * ElementStride;
+    }
+}
+
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* TransformedInput,
+    size_t TileStride,
+    size_t MatrixStride,
+    size_t StartTile,
+    size_t TileCount
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a range of input tiles to the Winograd domain by
+    computing B^T * d * B for each 4x4 input tile d, where:
+
+        B^T = | 1  0 -1  0 |
+              | 0  1  1  0 |
+              | 0 -1  1  0 |
+              | 0  1  0 -1 |
+
+    The transformed tiles are stored as 16 matrices of [InputChannels]
+    [TileStride], so that each element of a tile is the row major matrix B of
+    a GEMM.
+
+    Four horizontally adjacent tiles inside the input are transformed at a
+    time with vectors, where the vector of element (i, j) of the tiles is
+    loaded from every other input column. Tiles touching the padding are
+    transformed one at a time.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input channels of the group.
+
+    TransformedInput - Supplies the buffer to receive the transformed tiles.
+
+    TileStride - Supplies the number of tiles allocated per row of the
+        transformed tiles.
+
+    MatrixStride - Supplies the number of elements between the matrices of
+        the transformed tiles.
+
+    StartTile - Supplies the first tile to transform.
+
+    TileCount - Supplies the number of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileColumns = (Parameters->OutputShape[1] + 1) / 2;
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        size_t th = StartTile / TileColumns;
+        size_t tw = StartTile % TileColumns;
+
+        float* v = TransformedInput + c * TileStride;
+
+        for (size_t tile = 0; tile < TileCount; ) {
+
+            const size_t ih = th * 2 - PaddingTop;
+            const size_t iw = tw * 2 - PaddingLeft;
+
+            //
+            // Four adjacent tiles read input columns iw to iw + 9.
+            //
+
+            if (tile + 4 <= TileCount && tw + 4 <= TileColumns &&
+                InputHeight >= 4 && ih <= InputHeight - 4 && InputWidth >= 10 && iw <= InputWidth - 10) {
+
+                const float* input = Input + ih * InputWidth + iw;
+
+                MLAS_FLOAT32X4 d[4][4];
+
+                for (size_t i = 0; i < 4; i++) {
+                    for (size_t j = 0; j < 4; j++) {
+                        d[i][j] = MlasLoadStride2Float32x4(input + j);
+                    }
+                    input += InputWidth;
+                }
+
+                MLAS_FLOAT32X4 t[4][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    t[0][j] = MlasSubtractFloat32x4(d[0][j], d[2][j]);
+                    t[1][j] = MlasAddFloat32x4(d[1][j], d[2][j]);
+                    t[2][j] = MlasSubtractFloat32x4(d[2][j], d[1][j]);
+                    t[3][j] = MlasSubtractFloat32x4(d[1][j], d[3][j]);
+                }
+
+                for (size_t i = 0; i < 4; i++) {
+                    MlasStoreFloat32x4(&v[(i * 4 + 0) * MatrixStride + tile], MlasSubtractFloat32x4(t[i][0], t[i][2]));
+                    MlasStoreFloat32x4(&v[(i * 4 + 1) * MatrixStride + tile], MlasAddFloat32x4(t[i][1], t[i][2]));
+                    MlasStoreFloat32x4(&v[(i * 4 + 2) * MatrixStride + tile], MlasSubtractFloat32x4(t[i][2], t[i][1]));
+                    MlasStoreFloat32x4(&v[(i * 4 + 3) * MatrixStride + tile], MlasSubtractFloat32x4(t[i][1], t[i][3]));
+                }
+
+                tile += 4;
+                tw += 4;
+
+            } else {
+
+                //
+                // Gather the input tile, with zeroes for the padding.
+                //
+
+                float d[4][4];
+
+                for (size_t i = 0; i < 4; i++) {
+                    for (size_t j = 0; j < 4; j++) {
+                        d[i][j] = (ih + i < InputHeight && iw + j < InputWidth) ?
+                            Input[(ih + i) * InputWidth + iw + j] : 0.0f;
+                    }
+                }
+
+                float t[4][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    t[0][j] = d[0][j] - d[2][j];
+                    t[1][j] = d[1][j] + d[2][j];
+                    t[2][j] = d[2][j] - d[1][j];
+                    t[3][j] = d[1][j] - d[3][j];
+                }
+
+                for (size_t i = 0; i < 4; i++) {
+                    v[(i * 4 + 0) * MatrixStride + tile] = t[i][0] - t[i][2];
+                    v[(i * 4 + 1) * MatrixStride + tile] = t[i][1] + t[i][2];
+                    v[(i * 4 + 2) * MatrixStride + tile] = t[i][2] - t[i][1];
+                    v[(i * 4 + 3) * MatrixStride + tile] = t[i][1] - t[i][3];
+                }
+
+                tile += 1;
+                tw += 1;
+            }
+
+            if (tw == TileColumns) {
+                tw = 0;
+                th++;
+            }
+        }
+
+        Input += InputSize;
+    }
+}
+
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    const float* Bias,
+    float* Output,
+    size_t TileStride,
+    size_t MatrixStride,
+    size_t StartTile,
+    size_t TileCount
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a range of tiles from the Winograd domain to 2x2
+    output tiles by computing A^T * m * A for each 4x4 tile m, where:
+
+        A^T = | 1  1  1  0 |
+              | 0  1 -1 -1 |
+
+    Four horizontally adjacent tiles inside the output are transformed at a
+    time with vectors. Tiles at the bottom or right edge of the output are
+    transformed one at a time. The bias is added to the tiles before they
+    are stored and the activation is applied after each range of tiles.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedOutput - Supplies the tiles stored as 16 matrices of
+        [FilterCount][TileStride].
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    Output - Supplies the output channels of the group.
+
+    TileStride - Supplies the number of tiles allocated per row of the
+        transformed tiles.
+
+    MatrixStride - Supplies the number of elements between the matrices of
+        the transformed tiles.
+
+    StartTile - Supplies the first tile to transform.
+
+    TileCount - Supplies the number of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileColumns = (OutputWidth + 1) / 2;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const float BiasValue = (Bias != nullptr) ? Bias[f] : 0.0f;
+        const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(BiasValue);
+
+        size_t th = StartTile / TileColumns;
+        size_t tw = StartTile % TileColumns;
+
+        const float* m = TransformedOutput + f * TileStride;
+
+        for (size_t tile = 0; tile < TileCount; ) {
+
+            const size_t oh = th * 2;
+            const size_t ow = tw * 2;
+
+            float* output = Output + oh * OutputWidth + ow;
+
+            if (tile + 4 <= TileCount && tw + 4 <= TileColumns &&
+                oh + 2 <= OutputHeight && ow + 8 <= OutputWidth) {
+
+                MLAS_FLOAT32X4 t[2][4];
+
+                for (size_t j = 0; j < 4; j++) {
+
+                    MLAS_FLOAT32X4 m0 = MlasLoadFloat32x4(&m[j * MatrixStride + tile]);
+                    MLAS_FLOAT32X4 m1 = MlasLoadFloat32x4(&m[(4 + j) * MatrixStride + tile]);
+                    MLAS_FLOAT32X4 m2 = MlasLoadFloat32x4(&m[(8 + j) * MatrixStride + tile]);
+                    MLAS_FLOAT32X4 m3 = MlasLoadFloat32x4(&m[(12 + j) * MatrixStride + tile]);
+
+                    t[0][j] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+                    t[1][j] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+                }
+
+                for (size_t i = 0; i < 2; i++) {
+
+                    MLAS_FLOAT32X4 y0 = MlasAddFloat32x4(MlasAddFloat32x4(t[i][0], t[i][1]), t[i][2]);
+                    MLAS_FLOAT32X4 y1 = MlasSubtractFloat32x4(MlasSubtractFloat32x4(t[i][1], t[i][2]), t[i][3]);
+
+                    y0 = MlasAddFloat32x4(y0, BiasVector);
+                    y1 = MlasAddFloat32x4(y1, BiasVector);
+
+                    MlasStoreFloat32x4(output, MlasInterleaveLowFloat32x4(y0, y1));
+                    MlasStoreFloat32x4(output + 4, MlasInterleaveHighFloat32x4(y0, y1));
+
+                    output += OutputWidth;
+                }
+
+                tile += 4;
+                tw += 4;
+
+            } else {
+
+                float t[2][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    t[0][j] = m[j * MatrixStride + tile] + m[(4 + j) * MatrixStride + tile] + m[(8 + j) * MatrixStride + tile];
+                    t[1][j] = m[(4 + j) * MatrixStride + tile] - m[(8 + j) * MatrixStride + tile] - m[(12 + j) * MatrixStride + tile];
+                }
+
+                //
+                // Store the output tile, dropping the elements past the
+                // bottom or right edge of the output.
+                //
+
+                for (size_t i = 0; i < 2 && oh + i < OutputHeight; i++) {
+                    output[0] = t[i][0] + t[i][1] + t[i][2] + BiasValue;
+                    if (ow + 1 < OutputWidth) {
+                        output[1] = t[i][1] - t[i][2] - t[i][3] + BiasValue;
+                    }
+                    output += OutputWidth;
+                }
+
+                tile += 1;
+                tw += 1;
+            }
+
+            if (tw == TileColumns) {
+                tw = 0;
+                th++;
+            }
+        }
+
+        //
+        // Apply the activation to the output rows of each run of tiles while
+        // they are in the cache. Only the elements of this range of tiles are
+        // touched, as other threads may be storing the adjacent tiles.
+        //
+
+        if (Parameters->Activation != nullptr) {
+
+            for (size_t tile = StartTile; tile < StartTile + TileCount; ) {
+
+                const size_t RunStart = tile % TileColumns;
+                const size_t RunCount = std::min(TileColumns - RunStart, StartTile + TileCount - tile);
+
+                const size_t oh = (tile / TileColumns) * 2;
+                const size_t ow = RunStart * 2;
+
+                MlasActivation(Parameters->Activation, Output + oh * OutputWidth + ow, nullptr,
+                    std::min(OutputHeight - oh, size_t(2)), std::min(OutputWidth - ow, RunCount * 2),
+                    OutputWidth);
+
+                tile += RunCount;
+            }
+        }
+
+        Output += OutputSize;
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+    The work is split into segments of TileStride tiles of one batch and
+    group. Each thread transforms the input tiles of its segments, invokes a
+    GEMM for each element of a tile and transforms the products back to the
+    output.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_WINOGRAD_WORK_BLOCK* WorkBlock = (MLAS_WINOGRAD_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t TileStride = Parameters->u.Winograd.TileStride;
+
+    const size_t TileCount = ((Parameters->OutputShape[0] + 1) / 2) * ((Parameters->OutputShape[1] + 1) / 2);
+    const size_t SegmentCount = (TileCount + TileStride - 1) / TileStride;
+
+    //
+    // Compute the range of segments to use for this thread.
+    //
+
+    const size_t TotalWork = Parameters->BatchCount * GroupCount * SegmentCount;
+
+    const size_t TargetThreadCount = WorkBlock->TargetThreadCount;
+
+    const size_t WorkPerThread = TotalWork / TargetThreadCount;
+    const size_t WorkPerThreadExtra = TotalWork % TargetThreadCount;
+
+    size_t WorkIndex;
+    size_t WorkEnd;
+
+    if (uint32_t(Index) < WorkPerThreadExtra) {
+        WorkIndex = (WorkPerThread + 1) * Index;
+        WorkEnd = WorkIndex + WorkPerThread + 1;
+    } else {
+        WorkIndex = WorkPerThread * Index + WorkPerThreadExtra;
+        WorkEnd = WorkIndex + WorkPerThread;
+    }
+
+    const size_t InputMatrixStride = InputChannels * TileStride + MLAS_WINOGRAD_MATRIX_PADDING;
+    const size_t OutputMatrixStride = FilterCount * TileStride + MLAS_WINOGRAD_MATRIX_PADDING;
+
+    float* TransformedInput = WorkBlock->WorkingBuffer +
+        Index * MlasConvWinogradThreadBufferSize(Parameters, TileStride);
+    float* TransformedOutput = TransformedInput +
+        MLAS_WINOGRAD_TILE_ELEMENTS * InputMatrixStride;
+
+    const size_t InputGroupSize = InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = MLAS_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+
+    for (; WorkIndex < WorkEnd; WorkIndex++) {
+
+        const size_t bg = WorkIndex / SegmentCount;
+        const size_t group = bg % GroupCount;
+
+        const size_t StartTile = (WorkIndex % SegmentCount) * TileStride;
+        const size_t CountTile = std::min(TileStride, TileCount - StartTile);
+
+        const float* filter = WorkBlock->TransformedFilter + group * FilterGroupSize;
+        const float* bias = (WorkBlock->Bias != nullptr) ? WorkBlock->Bias + group * FilterCount : nullptr;
+
+        MlasConvWinogradTransformInput(Parameters, WorkBlock->Input + bg * InputGroupSize,
+            TransformedInput, TileStride, InputMatrixStride, StartTile, CountTile);
+
+        for (size_t element = 0; element < MLAS_WINOGRAD_TILE_ELEMENTS; element++) {
+
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountTile,
+                InputChannels, 1.0f, filter + element * FilterCount * InputChannels,
+                InputChannels, TransformedInput + element * InputMatrixStride,
+                TileStride, 0.0f, TransformedOutput + element * OutputMatrixStride,
+                TileStride, nullptr);
+        }
+
+        MlasConvWinogradTransformOutput(Parameters, TransformedOutput, bias,
+            WorkBlock->Output + bg * OutputGroupSize, TileStride, OutputMatrixStride, StartTile, CountTile);
+    }
+}
+
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a Winograd convolution operation by computing
+    the segment size, the number of threads and the required working buffer
+    size.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t BatchGroupCount = Parameters->BatchCount * Parameters->GroupCount;
+
+    const size_t TileCount = ((Parameters->OutputShape[0] + 1) / 2) * ((Parameters->OutputShape[1] + 1) / 2);
+
+    //
+    // Compute the number of target threads given the number of multiplies
+    // in the Winograd domain.
+    //
+
+    int32_t TargetThreadCount;
+    double Complexity = double(BatchGroupCount) * double(MLAS_WINOGRAD_TILE_ELEMENTS) *
+        double(FilterCount) * double(InputChannels) * double(TileCount);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Compute the number of tiles per segment. The transformed input and
+    // output tiles of a segment should stay in the cache, but the GEMMs need
+    // enough tiles to be efficient.
+    //
+
+    size_t TileStride = MLAS_WINOGRAD_WORKING_BUFFER_ELEMENTS /
+        (MLAS_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount));
+
+    TileStride = std::min(std::max(TileStride & ~size_t(15), size_t(16)), size_t(MLAS_SGEMM_STRIDEN));
+
+    //
+    // Split the tiles into more segments if there are not enough segments to
+    // keep the target threads busy.
+    //
+
+    const size_t SegmentsPerBatchGroup = (size_t(TargetThreadCount) + BatchGroupCount - 1) / BatchGroupCount;
+    const size_t BalancedTileStride = (TileCount + SegmentsPerBatchGroup - 1) / SegmentsPerBatchGroup;
+
+    TileStride = std::min(TileStride, std::max(BalancedTileStride, size_t(16)));
+    TileStride = std::min(TileStride, TileCount);
+
+    const size_t SegmentCount = BatchGroupCount * ((TileCount + TileStride - 1) / TileStride);
+
+    if (size_t(TargetThreadCount) > SegmentCount) {
+        TargetThreadCount = int32_t(SegmentCount);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->u.Winograd.TileStride = TileStride;
+    Parameters->u.Winograd.TargetThreadCount = size_t(TargetThreadCount);
+    Parameters->u.Winograd.TransformedFilter = nullptr;
+
+    //
+    // The working buffer holds the transformed filter, unless the caller
+    // supplies it with MlasConvSetTransformedFilter, followed by the
+    // transformed input and output tiles of each thread.
+    //
+
+    *WorkingBufferSize = MlasConvWinogradFilterSize(Parameters) + size_t(TargetThreadCount) *
+        MlasConvWinogradThreadBufferSize(Parameters, TileStride);
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor. This is ignored if the transformed
+        filter was supplied with MlasConvSetTransformedFilter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare or MlasConvSetTransformedFilter.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* TransformedFilter = Parameters->u.Winograd.TransformedFilter;
+
+    if (TransformedFilter == nullptr) {
+        MlasConvWinogradTransformFilter(Parameters, Filter, WorkingBuffer);
+        TransformedFilter = WorkingBuffer;
+        WorkingBuffer += MlasConvWinogradFilterSize(Parameters);
+    }
+
+    MLAS_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.TransformedFilter = TransformedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TargetThreadCount = int32_t(Parameters->u.Winograd.TargetThreadCount);
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+}
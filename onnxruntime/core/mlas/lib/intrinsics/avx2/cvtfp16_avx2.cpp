@@ -0,0 +1,95 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cvtfp16_avx2.cpp
+
+Abstract:
+
+    This module implements the conversion of half-precision floats to
+    single-precision floats for processors that support the F16C instruction
+    set.
+
+    The routine is only selected on processors that also support AVX2, which
+    all implement F16C, so the module can be built with the same compiler
+    flags as the other AVX2 kernels.
+
+--*/
+
+#include "../../mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatBufferF16C(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the source buffer of half-precision floats to the
+    destination buffer of single-precision floats.
+
+Arguments:
+
+    Source - Supplies the address of the source buffer of half-precision
+        floats.
+
+    Destination - Supplies the address of the destination buffer of
+        single-precision floats.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (Count >= 16) {
+
+        __m128i HalfVector0 = _mm_loadu_si128((const __m128i*)&Source[0]);
+        __m128i HalfVector1 = _mm_loadu_si128((const __m128i*)&Source[8]);
+
+        _mm256_storeu_ps(&Destination[0], _mm256_cvtph_ps(HalfVector0));
+        _mm256_storeu_ps(&Destination[8], _mm256_cvtph_ps(HalfVector1));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        __m128i HalfVector = _mm_loadu_si128((const __m128i*)Source);
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(HalfVector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    if (Count >= 4) {
+
+        __m128i HalfVector = _mm_loadl_epi64((const __m128i*)Source);
+
+        _mm_storeu_ps(Destination, _mm_cvtph_ps(HalfVector));
+
+        Source += 4;
+        Destination += 4;
+        Count -= 4;
+    }
+
+    while (Count > 0) {
+
+        *Destination++ = _cvtsh_ss(*Source++);
+        Count -= 1;
+    }
+}
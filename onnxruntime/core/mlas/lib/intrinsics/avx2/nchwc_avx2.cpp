@@ -0,0 +1,274 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    nchwc_avx2.cpp
+
+Abstract:
+
+    This module implements the NCHWc convolution kernel for processors that
+    support the AVX2 and FMA3 instruction sets.
+
+    A block of MLAS_NCHWC_BLOCK_SIZE output channels fits in a single 256-bit
+    register, so the kernel keeps an accumulator per output channel block and
+    output position in registers for the whole reduction.
+
+--*/
+
+#include "../../mlasi.h"
+
+//
+// Helper macros to operate on the accumulator of an output channel block and
+// output position. The accumulators are named variables rather than an array
+// so that they stay in registers; the tests of the template arguments are
+// resolved at compile time.
+//
+
+#define MlasNchwcInitializeAccumulator(fb, p) \
+    if (FilterBlockCount > fb && OutputCount > p) { \
+        Accumulator##fb##p = BiasVector##fb; \
+    }
+
+#define MlasNchwcMultiplyAddPosition(p) \
+    if (OutputCount > p) { \
+        __m256 InputVector = _mm256_broadcast_ss(in + p * InputPositionStride + ic); \
+        Accumulator0##p = _mm256_fmadd_ps(InputVector, FilterVector0, Accumulator0##p); \
+        if (FilterBlockCount > 1) { \
+            Accumulator1##p = _mm256_fmadd_ps(InputVector, FilterVector1, Accumulator1##p); \
+        } \
+    }
+
+#define MlasNchwcStoreAccumulator(fb, p) \
+    if (FilterBlockCount > fb && OutputCount > p) { \
+        _mm256_storeu_ps(Output + fb * OutputBlockStride + p * BlockSize, Accumulator##fb##p); \
+    }
+
+#define MlasNchwcForEachAccumulator(Macro) \
+    Macro(0, 0); Macro(0, 1); Macro(0, 2); Macro(0, 3); Macro(0, 4); Macro(0, 5); \
+    Macro(1, 0); Macro(1, 1); Macro(1, 2); Macro(1, 3); Macro(1, 4); Macro(1, 5);
+
+template<size_t FilterBlockCount, size_t OutputCount>
+void
+MlasNchwcConvKernelFma3Block(
+    const MLAS_NCHWC_CONV_KERNEL_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t KernelHeight,
+    size_t KernelWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output positions for one or two blocks
+    of output channels.
+
+Arguments:
+
+    Parameters - Supplies the strides of the convolution.
+
+    Input - Supplies the address of the first input element used by the first
+        output position.
+
+    Filter - Supplies the address of the first filter element of the first
+        block of output channels.
+
+    Bias - Optionally supplies the bias vector of the first block of output
+        channels.
+
+    Output - Supplies the address of the first output position of the first
+        block of output channels.
+
+    KernelHeight - Supplies the number of kernel rows to accumulate.
+
+    KernelWidth - Supplies the number of kernel columns to accumulate.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static_assert(MLAS_NCHWC_BLOCK_SIZE == 8, "kernel assumes a block fits in a 256-bit register");
+    static_assert(MLAS_NCHWC_CONV_FILTER_BLOCKS == 2, "kernel assumes two filter blocks");
+    static_assert(MLAS_NCHWC_CONV_OUTPUT_TILE == 6, "kernel assumes six output positions");
+
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t InputPositionStride = Parameters->InputPositionStride;
+    const size_t FilterOutputBlockStride = Parameters->FilterOutputBlockStride;
+    const size_t OutputBlockStride = Parameters->OutputBlockStride;
+
+    __m256 BiasVector0 = _mm256_setzero_ps();
+    __m256 BiasVector1 = _mm256_setzero_ps();
+
+    if (Bias != nullptr) {
+        BiasVector0 = _mm256_loadu_ps(Bias);
+        if (FilterBlockCount > 1) {
+            BiasVector1 = _mm256_loadu_ps(Bias + BlockSize);
+        }
+    }
+
+    __m256 Accumulator00, Accumulator01, Accumulator02, Accumulator03, Accumulator04, Accumulator05;
+    __m256 Accumulator10, Accumulator11, Accumulator12, Accumulator13, Accumulator14, Accumulator15;
+
+    MlasNchwcForEachAccumulator(MlasNchwcInitializeAccumulator);
+
+    for (size_t ib = 0; ib < Parameters->InputChannelBlocks; ib++) {
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            const float* in = Input + ib * Parameters->InputBlockStride +
+                kh * Parameters->InputRowStride;
+            const float* f = Filter + ib * Parameters->FilterInputBlockStride +
+                kh * Parameters->FilterRowStride;
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                for (size_t ic = 0; ic < BlockSize; ic++) {
+
+                    __m256 FilterVector0 = _mm256_loadu_ps(f);
+                    __m256 FilterVector1;
+
+                    if (FilterBlockCount > 1) {
+                        FilterVector1 = _mm256_loadu_ps(f + FilterOutputBlockStride);
+                    }
+
+                    MlasNchwcMultiplyAddPosition(0);
+                    MlasNchwcMultiplyAddPosition(1);
+                    MlasNchwcMultiplyAddPosition(2);
+                    MlasNchwcMultiplyAddPosition(3);
+                    MlasNchwcMultiplyAddPosition(4);
+                    MlasNchwcMultiplyAddPosition(5);
+
+                    f += BlockSize;
+                }
+
+                in += Parameters->InputColumnStride;
+            }
+        }
+    }
+
+    MlasNchwcForEachAccumulator(MlasNchwcStoreAccumulator);
+}
+
+template<size_t FilterBlockCount>
+void
+MlasNchwcConvKernelFma3Blocks(
+    const MLAS_NCHWC_CONV_KERNEL_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t OutputCount,
+    size_t KernelHeight,
+    size_t KernelWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine dispatches to the kernel specialized for the number of output
+    positions.
+
+Arguments:
+
+    See MlasNchwcConvKernelFma3.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (OutputCount) {
+
+        case 6:
+            MlasNchwcConvKernelFma3Block<FilterBlockCount, 6>(Parameters, Input, Filter, Bias, Output, KernelHeight, KernelWidth);
+            break;
+
+        case 5:
+            MlasNchwcConvKernelFma3Block<FilterBlockCount, 5>(Parameters, Input, Filter, Bias, Output, KernelHeight, KernelWidth);
+            break;
+
+        case 4:
+            MlasNchwcConvKernelFma3Block<FilterBlockCount, 4>(Parameters, Input, Filter, Bias, Output, KernelHeight, KernelWidth);
+            break;
+
+        case 3:
+            MlasNchwcConvKernelFma3Block<FilterBlockCount, 3>(Parameters, Input, Filter, Bias, Output, KernelHeight, KernelWidth);
+            break;
+
+        case 2:
+            MlasNchwcConvKernelFma3Block<FilterBlockCount, 2>(Parameters, Input, Filter, Bias, Output, KernelHeight, KernelWidth);
+            break;
+
+        case 1:
+            MlasNchwcConvKernelFma3Block<FilterBlockCount, 1>(Parameters, Input, Filter, Bias, Output, KernelHeight, KernelWidth);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasNchwcConvKernelFma3(
+    const MLAS_NCHWC_CONV_KERNEL_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t FilterBlockCount,
+    size_t OutputCount,
+    size_t KernelHeight,
+    size_t KernelWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a run of output positions of an output row for up
+    to MLAS_NCHWC_CONV_FILTER_BLOCKS blocks of output channels.
+
+Arguments:
+
+    Parameters - Supplies the strides of the convolution.
+
+    Input - Supplies the address of the first input element used by the first
+        output position.
+
+    Filter - Supplies the address of the first filter element of the first
+        block of output channels.
+
+    Bias - Optionally supplies the bias vector of the first block of output
+        channels.
+
+    Output - Supplies the address of the first output position of the first
+        block of output channels.
+
+    FilterBlockCount - Supplies the number of blocks of output channels.
+
+    OutputCount - Supplies the number of output positions, up to
+        MLAS_NCHWC_CONV_OUTPUT_TILE.
+
+    KernelHeight - Supplies the number of kernel rows to accumulate.
+
+    KernelWidth - Supplies the number of kernel columns to accumulate.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (FilterBlockCount == 2) {
+        MlasNchwcConvKernelFma3Blocks<2>(Parameters, Input, Filter, Bias, Output, OutputCount, KernelHeight, KernelWidth);
+    } else {
+        MlasNchwcConvKernelFma3Blocks<1>(Parameters, Input, Filter, Bias, Output, OutputCount, KernelHeight, KernelWidth);
+    }
+}
@@ -112,6 +112,27 @@ Abstract:
 
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the number of channels in a block of the NCHWc layout. A block is
+// processed as a pair of 4 element vectors.
+//
+
+#define MLAS_NCHWC_BLOCK_SIZE                       8
+
+//
+// Define the maximum number of output positions computed by one invocation
+// of a NCHWc convolution kernel.
+//
+
+#define MLAS_NCHWC_CONV_OUTPUT_TILE                 6
+
+//
+// Define the maximum number of output channel blocks computed by one
+// invocation of a NCHWc convolution kernel.
+//
+
+#define MLAS_NCHWC_CONV_FILTER_BLOCKS               2
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -176,6 +197,60 @@ void
 
 typedef MLAS_TANH_KERNEL_ROUTINE* PMLAS_TANH_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_ELEMENTWISE_KERNEL_ROUTINE)(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+typedef MLAS_ELEMENTWISE_KERNEL_ROUTINE* PMLAS_ELEMENTWISE_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE)(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE* PMLAS_CONVERT_HALF_TO_FLOAT_ROUTINE;
+
+//
+// Define the strides of a NCHWc convolution that are fixed for the operation.
+// All strides are in elements.
+//
+
+struct MLAS_NCHWC_CONV_KERNEL_PARAMETERS {
+    size_t InputChannelBlocks;
+    size_t InputBlockStride;
+    size_t InputRowStride;
+    size_t InputColumnStride;
+    size_t InputPositionStride;
+    size_t FilterInputBlockStride;
+    size_t FilterOutputBlockStride;
+    size_t FilterRowStride;
+    size_t OutputBlockStride;
+};
+
+typedef
+void
+(MLASCALL MLAS_NCHWC_CONV_KERNEL_ROUTINE)(
+    const MLAS_NCHWC_CONV_KERNEL_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t FilterBlockCount,
+    size_t OutputCount,
+    size_t KernelHeight,
+    size_t KernelWidth
+    );
+
+typedef MLAS_NCHWC_CONV_KERNEL_ROUTINE* PMLAS_NCHWC_CONV_KERNEL_ROUTINE;
+
 extern "C" {
 
     MLAS_SGEMM_KERNEL_ROUTINE MlasSgemmKernelZero;
@@ -210,6 +285,15 @@ extern "C" {
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernelFma3;
 #endif
 
+    MLAS_NCHWC_CONV_KERNEL_ROUTINE MlasNchwcConvKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_NCHWC_CONV_KERNEL_ROUTINE MlasNchwcConvKernelFma3;
+#endif
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CONVERT_HALF_TO_FLOAT_ROUTINE MlasConvertHalfToFloatBufferF16C;
+#endif
+
 }
 
 //
@@ -232,9 +316,61 @@ extern "C" {
 #endif
 
 //
-// Single-threaded single precision matrix/matrix multiply operation.
+// Define the target number of per-thread elements before using another thread
+// to compute an elementwise function. Each thread processes a contiguous
+// chunk of the buffer.
+//
+
+#define MLAS_ELEMENTWISE_THREAD_ELEMENTS            (64 * 1024)
+
+//
+// Fused bias addition and activation applied to a block of an output matrix.
 //
 
+void
+MlasActivationWithBias(
+    const MLAS_ACTIVATION* Activation,
+    float* Buffer,
+    const float* RowBias,
+    const float* ColumnBias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    );
+
+//
+// Elementwise functions applied to a buffer. Large buffers are split into
+// chunks that are computed in parallel.
+//
+
+void
+MlasExecuteElementwise(
+    PMLAS_ELEMENTWISE_KERNEL_ROUTINE KernelRoutine,
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+//
+// Define the epilogue applied by the SGEMM operation to each block of the
+// output matrix once the block is complete. The bias vectors are relative to
+// the first row and column of the output matrix.
+//
+
+struct MLAS_SGEMM_EPILOGUE {
+    const MLAS_ACTIVATION* Activation;
+    const float* RowBias;
+    const float* ColumnBias;
+};
+
+//
+// Single-threaded single precision matrix/matrix multiply operation. Matrix B
+// is either single precision or half precision, in which case the elements
+// are converted as the panels of matrix B are packed.
+//
+
+template<typename BType>
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -245,11 +381,83 @@ MlasSgemmOperation(
     float alpha,
     const float* A,
     size_t lda,
-    const float* B,
+    const BType* B,
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
+    );
+
+//
+// Multi-threaded single precision matrix/matrix multiply operation with an
+// epilogue.
+//
+
+template<typename BType>
+void
+MlasSgemmWithEpilogue(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const BType* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
+    );
+
+//
+// Single-threaded depthwise convolution operation.
+//
+
+void
+MlasConvDepthwise(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t StartPlane,
+    size_t PlaneCount
+    );
+
+//
+// Winograd convolution operation.
+//
+
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize
+    );
+
+size_t
+MlasConvWinogradFilterSize(
+    const MLAS_CONV_PARAMETERS* Parameters
+    );
+
+void
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
     );
 
 //
@@ -271,6 +479,8 @@ struct MLAS_PLATFORM {
     PMLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE TransposePackB16x4Routine;
     PMLAS_LOGISTIC_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_TANH_KERNEL_ROUTINE TanhKernelRoutine;
+    PMLAS_NCHWC_CONV_KERNEL_ROUTINE NchwcConvKernelRoutine;
+    PMLAS_CONVERT_HALF_TO_FLOAT_ROUTINE ConvertHalfToFloatRoutine;
 #endif
 
 #if defined(MLAS_USE_WIN32_THREADPOOL)
@@ -389,6 +599,26 @@ MlasLoadFloat32x4(const float* Buffer)
 #endif
 }
 
+//
+// Loads the even elements of Buffer[0..6] without accessing Buffer[7], for
+// example to gather the inputs of a stride 2 convolution.
+//
+
+inline
+MLAS_FLOAT32X4
+MlasLoadStride2Float32x4(const float* Buffer)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    float32x4_t Low = vld1q_f32(Buffer);
+    float32x4_t High = vld1q_f32(Buffer + 3);
+    return vuzpq_f32(Low, vextq_f32(High, High, 1)).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128 Low = _mm_loadu_ps(Buffer);
+    __m128 High = _mm_loadu_ps(Buffer + 3);
+    return _mm_shuffle_ps(Low, High, _MM_SHUFFLE(3, 1, 2, 0));
+#endif
+}
+
 inline
 void
 MlasStoreFloat32x4(float* Buffer, MLAS_FLOAT32X4 Vector)
@@ -468,6 +698,32 @@ MlasExtractLaneFloat32x4<0>(MLAS_FLOAT32X4 Vector)
 
 #endif
 
+inline
+MLAS_FLOAT32X4
+MlasInterleaveLowFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip1q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpacklo_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasInterleaveHighFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip2q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[1];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpackhi_ps(Vector1, Vector2);
+#endif
+}
+
 inline
 MLAS_FLOAT32X4
 MlasBroadcastFloat32x4(float Value)
@@ -575,6 +831,379 @@ MlasMinimumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+#if defined(MLAS_NEON_INTRINSICS)
+typedef int32x4_t MLAS_INT32X4;
+#elif defined(MLAS_SSE2_INTRINSICS)
+typedef __m128i MLAS_INT32X4;
+#endif
+
+inline
+MLAS_INT32X4
+MlasBroadcastInt32x4(int32_t Value)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vdupq_n_s32(Value);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_set1_epi32(Value);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasReinterpretAsInt32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_f32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasReinterpretAsFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castsi128_ps(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasCastToFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vcvtq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cvtepi32_ps(Vector);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasAddInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vaddq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_add_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasSubtractInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vsubq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_sub_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasAndInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vandq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_and_si128(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasOrInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vorrq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_si128(Vector1, Vector2);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftLeftInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshlq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_slli_epi32(Vector, ShiftCount);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftRightInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshrq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_srai_epi32(Vector, ShiftCount);
+#endif
+}
+
+//
+// Comparisons return a mask with all bits set in each lane where the
+// comparison is true. NaN operands compare as false.
+//
+
+inline
+MLAS_INT32X4
+MlasCompareEqualFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_u32(vceqq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(_mm_cmpeq_ps(Vector1, Vector2));
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasCompareLessThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_u32(vcltq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(_mm_cmplt_ps(Vector1, Vector2));
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasCompareGreaterThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_u32(vcgtq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(_mm_cmpgt_ps(Vector1, Vector2));
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasCompareGreaterThanOrEqualFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_u32(vcgeq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(_mm_cmpge_ps(Vector1, Vector2));
+#endif
+}
+
+//
+// Selects the elements of Vector2 where the mask is set, otherwise the
+// elements of Vector1.
+//
+
+inline
+MLAS_FLOAT32X4
+MlasBlendFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_INT32X4 Mask)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vbslq_f32(vreinterpretq_u32_s32(Mask), Vector2, Vector1);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128 FloatMask = _mm_castsi128_ps(Mask);
+    return _mm_or_ps(_mm_andnot_ps(FloatMask, Vector1), _mm_and_ps(FloatMask, Vector2));
+#endif
+}
+
+//
+// Bundles the floating point constants of the exponential function for use by
+// the inline vector routine below and by kernels written in assembly.
+//
+
+struct MLAS_EXP_CONSTANTS {
+    float LowerRange;
+    float UpperRange;
+    float RoundingBias;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_5;
+    float poly_6;
+    int32_t ExponentBias;
+};
+
+extern "C" const MLAS_EXP_CONSTANTS MlasExpConstants;
+
+inline
+MLAS_FLOAT32X4
+MlasComputeExpFloat32x4(MLAS_FLOAT32X4 Value)
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function of a vector.
+
+    The input is split as x = n * ln(2) + r where n is an integer and r is
+    within [-ln(2)/2, ln(2)/2]. The exponential of r is approximated by a
+    polynomial and then scaled by 2^n. The scale is applied as two factors of
+    2^(n/2) so that results in the denormal range remain accurate without
+    producing an invalid exponent field.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the exponential of the input vector.
+
+--*/
+{
+    Value = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Value);
+    Value = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Value);
+
+    //
+    // Round x/ln(2) to the nearest integer by adding a bias that leaves no
+    // fractional mantissa bits. The integer is also available in the low bits
+    // of the biased value.
+    //
+
+    MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+    MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(Value, MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    MLAS_FLOAT32X4 m = MlasSubtractFloat32x4(Biased, RoundingBias);
+
+    Value = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Value);
+    Value = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), Value);
+
+    MLAS_FLOAT32X4 p;
+    p = MlasMultiplyAddFloat32x4(Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_0),
+        MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, Value, MlasBroadcastFloat32x4(MlasExpConstants.poly_5));
+    p = MlasMultiplyAddFloat32x4(p, MlasMultiplyFloat32x4(Value, Value), Value);
+    p = MlasAddFloat32x4(p, MlasBroadcastFloat32x4(MlasExpConstants.poly_6));
+
+    //
+    // Build the scale factors 2^(n/2) and 2^(n-n/2) directly in the exponent
+    // field.
+    //
+
+    MLAS_INT32X4 n = MlasSubtractInt32x4(MlasReinterpretAsInt32x4(Biased), MlasReinterpretAsInt32x4(RoundingBias));
+    MLAS_INT32X4 n1 = MlasShiftRightInt32x4<1>(n);
+    MLAS_INT32X4 n2 = MlasSubtractInt32x4(n, n1);
+
+    MLAS_INT32X4 ExponentBias = MlasBroadcastInt32x4(MlasExpConstants.ExponentBias);
+    MLAS_FLOAT32X4 Scale1 = MlasReinterpretAsFloat32x4(MlasShiftLeftInt32x4<23>(MlasAddInt32x4(n1, ExponentBias)));
+    MLAS_FLOAT32X4 Scale2 = MlasReinterpretAsFloat32x4(MlasShiftLeftInt32x4<23>(MlasAddInt32x4(n2, ExponentBias)));
+
+    return MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(p, Scale1), Scale2);
+}
+
+//
+// Applies the vector form of an elementwise functor to a buffer. The tail of
+// the buffer is staged through a temporary vector so that the functor only
+// needs a vector form.
+//
+
+template<typename ElementwiseFunctor>
+void
+MLASCALL
+MlasElementwiseKernel(
+    const MLAS_ACTIVATION* Activation,
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    ElementwiseFunctor Functor(Activation);
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + 4);
+
+        MlasStoreFloat32x4(Output, Functor.Activate(Vector0));
+        MlasStoreFloat32x4(Output + 4, Functor.Activate(Vector1));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MlasStoreFloat32x4(Output, Functor.Activate(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    if (N > 0) {
+
+        float Buffer[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+        for (size_t n = 0; n < N; n++) {
+            Buffer[n] = Input[n];
+        }
+
+        MlasStoreFloat32x4(Buffer, Functor.Activate(MlasLoadFloat32x4(Buffer)));
+
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = Buffer[n];
+        }
+    }
+}
+
+//
+// Half-precision floating-point conversion.
+//
+
+inline
+float
+MlasConvertHalfToFloat(
+    MLAS_FP16 Value
+    )
+{
+    union {
+        uint32_t u;
+        float f;
+    } Result, MagicDenormal;
+
+    //
+    // Shift the exponent and mantissa into place and adjust the exponent bias.
+    // Infinity and NaN values need the maximum exponent, while denormal
+    // values are normalized by subtracting the magic denormal value.
+    //
+
+    const uint32_t ShiftedExponent = 0x7C00 << 13;
+
+    Result.u = uint32_t(Value & 0x7FFF) << 13;
+
+    uint32_t Exponent = Result.u & ShiftedExponent;
+
+    Result.u += (127 - 15) << 23;
+
+    if (Exponent == ShiftedExponent) {
+        Result.u += (128 - 16) << 23;
+    } else if (Exponent == 0) {
+        MagicDenormal.u = 113 << 23;
+        Result.u += 1 << 23;
+        Result.f -= MagicDenormal.f;
+    }
+
+    Result.u |= uint32_t(Value & 0x8000) << 16;
+
+    return Result.f;
+}
+
 //
 // Reads a platform specific time stamp counter.
 //
@@ -0,0 +1,1063 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    nchwc.cpp
+
+Abstract:
+
+    This module implements the convolution and pooling operations for tensors
+    in the NCHWc layout.
+
+    A tensor in the NCHWc layout stores the channels in blocks of
+    MLAS_NCHWC_BLOCK_SIZE channels: the logical NCHW tensor is stored as
+    [N][C/c][H][W][c]. A convolution then directly computes a vector of output
+    channels per output position from broadcasts of the input channels and
+    vectors of the filter, without expanding the input to a column buffer.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of a NCHWc operation on worker
+// threads.
+//
+
+struct MLAS_NCHWC_WORK_BLOCK {
+    size_t BatchCount;
+    size_t InputChannels;
+    size_t InputShape[2];
+    size_t OutputChannels;
+    size_t OutputShape[2];
+    size_t KernelShape[2];
+    size_t DilationShape[2];
+    size_t Padding[4];
+    size_t StrideShape[2];
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    float* Output;
+    MLAS_POOLING_KIND PoolingKind;
+    size_t OutputChannelBlocksPerRow;
+    size_t TotalRows;
+    int32_t TargetThreadCount;
+};
+
+size_t
+MLASCALL
+MlasNchwcGetBlockSize(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the channel block size of the NCHWc layout.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the number of channels in a block.
+
+--*/
+{
+    return MLAS_NCHWC_BLOCK_SIZE;
+}
+
+void
+MlasNchwcPrepareWorkBlock(
+    MLAS_NCHWC_WORK_BLOCK* WorkBlock,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t OutputChannelBlocksPerRow
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares the work block for a NCHWc convolution or pooling
+    operation and computes the number of threads to use.
+
+Arguments:
+
+    WorkBlock - Supplies the structure to initialize.
+
+    InputShape - Supplies the shape of the input tensor in NCHW order.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Optionally supplies the shape of the dilation.
+
+    Padding - Supplies the number of padding elements at the edge of the
+        input tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor in NCHW order.
+
+    OutputChannelBlocksPerRow - Supplies the number of output channel blocks
+        that are computed together for an output row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    WorkBlock->BatchCount = size_t(InputShape[0]);
+    WorkBlock->InputChannels = size_t(InputShape[1]);
+    WorkBlock->OutputChannels = size_t(OutputShape[1]);
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        WorkBlock->InputShape[dim] = size_t(InputShape[dim + 2]);
+        WorkBlock->OutputShape[dim] = size_t(OutputShape[dim + 2]);
+        WorkBlock->KernelShape[dim] = size_t(KernelShape[dim]);
+        WorkBlock->DilationShape[dim] = (DilationShape != nullptr) ? size_t(DilationShape[dim]) : 1;
+        WorkBlock->Padding[dim] = size_t(Padding[dim]);
+        WorkBlock->Padding[dim + 2] = size_t(Padding[dim + 2]);
+        WorkBlock->StrideShape[dim] = size_t(StrideShape[dim]);
+    }
+
+    //
+    // Each thread computes a range of output rows. Use fewer threads for small
+    // outputs so that each thread has a meaningful amount of work.
+    //
+
+    const size_t OutputChannelBlocks = WorkBlock->OutputChannels / MLAS_NCHWC_BLOCK_SIZE;
+    const size_t OutputChannelGroups =
+        (OutputChannelBlocks + OutputChannelBlocksPerRow - 1) / OutputChannelBlocksPerRow;
+
+    const size_t TotalRows = WorkBlock->BatchCount * OutputChannelGroups * WorkBlock->OutputShape[0];
+
+    WorkBlock->OutputChannelBlocksPerRow = OutputChannelBlocksPerRow;
+    WorkBlock->TotalRows = TotalRows;
+
+    int32_t TargetThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (size_t(TargetThreadCount) > TotalRows) {
+        TargetThreadCount = int32_t(TotalRows);
+    }
+
+    if (TargetThreadCount > MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    WorkBlock->TargetThreadCount = (TargetThreadCount > 0) ? TargetThreadCount : 1;
+}
+
+void
+MlasNchwcPartitionWork(
+    const MLAS_NCHWC_WORK_BLOCK* WorkBlock,
+    int32_t Index,
+    size_t* RowStart,
+    size_t* RowEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of output rows to process for the
+    specified thread index.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the operation parameters.
+
+    Index - Supplies the current index of the threaded operation.
+
+    RowStart - Receives the first output row to process.
+
+    RowEnd - Receives the output row after the last row to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TotalRows = WorkBlock->TotalRows;
+    const size_t TargetThreadCount = size_t(WorkBlock->TargetThreadCount);
+
+    const size_t RowsPerThread = TotalRows / TargetThreadCount;
+    const size_t RowsExtra = TotalRows % TargetThreadCount;
+
+    if (size_t(Index) < RowsExtra) {
+        *RowStart = (RowsPerThread + 1) * Index;
+        *RowEnd = *RowStart + RowsPerThread + 1;
+    } else {
+        *RowStart = RowsPerThread * Index + RowsExtra;
+        *RowEnd = *RowStart + RowsPerThread;
+    }
+}
+
+void
+MlasNchwcComputeInteriorRange(
+    size_t InputWidth,
+    size_t OutputWidth,
+    size_t KernelWidth,
+    size_t DilationWidth,
+    size_t PaddingLeftWidth,
+    size_t StrideWidth,
+    size_t* OutputStart,
+    size_t* OutputEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of output columns where every column of
+    the kernel maps into the input tensor, so that the kernel can skip the
+    bounds checks.
+
+Arguments:
+
+    InputWidth - Supplies the width of the input tensor.
+
+    OutputWidth - Supplies the width of the output tensor.
+
+    KernelWidth - Supplies the width of the kernel.
+
+    DilationWidth - Supplies the dilation of the kernel.
+
+    PaddingLeftWidth - Supplies the number of padding columns at the left edge.
+
+    StrideWidth - Supplies the stride of the kernel.
+
+    OutputStart - Receives the first interior output column.
+
+    OutputEnd - Receives the output column after the last interior column.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t SpanWidth = DilationWidth * (KernelWidth - 1) + 1;
+
+    size_t Start = (PaddingLeftWidth + StrideWidth - 1) / StrideWidth;
+    size_t End = 0;
+
+    if (InputWidth + PaddingLeftWidth >= SpanWidth) {
+        End = (InputWidth + PaddingLeftWidth - SpanWidth) / StrideWidth + 1;
+    }
+
+    End = (std::min)(End, OutputWidth);
+    Start = (std::min)(Start, End);
+
+    *OutputStart = Start;
+    *OutputEnd = End;
+}
+
+void
+MlasNchwcComputeKernelRange(
+    size_t Origin,
+    size_t InputSize,
+    size_t KernelSize,
+    size_t Dilation,
+    size_t Padding,
+    size_t* KernelStart,
+    size_t* KernelEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of kernel elements along one dimension
+    that map into the input tensor for an output position.
+
+Arguments:
+
+    Origin - Supplies the position of the first kernel element in the padded
+        input tensor.
+
+    InputSize - Supplies the size of the input tensor.
+
+    KernelSize - Supplies the size of the kernel.
+
+    Dilation - Supplies the dilation of the kernel.
+
+    Padding - Supplies the number of padding elements before the input tensor.
+
+    KernelStart - Receives the first kernel element inside the input tensor.
+
+    KernelEnd - Receives the kernel element after the last kernel element
+        inside the input tensor. The range is empty if this is not greater
+        than KernelStart.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t Start = 0;
+
+    if (Origin < Padding) {
+        Start = (Padding - Origin + Dilation - 1) / Dilation;
+    }
+
+    size_t End = 0;
+
+    if (Origin < Padding + InputSize) {
+        End = (Padding + InputSize - Origin + Dilation - 1) / Dilation;
+    }
+
+    End = (std::min)(End, KernelSize);
+    Start = (std::min)(Start, End);
+
+    *KernelStart = Start;
+    *KernelEnd = End;
+}
+
+template<size_t OutputCount>
+void
+MlasNchwcConvKernelBlock(
+    const MLAS_NCHWC_CONV_KERNEL_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t KernelHeight,
+    size_t KernelWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output positions for one block of output
+    channels.
+
+Arguments:
+
+    Parameters - Supplies the strides of the convolution.
+
+    Input - Supplies the address of the first input element used by the first
+        output position.
+
+    Filter - Supplies the address of the first filter element.
+
+    Bias - Optionally supplies the bias vector of the block.
+
+    Output - Supplies the address of the first output position.
+
+    KernelHeight - Supplies the number of kernel rows to accumulate.
+
+    KernelWidth - Supplies the number of kernel columns to accumulate.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    MLAS_FLOAT32X4 Accumulators[OutputCount][2];
+
+    MLAS_FLOAT32X4 BiasVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 BiasVector1 = MlasZeroFloat32x4();
+
+    if (Bias != nullptr) {
+        BiasVector0 = MlasLoadFloat32x4(Bias);
+        BiasVector1 = MlasLoadFloat32x4(Bias + 4);
+    }
+
+    for (size_t p = 0; p < OutputCount; p++) {
+        Accumulators[p][0] = BiasVector0;
+        Accumulators[p][1] = BiasVector1;
+    }
+
+    for (size_t ib = 0; ib < Parameters->InputChannelBlocks; ib++) {
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            const float* inputRow = Input + ib * Parameters->InputBlockStride +
+                kh * Parameters->InputRowStride;
+            const float* f = Filter + ib * Parameters->FilterInputBlockStride +
+                kh * Parameters->FilterRowStride;
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                const float* in = inputRow + kw * Parameters->InputColumnStride;
+
+                for (size_t ic = 0; ic < BlockSize; ic++) {
+
+                    MLAS_FLOAT32X4 FilterVector0 = MlasLoadFloat32x4(f);
+                    MLAS_FLOAT32X4 FilterVector1 = MlasLoadFloat32x4(f + 4);
+
+                    for (size_t p = 0; p < OutputCount; p++) {
+                        MLAS_FLOAT32X4 InputVector = MlasBroadcastFloat32x4(in + p * Parameters->InputPositionStride + ic);
+                        Accumulators[p][0] = MlasMultiplyAddFloat32x4(InputVector, FilterVector0, Accumulators[p][0]);
+                        Accumulators[p][1] = MlasMultiplyAddFloat32x4(InputVector, FilterVector1, Accumulators[p][1]);
+                    }
+
+                    f += BlockSize;
+                }
+            }
+        }
+    }
+
+    for (size_t p = 0; p < OutputCount; p++) {
+        MlasStoreFloat32x4(Output + p * BlockSize, Accumulators[p][0]);
+        MlasStoreFloat32x4(Output + p * BlockSize + 4, Accumulators[p][1]);
+    }
+}
+
+void
+MLASCALL
+MlasNchwcConvKernel(
+    const MLAS_NCHWC_CONV_KERNEL_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t FilterBlockCount,
+    size_t OutputCount,
+    size_t KernelHeight,
+    size_t KernelWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a run of output positions of an output row for up
+    to MLAS_NCHWC_CONV_FILTER_BLOCKS blocks of output channels.
+
+Arguments:
+
+    Parameters - Supplies the strides of the convolution.
+
+    Input - Supplies the address of the first input element used by the first
+        output position.
+
+    Filter - Supplies the address of the first filter element of the first
+        block of output channels.
+
+    Bias - Optionally supplies the bias vector of the first block of output
+        channels.
+
+    Output - Supplies the address of the first output position of the first
+        block of output channels.
+
+    FilterBlockCount - Supplies the number of blocks of output channels.
+
+    OutputCount - Supplies the number of output positions, up to
+        MLAS_NCHWC_CONV_OUTPUT_TILE.
+
+    KernelHeight - Supplies the number of kernel rows to accumulate.
+
+    KernelWidth - Supplies the number of kernel columns to accumulate.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    for (size_t fb = 0; fb < FilterBlockCount; fb++) {
+
+        const float* input = Input;
+        const float* filter = Filter + fb * Parameters->FilterOutputBlockStride;
+        const float* bias = (Bias != nullptr) ? Bias + fb * BlockSize : nullptr;
+        float* output = Output + fb * Parameters->OutputBlockStride;
+
+        size_t OutputRemaining = OutputCount;
+
+        while (OutputRemaining >= 3) {
+
+            MlasNchwcConvKernelBlock<3>(Parameters, input, filter, bias, output,
+                KernelHeight, KernelWidth);
+
+            input += 3 * Parameters->InputPositionStride;
+            output += 3 * BlockSize;
+            OutputRemaining -= 3;
+        }
+
+        if (OutputRemaining == 2) {
+            MlasNchwcConvKernelBlock<2>(Parameters, input, filter, bias, output,
+                KernelHeight, KernelWidth);
+        } else if (OutputRemaining == 1) {
+            MlasNchwcConvKernelBlock<1>(Parameters, input, filter, bias, output,
+                KernelHeight, KernelWidth);
+        }
+    }
+}
+
+void
+MlasNchwcConvThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    NCHWc convolution operation.
+
+    Each work item computes an output row for a group of output channel
+    blocks. Output positions whose receptive field lies inside the input are
+    computed in runs by the convolution kernel; the remaining positions at the
+    edges are computed one at a time with the kernel columns clipped to the
+    input.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_NCHWC_WORK_BLOCK* WorkBlock = (const MLAS_NCHWC_WORK_BLOCK*)Context;
+
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t InputChannelBlocks = WorkBlock->InputChannels / BlockSize;
+    const size_t OutputChannelBlocks = WorkBlock->OutputChannels / BlockSize;
+    const size_t OutputChannelBlocksPerRow = WorkBlock->OutputChannelBlocksPerRow;
+    const size_t OutputChannelGroups =
+        (OutputChannelBlocks + OutputChannelBlocksPerRow - 1) / OutputChannelBlocksPerRow;
+
+    const size_t InputHeight = WorkBlock->InputShape[0];
+    const size_t InputWidth = WorkBlock->InputShape[1];
+    const size_t OutputHeight = WorkBlock->OutputShape[0];
+    const size_t OutputWidth = WorkBlock->OutputShape[1];
+
+    const size_t KernelHeight = WorkBlock->KernelShape[0];
+    const size_t KernelWidth = WorkBlock->KernelShape[1];
+    const size_t DilationHeight = WorkBlock->DilationShape[0];
+    const size_t DilationWidth = WorkBlock->DilationShape[1];
+    const size_t PaddingTop = WorkBlock->Padding[0];
+    const size_t PaddingLeft = WorkBlock->Padding[1];
+    const size_t StrideHeight = WorkBlock->StrideShape[0];
+    const size_t StrideWidth = WorkBlock->StrideShape[1];
+
+    const size_t InputBlockSize = InputHeight * InputWidth * BlockSize;
+    const size_t OutputBlockSize = OutputHeight * OutputWidth * BlockSize;
+    const size_t FilterInputBlockSize = KernelHeight * KernelWidth * BlockSize * BlockSize;
+    const size_t FilterOutputBlockSize = InputChannelBlocks * FilterInputBlockSize;
+
+    MLAS_NCHWC_CONV_KERNEL_PARAMETERS Parameters;
+
+    Parameters.InputChannelBlocks = InputChannelBlocks;
+    Parameters.InputBlockStride = InputBlockSize;
+    Parameters.InputRowStride = DilationHeight * InputWidth * BlockSize;
+    Parameters.InputColumnStride = DilationWidth * BlockSize;
+    Parameters.InputPositionStride = StrideWidth * BlockSize;
+    Parameters.FilterInputBlockStride = FilterInputBlockSize;
+    Parameters.FilterOutputBlockStride = FilterOutputBlockSize;
+    Parameters.FilterRowStride = KernelWidth * BlockSize * BlockSize;
+    Parameters.OutputBlockStride = OutputBlockSize;
+
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_NCHWC_CONV_KERNEL_ROUTINE ConvKernelRoutine = MlasPlatform.NchwcConvKernelRoutine;
+#else
+    PMLAS_NCHWC_CONV_KERNEL_ROUTINE ConvKernelRoutine = MlasNchwcConvKernel;
+#endif
+
+    size_t OutputStart;
+    size_t OutputEnd;
+
+    MlasNchwcComputeInteriorRange(InputWidth, OutputWidth, KernelWidth, DilationWidth,
+        PaddingLeft, StrideWidth, &OutputStart, &OutputEnd);
+
+    size_t RowStart;
+    size_t RowEnd;
+
+    MlasNchwcPartitionWork(WorkBlock, Index, &RowStart, &RowEnd);
+
+    for (size_t row = RowStart; row < RowEnd; row++) {
+
+        const size_t oh = row % OutputHeight;
+        const size_t ob = ((row / OutputHeight) % OutputChannelGroups) * OutputChannelBlocksPerRow;
+        const size_t batch = row / (OutputHeight * OutputChannelGroups);
+
+        const size_t FilterBlockCount = (std::min)(OutputChannelBlocksPerRow, OutputChannelBlocks - ob);
+
+        //
+        // Clip the kernel rows to the rows of the input tensor.
+        //
+
+        size_t khStart;
+        size_t khEnd;
+
+        MlasNchwcComputeKernelRange(oh * StrideHeight, InputHeight, KernelHeight,
+            DilationHeight, PaddingTop, &khStart, &khEnd);
+
+        const float* input = WorkBlock->Input + batch * InputChannelBlocks * InputBlockSize;
+        const float* filter = WorkBlock->Filter + ob * FilterOutputBlockSize;
+        const float* bias = (WorkBlock->Bias != nullptr) ? WorkBlock->Bias + ob * BlockSize : nullptr;
+        float* output = WorkBlock->Output + (batch * OutputChannelBlocks + ob) * OutputBlockSize +
+            oh * OutputWidth * BlockSize;
+
+        if (khStart < khEnd) {
+            input += (oh * StrideHeight + khStart * DilationHeight - PaddingTop) * InputWidth * BlockSize;
+            filter += khStart * Parameters.FilterRowStride;
+        }
+
+        const size_t ClippedKernelHeight = khEnd - khStart;
+
+        size_t ow = 0;
+
+        while (ow < OutputWidth) {
+
+            if (ow >= OutputStart && ow < OutputEnd) {
+
+                //
+                // Compute a run of output positions without bounds checks.
+                //
+
+                const size_t OutputCount = (std::min)(size_t(MLAS_NCHWC_CONV_OUTPUT_TILE), OutputEnd - ow);
+
+                ConvKernelRoutine(&Parameters, input + (ow * StrideWidth - PaddingLeft) * BlockSize,
+                    filter, bias, output + ow * BlockSize, FilterBlockCount, OutputCount,
+                    ClippedKernelHeight, KernelWidth);
+
+                ow += OutputCount;
+
+            } else {
+
+                //
+                // Compute a single output position with the kernel columns
+                // clipped to the columns of the input tensor.
+                //
+
+                size_t kwStart;
+                size_t kwEnd;
+
+                MlasNchwcComputeKernelRange(ow * StrideWidth, InputWidth, KernelWidth,
+                    DilationWidth, PaddingLeft, &kwStart, &kwEnd);
+
+                const float* in = input;
+                const float* f = filter;
+
+                if (kwStart < kwEnd) {
+                    in += (ow * StrideWidth + kwStart * DilationWidth - PaddingLeft) * BlockSize;
+                    f += kwStart * BlockSize * BlockSize;
+                }
+
+                ConvKernelRoutine(&Parameters, in, f, bias, output + ow * BlockSize,
+                    FilterBlockCount, 1, ClippedKernelHeight, kwEnd - kwStart);
+
+                ow++;
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasNchwcConv(
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the two dimensional convolution operation for
+    tensors in the NCHWc layout.
+
+Arguments:
+
+    InputShape - Supplies the shape of the input tensor in NCHW order. The
+        channel count must be a multiple of the block size.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of padding elements at the edge of the
+        input tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor in NCHW order. The
+        channel count must be a multiple of the block size.
+
+    Input - Supplies the input tensor in the NCHWc layout.
+
+    Filter - Supplies the filter tensor reordered by MlasReorderFilterOIHWBiBo.
+
+    Bias - Optionally supplies the bias vector.
+
+    Output - Supplies the output tensor in the NCHWc layout.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NCHWC_WORK_BLOCK WorkBlock;
+
+    MlasNchwcPrepareWorkBlock(&WorkBlock, InputShape, KernelShape, DilationShape,
+        Padding, StrideShape, OutputShape, MLAS_NCHWC_CONV_FILTER_BLOCKS);
+
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.Output = Output;
+
+    MlasExecuteThreaded(MlasNchwcConvThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+}
+
+void
+MlasNchwcPoolThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    NCHWc pooling operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_NCHWC_WORK_BLOCK* WorkBlock = (const MLAS_NCHWC_WORK_BLOCK*)Context;
+
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t InputHeight = WorkBlock->InputShape[0];
+    const size_t InputWidth = WorkBlock->InputShape[1];
+    const size_t OutputHeight = WorkBlock->OutputShape[0];
+    const size_t OutputWidth = WorkBlock->OutputShape[1];
+
+    const size_t KernelHeight = WorkBlock->KernelShape[0];
+    const size_t KernelWidth = WorkBlock->KernelShape[1];
+    const size_t PaddingTop = WorkBlock->Padding[0];
+    const size_t PaddingLeft = WorkBlock->Padding[1];
+    const size_t StrideHeight = WorkBlock->StrideShape[0];
+    const size_t StrideWidth = WorkBlock->StrideShape[1];
+
+    const size_t InputBlockSize = InputHeight * InputWidth * BlockSize;
+    const size_t OutputBlockSize = OutputHeight * OutputWidth * BlockSize;
+
+    const MLAS_POOLING_KIND PoolingKind = WorkBlock->PoolingKind;
+
+    const MLAS_FLOAT32X4 KernelSizeVector = MlasBroadcastFloat32x4(float(KernelHeight * KernelWidth));
+
+    size_t RowStart;
+    size_t RowEnd;
+
+    MlasNchwcPartitionWork(WorkBlock, Index, &RowStart, &RowEnd);
+
+    for (size_t row = RowStart; row < RowEnd; row++) {
+
+        const size_t oh = row % OutputHeight;
+        const size_t channel_block = row / OutputHeight;
+
+        const float* input = WorkBlock->Input + channel_block * InputBlockSize;
+        float* output = WorkBlock->Output + channel_block * OutputBlockSize + oh * OutputWidth * BlockSize;
+
+        //
+        // Clip the window to the rows of the input tensor.
+        //
+
+        const size_t ihOrigin = oh * StrideHeight;
+        const size_t ihStart = (ihOrigin > PaddingTop) ? ihOrigin - PaddingTop : 0;
+        const size_t ihEnd = (std::min)(ihOrigin + KernelHeight, PaddingTop + InputHeight) - PaddingTop;
+
+        for (size_t ow = 0; ow < OutputWidth; ow++) {
+
+            const size_t iwOrigin = ow * StrideWidth;
+            const size_t iwStart = (iwOrigin > PaddingLeft) ? iwOrigin - PaddingLeft : 0;
+            const size_t iwEnd = (std::min)(iwOrigin + KernelWidth, PaddingLeft + InputWidth) - PaddingLeft;
+
+            MLAS_FLOAT32X4 Reduction0;
+            MLAS_FLOAT32X4 Reduction1;
+
+            if (PoolingKind == MlasMaximumPooling) {
+                Reduction0 = MlasBroadcastFloat32x4(std::numeric_limits<float>::lowest());
+            } else {
+                Reduction0 = MlasZeroFloat32x4();
+            }
+
+            Reduction1 = Reduction0;
+
+            for (size_t ih = ihStart; ih < ihEnd; ih++) {
+
+                const float* in = input + (ih * InputWidth + iwStart) * BlockSize;
+
+                for (size_t iw = iwStart; iw < iwEnd; iw++) {
+
+                    MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(in);
+                    MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(in + 4);
+
+                    if (PoolingKind == MlasMaximumPooling) {
+                        Reduction0 = MlasMaximumFloat32x4(Reduction0, InputVector0);
+                        Reduction1 = MlasMaximumFloat32x4(Reduction1, InputVector1);
+                    } else {
+                        Reduction0 = MlasAddFloat32x4(Reduction0, InputVector0);
+                        Reduction1 = MlasAddFloat32x4(Reduction1, InputVector1);
+                    }
+
+                    in += BlockSize;
+                }
+            }
+
+            if (PoolingKind == MlasAveragePoolingExcludePad) {
+                MLAS_FLOAT32X4 CountVector = MlasBroadcastFloat32x4(float((ihEnd - ihStart) * (iwEnd - iwStart)));
+                Reduction0 = MlasDivideFloat32x4(Reduction0, CountVector);
+                Reduction1 = MlasDivideFloat32x4(Reduction1, CountVector);
+            } else if (PoolingKind == MlasAveragePoolingIncludePad) {
+                Reduction0 = MlasDivideFloat32x4(Reduction0, KernelSizeVector);
+                Reduction1 = MlasDivideFloat32x4(Reduction1, KernelSizeVector);
+            }
+
+            MlasStoreFloat32x4(output, Reduction0);
+            MlasStoreFloat32x4(output + 4, Reduction1);
+
+            output += BlockSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasNchwcPool(
+    MLAS_POOLING_KIND PoolingKind,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the two dimensional pooling operation for tensors
+    in the NCHWc layout.
+
+Arguments:
+
+    PoolingKind - Supplies the kind of pooling operation to perform.
+
+    InputShape - Supplies the shape of the input tensor in NCHW order. The
+        channel count must be a multiple of the block size.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    Padding - Supplies the number of padding elements at the edge of the
+        input tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the output tensor in NCHW order.
+
+    Input - Supplies the input tensor in the NCHWc layout.
+
+    Output - Supplies the output tensor in the NCHWc layout.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NCHWC_WORK_BLOCK WorkBlock;
+
+    MlasNchwcPrepareWorkBlock(&WorkBlock, InputShape, KernelShape, nullptr,
+        Padding, StrideShape, OutputShape, 1);
+
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = nullptr;
+    WorkBlock.Bias = nullptr;
+    WorkBlock.Output = Output;
+    WorkBlock.PoolingKind = PoolingKind;
+
+    MlasExecuteThreaded(MlasNchwcPoolThreaded, &WorkBlock, WorkBlock.TargetThreadCount);
+}
+
+void
+MLASCALL
+MlasReorderInput(
+    const int64_t* InputShape,
+    const float* S,
+    float* D
+    )
+/*++
+
+Routine Description:
+
+    This routine reorders a tensor from the NCHW layout to the NCHWc layout.
+
+Arguments:
+
+    InputShape - Supplies the shape of the tensor in NCHW order. The channel
+        count must be a multiple of the block size.
+
+    S - Supplies the tensor in the NCHW layout.
+
+    D - Supplies the buffer to receive the tensor in the NCHWc layout.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t ChannelBlocks = size_t(InputShape[0]) * size_t(InputShape[1]) / BlockSize;
+    const size_t SpatialSize = size_t(InputShape[2]) * size_t(InputShape[3]);
+
+    for (size_t cb = 0; cb < ChannelBlocks; cb++) {
+
+        for (size_t s = 0; s < SpatialSize; s++) {
+
+            for (size_t c = 0; c < BlockSize; c++) {
+                D[c] = S[c * SpatialSize + s];
+            }
+
+            D += BlockSize;
+        }
+
+        S += BlockSize * SpatialSize;
+    }
+}
+
+void
+MLASCALL
+MlasReorderOutput(
+    const int64_t* OutputShape,
+    const float* S,
+    float* D
+    )
+/*++
+
+Routine Description:
+
+    This routine reorders a tensor from the NCHWc layout to the NCHW layout.
+
+Arguments:
+
+    OutputShape - Supplies the shape of the tensor in NCHW order. The channel
+        count must be a multiple of the block size.
+
+    S - Supplies the tensor in the NCHWc layout.
+
+    D - Supplies the buffer to receive the tensor in the NCHW layout.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t ChannelBlocks = size_t(OutputShape[0]) * size_t(OutputShape[1]) / BlockSize;
+    const size_t SpatialSize = size_t(OutputShape[2]) * size_t(OutputShape[3]);
+
+    for (size_t cb = 0; cb < ChannelBlocks; cb++) {
+
+        for (size_t s = 0; s < SpatialSize; s++) {
+
+            for (size_t c = 0; c < BlockSize; c++) {
+                D[c * SpatialSize + s] = S[c];
+            }
+
+            S += BlockSize;
+        }
+
+        D += BlockSize * SpatialSize;
+    }
+}
+
+void
+MLASCALL
+MlasReorderFilterOIHWBiBo(
+    const int64_t* FilterShape,
+    const float* S,
+    float* D
+    )
+/*++
+
+Routine Description:
+
+    This routine reorders a convolution filter from the OIHW layout to the
+    layout used by MlasNchwcConv: blocks of output channels, then blocks of
+    input channels, then the kernel rows and columns, then the input and
+    output channels of the block.
+
+Arguments:
+
+    FilterShape - Supplies the shape of the filter in OIHW order. The output
+        and input channel counts must be multiples of the block size.
+
+    S - Supplies the filter in the OIHW layout.
+
+    D - Supplies the buffer to receive the reordered filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockSize = MLAS_NCHWC_BLOCK_SIZE;
+
+    const size_t OutputChannels = size_t(FilterShape[0]);
+    const size_t InputChannels = size_t(FilterShape[1]);
+    const size_t KernelSize = size_t(FilterShape[2]) * size_t(FilterShape[3]);
+
+    for (size_t ob = 0; ob < OutputChannels; ob += BlockSize) {
+
+        for (size_t ib = 0; ib < InputChannels; ib += BlockSize) {
+
+            for (size_t k = 0; k < KernelSize; k++) {
+
+                for (size_t ic = 0; ic < BlockSize; ic++) {
+
+                    for (size_t oc = 0; oc < BlockSize; oc++) {
+                        *D++ = S[((ob + oc) * InputChannels + (ib + ic)) * KernelSize + k];
+                    }
+                }
+            }
+        }
+    }
+}
@@ -55,6 +55,12 @@ Return Value:
     this->TransposePackB16x4Routine = MlasSgemmTransposePackB16x4Sse;
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
+    this->NchwcConvKernelRoutine = MlasNchwcConvKernel;
+#if defined(_M_AMD64)
+    this->ConvertHalfToFloatRoutine = MlasConvertHalfToFloatBuffer;
+#else
+    this->ConvertHalfToFloatRoutine = nullptr;
+#endif
 #endif
 
     //
@@ -113,6 +119,11 @@ Return Value:
 
                 this->LogisticKernelRoutine = MlasLogisticKernelFma3;
                 this->TanhKernelRoutine = MlasTanhKernelFma3;
+                this->NchwcConvKernelRoutine = MlasNchwcConvKernelFma3;
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->ConvertHalfToFloatRoutine = MlasConvertHalfToFloatBufferF16C;
+                }
 
             } else {
 
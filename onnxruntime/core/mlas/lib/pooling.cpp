@@ -269,76 +269,6 @@ struct MLAS_AVERAGE_POOLING
     };
 };
 
-template<typename PoolingType>
-void
-MlasPool1DKernel(
-    const MLAS_WORK_BLOCK* WorkBlock,
-    size_t ChannelCount,
-    const float* Input,
-    float* Output
-    )
-/*++
-
-Routine Description:
-
-    This routine implements the 1D pooling operation using generic constructs.
-
-Arguments:
-
-    WorkBlock - Supplies the structure that contains the pooling parameters.
-
-    ChannelCount - Supplies the number of channels to process.
-
-    Input - Supplies the input tensor.
-
-    Output - Supplies the output tensor.
-
-Return Value:
-
-    None.
-
---*/
-{
-    constexpr size_t WidthShapeIndex = 0;
-
-    const MLAS_POOLING_KIND PoolingKind = WorkBlock->PoolingKind;
-
-    const size_t InputWidth = WorkBlock->InputShape[WidthShapeIndex];
-    const size_t OutputWidth = WorkBlock->OutputShape[WidthShapeIndex];
-
-    const int64_t KernelWidth = WorkBlock->KernelShape[WidthShapeIndex];
-    const int64_t PaddingLeftWidth = WorkBlock->Padding[WidthShapeIndex];
-    const int64_t StrideWidth = WorkBlock->StrideShape[WidthShapeIndex];
-
-    for (size_t c = 0; c < ChannelCount; c++) {
-
-        for (size_t pw = 0; pw < OutputWidth; pw++) {
-
-            const int64_t iwStart64 = pw * StrideWidth - PaddingLeftWidth;
-            const int64_t iwEnd64 = iwStart64 + KernelWidth;
-
-            const size_t iwStart = size_t((std::max)(iwStart64, int64_t(0)));
-            const size_t iwEnd = size_t((std::min)(iwEnd64, int64_t(InputWidth)));
-
-            float m = PoolingType::InitialValue();
-
-            for (size_t iw = size_t(iwStart); iw < size_t(iwEnd); iw++) {
-                m = PoolingType::Reduce(m, Input[iw]);
-            }
-
-            if (PoolingKind == MlasAveragePoolingExcludePad) {
-                m = PoolingType::AveragePool(m, float(iwEnd - iwStart));
-            } else {
-                m = PoolingType::AveragePool(m, float(KernelWidth));
-            }
-
-            *Output++ = m;
-        }
-
-        Input += InputWidth;
-    }
-}
-
 template<typename PoolingType>
 void
 MlasPool2DKernel(
@@ -1126,23 +1056,22 @@ Return Value:
 }
 
 //
-// Stores pointers to the pooling kernel routines.
+// Stores pointers to the pooling kernel routines. A 1D pooling operation is
+// mapped to a 2D pooling operation by MlasPool, so the generic and vector
+// kernels are indexed by the number of dimensions minus two.
 //
 
-static const PMLAS_POOL_KERNEL_ROUTINE MlasPoolGenericKernels[][3] =
+static const PMLAS_POOL_KERNEL_ROUTINE MlasPoolGenericKernels[][2] =
 {
     {
-        MlasPool1DKernel<MLAS_MAXIMUM_POOLING>,
         MlasPool2DKernel<MLAS_MAXIMUM_POOLING>,
         MlasPool3DKernel<MLAS_MAXIMUM_POOLING>,
     },
     {
-        MlasPool1DKernel<MLAS_AVERAGE_POOLING>,
         MlasPool2DKernel<MLAS_AVERAGE_POOLING>,
         MlasPool3DKernel<MLAS_AVERAGE_POOLING>,
     },
     {
-        MlasPool1DKernel<MLAS_AVERAGE_POOLING>,
         MlasPool2DKernel<MLAS_AVERAGE_POOLING>,
         MlasPool3DKernel<MLAS_AVERAGE_POOLING>,
     },
@@ -1217,6 +1146,45 @@ Return Value:
 
 --*/
 {
+    //
+    // Map a 1D pooling operation to a 2D pooling operation with a unit height
+    // so that it can use the vectorized 2D kernels.
+    //
+
+    if (Dimensions == 1) {
+
+        const int64_t InputShape2D[4] = { InputShape[0], InputShape[1], 1, InputShape[2] };
+        const int64_t OutputShape2D[4] = { OutputShape[0], OutputShape[1], 1, OutputShape[2] };
+        int64_t KernelShape2D[2];
+        int64_t Padding2D[4];
+        int64_t StrideShape2D[2];
+
+        if (KernelShape != nullptr) {
+            KernelShape2D[0] = 1;
+            KernelShape2D[1] = KernelShape[0];
+        }
+
+        if (Padding != nullptr) {
+            Padding2D[0] = 0;
+            Padding2D[1] = Padding[0];
+            Padding2D[2] = 0;
+            Padding2D[3] = Padding[1];
+        }
+
+        if (StrideShape != nullptr) {
+            StrideShape2D[0] = 1;
+            StrideShape2D[1] = StrideShape[0];
+        }
+
+        MlasPool(PoolingKind, 2, InputShape2D,
+            (KernelShape != nullptr) ? KernelShape2D : nullptr,
+            (Padding != nullptr) ? Padding2D : nullptr,
+            (StrideShape != nullptr) ? StrideShape2D : nullptr,
+            OutputShape2D, Input, Output);
+
+        return;
+    }
+
     MLAS_WORK_BLOCK WorkBlock;
 
     WorkBlock.PoolingKind = PoolingKind;
@@ -1288,13 +1256,13 @@ Return Value:
     // in the reduction buffer.
     //
 
-    PMLAS_POOL_KERNEL_ROUTINE PoolKernelRoutine = MlasPoolGenericKernels[PoolingKind][Dimensions - 1];
+    PMLAS_POOL_KERNEL_ROUTINE PoolKernelRoutine = MlasPoolGenericKernels[PoolingKind][Dimensions - 2];
 
     if (InputAndKernelShapeMatch && AllStridesAreOne && AllPaddingIsZero) {
 
         PoolKernelRoutine = MlasPoolGlobalKernels[PoolingKind];
 
-    } else if (Dimensions >= 2 && WorkBlock.StrideShape[Dimensions - 1] <= 2 && AllKernelsAreSmall) {
+    } else if (WorkBlock.StrideShape[Dimensions - 1] <= 2 && AllKernelsAreSmall) {
 
         int64_t ReductionBufferRemaining = MLAS_POOL_REDUCTION_BUFFER_STACK - MLAS_POOL_REDUCTION_BUFFER_PADDING;
 
@@ -31,6 +31,7 @@ Abstract:
 // threads.
 //
 
+template<typename BType>
 struct MLAS_SGEMM_WORK_BLOCK {
     CBLAS_TRANSPOSE TransA;
     CBLAS_TRANSPOSE TransB;
@@ -40,12 +41,14 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    bool HasEpilogue;
     struct SEGMENT {
         size_t M;
         size_t N;
         const float* A;
-        const float* B;
+        const BType* B;
         float* C;
+        MLAS_SGEMM_EPILOGUE Epilogue;
     } Segments[MLAS_MAXIMUM_THREAD_COUNT];
 };
 
@@ -772,6 +775,370 @@ Return Value:
     }
 }
 
+inline
+void
+MlasSgemmConvertHalfToFloat(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a run of half-precision elements to single
+    precision using the best routine supported by the processor.
+
+Arguments:
+
+    Source - Supplies the address of the half-precision elements.
+
+    Destination - Supplies the address of the single-precision elements.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    PMLAS_CONVERT_HALF_TO_FLOAT_ROUTINE ConvertHalfToFloatRoutine =
+        MlasPlatform.ConvertHalfToFloatRoutine;
+
+    if (ConvertHalfToFloatRoutine != nullptr) {
+        ConvertHalfToFloatRoutine(Source, Destination, Count);
+        return;
+    }
+
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasConvertHalfToFloat(Source[i]);
+    }
+}
+
+void
+MlasSgemmCopyPackB(
+    float* D,
+    const MLAS_FP16* B,
+    size_t ldb,
+    size_t CountX,
+    size_t CountY
+    )
+/*++
+
+Routine Description:
+
+    This routine converts elements from the half-precision source matrix to
+    the single-precision destination packed buffer.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous for better locality inside the SGEMM kernels. Any remaining
+    columns less than 16 elements wide are zero-padded.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountX - Supplies the number of columns of the source matrix to copy.
+
+    CountY - Supplies the number of rows of the source matrix to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Convert data from matrix B into the destination buffer 16 columns at a
+    // time.
+    //
+
+    while (CountX >= 16) {
+
+        const MLAS_FP16* b = B;
+        size_t y = CountY;
+
+        do {
+
+            MlasSgemmConvertHalfToFloat(b, D, 16);
+
+            D += 16;
+            b += ldb;
+            y--;
+
+        } while (y > 0);
+
+        B += 16;
+        CountX -= 16;
+    }
+
+    //
+    // Special case the handling of the remaining columns less than 16 elements
+    // wide.
+    //
+
+    if (CountX > 0) {
+
+        size_t y = CountY;
+
+        do {
+
+            MlasSgemmConvertHalfToFloat(B, D, CountX);
+
+            for (size_t x = CountX; x < 16; x++) {
+                D[x] = 0.0f;
+            }
+
+            D += 16;
+            B += ldb;
+            y--;
+
+        } while (y > 0);
+    }
+}
+
+void
+MlasSgemmTransposePackB(
+    float* D,
+    const MLAS_FP16* B,
+    size_t ldb,
+    size_t CountY,
+    size_t CountX
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes elements from the half-precision source matrix to
+    the single-precision destination packed buffer.
+
+    Blocks of up to 16 rows by 16 columns are converted to a local buffer and
+    then transposed with the single-precision routine, which produces the
+    same packed layout as transposing the whole panel at once.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountY - Supplies the number of rows of the source matrix to transpose.
+
+    CountX - Supplies the number of columns of the source matrix to transpose.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float Block[16 * 16];
+
+    while (CountY > 0) {
+
+        size_t RowsThisPass = (CountY < 16) ? CountY : 16;
+
+        size_t ColumnsThisPass;
+
+        for (size_t x = 0; x < CountX; x += ColumnsThisPass) {
+
+            ColumnsThisPass = CountX - x;
+
+            if (ColumnsThisPass > 16) {
+                ColumnsThisPass = 16;
+            }
+
+            for (size_t y = 0; y < RowsThisPass; y++) {
+                MlasSgemmConvertHalfToFloat(B + y * ldb + x, Block + y * 16, ColumnsThisPass);
+            }
+
+            MlasSgemmTransposePackB(D, Block, 16, RowsThisPass, ColumnsThisPass);
+
+            D += 16 * ColumnsThisPass;
+        }
+
+        B += ldb * RowsThisPass;
+        CountY -= RowsThisPass;
+    }
+}
+
+inline
+bool
+MlasSgemmTryKernelM1(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* A,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C
+    )
+/*++
+
+Routine Description:
+
+    This routine attempts to compute a single row of the output matrix
+    directly from matrix B, without packing matrix B. The data from matrix B
+    is not referenced multiple times, so packing it would be a wasted memory
+    copy.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+Return Value:
+
+    Returns true if the row was computed, else false if the caller should use
+    the packed path.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
+
+    if (TransB == CblasNoTrans) {
+        SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
+    } else {
+        SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
+    }
+
+    if (SgemmKernelM1Routine != nullptr) {
+        SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+        return true;
+    }
+
+#else
+
+    MLAS_UNREFERENCED_PARAMETER(TransB);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(A);
+    MLAS_UNREFERENCED_PARAMETER(B);
+    MLAS_UNREFERENCED_PARAMETER(ldb);
+    MLAS_UNREFERENCED_PARAMETER(beta);
+    MLAS_UNREFERENCED_PARAMETER(C);
+
+#endif
+
+    return false;
+}
+
+inline
+bool
+MlasSgemmTryKernelM1(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* A,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    float* C
+    )
+/*++
+
+Routine Description:
+
+    This routine handles the single row case for a half-precision matrix B,
+    which must always be converted through the packed buffer.
+
+Arguments:
+
+    See the single-precision version of this routine.
+
+Return Value:
+
+    Returns false.
+
+--*/
+{
+    MLAS_UNREFERENCED_PARAMETER(TransB);
+    MLAS_UNREFERENCED_PARAMETER(N);
+    MLAS_UNREFERENCED_PARAMETER(K);
+    MLAS_UNREFERENCED_PARAMETER(A);
+    MLAS_UNREFERENCED_PARAMETER(B);
+    MLAS_UNREFERENCED_PARAMETER(ldb);
+    MLAS_UNREFERENCED_PARAMETER(beta);
+    MLAS_UNREFERENCED_PARAMETER(C);
+
+    return false;
+}
+
+inline
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    float* C,
+    size_t ldc,
+    size_t m,
+    size_t CountM,
+    size_t n,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the epilogue to a completed block of the output
+    matrix.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue of the SGEMM operation.
+
+    C - Supplies the address of the block of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    m - Supplies the first row of the block in matrix C.
+
+    CountM - Supplies the number of rows of the block.
+
+    n - Supplies the first column of the block in matrix C.
+
+    CountN - Supplies the number of columns of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* RowBias = (Epilogue->RowBias != nullptr) ? Epilogue->RowBias + m : nullptr;
+    const float* ColumnBias = (Epilogue->ColumnBias != nullptr) ? Epilogue->ColumnBias + n : nullptr;
+
+    MlasActivationWithBias(Epilogue->Activation, C, RowBias, ColumnBias, CountM, CountN, ldc);
+}
+
+template<typename BType>
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -782,11 +1149,12 @@ MlasSgemmOperation(
     float alpha,
     const float* A,
     size_t lda,
-    const float* B,
+    const BType* B,
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -795,6 +1163,10 @@ Routine Description:
     This routine implements the single precision matrix/matrix multiply
     operation (SGEMM).
 
+    The optional epilogue is applied to each block of rows of a slice of
+    matrix C as soon as the last slice along the K dimension has been
+    accumulated, while the block is still in the cache.
+
 Arguments:
 
     TransA - Supplies the transpose operation for matrix A.
@@ -814,7 +1186,7 @@ Arguments:
 
     lda - Supplies the first dimension of matrix A.
 
-    B - Supplies the address of matrix B.
+    B - Supplies the address of matrix B, in single or half precision.
 
     ldb - Supplies the first dimension of matrix B.
 
@@ -824,6 +1196,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the bias vectors and activation to apply
+        to matrix C.
+
 Return Value:
 
     None.
@@ -841,23 +1216,14 @@ Return Value:
 
     if (M == 1 && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
 
-#if defined(MLAS_TARGET_AMD64)
-
-        PMLAS_SGEMM_KERNEL_M1_ROUTINE SgemmKernelM1Routine;
+        if (MlasSgemmTryKernelM1(TransB, N, K, A, B, ldb, beta, C)) {
 
-        if (TransB == CblasNoTrans) {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1Routine;
-        } else {
-            SgemmKernelM1Routine = MlasPlatform.KernelM1TransposeBRoutine;
-        }
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, ldc, 0, 1, 0, N);
+            }
 
-        if (SgemmKernelM1Routine != nullptr) {
-            SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
             return;
         }
-
-#endif
-
     }
 
     //
@@ -922,7 +1288,8 @@ Return Value:
             }
 
             //
-            // Copy or transpose a panel of matrix B to a local packed buffer.
+            // Copy or transpose a panel of matrix B to a local packed buffer,
+            // converting half-precision elements to single precision.
             //
 
             if (TransB == CblasNoTrans) {
@@ -937,6 +1304,12 @@ Return Value:
 
             bool UseKernelZeroRoutine = (k == 0 && beta == 0.0f);
 
+            //
+            // Apply the epilogue to the rows completed by the last panel.
+            //
+
+            bool ApplyEpilogue = (Epilogue != nullptr && k + CountK == K);
+
 #if defined(MLAS_TARGET_AMD64_IX86)
             PMLAS_SGEMM_KERNEL_ROUTINE SgemmKernelRoutine =
                 UseKernelZeroRoutine ? MlasPlatform.KernelZeroRoutine : MlasPlatform.KernelAddRoutine;
@@ -950,6 +1323,7 @@ Return Value:
 
             size_t RowsRemaining = M;
             size_t RowsHandled;
+            size_t m = 0;
 
             if (TransA == CblasNoTrans) {
 
@@ -971,8 +1345,13 @@ Return Value:
                     }
 #endif
 
+                    if (ApplyEpilogue) {
+                        MlasSgemmApplyEpilogue(Epilogue, c, ldc, m, RowsHandled, n, CountN);
+                    }
+
                     c += ldc * RowsHandled;
                     a += lda * RowsHandled;
+                    m += RowsHandled;
 
                     RowsRemaining -= RowsHandled;
 
@@ -1018,8 +1397,13 @@ Return Value:
                         }
 #endif
 
+                        if (ApplyEpilogue) {
+                            MlasSgemmApplyEpilogue(Epilogue, c, ldc, m, RowsHandled, n, CountN);
+                        }
+
                         c += ldc * RowsHandled;
                         pa += CountK * RowsHandled;
+                        m += RowsHandled;
 
                         RowsTransposed -= RowsHandled;
 
@@ -1031,6 +1415,7 @@ Return Value:
     }
 }
 
+template<typename BType>
 void
 MlasSgemmOperationThreaded(
     void* Context,
@@ -1055,16 +1440,17 @@ Return Value:
 
 --*/
 {
-    MLAS_SGEMM_WORK_BLOCK* WorkBlock = (MLAS_SGEMM_WORK_BLOCK*)Context;
+    MLAS_SGEMM_WORK_BLOCK<BType>* WorkBlock = (MLAS_SGEMM_WORK_BLOCK<BType>*)Context;
 
-    MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+    typename MLAS_SGEMM_WORK_BLOCK<BType>::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
     MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
         Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
         Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
-        WorkBlock->ldc);
+        WorkBlock->ldc, WorkBlock->HasEpilogue ? &Segment->Epilogue : nullptr);
 }
 
+template<typename BType>
 inline
 bool
 MlasSgemmTryMultithread(
@@ -1076,11 +1462,12 @@ MlasSgemmTryMultithread(
     float alpha,
     const float* A,
     size_t lda,
-    const float* B,
+    const BType* B,
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1118,6 +1505,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the bias vectors and activation to apply
+        to matrix C.
+
 Return Value:
 
     Returns true if the operation was completed across multiple threads, else
@@ -1128,7 +1518,7 @@ Return Value:
 
 #if defined(MLAS_HAS_THREADING_SUPPORT)
 
-    MLAS_SGEMM_WORK_BLOCK WorkBlock;
+    MLAS_SGEMM_WORK_BLOCK<BType> WorkBlock;
     int32_t TargetThreadCount;
 
     //
@@ -1166,6 +1556,7 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.HasEpilogue = (Epilogue != nullptr);
 
     //
     // Segment the operation across multiple threads.
@@ -1200,6 +1591,13 @@ Return Value:
             WorkBlock.Segments[Index].B = B + n * pldb;
             WorkBlock.Segments[Index].C = C + n;
 
+            if (Epilogue != nullptr) {
+                WorkBlock.Segments[Index].Epilogue.Activation = Epilogue->Activation;
+                WorkBlock.Segments[Index].Epilogue.RowBias = Epilogue->RowBias;
+                WorkBlock.Segments[Index].Epilogue.ColumnBias =
+                    (Epilogue->ColumnBias != nullptr) ? Epilogue->ColumnBias + n : nullptr;
+            }
+
             Index++;
         }
 
@@ -1227,11 +1625,18 @@ Return Value:
             WorkBlock.Segments[Index].B = B;
             WorkBlock.Segments[Index].C = C + m * ldc;
 
+            if (Epilogue != nullptr) {
+                WorkBlock.Segments[Index].Epilogue.Activation = Epilogue->Activation;
+                WorkBlock.Segments[Index].Epilogue.RowBias =
+                    (Epilogue->RowBias != nullptr) ? Epilogue->RowBias + m : nullptr;
+                WorkBlock.Segments[Index].Epilogue.ColumnBias = Epilogue->ColumnBias;
+            }
+
             Index++;
         }
     }
 
-    MlasExecuteThreaded(MlasSgemmOperationThreaded, &WorkBlock, Index);
+    MlasExecuteThreaded(MlasSgemmOperationThreaded<BType>, &WorkBlock, Index);
 
     return true;
 
@@ -1254,6 +1659,7 @@ Return Value:
     MLAS_UNREFERENCED_PARAMETER(beta);
     MLAS_UNREFERENCED_PARAMETER(C);
     MLAS_UNREFERENCED_PARAMETER(ldc);
+    MLAS_UNREFERENCED_PARAMETER(Epilogue);
 
     return false;
 
@@ -1325,7 +1731,281 @@ Return Value:
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc)) {
-        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, nullptr)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, nullptr);
+    }
+}
+
+template<typename BType>
+void
+MlasSgemmWithEpilogue(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const BType* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) followed by an epilogue that is applied to each block
+    of the output matrix while the block is still in the cache.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Epilogue - Supplies the bias vectors and activation to apply to matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, Epilogue)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, Epilogue);
     }
 }
+
+//
+// Instantiate the single-precision operations used by the convolution
+// routines.
+//
+
+template
+void
+MlasSgemmOperation<float>(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
+    );
+
+template
+void
+MlasSgemmWithEpilogue<float>(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
+    );
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    const MLAS_ACTIVATION* Activation
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) fused with a bias addition and an activation:
+
+        C = Activation(alpha * op(A) * op(B) + beta * C + Bias)
+
+    The bias and activation are applied to each block of the output matrix
+    while the block is still in the cache, instead of as separate passes.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Optionally supplies the bias vector of N elements, which is added
+        to each row of matrix C.
+
+    Activation - Optionally supplies the activation to apply to matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SGEMM_EPILOGUE Epilogue;
+
+    Epilogue.Activation = Activation;
+    Epilogue.RowBias = nullptr;
+    Epilogue.ColumnBias = Bias;
+
+    MlasSgemmWithEpilogue(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, &Epilogue);
+}
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    const MLAS_ACTIVATION* Activation
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a matrix B stored in half precision, fused with a
+    bias addition and an activation:
+
+        C = Activation(alpha * op(A) * op(B) + beta * C + Bias)
+
+    The elements of matrix B are converted to single precision as the panels
+    of matrix B are packed, so no single-precision copy of matrix B is ever
+    materialized. This halves the memory and bandwidth used by weights that
+    are stored in half precision.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of the half-precision matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Optionally supplies the bias vector of N elements, which is added
+        to each row of matrix C.
+
+    Activation - Optionally supplies the activation to apply to matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SGEMM_EPILOGUE Epilogue;
+
+    Epilogue.Activation = Activation;
+    Epilogue.RowBias = nullptr;
+    Epilogue.ColumnBias = Bias;
+
+    MlasSgemmWithEpilogue(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, &Epilogue);
+}
@@ -30,22 +30,87 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(Softsign, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(Tanh, 6);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ThresholdedRelu, 1);
 
-template <>
-Status Sigmoid<float>::Compute(OpKernelContext* context) const {
+namespace {
+
+// computes the activation with MLAS, which vectorizes the function and splits large tensors across threads
+Status ComputeMlasActivation(OpKernelContext* context, const MLAS_ACTIVATION& activation) {
   const Tensor* X = context->Input<Tensor>(0);
   const auto& x_shape = X->Shape();
   Tensor* Y = context->Output(0, x_shape);
-  MlasComputeLogistic(X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
+  MlasComputeActivation(&activation, X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
   return Status::OK();
 }
 
+}  // namespace
+
+template <>
+Status Elu<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasEluActivation;
+  activation.Parameters.Elu.alpha = alpha_;
+  return ComputeMlasActivation(context, activation);
+}
+
+template <>
+Status HardSigmoid<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasHardSigmoidActivation;
+  activation.Parameters.HardSigmoid.alpha = alpha_;
+  activation.Parameters.HardSigmoid.beta = beta_;
+  return ComputeMlasActivation(context, activation);
+}
+
+template <>
+Status LeakyRelu<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasLeakyReluActivation;
+  activation.Parameters.LeakyRelu.alpha = alpha_;
+  return ComputeMlasActivation(context, activation);
+}
+
+template <>
+Status Relu<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasReluActivation;
+  return ComputeMlasActivation(context, activation);
+}
+
+template <>
+Status Selu<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasSeluActivation;
+  activation.Parameters.Selu.alpha = alpha_;
+  activation.Parameters.Selu.gamma = gamma_;
+  return ComputeMlasActivation(context, activation);
+}
+
+template <>
+Status Sigmoid<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasLogisticActivation;
+  return ComputeMlasActivation(context, activation);
+}
+
+template <>
+Status Softsign<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasSoftsignActivation;
+  return ComputeMlasActivation(context, activation);
+}
+
 template <>
 Status Tanh<float>::Compute(OpKernelContext* context) const {
-  const Tensor* X = context->Input<Tensor>(0);
-  const auto& x_shape = X->Shape();
-  Tensor* Y = context->Output(0, x_shape);
-  MlasComputeTanh(X->template Data<float>(), Y->template MutableData<float>(), x_shape.Size());
-  return Status::OK();
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasTanhActivation;
+  return ComputeMlasActivation(context, activation);
+}
+
+template <>
+Status ThresholdedRelu<float>::Compute(OpKernelContext* context) const {
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasThresholdedReluActivation;
+  activation.Parameters.ThresholdedRelu.alpha = alpha_;
+  return ComputeMlasActivation(context, activation);
 }
 
 }  // namespace onnxruntime
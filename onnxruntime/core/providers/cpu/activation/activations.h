@@ -31,6 +31,9 @@ class Elu final : public OpKernel {
   const float alpha_;
 };
 
+template <>
+Status Elu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class HardSigmoid final : public OpKernel {
  public:
@@ -51,6 +54,9 @@ class HardSigmoid final : public OpKernel {
   const float beta_;
 };
 
+template <>
+Status HardSigmoid<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class LeakyRelu final : public OpKernel {
  public:
@@ -68,6 +74,9 @@ class LeakyRelu final : public OpKernel {
   const float alpha_;
 };
 
+template <>
+Status LeakyRelu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class ParametricSoftplus final : public OpKernel {
  public:
@@ -102,6 +111,9 @@ class Relu final : public OpKernel {
   }
 };
 
+template <>
+Status Relu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class ScaledTanh final : public OpKernel {
  public:
@@ -142,6 +154,9 @@ class Selu final : public OpKernel {
   const float gamma_;
 };
 
+template <>
+Status Selu<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class Sigmoid final : public OpKernel {
  public:
@@ -174,6 +189,9 @@ class Softsign final : public OpKernel {
   }
 };
 
+template <>
+Status Softsign<float>::Compute(OpKernelContext* context) const;
+
 template <typename T>
 class Tanh final : public OpKernel {
  public:
@@ -207,4 +225,7 @@ class ThresholdedRelu final : public OpKernel {
   const float alpha_;
 };
 
+template <>
+Status ThresholdedRelu<float>::Compute(OpKernelContext* context) const;
+
 }  // namespace onnxruntime
@@ -13,6 +13,7 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  ArenaConfig arena_config;
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -26,7 +27,7 @@ class CPUExecutionProvider : public IExecutionProvider {
  public:
   explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info) {
     DeviceAllocatorRegistrationInfo device_info({OrtMemTypeDefault, [](int) {
-          return std::make_unique<CPUAllocator>(); }, std::numeric_limits<size_t>::max()});
+          return std::make_unique<CPUAllocator>(); }, std::numeric_limits<size_t>::max(), info.arena_config});
 #ifdef USE_JEMALLOC
     ORT_UNUSED_PARAMETER(info);
     //JEMalloc already has memory pool, so just use device allocator.
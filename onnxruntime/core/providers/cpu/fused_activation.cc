@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/fused_activation.h"
+
+namespace onnxruntime {
+
+Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation) {
+  activation.ActivationKind = MlasIdentityActivation;
+
+  std::string activation_type;
+  if (!info.GetAttr<std::string>("activation", &activation_type).IsOK() || activation_type.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<float> activation_params;
+  if (!info.GetAttrs<float>("activation_params", activation_params).IsOK()) {
+    activation_params.clear();
+  }
+
+  if (activation_type == "Relu") {
+    activation.ActivationKind = MlasReluActivation;
+  } else if (activation_type == "Tanh") {
+    activation.ActivationKind = MlasTanhActivation;
+  } else if (activation_type == "Sigmoid") {
+    activation.ActivationKind = MlasLogisticActivation;
+  } else if (activation_type == "LeakyRelu") {
+    activation.ActivationKind = MlasLeakyReluActivation;
+    // models fused before activation_params existed carry the slope in "alpha"
+    activation.Parameters.LeakyRelu.alpha =
+        activation_params.size() == 1 ? activation_params[0] : info.GetAttrOrDefault("alpha", 0.01f);
+  } else if (activation_type == "Clip") {
+    if (activation_params.size() != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Clip activation expects activation_params of [min, max]");
+    }
+    activation.ActivationKind = MlasClipActivation;
+    activation.Parameters.Clip.minimum = activation_params[0];
+    activation.Parameters.Clip.maximum = activation_params[1];
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Not implemented fused activation: ", activation_type);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
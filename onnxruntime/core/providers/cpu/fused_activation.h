@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+// Reads the "activation" attribute of a fused operator, along with its optional "activation_params", into the
+// MLAS activation that is applied to the output while it is still in the cache.
+// An operator without the attribute gets the identity activation.
+Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation);
+
+}  // namespace onnxruntime
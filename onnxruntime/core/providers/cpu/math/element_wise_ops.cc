@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/mlas/inc/mlas.h"
 #include <unsupported/Eigen/SpecialFunctions>
 
 namespace onnxruntime {
@@ -421,7 +422,7 @@ Status Exp<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().exp();
+  MlasComputeExp(X.Data<float>(), Y.MutableData<float>(), X.Shape().Size());
 
   return Status::OK();
 }
@@ -431,7 +432,7 @@ Status Log<float>::Compute(OpKernelContext* ctx) const {
   auto& X = *ctx->Input<Tensor>(0);
   auto& Y = *ctx->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().log();
+  MlasComputeLog(X.Data<float>(), Y.MutableData<float>(), X.Shape().Size());
 
   return Status::OK();
 }
@@ -888,7 +889,7 @@ Status Erf<float>::Compute(OpKernelContext* context) const {
   auto& X = *X_ptr;
   auto& Y = *context->Output(0, X.Shape());
 
-  EigenMap<float>(Y) = EigenMap<float>(X).array().erf();
+  MlasComputeErf(X.Data<float>(), Y.MutableData<float>(), X.Shape().Size());
 
   return Status::OK();
 }
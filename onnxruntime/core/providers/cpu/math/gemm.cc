@@ -5,10 +5,79 @@
 
 namespace onnxruntime {
 
+template <>
+Status Gemm<float, float, float, float>::Compute(OpKernelContext* context) const {
+  const auto X = context->Input<Tensor>(0);
+  const auto W = context->Input<Tensor>(1);
+  // C is optional for FusedGemm, which is then computed with beta ignored
+  const auto B = context->Input<Tensor>(2);
+  GemmHelper helper(X->Shape(), trans_A_ != CblasNoTrans, W->Shape(), trans_B_ != CblasNoTrans,
+                    B != nullptr ? B->Shape() : TensorShape({1}));
+
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  const int64_t M = helper.M();
+  const int64_t N = helper.N();
+  const int64_t K = helper.K();
+  auto Y = context->Output(0, TensorShape({M, N}));
+  float* y_data = Y->template MutableData<float>();
+
+  // a bias of (N,) or (1, N) is added by the GEMM epilogue together with the activation, as each block of the
+  // output is completed. other shapes are broadcast to the output up front and accumulated through beta.
+  const float* bias_data = nullptr;
+  float beta = B != nullptr ? beta_ : 0.0f;
+
+  if (beta != 0) {
+    const float* b_data = B->template Data<float>();
+    const auto& b_shape = B->Shape();
+
+    if (beta_ == 1 && b_shape.Size() == N &&
+        (b_shape.NumDimensions() == 1 || (b_shape.NumDimensions() == 2 && b_shape[0] == 1))) {
+      bias_data = b_data;
+      beta = 0;
+    } else {
+      auto output_mat = EigenMatrixMapRowMajor<float>(y_data, M, N);
+      // if B is (), (1,) or (1, 1), set the scalar
+      if (b_shape.Size() == 1) {
+        output_mat.setConstant(*b_data);
+      }
+      // B is (N,) or (1, N)
+      else if (b_shape.NumDimensions() == 1 || b_shape[0] == 1) {
+        output_mat = ConstEigenVectorMap<float>(b_data, N).transpose().replicate(M, 1);
+      }
+      // B is (M, 1)
+      else if (b_shape[1] == 1) {
+        output_mat = ConstEigenVectorMap<float>(b_data, M).replicate(1, N);
+      }
+      // B is (M, N), no broadcast needed.
+      else {
+        output_mat = ConstEigenMatrixMapRowMajor<float>(b_data, M, N);
+      }
+    }
+  }
+
+  const auto lda = static_cast<size_t>(trans_A_ == CblasNoTrans ? K : M);
+  const auto ldb = static_cast<size_t>(trans_B_ == CblasNoTrans ? N : K);
+
+  // float16 weights of FusedGemm are converted to float as MLAS packs them, without a float copy of the weights
+  if (W->DataType() == DataTypeImpl::GetType<MLFloat16>()) {
+    MlasSgemm(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+              alpha_, X->template Data<float>(), lda, &W->template Data<MLFloat16>()->val, ldb,
+              beta, y_data, static_cast<size_t>(N), bias_data, &activation_);
+  } else {
+    MlasSgemm(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+              alpha_, X->template Data<float>(), lda, W->template Data<float>(), ldb,
+              beta, y_data, static_cast<size_t>(N), bias_data, &activation_);
+  }
+
+  return Status::OK();
+}
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Gemm,
     7,
     9,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float, float, float, float>);
-}
\ No newline at end of file
+}  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 #include "gemm_helper.h"
 
 namespace onnxruntime {
@@ -15,7 +16,7 @@ template <typename T_X,
           typename T_W,
           typename T_B,
           typename T_Y>
-class Gemm final : public OpKernel {
+class Gemm : public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : OpKernel(info) {
     int64_t temp;
@@ -27,6 +28,8 @@ class Gemm final : public OpKernel {
 
     ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+    activation_.ActivationKind = MlasIdentityActivation;
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -107,6 +110,10 @@ class Gemm final : public OpKernel {
     return Status::OK();
   }
 
+ protected:
+  // applied to the output together with the bias, set by FusedGemm
+  MLAS_ACTIVATION activation_;
+
  private:
   CBLAS_TRANSPOSE trans_A_;
   CBLAS_TRANSPOSE trans_B_;
@@ -114,4 +121,7 @@ class Gemm final : public OpKernel {
   float beta_;
 };
 
+template <>
+Status Gemm<float, float, float, float>::Compute(OpKernelContext* context) const;
+
 }  // namespace onnxruntime
@@ -5,6 +5,16 @@
 
 namespace onnxruntime {
 
+template <>
+const float* Conv<float>::GetTransformedFilter(const MLAS_CONV_PARAMETERS& parameters, const Tensor& W) const {
+  std::lock_guard<std::mutex> lock(transformed_filter_mutex_);
+  if (transformed_filter_ == nullptr) {
+    transformed_filter_.reset(new float[MlasConvGetTransformedFilterSize(&parameters)]);
+    MlasConvTransformFilter(&parameters, W.template Data<float>(), transformed_filter_.get());
+  }
+  return transformed_filter_.get();
+}
+
 template <>
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
@@ -60,7 +70,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
 
   const size_t kernel_rank = kernel_shape.size();
 
-  if (kernel_rank == 2 || kernel_rank == 3) {
+  // MLAS handles 1D convolutions by mapping them to 2D with a unit height
+  if (kernel_rank >= 1 && kernel_rank <= 3) {
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
     MlasConvPrepare(&Parameters,
@@ -75,8 +86,14 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     strides.data(),
                     output_shape.GetDims().data(),
                     static_cast<size_t>(M / group_),
+                    &activation_,
                     &WorkingBufferSize);
 
+    // transform a constant filter once instead of on every run, e.g. for the Winograd algorithm
+    if (filter_is_constant_ && MlasConvGetTransformedFilterSize(&Parameters) > 0) {
+      MlasConvSetTransformedFilter(&Parameters, GetTransformedFilter(Parameters, *W), &WorkingBufferSize);
+    }
+
     auto working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * WorkingBufferSize) : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
 
@@ -87,9 +104,6 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
              static_cast<float*>(working_buffer.get()),
              Ydata);
 
-    //TODO: this will be replaced with Tracy's changes.
-    fuse_activation(activation_, Ydata, Y->Shape().Size(), alpha_);
-
   } else {
     const int64_t input_image_size = input_shape.Size();
     const int64_t output_image_size = output_shape.Size();
@@ -138,13 +152,9 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
             &CPUMathUtil::Instance());
       }
 
-      if (B != nullptr) {
-        auto Ymatrix = EigenMatrixMap<float>(Ydata, output_image_size, M);
-        auto Bvec = ConstEigenVectorMap<float>(B->template Data<float>(), M);
-        Ymatrix.rowwise() += Bvec.transpose();
-      }
-
-      fuse_activation(activation_, Ydata, Y_offset * group_, alpha_);
+      // add the bias and apply the activation in one pass over the output
+      MlasActivation(&activation_, Ydata, B != nullptr ? B->template Data<float>() : nullptr,
+                     static_cast<size_t>(M), static_cast<size_t>(output_image_size), static_cast<size_t>(output_image_size));
 
       Xdata += X_offset * group_;
       Ydata += Y_offset * group_;
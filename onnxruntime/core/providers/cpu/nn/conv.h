@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <mutex>
 #include "core/providers/cpu/nn/conv_base.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -25,9 +27,25 @@ template <typename T>
 class Conv : public OpKernel, public ConvBase {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {
+    const Tensor* W;
+    filter_is_constant_ = info.TryGetConstantInput(1, &W);
+    activation_.ActivationKind = MlasIdentityActivation;
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ protected:
+  // applied to the output together with the bias, set by FusedConv
+  MLAS_ACTIVATION activation_;
+
+ private:
+  // Returns the constant filter transformed for the MLAS algorithm in parameters, transforming it on first use.
+  // The transform only depends on the filter and the group count, so it is shared by all input shapes.
+  const float* GetTransformedFilter(const MLAS_CONV_PARAMETERS& parameters, const Tensor& W) const;
+
+  bool filter_is_constant_{false};
+  mutable std::mutex transformed_filter_mutex_;
+  mutable std::unique_ptr<float[]> transformed_filter_;
 };
 
 }  // namespace onnxruntime
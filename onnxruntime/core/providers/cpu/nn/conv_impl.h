@@ -24,20 +24,44 @@
 
 namespace onnxruntime {
 template <typename T>
-void fuse_activation(const std::string& activation, T* y_data, size_t size, float alpha) {
+void fuse_activation(const MLAS_ACTIVATION& activation, T* y_data, size_t size) {
   EigenVectorArrayMap<T> y_vec(y_data, size);
-  if (activation.empty()) {
-    return;
-  } else if (activation == "Relu") {
-    y_vec = y_vec.cwiseMax(0);
-  } else if (activation == "Sigmoid") {
-    y_vec = (y_vec >= 0).select(1 / (1. + (-y_vec.abs()).exp()), 1 - 1 / (1. + (-y_vec.abs()).exp()));
-  } else if (activation == "Tanh") {
-    y_vec = y_vec.tanh();
-  } else if (activation == "LeakyRelu") {
-    y_vec = (y_vec >= 0).select(y_vec, (T)alpha * y_vec);
-  } else {
-    ORT_NOT_IMPLEMENTED("Not implemented fused activation: ", activation);
+  switch (activation.ActivationKind) {
+    case MlasIdentityActivation:
+      break;
+    case MlasReluActivation:
+      y_vec = y_vec.cwiseMax(0);
+      break;
+    case MlasLogisticActivation:
+      y_vec = (y_vec >= 0).select(1 / (1. + (-y_vec.abs()).exp()), 1 - 1 / (1. + (-y_vec.abs()).exp()));
+      break;
+    case MlasTanhActivation:
+      y_vec = y_vec.tanh();
+      break;
+    case MlasLeakyReluActivation:
+      y_vec = (y_vec >= 0).select(y_vec, (T)activation.Parameters.LeakyRelu.alpha * y_vec);
+      break;
+    case MlasClipActivation:
+      y_vec = y_vec.cwiseMax((T)activation.Parameters.Clip.minimum).cwiseMin((T)activation.Parameters.Clip.maximum);
+      break;
+    case MlasEluActivation:
+      y_vec = (y_vec >= 0).select(y_vec, (T)activation.Parameters.Elu.alpha * (y_vec.exp() - 1));
+      break;
+    case MlasSeluActivation:
+      y_vec = (T)activation.Parameters.Selu.gamma *
+              (y_vec > 0).select(y_vec, (T)activation.Parameters.Selu.alpha * (y_vec.exp() - 1));
+      break;
+    case MlasHardSigmoidActivation:
+      y_vec = ((T)activation.Parameters.HardSigmoid.alpha * y_vec + (T)activation.Parameters.HardSigmoid.beta)
+                  .cwiseMin(1)
+                  .cwiseMax(0);
+      break;
+    case MlasSoftsignActivation:
+      y_vec = y_vec / (1 + y_vec.abs());
+      break;
+    case MlasThresholdedReluActivation:
+      y_vec = (y_vec > (T)activation.Parameters.ThresholdedRelu.alpha).select(y_vec, 0);
+      break;
   }
 }
 
@@ -168,7 +192,7 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
       auto Bvec = ConstEigenVectorMap<T>(B->template Data<T>(), M);
       Ymatrix.rowwise() += Bvec.transpose();
     }
-    fuse_activation(activation_, Ydata, Y_offset * group_, alpha_);
+    fuse_activation(activation_, Ydata, Y_offset * group_);
 
     Xdata += X_offset * group_;
     Ydata += Y_offset * group_;
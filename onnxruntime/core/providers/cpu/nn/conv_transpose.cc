@@ -16,8 +16,7 @@
 /* Modifications Copyright (c) Microsoft. */
 
 #include "core/providers/cpu/nn/conv_transpose.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -85,11 +84,8 @@ Status ConvTransposeBase::PrepareForCompute(OpKernelContext* context, bool has_b
                            " group: ", group_);
   }
 
-  if (input_shape.NumDimensions() != 4) {
-    // This condition is not true for two tests in ONNX tests series:
-    // test_convtranspose_1d_cpu, test_convtranspose_3d_cpu.
-    // TODO: the error message should tell which operator raises it.
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input X must be 4-dimensional.",
+  if (input_shape.NumDimensions() < 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input X must be at least 3-dimensional.",
                            " X: ", X->Shape().ToString().c_str());
   }
 
@@ -108,8 +104,6 @@ Status ConvTransposeBase::PrepareForCompute(OpKernelContext* context, bool has_b
   }
 
   const int64_t N = input_shape[0];
-  const int64_t H = input_shape[2];
-  const int64_t W = input_shape[3];
   const int64_t num_output_channels_multiplier = F->Shape()[1];
   const int64_t num_output_channels = num_output_channels_multiplier * group_;
 
@@ -124,16 +118,24 @@ Status ConvTransposeBase::PrepareForCompute(OpKernelContext* context, bool has_b
 
   std::vector<int64_t> kernel_shape = ComputeKernelShape(F->Shape());
 
-  if (kernel_shape[0] != F->Shape()[2]) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "kernel height does not match filter height.",
-                           " kernel_height: ", kernel_shape[0],
-                           " filter_height: ", F->Shape()[2]);
+  const size_t rank = input_shape.NumDimensions() - 2;
+  static const char* const dim_names[] = {"width", "height", "depth"};
+
+  for (size_t i = 0; i < std::min<size_t>(kernel_shape.size(), rank); ++i) {
+    if (kernel_shape[i] != F->Shape()[i + 2]) {
+      // name the spatial dims from the innermost one: width, height, depth
+      const size_t name_index = rank - 1 - i;
+      const char* dim_name = name_index < 3 ? dim_names[name_index] : "dim";
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "kernel ", dim_name, " does not match filter ", dim_name, ".",
+                             " kernel_", dim_name, ": ", kernel_shape[i],
+                             " filter_", dim_name, ": ", F->Shape()[i + 2]);
+    }
   }
 
-  if (kernel_shape[1] != F->Shape()[3]) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "kernel width does not match filter width.",
-                           " kernel_width: ", kernel_shape[1],
-                           " filter_width: ", F->Shape()[3]);
+  if (kernel_shape.size() != rank) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "kernel_shape num_dims is not compatible with X num_dims.",
+                           " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
+                           " X: ", X->Shape().ToString().c_str());
   }
 
   std::vector<int64_t> output_padding(output_padding_);
@@ -155,7 +157,8 @@ Status ConvTransposeBase::PrepareForCompute(OpKernelContext* context, bool has_b
 
   std::vector<int64_t> Y_dims;
 
-  ComputePadsAndOutputShape(input_shape, num_output_channels, kernel_shape, strides, output_padding, &pads, &Y_dims);
+  ComputePadsAndOutputShape(input_shape, num_output_channels, kernel_shape, strides, dilations, output_padding,
+                            &pads, &Y_dims);
   TensorShape Yshape(Y_dims);
   Tensor* Y = context->Output(0, Yshape);
 
@@ -164,8 +167,7 @@ Status ConvTransposeBase::PrepareForCompute(OpKernelContext* context, bool has_b
   p.B = B;
   p.Y = Y;
   p.N = N;
-  p.H = H;
-  p.W = W;
+  p.input_shape = input_shape.Slice(2);
   p.num_input_channels = num_input_channels;
   p.num_output_channels = num_output_channels;
   p.kernel_shape = std::move(kernel_shape);
@@ -180,114 +182,81 @@ void ConvTransposeBase::ComputePadsAndOutputShape(
     const int64_t output_channel,
     const std::vector<int64_t>& kernel_shape,
     const std::vector<int64_t>& strides,
+    const std::vector<int64_t>& dilations,
     const std::vector<int64_t>& output_padding,
     std::vector<int64_t>* pads,
     std::vector<int64_t>* output_shape) const {
-  const int64_t N = input_shape[0];
-  const int64_t H = input_shape[2];
-  const int64_t W = input_shape[3];
-  int64_t output_height = -1, output_width = -1;
-  size_t output_shape_size = output_shape_.size();
-
-  if (output_shape_size != 0) {
-    output_height = output_shape_[output_shape_size - 2];
-    output_width = output_shape_[output_shape_size - 1];
-    ORT_ENFORCE(output_height >= H, "Output height cannot be smaller than input height.");
-    ORT_ENFORCE(output_width >= W, "Output width cannot be smaller than input width.");
-  }
+  const size_t rank = input_shape.NumDimensions() - 2;
+  const size_t output_shape_size = output_shape_.size();
+
+  output_shape->insert(output_shape->begin(), {input_shape[0], output_channel});
+
+  for (size_t dim = 0; dim < rank; ++dim) {
+    const int64_t in_size = input_shape[dim + 2];
+    int64_t out_size = -1;
+
+    // output_shape may list the full output dims or only the spatial dims
+    if (output_shape_size != 0) {
+      ORT_ENFORCE(output_shape_size >= rank, "output_shape has fewer dims than the input spatial dims.");
+      out_size = output_shape_[output_shape_size - rank + dim];
+      ORT_ENFORCE(out_size >= in_size, "Output dim cannot be smaller than input dim.");
+    }
 
-  ComputeTransposePadAndOutputShape(
-      H,
-      strides[0],
-      kernel_shape[0],
-      output_padding[0],
-      auto_pad_,
-      &pads->at(0),
-      &pads->at(2),
-      &output_height);
-
-  ComputeTransposePadAndOutputShape(
-      W,
-      strides[1],
-      kernel_shape[1],
-      output_padding[1],
-      auto_pad_,
-      &pads->at(1),
-      &pads->at(3),
-      &output_width);
-
-  output_shape->insert(output_shape->begin(), {N, output_channel, output_height, output_width});
+    ComputeTransposePadAndOutputShape(
+        in_size,
+        strides[dim],
+        dilations[dim] * (kernel_shape[dim] - 1) + 1,
+        output_padding[dim],
+        auto_pad_,
+        &pads->at(dim),
+        &pads->at(dim + rank),
+        &out_size);
+
+    output_shape->push_back(out_size);
+  }
 }
 
-template <typename T>
-Status ConvTranspose<T>::Compute(OpKernelContext* context) const {
+template <>
+Status ConvTranspose<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute(context, num_inputs == 3, p));
 
-  const int64_t input_image_size = p.H * p.W;
-  const int64_t X_offset = p.num_input_channels / group_ * input_image_size;
-  const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / group_;
-  const int64_t W_offset = p.F->Shape().Size() / group_;
-  const int64_t kernel_dim = p.num_output_channels / group_ * p.kernel_shape[0] * p.kernel_shape[1];
-  const int64_t output_image_size = p.Y->Shape()[2] * p.Y->Shape()[3];
+  const size_t rank = p.kernel_shape.size();
+  if (rank > 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "ConvTranspose only supports 1D, 2D and 3D inputs.",
+                           " X: ", p.X->Shape().ToString().c_str());
+  }
+
+  MLAS_CONV_TRANSPOSE_PARAMETERS Parameters;
+  size_t WorkingBufferSize;
+  MlasConvTransposePrepare(&Parameters,
+                           rank,
+                           static_cast<size_t>(p.N),
+                           static_cast<size_t>(group_),
+                           static_cast<size_t>(p.num_input_channels / group_),
+                           p.input_shape.GetDims().data(),
+                           p.kernel_shape.data(),
+                           p.dilations.data(),
+                           p.pads.data(),
+                           p.strides.data(),
+                           p.Y->Shape().GetDims().data() + 2,
+                           static_cast<size_t>(p.num_output_channels / group_),
+                           nullptr,
+                           &WorkingBufferSize);
 
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
-  auto col_data = alloc->Alloc(sizeof(T) * kernel_dim * p.H * p.W);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
-  T* col_buffer_data = static_cast<T*>(col_buffer.get());
-
-  const T* Xdata = p.X->template Data<T>();
-  const T* filter_data = p.F->template Data<T>();
-  T* Ydata = p.Y->template MutableData<T>();
-
-  for (auto image_id = 0; image_id < p.N; ++image_id) {
-    for (int group_id = 0; group_id < group_; ++group_id) {
-      // Weight term
-      math::Gemm<T, CPUMathUtil>(
-          CblasTrans,
-          CblasNoTrans,
-          kernel_dim,
-          input_image_size,
-          p.num_input_channels / group_,
-          1,
-          filter_data + group_id * W_offset,
-          Xdata + group_id * X_offset,
-          0,
-          col_buffer_data,
-          &CPUMathUtil::Instance());
-
-      // Col2im
-      math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
-          col_buffer_data,
-          p.num_output_channels / group_,
-          p.Y->Shape()[2],
-          p.Y->Shape()[3],
-          p.kernel_shape[0],
-          p.kernel_shape[1],
-          1,
-          1,
-          p.pads[0],
-          p.pads[1],
-          p.pads[2],
-          p.pads[3],
-          p.strides[0],
-          p.strides[1],
-          Ydata + group_id * Y_offset,
-          &CPUMathUtil::Instance());
-    }
+  auto working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * WorkingBufferSize) : nullptr;
+  BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
 
-    if (p.B != nullptr) {
-      auto Ymatrix = EigenMatrixMap<T>(Ydata, output_image_size, p.num_output_channels);
-      auto Bvec = ConstEigenVectorMap<T>(p.B->template Data<T>(), p.num_output_channels);
-      Ymatrix.rowwise() += Bvec.transpose();
-    }
-
-    Xdata += X_offset * group_;
-    Ydata += Y_offset * group_;
-  }
+  MlasConvTranspose(&Parameters,
+                    p.X->template Data<float>(),
+                    p.F->template Data<float>(),
+                    p.B != nullptr ? p.B->template Data<float>() : nullptr,
+                    static_cast<float*>(working_buffer.get()),
+                    p.Y->template MutableData<float>());
 
   return Status::OK();
 }
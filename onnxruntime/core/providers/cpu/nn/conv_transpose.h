@@ -35,8 +35,7 @@ class ConvTransposeBase : public ConvBase {
     const Tensor* B;
     Tensor* Y;
     int64_t N;
-    int64_t H;
-    int64_t W;
+    TensorShape input_shape;
     int64_t num_input_channels;
     int64_t num_output_channels;
     std::vector<int64_t> kernel_shape;
@@ -52,6 +51,7 @@ class ConvTransposeBase : public ConvBase {
       const int64_t output_channel,
       const std::vector<int64_t>& kernel_shape,
       const std::vector<int64_t>& strides,
+      const std::vector<int64_t>& dilations,
       const std::vector<int64_t>& output_padding,
       std::vector<int64_t>* pads,
       std::vector<int64_t>* output_shape) const;
@@ -90,9 +90,16 @@ Status Concat::Compute(OpKernelContext* ctx) const {
     auto input_axis_pitch = prep.axis_pitch;
     const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
     auto input_size = prep.tensor->Shape().Size();
+    uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+
+    // The allocation planner may have placed this input directly in its slice of the output,
+    // in which case there is nothing to copy.
+    if (input_size == input_axis_pitch && input == output + output_offset * element_bytes) {
+      output_offset += input_axis_pitch;
+      continue;
+    }
 
     // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
-    uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
     for (int idxCopy = 0; idxCopy < input_size / input_axis_pitch; ++idxCopy) {
       if (is_string_type) {
         for (int idxItem = 0; idxItem < input_axis_pitch; ++idxItem)
@@ -30,38 +30,56 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+// a run of consecutive indices that refer to consecutive blocks of the input
+struct GatherRun {
+  int64_t dst_index;
+  int64_t src_index;
+  int64_t count;
+};
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
                       const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
                       const TensorShape& input_data_shape, const int64_t axis) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
+  const int64_t axis_dim = input_data_shape[axis];
 
-  // Check the indices first in case there's a out of bound index.
+  // Check the indices and coalesce runs of consecutive indices in a single pass, so that
+  // sorted or contiguous lookups are copied with one memcpy per run instead of one per index.
   // We can't merge this code in the omp loop below as omp does not allow return in the loop
+  std::vector<GatherRun> runs;
   for (int64_t i = 0; i < N; ++i) {
     Tin idx = indices_data[i];
-    if (idx < 0 || idx >= input_data_shape[axis]) {
+    if (idx < 0 || idx >= axis_dim) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
-                             " data_dim=", input_data_shape[axis]);
+                             " data_dim=", axis_dim);
+    }
+    if (!runs.empty() && runs.back().src_index + runs.back().count == static_cast<int64_t>(idx)) {
+      ++runs.back().count;
+    } else {
+      runs.push_back({i, static_cast<int64_t>(idx), 1});
     }
   }
 
+  // split the work over both the outer batches and the runs, so that gathering along axis 0
+  // (e.g. an embedding lookup, where M is 1) is also spread across threads
+  const int64_t num_runs = static_cast<int64_t>(runs.size());
+  const int64_t total_runs = M * num_runs;
+
 #pragma omp parallel for
-  for (int64_t batch = 0; batch < M; ++batch) {
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    for (int64_t i = 0; i < N; ++i) {
-      Tin idx = indices_data[i];
-      const int64_t src_offset = src_offset_batch + idx * block_size;
-      const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-            reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-      } else {
-        memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
-      }
+  for (int64_t r = 0; r < total_runs; ++r) {
+    const int64_t batch = r / num_runs;
+    const GatherRun& run = runs[r % num_runs];
+    const int64_t src_offset = batch * data_batch_bytes + run.src_index * block_size;
+    const int64_t dst_offset = batch * gathered_batch_bytes + run.dst_index * block_size;
+
+    if (is_string_type) {
+      const std::string* src = reinterpret_cast<const std::string*>(src_base) + src_offset / element_bytes;
+      std::string* dst = reinterpret_cast<std::string*>(dst_base) + dst_offset / element_bytes;
+      std::copy(src, src + run.count * block_size / element_bytes, dst);
+    } else {
+      memcpy(dst_base + dst_offset, src_base + src_offset, run.count * block_size);
     }
   }
 
@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/upsample.h"
+#include "core/util/math_cpuonly.h"
 #include <math.h>  //for fabs
+#include <type_traits>
 
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -22,32 +24,6 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>()),
     Upsample<int32_t>);
 
-void upsampleNearest2x(
-    int64_t batch_size,
-    int64_t num_channels,
-    int64_t input_height,
-    int64_t input_width,
-    const float* input,
-    float* output) {
-  const int64_t output_height = input_height * 2;
-  const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const float v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
-      }
-      input += input_height * input_width;
-      output += output_height * output_width;
-    }
-  }
-}
-
 template <typename T>
 Status upsampleNearest(const T* input,
                        T* output,
@@ -58,20 +34,63 @@ Status upsampleNearest(const T* input,
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value is nullptr");
   if (input_shape.NumDimensions() != output_shape.NumDimensions())
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value's dimension mismatch");
-  auto n_dim = input_shape.NumDimensions();
-  for (size_t i = 0, size = output_shape.Size(); i < size; i++) {
-    size_t old_idx = 0;
-    size_t cur_idx = i;
+  const int64_t n_dim = static_cast<int64_t>(input_shape.NumDimensions());
+  if (n_dim == 0 || output_shape.Size() == 0)
+    return Status::OK();
 
-    int64_t base = 1;
-    for (int64_t j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
-      auto tmp = cur_idx % output_shape[j];
-      old_idx += (std::min(static_cast<int64_t>(tmp / scales[j]), input_shape[j] - 1)) * base;
-      base *= input_shape[j];
-      cur_idx /= output_shape[j];
+  // map every output coordinate to the offset of its source element along that dim once,
+  // instead of recomputing the indices with division and modulo for every output element
+  std::vector<std::vector<int64_t>> input_offsets(n_dim);
+  int64_t input_pitch = 1;
+  for (int64_t j = n_dim - 1; j >= 0; j--) {
+    std::vector<int64_t>& offsets = input_offsets[j];
+    offsets.resize(output_shape[j]);
+    for (int64_t i = 0; i < output_shape[j]; i++) {
+      offsets[i] = std::min(static_cast<int64_t>(i / scales[j]), input_shape[j] - 1) * input_pitch;
     }
+    input_pitch *= input_shape[j];
+  }
 
-    output[i] = input[old_idx];
+  const int64_t output_width = output_shape[n_dim - 1];
+  const int64_t output_height = n_dim >= 2 ? output_shape[n_dim - 2] : 1;
+  const int64_t num_planes = output_shape.Size() / (output_height * output_width);
+  const std::vector<int64_t>& col_offsets = input_offsets[n_dim - 1];
+  bool copy_cols = output_width == input_shape[n_dim - 1];
+  for (int64_t x = 0; copy_cols && x < output_width; x++) {
+    copy_cols = col_offsets[x] == x;
+  }
+
+#pragma omp parallel for
+  for (int64_t plane = 0; plane < num_planes; plane++) {
+    int64_t input_plane_offset = 0;
+    int64_t outer = plane;
+    for (int64_t j = n_dim - 3; j >= 0; j--) {
+      input_plane_offset += input_offsets[j][outer % output_shape[j]];
+      outer /= output_shape[j];
+    }
+
+    T* output_row = output + plane * output_height * output_width;
+    int64_t prev_row_offset = -1;
+
+    for (int64_t y = 0; y < output_height; y++, output_row += output_width) {
+      const int64_t row_offset = n_dim >= 2 ? input_offsets[n_dim - 2][y] : 0;
+
+      // rows that read the same source row as the previous one are replicated with a block copy
+      if (row_offset == prev_row_offset) {
+        memcpy(output_row, output_row - output_width, output_width * sizeof(T));
+        continue;
+      }
+      prev_row_offset = row_offset;
+
+      const T* input_row = input + input_plane_offset + row_offset;
+      if (copy_cols) {
+        memcpy(output_row, input_row, output_width * sizeof(T));
+      } else {
+        for (int64_t x = 0; x < output_width; x++) {
+          output_row[x] = input_row[col_offsets[x]];
+        }
+      }
+    }
   }
   return Status::OK();
 }
@@ -145,47 +164,93 @@ void upsampleBilinear(
   int64_t output_width = static_cast<int64_t>(input_width * width_scale);
   int64_t output_height = static_cast<int64_t>(input_height * height_scale);
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
-        const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-        const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-        float dy1 = fabs(in_y - in_y1);
-        float dy2 = fabs(in_y - in_y2);
-        if (in_y1 == in_y2) {
-          dy1 = 0.5f;
-          dy2 = 0.5f;
-        }
+  // the source rows/columns and interpolation weights only depend on the output coordinate,
+  // so compute them once for all planes
+  std::vector<int64_t> in_y1(output_height), in_y2(output_height);
+  std::vector<float> dy1(output_height), dy2(output_height);
+  for (int64_t y = 0; y < output_height; ++y) {
+    float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
+    in_y1[y] = std::min(static_cast<int64_t>(in_y), input_height - 1);
+    in_y2[y] = std::min(in_y1[y] + 1, input_height - 1);
+    dy1[y] = fabs(in_y - in_y1[y]);
+    dy2[y] = fabs(in_y - in_y2[y]);
+    if (in_y1[y] == in_y2[y]) {
+      dy1[y] = 0.5f;
+      dy2[y] = 0.5f;
+    }
+  }
 
-        const int64_t input_width_mul_y1 = input_width * in_y1;
-        const int64_t input_width_mul_y2 = input_width * in_y2;
+  std::vector<int64_t> in_x1(output_width), in_x2(output_width);
+  std::vector<float> dx1(output_width), dx2(output_width);
+  for (int64_t x = 0; x < output_width; ++x) {
+    float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
+    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
+    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
+    dx1[x] = std::abs(in_x - in_x1[x]);
+    dx2[x] = std::abs(in_x - in_x2[x]);
+    if (in_x1[x] == in_x2[x]) {
+      dx1[x] = 0.5f;
+      dx2[x] = 0.5f;
+    }
+  }
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
-          const int64_t in_x1 = std::min(static_cast<int64_t>(in_x), input_width - 1);
-          const int64_t in_x2 = std::min(in_x1 + 1, input_width - 1);
-
-          float dx1 = std::abs(in_x - in_x1);
-          float dx2 = std::abs(in_x - in_x2);
-          if (in_x1 == in_x2) {
-            dx1 = 0.5f;
-            dx2 = 0.5f;
+  const int64_t num_planes = batch_size * num_channels;
+
+#pragma omp parallel
+  {
+    // source rows interpolated along x, cached so that adjacent output rows reading
+    // the same source rows don't interpolate them again. one buffer per thread is reused for its planes.
+    std::vector<float> row_buffer(std::is_same<T, float>::value ? 2 * output_width : 0);
+    float* rows[2] = {row_buffer.data(), row_buffer.data() + row_buffer.size() / 2};
+
+#pragma omp for
+    for (int64_t plane = 0; plane < num_planes; ++plane) {
+      const T* X = Xdata + plane * input_height * input_width;
+      T* Y = Ydata + plane * output_height * output_width;
+
+      if (!std::is_same<T, float>::value) {
+        // integer outputs are truncated, so keep the original order of operations for them
+        for (int64_t y = 0; y < output_height; ++y) {
+          const T* X_row1 = X + in_y1[y] * input_width;
+          const T* X_row2 = X + in_y2[y] * input_width;
+          for (int64_t x = 0; x < output_width; ++x) {
+            Y[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X_row1[in_x1[x]] +
+                                                     dx1[x] * dy2[y] * X_row1[in_x2[x]] +
+                                                     dx2[x] * dy1[y] * X_row2[in_x1[x]] +
+                                                     dx1[x] * dy1[y] * X_row2[in_x2[x]]);
           }
+        }
+        continue;
+      }
 
-          T X11 = Xdata[input_width_mul_y1 + in_x1];
-          T X21 = Xdata[input_width_mul_y1 + in_x2];
-          T X12 = Xdata[input_width_mul_y2 + in_x1];
-          T X22 = Xdata[input_width_mul_y2 + in_x2];
+      int64_t cached_rows[2] = {-1, -1};
 
-          Ydata[output_width * y + x] = static_cast<T>(dx2 * dy2 * X11 +
-                                                       dx1 * dy2 * X21 +
-                                                       dx2 * dy1 * X12 +
-                                                       dx1 * dy1 * X22);
+      auto interpolate_row = [&](int64_t in_y, int64_t keep_y) -> const float* {
+        for (int i = 0; i < 2; ++i) {
+          if (cached_rows[i] == in_y) {
+            return rows[i];
+          }
         }
+        const int slot = cached_rows[0] == keep_y ? 1 : 0;
+        const T* X_row = X + in_y * input_width;
+        float* row = rows[slot];
+        for (int64_t x = 0; x < output_width; ++x) {
+          row[x] = dx2[x] * X_row[in_x1[x]] + dx1[x] * X_row[in_x2[x]];
+        }
+        cached_rows[slot] = in_y;
+        return row;
+      };
+
+      for (int64_t y = 0; y < output_height; ++y) {
+        const float* row1 = interpolate_row(in_y1[y], in_y2[y]);
+        const float* row2 = interpolate_row(in_y2[y], in_y1[y]);
+
+        // blend the two rows along y with vector operations
+        EigenVectorArrayMap<T>(Y + y * output_width, output_width) =
+            (dy2[y] * ConstEigenVectorArrayMap<float>(row1, output_width) +
+             dy1[y] * ConstEigenVectorArrayMap<float>(row2, output_width))
+                .template cast<T>();
       }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
     }
   }
 }
@@ -3,7 +3,12 @@
 
 #pragma once
 #include "core/common/common.h"
+#include "core/common/logging/logging.h"
 #include "mkldnn.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <list>
 #include <unordered_map>
 
 namespace onnxruntime {
@@ -23,49 +28,124 @@ static mkldnn::engine& GetEngine() {
   return cpu_engine;
 }
 
-static void AddDimsToKey(std::string& key, const mkldnn::memory::dims& dims) {
-  key.append(1, '#');
-  for (size_t i = 0; i < dims.size(); i++) {
-    key.append(std::to_string(dims[i]));
-    key.append(1, '_');
+// Key of a primitive in a PrimitivePool, built from the parameters of the primitive.
+// The values are kept in a fixed size array, so building and looking up a key doesn't allocate.
+class PrimitiveKey {
+ public:
+  void Append(int64_t value) {
+    ORT_ENFORCE(size_ < kMaxValues, "Too many values in the primitive key.");
+    values_[size_++] = value;
   }
-  key.append(1, '#');
-}
+
+  void AppendFloat(float value) {
+    int32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    Append(bits);
+  }
+
+  void Append(const mkldnn::memory::dims& dims) {
+    Append(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) {
+      Append(static_cast<int64_t>(dim));
+    }
+  }
+
+  bool operator==(const PrimitiveKey& other) const {
+    return size_ == other.size_ && std::equal(values_.begin(), values_.begin() + size_, other.values_.begin());
+  }
+
+  size_t Hash() const {
+    size_t hash = 0;
+    for (size_t i = 0; i < size_; i++) {
+      hash ^= std::hash<int64_t>()(values_[i]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+
+ private:
+  static constexpr size_t kMaxValues = 64;
+  std::array<int64_t, kMaxValues> values_;
+  size_t size_{0};
+};
+
+struct PrimitiveKeyHash {
+  size_t operator()(const PrimitiveKey& key) const { return key.Hash(); }
+};
+
+// Counters of the primitive pool of one type on one thread.
+struct PrimitivePoolStats {
+  uint64_t hits{0};
+  uint64_t misses{0};
+  uint64_t evictions{0};
+};
 
 class PrimitiveBase {
  public:
   virtual ~PrimitiveBase() = default;
 };
 
-template <typename T>
+// Pool of the primitives of one type, keyed by their parameters.
+// For thread safety, and so concurrent sessions don't contend on a lock, each thread has its own pool.
+// A pool keeps the kPrimitivePoolCapacity most recently used primitives, so workloads with many different
+// shapes don't grow it forever. A primitive returned by the pool stays valid until the next SetPrimitive of the
+// same pool on the same thread, which may evict it.
+template <typename Primitive>
 class PrimitivePool {
  public:
-  PrimitivePool() = default;
-  ~PrimitivePool() = default;
+  static constexpr size_t kPrimitivePoolCapacity = 128;
 
-  void SetPrimitive(const std::string& key, std::unique_ptr<PrimitiveBase> primitive) {
-    auto& map = PrimitivePool<T>::GetMap();
-    auto iter = map.find(key);
-    // We should not find a primitive already using this key.
-    ORT_ENFORCE(iter == map.end(), "duplicate key: " + key);
-    map.insert(std::make_pair(key, std::move(primitive)));
+  static Primitive* GetPrimitive(const PrimitiveKey& key) {
+    auto& cache = GetCache();
+    auto iter = cache.map.find(key);
+    if (iter == cache.map.end()) {
+      cache.stats.misses++;
+      return nullptr;
+    }
+
+    cache.stats.hits++;
+    cache.lru.splice(cache.lru.begin(), cache.lru, iter->second);
+    return iter->second->second.get();
   }
 
-  PrimitiveBase* GetPrimitive(const std::string& key) {
-    const auto& map = PrimitivePool<T>::GetMap();
-    auto iter = map.find(key);
-    if (iter != map.end()) {
-      return iter->second.get();
-    } else {
-      return nullptr;
+  static Primitive* SetPrimitive(const PrimitiveKey& key, std::unique_ptr<Primitive> primitive) {
+    auto& cache = GetCache();
+    // We should not find a primitive already using this key.
+    ORT_ENFORCE(cache.map.find(key) == cache.map.end(), "duplicate primitive key");
+
+    if (cache.lru.size() >= kPrimitivePoolCapacity) {
+      cache.map.erase(cache.lru.back().first);
+      cache.lru.pop_back();
+
+      // evictions mean the shapes in use don't fit in the pool, so primitives get created again and again.
+      // log at powers of two so that a thrashing pool doesn't flood the log.
+      const uint64_t evictions = ++cache.stats.evictions;
+      if ((evictions & (evictions - 1)) == 0) {
+        LOGS_DEFAULT(INFO) << "MKL-DNN primitive pool of this thread is full. hits: " << cache.stats.hits
+                           << " misses: " << cache.stats.misses << " evictions: " << evictions;
+      }
     }
+
+    cache.lru.emplace_front(key, std::move(primitive));
+    cache.map.emplace(key, cache.lru.begin());
+    return cache.lru.front().second.get();
+  }
+
+  // the counters of the pool of the calling thread
+  static PrimitivePoolStats GetStats() {
+    return GetCache().stats;
   }
 
  private:
-  // For thread safety, the map needs to be kept in thread local storage.
-  static inline std::unordered_map<std::string, std::unique_ptr<PrimitiveBase>>& GetMap() {
-    static thread_local std::unordered_map<std::string, std::unique_ptr<PrimitiveBase>> map;
-    return map;
+  struct Cache {
+    // most recently used first
+    std::list<std::pair<PrimitiveKey, std::unique_ptr<Primitive>>> lru;
+    std::unordered_map<PrimitiveKey, decltype(lru.begin()), PrimitiveKeyHash> map;
+    PrimitivePoolStats stats;
+  };
+
+  static Cache& GetCache() {
+    static thread_local Cache cache;
+    return cache;
   }
 };
 
@@ -77,22 +157,16 @@ struct MemoryReorderParams {
   MemoryReorderParams(const mkldnn::memory& src, const mkldnn::memory& dst) : src(src), dst(dst) {}
 
   // Used as the key for MemoryReorder primitive reuse pool.
-  std::string ToString() const {
-    std::string key;
-    key.reserve(64);
-    key.append("reorder_");
-    const auto& src_desc = src.get_primitive_desc().desc().data;
-    const auto& dst_desc = dst.get_primitive_desc().desc().data;
-    mkldnn::memory::dims src_dims(src_desc.dims, &src_desc.dims[src_desc.ndims]);
-    mkldnn::memory::dims dst_dims(dst_desc.dims, &dst_desc.dims[dst_desc.ndims]);
-    key.append(std::to_string(src_desc.format));
-    key.append(1, '_');
-    key.append(std::to_string(dst_desc.data_type));
-    AddDimsToKey(key, src_dims);
-    key.append(std::to_string(dst_desc.format));
-    key.append(1, '_');
-    key.append(std::to_string(dst_desc.data_type));
-    AddDimsToKey(key, dst_dims);
+  PrimitiveKey ToKey() const {
+    PrimitiveKey key;
+    for (const auto* desc : {&src.get_primitive_desc().desc().data, &dst.get_primitive_desc().desc().data}) {
+      key.Append(static_cast<int64_t>(desc->format));
+      key.Append(static_cast<int64_t>(desc->data_type));
+      key.Append(static_cast<int64_t>(desc->ndims));
+      for (int i = 0; i < desc->ndims; i++) {
+        key.Append(static_cast<int64_t>(desc->dims[i]));
+      }
+    }
     return key;
   }
 };
@@ -138,30 +212,18 @@ class MemoryReorderPrimitive : public PrimitiveBase {
 };
 
 // Pool which allows for reuse of MKLDNN memory reorder primitives which are expensive to instantiate.
-// To address thread safety, the primitives are stored in a map on thread local storage.
 template <typename T>
-class MemoryReorderPrimitivePool : public PrimitivePool<T> {
+class MemoryReorderPrimitivePool : public PrimitivePool<MemoryReorderPrimitive> {
  public:
-  static MemoryReorderPrimitivePool& GetInstance() {
-    static MemoryReorderPrimitivePool pool;
-    return pool;
-  }
-
   static MemoryReorderPrimitive* Get(const MemoryReorderParams& params) {
-    MemoryReorderPrimitive* primitive = static_cast<MemoryReorderPrimitive*>(
-        MemoryReorderPrimitivePool<T>::GetInstance().GetPrimitive(params.ToString()));
+    const PrimitiveKey key = params.ToKey();
+    MemoryReorderPrimitive* primitive = GetPrimitive(key);
     if (primitive == nullptr) {
-      auto reorder_primitive = std::make_unique<MemoryReorderPrimitive>(params);
-      primitive = reorder_primitive.get();
-      MemoryReorderPrimitivePool<T>::GetInstance().SetPrimitive(params.ToString(), std::move(reorder_primitive));
+      primitive = SetPrimitive(key, std::make_unique<MemoryReorderPrimitive>(params));
     }
     primitive->SetMemory(params);
     return primitive;
   }
-
- private:
-  MemoryReorderPrimitivePool() = default;
-  ~MemoryReorderPrimitivePool() = default;
 };
 
 template <typename T>
@@ -7,7 +7,9 @@
 #include "core/framework/transformer_memcpy.h"
 #include "core/framework/memcpy.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/compute_capability.h"
 #include "mkldnn_fwd.h"
+#include "mkldnn_subgraph.h"
 
 namespace onnxruntime {
 namespace mkl_dnn {
@@ -60,6 +62,31 @@ Status MKLDNNExecutionProvider::CopyTensor(const Tensor& src, Tensor& dst) const
   return Status::OK();
 }
 
+std::vector<std::unique_ptr<ComputeCapability>>
+MKLDNNExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_viewer,
+                                       const std::vector<const KernelRegistry*>& kernel_registries) const {
+  auto single_nodes = IExecutionProvider::GetCapability(graph_viewer, kernel_registries);
+  std::unordered_set<NodeIndex> candidates;
+  for (const auto& capability : single_nodes) {
+    candidates.insert(capability->sub_graph->nodes[0]);
+  }
+
+  auto result = mkl_dnn::GetSubgraphCapabilities(graph_viewer, candidates);
+  std::unordered_set<NodeIndex> fused;
+  for (const auto& capability : result) {
+    fused.insert(capability->sub_graph->nodes.begin(), capability->sub_graph->nodes.end());
+  }
+
+  // the nodes that aren't part of a subgraph run with their own kernels
+  for (auto& capability : single_nodes) {
+    if (fused.count(capability->sub_graph->nodes[0]) == 0) {
+      result.push_back(std::move(capability));
+    }
+  }
+
+  return result;
+}
+
 namespace mkl_dnn {
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kMklDnnExecutionProvider, kOnnxDomain, 1, Conv);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kMklDnnExecutionProvider, kOnnxDomain, 7, Gemm);
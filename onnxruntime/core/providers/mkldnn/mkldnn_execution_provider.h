@@ -32,6 +32,12 @@ class MKLDNNExecutionProvider : public IExecutionProvider {
 
   Status CopyTensor(const Tensor& src, Tensor& dst) const override;
 
+  // Claims the nodes with a MKLDNN kernel, fusing connected Conv, Pool and LRN nodes into subgraphs that keep
+  // their activations in MKLDNN's blocked layouts.
+  std::vector<std::unique_ptr<ComputeCapability>>
+  GetCapability(const onnxruntime::GraphViewer& graph_viewer,
+                const std::vector<const KernelRegistry*>& kernel_registries) const override;
+
   const void* GetExecutionHandle() const noexcept override {
     return nullptr;
   }
@@ -0,0 +1,445 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef _WIN32
+#pragma warning(disable : 4244)
+#endif
+
+#include "core/providers/mkldnn/mkldnn_subgraph.h"
+
+#include <algorithm>
+
+#include "core/graph/function.h"
+#include "core/providers/mkldnn/mkldnn_common.h"
+
+namespace onnxruntime {
+namespace mkl_dnn {
+
+namespace {
+using NodeAttributesHelper = OpNodeProtoHelper<ProtoHelperNodeContext>;
+
+bool IsConstantInitializer(const GraphViewer& graph_viewer, const NodeArg* arg) {
+  const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+  return arg->Exists() && graph_viewer.GetInitializedTensor(arg->Name(), initializer);
+}
+
+// Whether the subgraph kernel supports <node>. The kernel only handles 2D spatial inputs and explicit padding.
+bool IsSubgraphNode(const GraphViewer& graph_viewer, const Node& node) {
+  if (node.Domain() != kOnnxDomain) {
+    return false;
+  }
+
+  const auto& op_type = node.OpType();
+  if (op_type != "Conv" && op_type != "MaxPool" && op_type != "AveragePool" && op_type != "LRN") {
+    return false;
+  }
+
+  const auto* input_shape = node.InputDefs()[0]->Shape();
+  if (input_shape == nullptr || input_shape->dim_size() != 4) {
+    return false;
+  }
+
+  ProtoHelperNodeContext context(node);
+  NodeAttributesHelper attributes(&context);
+  if (attributes.GetAttrOrDefault<std::string>("auto_pad", "NOTSET") != "NOTSET") {
+    return false;
+  }
+
+  if (op_type == "Conv") {
+    // the filters are reordered once, when the primitives are created
+    const auto input_defs = node.InputDefs();
+    if (!IsConstantInitializer(graph_viewer, input_defs[1])) {
+      return false;
+    }
+    if (input_defs.size() == 3 && input_defs[2]->Exists() && !IsConstantInitializer(graph_viewer, input_defs[2])) {
+      return false;
+    }
+  } else if (op_type == "MaxPool") {
+    const auto output_defs = node.OutputDefs();
+    if (output_defs.size() > 1 && output_defs[1]->Exists()) {
+      return false;
+    }
+    if (attributes.GetAttrOrDefault<int64_t>("storage_order", 0) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+mkldnn::memory::dims GetDims(const mkldnn::memory& memory) {
+  const auto& desc = memory.get_primitive_desc().desc().data;
+  return mkldnn::memory::dims(desc.dims, &desc.dims[desc.ndims]);
+}
+}  // namespace
+
+std::vector<std::unique_ptr<ComputeCapability>>
+GetSubgraphCapabilities(const GraphViewer& graph_viewer, const std::unordered_set<NodeIndex>& candidates) {
+  // the nodes that can be part of a subgraph, and the subgraph each one belongs to
+  std::unordered_map<NodeIndex, NodeIndex> subgraph_of;
+  std::unordered_map<std::string, NodeIndex> producers;
+  std::unordered_map<std::string, std::vector<NodeIndex>> consumers;
+  for (auto& node : graph_viewer.Nodes()) {
+    for (const auto* input : node.InputDefs()) {
+      if (input->Exists()) {
+        consumers[input->Name()].push_back(node.Index());
+      }
+    }
+    if (candidates.count(node.Index()) != 0 && node.GetExecutionProviderType().empty() &&
+        IsSubgraphNode(graph_viewer, node)) {
+      subgraph_of[node.Index()] = node.Index();
+      producers[node.OutputDefs()[0]->Name()] = node.Index();
+    }
+  }
+
+  auto find_subgraph = [&subgraph_of](NodeIndex index) {
+    while (subgraph_of[index] != index) {
+      index = subgraph_of[index] = subgraph_of[subgraph_of[index]];
+    }
+    return index;
+  };
+
+  // a node joins the subgraph of the node producing its input
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto index : order) {
+    if (subgraph_of.count(index) == 0) {
+      continue;
+    }
+    auto producer = producers.find(graph_viewer.GetNode(index)->InputDefs()[0]->Name());
+    if (producer != producers.end()) {
+      subgraph_of[find_subgraph(index)] = find_subgraph(producer->second);
+    }
+  }
+
+  std::unordered_map<NodeIndex, std::vector<NodeIndex>> subgraphs;
+  std::vector<NodeIndex> subgraph_roots;
+  for (auto index : order) {
+    if (subgraph_of.count(index) != 0) {
+      auto& nodes = subgraphs[find_subgraph(index)];
+      if (nodes.empty()) {
+        subgraph_roots.push_back(find_subgraph(index));
+      }
+      nodes.push_back(index);
+    }
+  }
+
+  std::unordered_set<std::string> graph_outputs;
+  for (const auto* output : graph_viewer.GetOutputs()) {
+    graph_outputs.insert(output->Name());
+  }
+
+  std::vector<std::unique_ptr<ComputeCapability>> result;
+  for (auto root : subgraph_roots) {
+    const auto& nodes = subgraphs[root];
+    if (nodes.size() < 2) {
+      continue;
+    }
+
+    std::unordered_set<NodeIndex> node_set(nodes.begin(), nodes.end());
+    std::unordered_set<std::string> produced;
+    auto meta_def = std::make_unique<IndexedSubGraph::MetaDef>();
+    for (auto index : nodes) {
+      const Node* node = graph_viewer.GetNode(index);
+      for (const auto* input : node->InputDefs()) {
+        if (input->Exists() && produced.count(input->Name()) == 0 &&
+            std::find(meta_def->inputs.begin(), meta_def->inputs.end(), input->Name()) == meta_def->inputs.end()) {
+          meta_def->inputs.push_back(input->Name());
+        }
+      }
+
+      // the output is reordered back to NCHW if it's used outside of the subgraph
+      const auto& output_name = node->OutputDefs()[0]->Name();
+      produced.insert(output_name);
+      bool used_outside = graph_outputs.count(output_name) != 0;
+      for (auto consumer : consumers[output_name]) {
+        used_outside |= node_set.count(consumer) == 0;
+      }
+      if (used_outside) {
+        meta_def->outputs.push_back(output_name);
+      }
+    }
+
+    meta_def->name = "MklDnnSubgraph";
+    meta_def->domain = kMSDomain;
+    meta_def->since_version = 1;
+    meta_def->status = ONNX_NAMESPACE::EXPERIMENTAL;
+
+    auto sub_graph = std::make_unique<IndexedSubGraph>();
+    sub_graph->nodes = nodes;
+    sub_graph->SetMetaDef(meta_def);
+    result.push_back(std::make_unique<ComputeCapability>(
+        std::move(sub_graph),
+        [](const OpKernelInfo& info) -> OpKernel* { return new MklDnnSubgraph(info); }));
+  }
+
+  return result;
+}
+
+struct MklDnnSubgraph::Net {
+  // a tensor of the subgraph bound to an NCHW memory for each run
+  struct Binding {
+    int index;
+    TensorShape shape;
+    std::shared_ptr<mkldnn::memory> memory;
+  };
+
+  std::vector<Binding> inputs;
+  std::vector<Binding> outputs;
+
+  // the memories the primitives refer to, including the reordered filters
+  std::vector<std::shared_ptr<mkldnn::memory>> memories;
+  std::vector<mkldnn::primitive> primitives;
+};
+
+MklDnnSubgraph::MklDnnSubgraph(const OpKernelInfo& info) : OpKernel(info) {
+  const auto& fused_node = info.node();
+  for (size_t i = 0; i < fused_node.InputDefs().size(); ++i) {
+    input_indices_[fused_node.InputDefs()[i]->Name()] = static_cast<int>(i);
+  }
+  for (size_t i = 0; i < fused_node.OutputDefs().size(); ++i) {
+    output_indices_[fused_node.OutputDefs()[i]->Name()] = static_cast<int>(i);
+  }
+
+  const Function* function = fused_node.GetFunctionBody();
+  ORT_ENFORCE(function != nullptr, "MklDnnSubgraph requires a fused node");
+  GraphViewer body(function->Body());
+  for (auto index : body.GetNodesInTopologicalOrder()) {
+    const Node& node = *body.GetNode(index);
+    ProtoHelperNodeContext context(node);
+    NodeAttributesHelper attributes(&context);
+
+    SubgraphNode subgraph_node;
+    subgraph_node.input = node.InputDefs()[0]->Name();
+    subgraph_node.output = node.OutputDefs()[0]->Name();
+    subgraph_node.strides = attributes.GetAttrsOrDefault<int64_t>("strides");
+    subgraph_node.pads = attributes.GetAttrsOrDefault<int64_t>("pads");
+
+    const auto& op_type = node.OpType();
+    if (op_type == "Conv") {
+      subgraph_node.kind = NodeKind::Conv;
+      subgraph_node.weights = node.InputDefs()[1]->Name();
+      if (node.InputDefs().size() == 3 && node.InputDefs()[2]->Exists()) {
+        subgraph_node.bias = node.InputDefs()[2]->Name();
+      }
+      subgraph_node.dilations = attributes.GetAttrsOrDefault<int64_t>("dilations");
+      subgraph_node.group = attributes.GetAttrOrDefault<int64_t>("group", 1);
+    } else if (op_type == "MaxPool" || op_type == "AveragePool") {
+      subgraph_node.kind = op_type == "MaxPool" ? NodeKind::MaxPool : NodeKind::AveragePool;
+      ORT_ENFORCE(attributes.GetAttrs<int64_t>("kernel_shape", subgraph_node.kernel_shape).IsOK(),
+                  "No kernel shape is set.");
+      subgraph_node.count_include_pad = attributes.GetAttrOrDefault<int64_t>("count_include_pad", 0) != 0;
+    } else {
+      ORT_ENFORCE(op_type == "LRN", "Unexpected node in MklDnnSubgraph: ", op_type);
+      subgraph_node.kind = NodeKind::LRN;
+      ORT_ENFORCE(attributes.GetAttr<int64_t>("size", &subgraph_node.size).IsOK());
+      ORT_ENFORCE(attributes.GetAttr<float>("alpha", &subgraph_node.alpha).IsOK());
+      ORT_ENFORCE(attributes.GetAttr<float>("beta", &subgraph_node.beta).IsOK());
+      subgraph_node.bias_value = attributes.GetAttrOrDefault<float>("bias", 1.0f);
+    }
+
+    nodes_.push_back(std::move(subgraph_node));
+  }
+}
+
+MklDnnSubgraph::~MklDnnSubgraph() = default;
+
+Status MklDnnSubgraph::CreateNet(OpKernelContext* context, std::unique_ptr<Net>& net) const {
+  net = std::make_unique<Net>();
+  mkldnn::engine& cpu_engine = GetEngine();
+
+  // the memory holding each activation, in the layout of the primitive that produced it
+  std::unordered_map<std::string, std::shared_ptr<mkldnn::memory>> values;
+  auto get_value = [&](const std::string& name) {
+    auto iter = values.find(name);
+    if (iter != values.end()) {
+      return iter->second;
+    }
+    // an input of the subgraph, in NCHW
+    int index = input_indices_.at(name);
+    const auto& shape = context->Input<Tensor>(index)->Shape();
+    mkldnn::memory::dims dims(shape.GetDims().begin(), shape.GetDims().end());
+    auto memory = std::make_shared<mkldnn::memory>(
+        mkldnn::memory::primitive_desc({dims, MklDnnType<float>(), mkldnn::memory::format::nchw}, cpu_engine),
+        nullptr);
+    net->inputs.push_back({index, shape, memory});
+    values[name] = memory;
+    return memory;
+  };
+
+  auto to_dims = [](const std::vector<int64_t>& attribute, size_t rank, int default_value) {
+    mkldnn::memory::dims dims(attribute.begin(), attribute.end());
+    if (dims.empty()) {
+      dims.resize(rank, default_value);
+    }
+    return dims;
+  };
+
+  for (const auto& node : nodes_) {
+    auto src_mem = get_value(node.input);
+    const auto src_dims = GetDims(*src_mem);
+    const auto strides = to_dims(node.strides, 2, 1);
+    const auto pads = to_dims(node.pads, 4, 0);
+    const mkldnn::memory::dims padding_left(pads.begin(), pads.begin() + 2);
+    const mkldnn::memory::dims padding_right(pads.begin() + 2, pads.end());
+
+    std::shared_ptr<mkldnn::memory> dst_mem;
+    if (node.kind == NodeKind::Conv) {
+      const Tensor* W = context->Input<Tensor>(input_indices_.at(node.weights));
+      const Tensor* B = node.bias.empty() ? nullptr : context->Input<Tensor>(input_indices_.at(node.bias));
+      const auto& w_dims = W->Shape().GetDims();
+      const int group = static_cast<int>(node.group);
+
+      mkldnn::memory::dims filter_dims;
+      if (group == 1) {
+        filter_dims.assign(w_dims.begin(), w_dims.end());
+      } else {
+        filter_dims.assign({group, static_cast<int>(w_dims[0] / group)});
+        filter_dims.insert(filter_dims.end(), w_dims.begin() + 1, w_dims.end());
+      }
+
+      // mkldnn dilations start from 0
+      auto dilations = to_dims(node.dilations, 2, 1);
+      mkldnn::memory::dims dst_dims{src_dims[0], static_cast<int>(w_dims[0])};
+      for (size_t dim = 0; dim < 2; ++dim) {
+        const int kernel_extent = dilations[dim] * (static_cast<int>(w_dims[dim + 2]) - 1) + 1;
+        dst_dims.push_back((src_dims[dim + 2] + padding_left[dim] + padding_right[dim] - kernel_extent) /
+                               strides[dim] + 1);
+        dilations[dim] -= 1;
+      }
+
+      mkldnn::memory::desc src_md(src_dims, MklDnnType<float>(), mkldnn::memory::format::any);
+      mkldnn::memory::desc filter_md(filter_dims, MklDnnType<float>(), mkldnn::memory::format::any);
+      mkldnn::memory::desc dst_md(dst_dims, MklDnnType<float>(), mkldnn::memory::format::any);
+      std::unique_ptr<mkldnn::convolution_forward::desc> fwd_desc;
+      if (B != nullptr) {
+        mkldnn::memory::desc bias_md({static_cast<int>(w_dims[0])}, MklDnnType<float>(), mkldnn::memory::format::any);
+        fwd_desc.reset(new mkldnn::convolution_forward::desc(
+            mkldnn::prop_kind::forward_inference, mkldnn::convolution_direct, src_md, filter_md, bias_md, dst_md,
+            strides, dilations, padding_left, padding_right, mkldnn::padding_kind::zero));
+      } else {
+        fwd_desc.reset(new mkldnn::convolution_forward::desc(
+            mkldnn::prop_kind::forward_inference, mkldnn::convolution_direct, src_md, filter_md, dst_md,
+            strides, dilations, padding_left, padding_right, mkldnn::padding_kind::zero));
+      }
+      mkldnn::convolution_forward::primitive_desc conv_pd(*fwd_desc, cpu_engine);
+
+      // reorder the activation if the primitive wants another layout than the one it was produced in
+      if (conv_pd.src_primitive_desc() != src_mem->get_primitive_desc()) {
+        auto reordered = std::make_shared<mkldnn::memory>(conv_pd.src_primitive_desc());
+        net->primitives.push_back(mkldnn::reorder(*src_mem, *reordered));
+        net->memories.push_back(reordered);
+        src_mem = reordered;
+      }
+
+      // the filter is a constant initializer, so reorder it now and keep the result
+      auto filter_format = group == 1 ? mkldnn::memory::format::oihw : mkldnn::memory::format::goihw;
+      auto filter_mem = std::make_shared<mkldnn::memory>(
+          mkldnn::memory::primitive_desc({filter_dims, MklDnnType<float>(), filter_format}, cpu_engine),
+          const_cast<float*>(W->Data<float>()));
+      if (conv_pd.weights_primitive_desc() != filter_mem->get_primitive_desc()) {
+        auto reordered = std::make_shared<mkldnn::memory>(conv_pd.weights_primitive_desc());
+        std::vector<mkldnn::primitive> reorder{mkldnn::reorder(*filter_mem, *reordered)};
+        mkldnn::stream(mkldnn::stream::kind::eager).submit(reorder).wait();
+        filter_mem = reordered;
+      }
+      net->memories.push_back(filter_mem);
+
+      dst_mem = std::make_shared<mkldnn::memory>(conv_pd.dst_primitive_desc());
+      if (B != nullptr) {
+        auto bias_mem = std::make_shared<mkldnn::memory>(conv_pd.bias_primitive_desc(),
+                                                         const_cast<float*>(B->Data<float>()));
+        net->memories.push_back(bias_mem);
+        net->primitives.push_back(mkldnn::convolution_forward(conv_pd, *src_mem, *filter_mem, *bias_mem, *dst_mem));
+      } else {
+        net->primitives.push_back(mkldnn::convolution_forward(conv_pd, *src_mem, *filter_mem, *dst_mem));
+      }
+    } else if (node.kind == NodeKind::LRN) {
+      mkldnn::lrn_forward::desc fwd_desc(mkldnn::prop_kind::forward_scoring, mkldnn::algorithm::lrn_across_channels,
+                                         src_mem->get_primitive_desc().desc(), static_cast<int>(node.size),
+                                         node.alpha, node.beta, node.bias_value);
+      mkldnn::lrn_forward::primitive_desc lrn_pd(fwd_desc, cpu_engine);
+      dst_mem = std::make_shared<mkldnn::memory>(lrn_pd.dst_primitive_desc());
+      net->primitives.push_back(mkldnn::lrn_forward(lrn_pd, *src_mem, *dst_mem));
+    } else {
+      const mkldnn::memory::dims kernel(node.kernel_shape.begin(), node.kernel_shape.end());
+      mkldnn::memory::dims dst_dims{src_dims[0], src_dims[1]};
+      for (size_t dim = 0; dim < 2; ++dim) {
+        dst_dims.push_back((src_dims[dim + 2] + padding_left[dim] + padding_right[dim] - kernel[dim]) /
+                               strides[dim] + 1);
+      }
+
+      mkldnn::algorithm algo = mkldnn::algorithm::pooling_max;
+      if (node.kind == NodeKind::AveragePool) {
+        algo = node.count_include_pad ? mkldnn::algorithm::pooling_avg_include_padding
+                                      : mkldnn::algorithm::pooling_avg_exclude_padding;
+      }
+      // the pooling primitive works in the layout of its input
+      mkldnn::memory::desc dst_md(dst_dims, MklDnnType<float>(), mkldnn::memory::format::any);
+      mkldnn::pooling_forward::desc fwd_desc(mkldnn::prop_kind::forward_inference, algo,
+                                             src_mem->get_primitive_desc().desc(), dst_md,
+                                             strides, kernel, padding_left, padding_right,
+                                             mkldnn::padding_kind::zero);
+      mkldnn::pooling_forward::primitive_desc pool_pd(fwd_desc, cpu_engine);
+      dst_mem = std::make_shared<mkldnn::memory>(pool_pd.dst_primitive_desc());
+      net->primitives.push_back(mkldnn::pooling_forward(pool_pd, *src_mem, *dst_mem));
+    }
+
+    net->memories.push_back(dst_mem);
+    values[node.output] = dst_mem;
+
+    // reorder the outputs of the subgraph back to NCHW
+    auto output = output_indices_.find(node.output);
+    if (output != output_indices_.end()) {
+      const auto dst_dims = GetDims(*dst_mem);
+      auto output_mem = std::make_shared<mkldnn::memory>(
+          mkldnn::memory::primitive_desc({dst_dims, MklDnnType<float>(), mkldnn::memory::format::nchw}, cpu_engine),
+          nullptr);
+      net->primitives.push_back(mkldnn::reorder(*dst_mem, *output_mem));
+      net->outputs.push_back({output->second, TensorShape(std::vector<int64_t>(dst_dims.begin(), dst_dims.end())),
+                              output_mem});
+    }
+  }
+
+  return Status::OK();
+}
+
+Status MklDnnSubgraph::Compute(OpKernelContext* context) const {
+  std::unique_ptr<Net> net;
+  {
+    std::lock_guard<std::mutex> lock(nets_mutex_);
+    if (!free_nets_.empty()) {
+      net = std::move(free_nets_.back());
+      free_nets_.pop_back();
+    }
+  }
+
+  try {
+    bool shape_changed = net == nullptr;
+    for (size_t i = 0; !shape_changed && i < net->inputs.size(); ++i) {
+      shape_changed = context->Input<Tensor>(net->inputs[i].index)->Shape() != net->inputs[i].shape;
+    }
+    if (shape_changed) {
+      std::lock_guard<std::mutex> lock(nets_mutex_);
+      ORT_RETURN_IF_ERROR(CreateNet(context, net));
+    }
+
+    for (auto& input : net->inputs) {
+      input.memory->set_data_handle(const_cast<void*>(context->Input<Tensor>(input.index)->DataRaw()));
+    }
+    for (auto& output : net->outputs) {
+      output.memory->set_data_handle(context->Output(output.index, output.shape)->MutableDataRaw());
+    }
+
+    mkldnn::stream(mkldnn::stream::kind::eager).submit(net->primitives).wait();
+  } catch (mkldnn::error& e) {
+    // the net is dropped rather than put back
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Status: ", e.status, ", message: ", e.message.c_str());
+  }
+
+  std::lock_guard<std::mutex> lock(nets_mutex_);
+  free_nets_.push_back(std::move(net));
+  return Status::OK();
+}
+
+}  // namespace mkl_dnn
+}  // namespace onnxruntime
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/framework/compute_capability.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace mkl_dnn {
+
+// Groups connected Conv, MaxPool, AveragePool and LRN nodes from <candidates> into subgraphs that run as a
+// single MklDnnSubgraph kernel. <candidates> are the nodes that have a MKLDNN kernel.
+// Returns one ComputeCapability with a meta-def per subgraph of more than one node.
+std::vector<std::unique_ptr<ComputeCapability>>
+GetSubgraphCapabilities(const GraphViewer& graph_viewer, const std::unordered_set<NodeIndex>& candidates);
+
+// Runs a fused subgraph of Conv, MaxPool, AveragePool and LRN nodes.
+// The activations between the nodes stay in the blocked layouts MKLDNN picks for the primitives and are only
+// reordered from and to NCHW at the boundary of the subgraph. The filters are constant initializers, so they are
+// reordered once when the primitives are created. The primitives are created on the first run and again when
+// the shape of an input changes. Concurrent runs each use their own primitives and memories.
+class MklDnnSubgraph final : public OpKernel {
+ public:
+  explicit MklDnnSubgraph(const OpKernelInfo& info);
+  ~MklDnnSubgraph() override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class NodeKind {
+    Conv,
+    MaxPool,
+    AveragePool,
+    LRN
+  };
+
+  struct SubgraphNode {
+    NodeKind kind;
+    std::string input;
+    std::string weights;
+    std::string bias;
+    std::string output;
+
+    std::vector<int64_t> kernel_shape;
+    std::vector<int64_t> strides;
+    std::vector<int64_t> dilations;
+    std::vector<int64_t> pads;
+    int64_t group{1};
+    bool count_include_pad{false};
+
+    int64_t size{0};
+    float alpha{0.f};
+    float beta{0.f};
+    float bias_value{1.f};
+  };
+
+  struct Net;
+
+  Status CreateNet(OpKernelContext* context, std::unique_ptr<Net>& net) const;
+
+  std::vector<SubgraphNode> nodes_;
+  std::unordered_map<std::string, int> input_indices_;
+  std::unordered_map<std::string, int> output_indices_;
+
+  // the primitives bind the tensors of one run at a time, so a run takes a net from the pool, or creates one if
+  // all are in use, and puts it back when it's done. only taking, creating and putting back a net is locked.
+  mutable std::mutex nets_mutex_;
+  mutable std::vector<std::unique_ptr<Net>> free_nets_;
+};
+
+}  // namespace mkl_dnn
+}  // namespace onnxruntime
@@ -38,18 +38,16 @@ struct ConvParams {
         padding_right(padding_right) {}
 
   // Used as the key for Conv Primitive Reuse Pool.
-  std::string ToString() const {
-    std::string key;
-    key.reserve(128);
-    key.append("conv_");
-    AddDimsToKey(key, src_dims);
-    AddDimsToKey(key, filter_dims);
-    AddDimsToKey(key, bias_dims);
-    AddDimsToKey(key, dst_dims);
-    AddDimsToKey(key, strides);
-    AddDimsToKey(key, dilations);
-    AddDimsToKey(key, padding_left);
-    AddDimsToKey(key, padding_right);
+  PrimitiveKey ToKey() const {
+    PrimitiveKey key;
+    key.Append(src_dims);
+    key.Append(filter_dims);
+    key.Append(bias_dims);
+    key.Append(dst_dims);
+    key.Append(strides);
+    key.Append(dilations);
+    key.Append(padding_left);
+    key.Append(padding_right);
     return key;
   }
 };
@@ -227,33 +225,37 @@ class ConvPrimitive : public PrimitiveBase {
 };
 
 // Pool which allows for reuse of MKLDNN Conv primitives which are expensive to instantiate.
-// To address thread safety, the primitives are stored in a map on thread local storage.
 template <typename T>
-class ConvPrimitivePool : public PrimitivePool<T> {
+class ConvPrimitivePool : public PrimitivePool<ConvPrimitive<T>> {
  public:
   static ConvPrimitive<T>* Get(const ConvParams& params) {
-    ConvPrimitive<T>* primitive = dynamic_cast<ConvPrimitive<T>*>(
-        ConvPrimitivePool<T>::GetInstance().GetPrimitive(params.ToString()));
-
+    const PrimitiveKey key = params.ToKey();
+    ConvPrimitive<T>* primitive = ConvPrimitivePool<T>::GetPrimitive(key);
     if (primitive == nullptr) {
-      auto conv_primitive = std::make_unique<ConvPrimitive<T>>(params);
-      primitive = conv_primitive.get();
-      ConvPrimitivePool<T>::GetInstance().SetPrimitive(params.ToString(), std::move(conv_primitive));
+      primitive = ConvPrimitivePool<T>::SetPrimitive(key, std::make_unique<ConvPrimitive<T>>(params));
     }
     return primitive;
   }
-
- private:
-  ConvPrimitivePool() = default;
-  ~ConvPrimitivePool() = default;
-
-  static ConvPrimitivePool& GetInstance() {
-    static ConvPrimitivePool pool;
-    return pool;
-  }
 };
 }  // namespace
 
+template <typename T>
+const T* Conv<T>::GetReorderedFilter(int filter_format, size_t filter_size,
+                                    const std::function<void(void* buffer)>& reorder) const {
+  std::lock_guard<std::mutex> lock(reordered_filters_mutex_);
+  for (const auto& reordered_filter : reordered_filters_) {
+    if (reordered_filter.first == filter_format) {
+      return static_cast<const T*>(reordered_filter.second.get());
+    }
+  }
+
+  auto alloc = OpKernel::Info().GetExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  std::shared_ptr<void> buffer = IAllocator::MakeUniquePtr<void>(alloc, filter_size);
+  reorder(buffer.get());
+  reordered_filters_.emplace_back(filter_format, buffer);
+  return static_cast<const T*>(buffer.get());
+}
+
 template <typename T>
 Status Conv<T>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
@@ -409,13 +411,22 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
                                                                     filter_format),
                                                cpu_engine);
       mkldnn::memory src = mkldnn::memory(pd, (void*)filter_data);
-      // allocate the size queried from memory primitive desc. it may not match tensor logical size due to
-      // mkldnn using padding to allow use of blocked format.
-      filter_reorder_buffer = IAllocator::MakeUniquePtr<void>(alloc, conv_primitive->GetFilterSize());
-      mkldnn::memory dst = mkldnn::memory(conv_fwd_pd->weights_primitive_desc(), filter_reorder_buffer.get());
-      MemoryReorderParams params(src, dst);
-      DoReorder<T>(params);
-      filter_data = static_cast<T*>(dst.get_data_handle());
+      auto reorder = [&](void* buffer) {
+        mkldnn::memory dst = mkldnn::memory(conv_fwd_pd->weights_primitive_desc(), buffer);
+        MemoryReorderParams params(src, dst);
+        DoReorder<T>(params);
+      };
+      if (filter_is_constant_) {
+        // the weights don't change between runs, so reorder them once
+        filter_data = GetReorderedFilter(conv_primitive->GetFilterMemoryFormat(), conv_primitive->GetFilterSize(),
+                                         reorder);
+      } else {
+        // allocate the size queried from memory primitive desc. it may not match tensor logical size due to
+        // mkldnn using padding to allow use of blocked format.
+        filter_reorder_buffer = IAllocator::MakeUniquePtr<void>(alloc, conv_primitive->GetFilterSize());
+        reorder(filter_reorder_buffer.get());
+        filter_data = static_cast<T*>(filter_reorder_buffer.get());
+      }
     }
 
     // Allocate dst buffer if reorder is necessary
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <mutex>
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv.h"
 
@@ -11,11 +12,25 @@ template <typename T>
 class Conv final : public onnxruntime::Conv<T> {
  public:
   Conv(const OpKernelInfo& info) : onnxruntime::Conv<T>(info) {
+    const Tensor* W;
+    filter_is_constant_ = info.TryGetConstantInput(1, &W);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  // Returns the filter reordered into the given MKLDNN memory format, reordering it on first use.
+  // Only used when the filter is a constant initializer.
+  const T* GetReorderedFilter(int filter_format, size_t filter_size,
+                              const std::function<void(void* buffer)>& reorder) const;
+
+  bool filter_is_constant_{false};
+
+  // The filter in each blocked format requested so far. The primitive can pick a different format
+  // for a different input shape, so more than one can be cached. Entries are never replaced, so a
+  // pointer returned by GetReorderedFilter stays valid for the lifetime of the kernel.
+  mutable std::mutex reordered_filters_mutex_;
+  mutable std::vector<std::pair<int, std::shared_ptr<void>>> reordered_filters_;
 };
 }  // namespace mkl_dnn
 }  // namespace onnxruntime
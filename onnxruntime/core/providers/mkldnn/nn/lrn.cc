@@ -35,16 +35,13 @@ struct LRNParams {
       : dims_(dims), alpha_(alpha), beta_(beta), bias_(bias), size_(size) {}
 
   // Used as the key for LRN Primitive Reuse LRN.
-  std::string ToString() const {
-    std::string key;
-    key.reserve(128);
-    key.append("lrn");
-    AddDimsToKey(key, dims_);
-    key.append('#' + std::to_string(alpha_) + '#');
-    key.append('#' + std::to_string(beta_) + '#');
-    key.append('#' + std::to_string(bias_) + '#');
-    key.append('#' + std::to_string(size_) + '#');
-
+  PrimitiveKey ToKey() const {
+    PrimitiveKey key;
+    key.Append(dims_);
+    key.AppendFloat(alpha_);
+    key.AppendFloat(beta_);
+    key.AppendFloat(bias_);
+    key.Append(size_);
     return key;
   }
 };
@@ -141,30 +138,18 @@ class LRNPrimitive : public PrimitiveBase {
   mkldnn::engine& cpu_engine_;
 };
 
-// Pool which allows for reuse of MKLDNN Pool primitives which are expensive to instantiate.
-// To address thread safety, the primitives are stored in a map on thread local storage.
+// Pool which allows for reuse of MKLDNN LRN primitives which are expensive to instantiate.
 template <typename T>
-class LRNPrimitivePool : public PrimitivePool<T> {
+class LRNPrimitivePool : public PrimitivePool<LRNPrimitive<T>> {
  public:
   static LRNPrimitive<T>* Get(const LRNParams& params) {
-    LRNPrimitive<T>* primitive = dynamic_cast<LRNPrimitive<T>*>(
-        LRNPrimitivePool<T>::GetInstance().GetPrimitive(params.ToString()));
+    const PrimitiveKey key = params.ToKey();
+    LRNPrimitive<T>* primitive = LRNPrimitivePool<T>::GetPrimitive(key);
     if (primitive == nullptr) {
-      auto pool_primitive = std::make_unique<LRNPrimitive<T>>(params);
-      primitive = pool_primitive.get();
-      LRNPrimitivePool<T>::GetInstance().SetPrimitive(params.ToString(), std::move(pool_primitive));
+      primitive = LRNPrimitivePool<T>::SetPrimitive(key, std::make_unique<LRNPrimitive<T>>(params));
     }
     return primitive;
   }
-
- private:
-  LRNPrimitivePool() = default;
-  ~LRNPrimitivePool() = default;
-
-  static LRNPrimitivePool& GetInstance() {
-    static LRNPrimitivePool pool;
-    return pool;
-  }
 };
 }  // namespace
 
@@ -33,10 +33,9 @@ POOLING_KERNEL(GlobalMaxPool, float, MaxPool<1>, 1, 8)
 namespace {
 // Struct which encapsulates parameters for MKLDNN Pool primitive.
 struct PoolParams {
-  std::string op_name;
   // Pooling primitive needs version as part of key because there
   // are multiple versions of mkldnn pool kernels.
-  std::string version;
+  int version;
   mkldnn::memory::dims& src_dims;
   mkldnn::memory::dims& dst_dims;
   mkldnn::memory::dims& kernel;
@@ -45,13 +44,12 @@ struct PoolParams {
   mkldnn::memory::dims& padding_right;
   bool count_include_pad;
 
-  PoolParams(std::string op_name, std::string version,
+  PoolParams(int version,
              mkldnn::memory::dims& src_dims, mkldnn::memory::dims& dst_dims,
              mkldnn::memory::dims& kernel, mkldnn::memory::dims& strides,
              mkldnn::memory::dims& padding_left, mkldnn::memory::dims& padding_right,
              bool count_include_pad)
-      : op_name(op_name),
-        version(version),
+      : version(version),
         src_dims(src_dims),
         dst_dims(dst_dims),
         kernel(kernel),
@@ -61,18 +59,17 @@ struct PoolParams {
         count_include_pad(count_include_pad) {}
 
   // Used as the key for Pool Primitive Reuse Pool.
-  std::string ToString() const {
-    std::string key;
-    key.reserve(128);
-    key.append(op_name);
-    key.append(version);
-    AddDimsToKey(key, src_dims);
-    AddDimsToKey(key, dst_dims);
-    AddDimsToKey(key, kernel);
-    AddDimsToKey(key, strides);
-    AddDimsToKey(key, padding_left);
-    AddDimsToKey(key, padding_right);
-    key.append(count_include_pad ? "true" : "false");
+  // The pool type is part of the type of the pool, so it isn't part of the key.
+  PrimitiveKey ToKey() const {
+    PrimitiveKey key;
+    key.Append(version);
+    key.Append(src_dims);
+    key.Append(dst_dims);
+    key.Append(kernel);
+    key.Append(strides);
+    key.Append(padding_left);
+    key.Append(padding_right);
+    key.Append(count_include_pad ? 1 : 0);
     return key;
   }
 };
@@ -203,29 +200,17 @@ class PoolPrimitive : public PrimitiveBase {
 };
 
 // Pool which allows for reuse of MKLDNN Pool primitives which are expensive to instantiate.
-// To address thread safety, the primitives are stored in a map on thread local storage.
 template <typename T, typename PoolType>
-class PoolPrimitivePool : public PrimitivePool<T> {
+class PoolPrimitivePool : public PrimitivePool<PoolPrimitive<T, PoolType>> {
  public:
   static PoolPrimitive<T, PoolType>* Get(const PoolParams& params) {
-    PoolPrimitive<T, PoolType>* primitive = dynamic_cast<PoolPrimitive<T, PoolType>*>(
-        PoolPrimitivePool<T, PoolType>::GetInstance().GetPrimitive(params.ToString()));
+    const PrimitiveKey key = params.ToKey();
+    PoolPrimitive<T, PoolType>* primitive = PoolPrimitivePool<T, PoolType>::GetPrimitive(key);
     if (primitive == nullptr) {
-      auto pool_primitive = std::make_unique<PoolPrimitive<T, PoolType>>(params);
-      primitive = pool_primitive.get();
-      PoolPrimitivePool<T, PoolType>::GetInstance().SetPrimitive(params.ToString(), std::move(pool_primitive));
+      primitive = PoolPrimitivePool<T, PoolType>::SetPrimitive(key, std::make_unique<PoolPrimitive<T, PoolType>>(params));
     }
     return primitive;
   }
-
- private:
-  PoolPrimitivePool() = default;
-  ~PoolPrimitivePool() = default;
-
-  static PoolPrimitivePool& GetInstance() {
-    static PoolPrimitivePool pool;
-    return pool;
-  }
 };
 }  // namespace
 
@@ -281,7 +266,7 @@ Status Pool<T, PoolType>::Compute(OpKernelContext* context) const {
   IAllocatorUniquePtr<void> dst_reorder_buffer;
 
   try {
-    PoolParams pool_params(this->op_name_, this->opset_version_,
+    PoolParams pool_params(opset_version_,
                            src_dims_mkl, dst_dims_mkl,
                            kernel_mkl, strides_mkl,
                            padding_left_mkl, padding_right_mkl,
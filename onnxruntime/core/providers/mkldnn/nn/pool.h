@@ -14,15 +14,14 @@ class Pool final : public onnxruntime::Pool<T, PoolType> {
   Pool(const OpKernelInfo& info) : onnxruntime::Pool<T, PoolType>(info) {
     // Since there are multiple versions of Pooling kernels, we need to use
     // the opset version as part of the key for caching Pooling Primitives.
-    int start, end;
-    OpKernel::KernelDef().SinceVersion(&start, &end);
-    opset_version_ = std::to_string(start);
+    int end;
+    OpKernel::KernelDef().SinceVersion(&opset_version_, &end);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::string opset_version_;
+  int opset_version_;
 };
 
 }  // namespace mkl_dnn
@@ -161,6 +161,15 @@ common::Status IOBinding::BindOutput(const std::string& name, const MLValue& ml_
   return Status::OK();
 }
 
+void IOBinding::ClearInputs() {
+  feeds_.clear();
+}
+
+void IOBinding::ClearOutputs() {
+  output_names_.clear();
+  outputs_.clear();
+}
+
 const std::vector<std::string>& IOBinding::GetOutputNames() const {
   return output_names_;
 }
@@ -62,6 +62,12 @@ class IOBinding {
     */
   common::Status BindOutput(const std::string& name, const MLValue& ml_value);
 
+  /**
+    * Remove all the bound inputs or outputs so the binding can be set up again.
+    */
+  void ClearInputs();
+  void ClearOutputs();
+
   /**
     * This simply collects the outputs obtained after calling Run() inside the @param outputs.
     */
@@ -4,6 +4,7 @@
 #include "core/session/onnxruntime_c_api.h"
 #include <cstring>
 #include <cassert>
+#include "core/framework/shared_initialized_tensors.h"
 #include "core/session/inference_session.h"
 #include "abi_session_options_impl.h"
 
@@ -69,6 +70,15 @@ ORT_API(void, OrtDisableMemPattern, _In_ OrtSessionOptions* options) {
   options->value.enable_mem_pattern = false;
 }
 
+ORT_API(void, OrtAddMemPatternPrewarmShapes, _In_ OrtSessionOptions* options, _In_ const char* const* input_names,
+        _In_ const int64_t* const* input_dims, _In_ const size_t* input_dims_lengths, size_t input_len) {
+  std::unordered_map<std::string, std::vector<int64_t>> shapes;
+  for (size_t i = 0; i != input_len; ++i) {
+    shapes[input_names[i]].assign(input_dims[i], input_dims[i] + input_dims_lengths[i]);
+  }
+  options->value.mem_pattern_prewarm_shapes.push_back(std::move(shapes));
+}
+
 // enable the memory arena on CPU
 // Arena may pre-allocate memory for future usage.
 // set this option to false if you don't want it.
@@ -80,6 +90,74 @@ ORT_API(void, OrtDisableCpuMemArena, _In_ OrtSessionOptions* options) {
   options->value.enable_cpu_mem_arena = false;
 }
 
+ORT_API(void, OrtEnableSharedInitializerCache, _In_ OrtSessionOptions* options) {
+  options->value.enable_shared_initializer_cache = true;
+}
+
+ORT_API(void, OrtDisableSharedInitializerCache, _In_ OrtSessionOptions* options) {
+  options->value.enable_shared_initializer_cache = false;
+}
+
+ORT_API(void, OrtEnableConvAutotuning, _In_ OrtSessionOptions* options) {
+  options->value.enable_conv_autotuning = true;
+}
+
+ORT_API(void, OrtDisableConvAutotuning, _In_ OrtSessionOptions* options) {
+  options->value.enable_conv_autotuning = false;
+}
+
+ORT_API(void, OrtEnableGemmFusion, _In_ OrtSessionOptions* options) {
+  options->value.enable_gemm_fusion = true;
+}
+
+ORT_API(void, OrtDisableGemmFusion, _In_ OrtSessionOptions* options) {
+  options->value.enable_gemm_fusion = false;
+}
+
+ORT_API(void, OrtEnableNchwcLayout, _In_ OrtSessionOptions* options) {
+  options->value.enable_nchwc_layout = true;
+}
+
+ORT_API(void, OrtDisableNchwcLayout, _In_ OrtSessionOptions* options) {
+  options->value.enable_nchwc_layout = false;
+}
+
+ORT_API(void, OrtEnableKeepFloat16Weights, _In_ OrtSessionOptions* options) {
+  options->value.keep_float16_weights = true;
+}
+
+ORT_API(void, OrtDisableKeepFloat16Weights, _In_ OrtSessionOptions* options) {
+  options->value.keep_float16_weights = false;
+}
+
+ORT_API(void, OrtGetSharedInitializerCacheStats, _Out_ size_t* num_tensors, _Out_ size_t* bytes_in_use,
+        _Out_ size_t* bytes_saved) {
+  auto stats = onnxruntime::SharedInitializedTensors::GetProcessWideStats();
+  *num_tensors = stats.num_tensors;
+  *bytes_in_use = stats.bytes_in_use;
+  *bytes_saved = stats.bytes_saved;
+}
+
+ORT_API(void, OrtSetCpuMemArenaExtendStrategy, _In_ OrtSessionOptions* options, OrtArenaExtendStrategy strategy,
+        size_t initial_chunk_bytes, size_t extend_increment_bytes) {
+  options->value.cpu_arena_config.extend_strategy = static_cast<onnxruntime::ArenaExtendStrategy>(strategy);
+  options->value.cpu_arena_config.initial_chunk_bytes = initial_chunk_bytes;
+  options->value.cpu_arena_config.extend_increment_bytes = extend_increment_bytes;
+}
+
+ORT_API(void, OrtSetCpuMemArenaMaxMemory, _In_ OrtSessionOptions* options, size_t max_mem) {
+  options->value.cpu_arena_config.max_mem = max_mem;
+}
+
+ORT_API(void, OrtSetCpuMemArenaThreadCacheSize, _In_ OrtSessionOptions* options, size_t thread_cache_bytes) {
+  options->value.cpu_arena_config.thread_cache_bytes = thread_cache_bytes;
+}
+
+ORT_API(void, OrtSetCpuMemArenaShrinkPolicy, _In_ OrtSessionOptions* options, size_t threshold_bytes, int64_t interval_ms) {
+  options->value.cpu_arena_config.shrink_threshold_bytes = threshold_bytes;
+  options->value.cpu_arena_config.shrink_interval_ms = interval_ms;
+}
+
 ///< logger id to use for session output
 ORT_API(void, OrtSetSessionLogId, _In_ OrtSessionOptions* options, const char* logid) {
   options->value.session_logid = logid;
@@ -8,13 +8,17 @@
 #include <sstream>
 #include <unordered_set>
 #include <list>
+#include <iterator>
 
 #include "core/common/logging/logging.h"
 #include "core/common/task_thread_pool.h"
+#include "core/graph/gemm_activation_fusion.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/graph_transformer.h"
 #include "core/graph/graph_transformer_mgr.h"
+#include "core/graph/matmul_add_fusion.h"
 #include "core/graph/model.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/framework/allocatormgr.h"
 #include "core/framework/customregistry.h"
 #include "core/framework/environment.h"
@@ -25,11 +29,13 @@
 #include "core/framework/kernel_registry.h"
 #include "core/framework/ml_value_patterns_planner.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/nchwc_transformer.h"
 #include "core/framework/mlvalue_name_idx_map.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/parallel_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/session_state_initializer.h"
+#include "core/framework/shared_initialized_tensors.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensorutils.h"
 #include "core/framework/transformer_memcpy.h"
@@ -38,6 +44,7 @@
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/CustomOpsLoader.h"
 #include "core/session/IOBinding.h"
+#include "core/session/prepared_model.h"
 
 using namespace ONNX_NAMESPACE;
 
@@ -50,7 +57,7 @@ class InferenceSession::Impl {
         graph_transformation_mgr_{session_options_.max_num_graph_transformation_steps},
         logging_manager_{logging_manager},
         session_state_{execution_providers_},
-        insert_cast_transformer_{"CastFloat16Transformer"} {
+        insert_cast_transformer_{"CastFloat16Transformer", session_options.keep_float16_weights} {
     ORT_ENFORCE(Environment::IsInitialized(),
                 "Environment must be initialized before creating an InferenceSession.");
 
@@ -65,6 +72,14 @@ class InferenceSession::Impl {
       thread_pool_ = std::make_unique<TaskThreadPool>(pool_size);
     }
 
+    if (session_options.enable_nchwc_layout) {
+      ORT_ENFORCE(graph_transformation_mgr_.Register(std::make_unique<NchwcTransformer>()).IsOK());
+    }
+
+    if (session_options.enable_conv_autotuning) {
+      MlasConvSetAutotuning(true);
+    }
+
     session_state_.SetThreadPool(thread_pool_.get());
     session_state_.SetEnableMemoryPattern(session_options.enable_mem_pattern);
     session_profiler_.Initialize(session_logger_);
@@ -210,6 +225,49 @@ class InferenceSession::Impl {
     return Status::OK();
   }
 
+  common::Status Load(const void* model_data, int model_data_len) {
+    auto tp = session_profiler_.StartTime();
+    try {
+      LOGS(*session_logger_, INFO) << "Loading model using array";
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (is_model_loaded_) {  // already loaded
+        LOGS(*session_logger_, ERROR) << "This session already contains a loaded model.";
+        return common::Status(common::ONNXRUNTIME, common::MODEL_LOADED, "This session already contains a loaded model.");
+      }
+
+      std::shared_ptr<onnxruntime::Model> p_tmp_model;
+      ORT_RETURN_IF_ERROR(onnxruntime::Model::LoadFromBytes(model_data_len, const_cast<void*>(model_data), p_tmp_model,
+                                                            HasLocalSchema() ? &custom_schema_registries_ : nullptr));
+      model_ = p_tmp_model;
+
+      ORT_RETURN_IF_ERROR(DoPostLoadProcessing(*model_.get()));
+
+      // all steps complete, mark the model as loaded.
+      is_model_loaded_ = true;
+
+      LOGS(*session_logger_, INFO) << "Model successfully loaded.";
+    } catch (const std::exception& ex) {
+      return Status(common::ONNXRUNTIME, common::FAIL, "Exception during loading: " + std::string(ex.what()));
+    } catch (...) {
+      LOGS(*session_logger_, ERROR) << "Unknown exception in Load()";
+      return Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in Load()");
+    }
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_loading_array", tp);
+    return common::Status::OK();
+  }
+
+  common::Status Load(std::shared_ptr<const PreparedModel> prepared_model) {
+    if (!prepared_model) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "prepared_model is null");
+    }
+
+    ORT_RETURN_IF_ERROR(Load(prepared_model->CopyModelProto()));
+
+    std::lock_guard<std::mutex> l(session_mutex_);
+    prepared_model_ = std::move(prepared_model);
+    return common::Status::OK();
+  }
+
   common::Status Load(std::istream& model_istream) {
     auto tp = session_profiler_.StartTime();
     try {
@@ -282,8 +340,10 @@ class InferenceSession::Impl {
                                      node.ImplicitInputDefs(),
                                      session_options_.enable_sequential_execution));
 
-          ORT_RETURN_IF_ERROR(initializer.InitializeAndSave(session_state_.GetEnableMemoryPattern(),
-                                                            subgraph_info.weights_buffers));
+          ORT_RETURN_IF_ERROR(initializer.InitializeAndSave(
+              session_state_.GetEnableMemoryPattern(), subgraph_info.weights_buffers,
+              prepared_model_ ? &prepared_model_->Initializers() : nullptr,
+              session_options_.enable_shared_initializer_cache ? &cached_initializers_ : nullptr));
 
           // add the subgraph SessionState instance to the parent graph SessionState so it can be retrieved
           // by Compute() via OpKernelContextInternal.
@@ -307,6 +367,7 @@ class InferenceSession::Impl {
 
   common::Status Initialize() {
     Status status = Status::OK();
+    bool prewarm = false;
     auto tp = session_profiler_.StartTime();
 
     try {
@@ -326,10 +387,20 @@ class InferenceSession::Impl {
       if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
         LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
         CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+        epi.arena_config = session_options_.cpu_arena_config;
         execution_providers_.Add(onnxruntime::kCpuExecutionProvider,
                                  std::make_unique<CPUExecutionProvider>(epi));
       }
 
+      // the graph transformers run before the nodes are assigned to execution providers, and FusedGemm only has a
+      // CPU kernel, so only fuse the activations into Gemm when no other provider could take the Gemm nodes.
+      if (session_options_.enable_gemm_fusion) {
+        ORT_RETURN_IF_ERROR(graph_transformation_mgr_.Register(std::make_unique<MatMulAddFusion>()));
+        if (std::next(execution_providers_.begin()) == execution_providers_.end()) {
+          ORT_RETURN_IF_ERROR(graph_transformation_mgr_.Register(std::make_unique<GemmActivationFusion>()));
+        }
+      }
+
       onnxruntime::Graph& graph = model_->MainGraph();
 
       // Collect the kernel registries from execution provider instances;
@@ -350,13 +421,23 @@ class InferenceSession::Impl {
       ORT_RETURN_IF_ERROR(session_initializer.CreatePlan(graph_transformation_mgr_, insert_cast_transformer_,
                                                          {}, session_options_.enable_sequential_execution));
 
-      ORT_RETURN_IF_ERROR(session_initializer.InitializeAndSave(session_state_.GetEnableMemoryPattern(),
-                                                                weights_buffers_));
+      ORT_RETURN_IF_ERROR(session_initializer.InitializeAndSave(
+          session_state_.GetEnableMemoryPattern(), weights_buffers_,
+          prepared_model_ ? &prepared_model_->Initializers() : nullptr,
+          session_options_.enable_shared_initializer_cache ? &cached_initializers_ : nullptr));
 
       // handle any subgraphs
       ORT_RETURN_IF_ERROR(InitializeSubgraphSessions(graph, session_state_));
 
+      if (session_options_.enable_shared_initializer_cache) {
+        auto stats = SharedInitializedTensors::GetProcessWideStats();
+        LOGS(*session_logger_, INFO) << "Shared initializer cache: " << cached_initializers_.size()
+                                     << " initializers of this session, " << stats.num_tensors << " tensors using "
+                                     << stats.bytes_in_use << " bytes, " << stats.bytes_saved << " bytes saved.";
+      }
+
       is_inited_ = true;
+      prewarm = session_state_.GetEnableMemoryPattern() && !session_options_.mem_pattern_prewarm_shapes.empty();
 
       LOGS(*session_logger_, INFO) << "Session successfully initialized.";
     } catch (const NotImplementedException& ex) {
@@ -370,14 +451,98 @@ class InferenceSession::Impl {
       LOGS(*session_logger_, ERROR) << status.ErrorMessage();
     }
 
+    // outside of the session lock as it runs the model
+    if (prewarm) {
+      PrewarmMemoryPatterns();
+    }
+
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_initialization", tp);
     return status;
   }
 
+  // run the model once per entry of mem_pattern_prewarm_shapes so the memory patterns for those shapes are cached
+  // before the first request. best effort: a shape set that can't be run is skipped with a warning.
+  void PrewarmMemoryPatterns() {
+    AllocatorPtr allocator = execution_providers_.Get(onnxruntime::kCpuExecutionProvider)->GetAllocator(0, OrtMemTypeDefault);
+    std::vector<std::string> output_names;
+    for (const auto* output : output_def_list_) {
+      output_names.push_back(output->Name());
+    }
+
+    for (const auto& shapes : session_options_.mem_pattern_prewarm_shapes) {
+      NameMLValMap feeds;
+      Status status = CreatePrewarmFeeds(shapes, allocator, feeds);
+      if (status.IsOK()) {
+        std::vector<MLValue> fetches;
+        status = Run(RunOptions(), feeds, output_names, &fetches);
+      }
+
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Could not generate memory patterns for prewarm shapes: "
+                                        << status.ErrorMessage();
+      }
+    }
+  }
+
+  common::Status CreatePrewarmFeeds(const std::unordered_map<std::string, std::vector<int64_t>>& shapes,
+                                    const AllocatorPtr& allocator, NameMLValMap& feeds) {
+    for (const auto* input : required_input_def_list_) {
+      auto shape_entry = shapes.find(input->Name());
+      if (shape_entry == shapes.cend()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No shape given for input ", input->Name());
+      }
+
+      MLDataType type = DataTypeImpl::TypeFromProto(*input->TypeAsProto());
+      const auto* tensor_type = dynamic_cast<const TensorTypeBase*>(type);
+      if (tensor_type == nullptr || tensor_type->GetElementType() == DataTypeImpl::GetType<std::string>()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input ", input->Name(),
+                               " is not a numeric tensor");
+      }
+
+      MLDataType element_type = tensor_type->GetElementType();
+      TensorShape shape(shape_entry->second);
+      if (shape.Size() < 0) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid shape given for input ", input->Name());
+      }
+
+      size_t size_in_bytes = 0;
+      if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(shape.Size()), element_type->Size(), &size_in_bytes)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Shape given for input ", input->Name(), " is too large");
+      }
+
+      void* buffer = size_in_bytes > 0 ? allocator->Alloc(size_in_bytes) : nullptr;
+      if (buffer != nullptr) {
+        memset(buffer, 0, size_in_bytes);
+      }
+
+      auto tensor = std::make_unique<Tensor>(element_type, shape, buffer, allocator->Info(), allocator);
+      MLValue value;
+      value.Init(tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      feeds.insert({input->Name(), value});
+    }
+
+    return Status::OK();
+  }
+
   int GetCurrentNumRuns() const {
     return current_num_runs_.load();
   }
 
+  common::Status GetAllocatorStats(const OrtAllocatorInfo& info, AllocatorStats* stats) const {
+    const IExecutionProvider* provider = execution_providers_.Get(info);
+    if (provider == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No execution provider owns allocator ", info.ToString());
+    }
+
+    auto* arena = dynamic_cast<IArenaAllocator*>(provider->GetAllocator(info.id, info.mem_type).get());
+    if (arena == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Allocator is not an arena: ", info.ToString());
+    }
+
+    arena->GetStats(stats);
+    return Status::OK();
+  }
+
   common::Status Run(const NameMLValMap& feeds,
                      const std::vector<std::string>& output_names,
                      std::vector<MLValue>* p_fetches) {
@@ -791,11 +956,45 @@ class InferenceSession::Impl {
     for (auto& xp : execution_providers_)
       ORT_CHECK_AND_SET_RETVAL(xp->OnRunEnd());
 
+    if (session_profiler_.IsEnabled()) {
+      RecordArenaStats();
+    }
+
     --current_num_runs_;
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp);
     return retval;
   }
 
+  // add the state of every arena to the profile, so growth and fragmentation can be followed run by run
+  void RecordArenaStats() {
+    for (const auto& xp : execution_providers_) {
+      for (const auto& allocator : xp->GetAllocatorMap()) {
+        auto* arena = dynamic_cast<IArenaAllocator*>(allocator.get());
+        if (arena == nullptr) {
+          continue;
+        }
+
+        AllocatorStats stats;
+        arena->GetStats(&stats);
+        // share of allocations that were served without asking the device for memory
+        double hit_rate = stats.num_allocs > 0 ? 1.0 - static_cast<double>(stats.num_extends) / stats.num_allocs : 1.0;
+        double thread_cache_hit_rate = stats.num_allocs > 0 ? static_cast<double>(stats.num_thread_cache_hits) / stats.num_allocs : 0.0;
+
+        auto tp = session_profiler_.StartTime();
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, std::string(arena->Info().name) + "_arena_stats", tp,
+                                                {{"bytes_in_use", std::to_string(stats.bytes_in_use)},
+                                                 {"total_allocated_bytes", std::to_string(stats.total_allocated_bytes)},
+                                                 {"max_bytes_in_use", std::to_string(stats.max_bytes_in_use)},
+                                                 {"largest_free_block", std::to_string(stats.largest_free_block)},
+                                                 {"fragmentation", std::to_string(stats.Fragmentation())},
+                                                 {"num_allocs", std::to_string(stats.num_allocs)},
+                                                 {"num_extends", std::to_string(stats.num_extends)},
+                                                 {"hit_rate", std::to_string(hit_rate)},
+                                                 {"thread_cache_hit_rate", std::to_string(thread_cache_hit_rate)}});
+      }
+    }
+  }
+
   std::pair<common::Status, const ModelMetadata*> GetModelMetadata() const {
     {
       std::lock_guard<std::mutex> l(session_mutex_);
@@ -1043,6 +1242,9 @@ class InferenceSession::Impl {
   // if they need.
   std::shared_ptr<onnxruntime::Model> model_;
 
+  // set if the model was loaded from a PreparedModel, whose initializers are then shared with this session.
+  std::shared_ptr<const PreparedModel> prepared_model_;
+
   // A set of executors that can run in parallel.
   std::vector<std::unique_ptr<IExecutor>> executors_;  // TODO do we need this vector?
 
@@ -1076,6 +1278,8 @@ class InferenceSession::Impl {
   bool is_inited_ = false;            // GUARDED_BY(session_mutex_)
 
   std::map<OrtAllocatorInfo, BufferUniquePtr> weights_buffers_;
+  // references to the initializers of this session and its subgraphs in the process wide SharedInitializedTensors
+  std::vector<SharedInitializedTensors::Reference> cached_initializers_;
   InsertCastTransformer insert_cast_transformer_;
 
   // memory allocations for any subgraphs
@@ -1104,6 +1308,14 @@ common::Status InferenceSession::Load(std::istream& model_istream) {
   return impl_->Load(model_istream);
 }
 
+common::Status InferenceSession::Load(const void* model_data, int model_data_len) {
+  return impl_->Load(model_data, model_data_len);
+}
+
+common::Status InferenceSession::Load(std::shared_ptr<const PreparedModel> prepared_model) {
+  return impl_->Load(std::move(prepared_model));
+}
+
 common::Status InferenceSession::Initialize() {
   return impl_->Initialize();
 }
@@ -1137,6 +1349,10 @@ int InferenceSession::GetCurrentNumRuns() {
   return impl_->GetCurrentNumRuns();
 }
 
+common::Status InferenceSession::GetAllocatorStats(const OrtAllocatorInfo& info, AllocatorStats* stats) const {
+  return impl_->GetAllocatorStats(info, stats);
+}
+
 void InferenceSession::StartProfiling(const std::string& file_prefix) {
   impl_->StartProfiling(file_prefix);
 }
@@ -8,6 +8,7 @@
 
 #include "core/common/common.h"
 #include "core/common/status.h"
+#include "core/framework/arena.h"
 #include "core/framework/framework_common.h"
 #include "core/graph/basic_types.h"
 #include "core/common/logging/logging.h"
@@ -23,6 +24,7 @@ class ModelProto;
 namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
+class PreparedModel;
 
 class CustomRegistry;
 
@@ -46,11 +48,41 @@ struct SessionOptions {
   // with a big chunk for all the internal memory allocation.
   bool enable_mem_pattern = true;
 
+  // input shapes, by input name, to generate memory patterns for at the end of Initialize by running the model
+  // once with zero filled inputs per entry. Two entries that only differ in the symbolic dimensions of the inputs
+  // (e.g. batch size) are enough to derive the patterns for any other value of those dimensions.
+  // Initialize runs inference once per entry, so it takes as long as those runs. Ops that depend on the input
+  // values, e.g. the indices of Gather or the shape of Reshape, see zeros and may fail. A run that fails is
+  // logged as a warning and skipped, and doesn't fail Initialize.
+  std::vector<std::unordered_map<std::string, std::vector<int64_t>>> mem_pattern_prewarm_shapes;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
   bool enable_cpu_mem_arena = true;
 
+  // growth policy, limits, per-thread caches and shrink policy of the CPU memory arena.
+  ArenaConfig cpu_arena_config;
+
+  // share the initializers placed on CPU through the process wide SharedInitializedTensors, so sessions of models
+  // that have weights in common hold one copy of them.
+  bool enable_shared_initializer_cache = false;
+
+  // fuse MatMul + Add into Gemm, and Gemm + activation into FusedGemm when CPU is the only execution provider as
+  // FusedGemm only has a CPU kernel.
+  bool enable_gemm_fusion = true;
+
+  // run the CNN parts of the graph on MLAS in the blocked channel (NCHWc) layout. see NchwcTransformer.
+  bool enable_nchwc_layout = false;
+
+  // measure the MLAS convolution algorithms and thread strides for each convolution shape on first use and run
+  // the fastest. the choices are cached for the process, and a session enabling this enables it for the process.
+  bool enable_conv_autotuning = false;
+
+  // keep the float16 weights of Gemm and 2-D MatMul nodes that run on CPU in float16, converting them to float as
+  // MLAS packs them instead of casting them to a float copy. this halves the weight memory and bandwidth.
+  bool keep_float16_weights = false;
+
   // the prefix of the profile file. The current time will be appended to the file name.
   std::string profile_file_prefix = "onnxruntime_profile_";
 
@@ -164,6 +196,21 @@ class InferenceSession {
     */
   common::Status Load(std::istream& model_istream);
 
+  /**
+    * Load an ONNX model.
+    * @param model_data serialized ModelProto of the model. it's only used during this call.
+    * @param model_data_len length of model_data in bytes.
+    * @return OK if success.
+    */
+  common::Status Load(const void* model_data, int model_data_len);
+
+  /**
+    * Load an ONNX model that was parsed once to be loaded by many sessions.
+    * The initializers this session places on CPU use the memory of prepared_model, which this session keeps alive.
+    * @return OK if success.
+    */
+  common::Status Load(std::shared_ptr<const PreparedModel> prepared_model);
+
   /**
     * Initializes a previously loaded model. Initialization includes but is not
     * limited to graph transformations, construction of kernels, etc.
@@ -232,6 +279,13 @@ class InferenceSession {
     */
   int GetCurrentNumRuns();
 
+  /**
+    * Get the runtime statistics of the arena behind the given allocator.
+    * @param info identifies the allocator. Must belong to a registered execution provider and be backed by an arena.
+    * @param stats receives the statistics.
+    */
+  common::Status GetAllocatorStats(const OrtAllocatorInfo& info, AllocatorStats* stats) const;
+
   /**
     * Start profiling on this inference session. This simply turns on profiling events to be 
     * recorded. A corresponding EndProfiling has to follow to write profiling data to a file.
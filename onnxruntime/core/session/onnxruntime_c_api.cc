@@ -8,6 +8,7 @@
 #include "core/framework/execution_provider.h"
 #include <cassert>
 #include <cstring>
+#include <limits>
 #include <sstream>
 
 #include "core/common/logging/logging.h"
@@ -22,6 +23,7 @@
 #include "core/framework/onnxruntime_typeinfo.h"
 #include "core/framework/onnx_object_cxx.h"
 #include "core/session/inference_session.h"
+#include "core/session/prepared_model.h"
 
 #include "abi_session_options_impl.h"
 
@@ -350,8 +352,9 @@ ORT_API_STATUS_IMPL(OrtCreateTensorAsONNXValue, _Inout_ OrtAllocator* allocator,
   API_IMPL_END
 }
 
-template <typename T>
-static ONNXStatus* CreateInferenceSessionImpl(_In_ OrtEnv* env, _In_ T model_path,
+// load_model is called with the session to load the model into it
+template <typename LoadModelFn>
+static ONNXStatus* CreateInferenceSessionImpl(_In_ OrtEnv* env, const LoadModelFn& load_model,
                                               _In_ const OrtSessionOptions* options,
                                               _Out_ ONNXSession** out) {
   API_IMPL_BEGIN
@@ -371,7 +374,7 @@ static ONNXStatus* CreateInferenceSessionImpl(_In_ OrtEnv* env, _In_ T model_pat
       sess->RegisterExecutionProvider(std::unique_ptr<onnxruntime::IExecutionProvider>(
           reinterpret_cast<onnxruntime::IExecutionProvider*>(provider)));
     }
-  status = sess->Load(model_path);
+  status = load_model(*sess);
   if (!status.IsOK())
     return ToONNXStatus(status);
   status = sess->Initialize();
@@ -386,18 +389,57 @@ static ONNXStatus* CreateInferenceSessionImpl(_In_ OrtEnv* env, _In_ T model_pat
 ORT_API_STATUS_IMPL(OrtCreateInferenceSession, _In_ OrtEnv* env, _In_ const wchar_t* model_path,
                     _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out) {
   API_IMPL_BEGIN
-  return CreateInferenceSessionImpl(env, model_path, options, out);
+  return CreateInferenceSessionImpl(
+      env, [model_path](::onnxruntime::InferenceSession& sess) { return sess.Load(model_path); }, options, out);
   API_IMPL_END
 }
 #else
 ORT_API_STATUS_IMPL(OrtCreateInferenceSession, _In_ OrtEnv* env, _In_ const char* model_path,
                     _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out) {
   API_IMPL_BEGIN
-  return CreateInferenceSessionImpl(env, model_path, options, out);
+  return CreateInferenceSessionImpl(
+      env, [model_path](::onnxruntime::InferenceSession& sess) { return sess.Load(model_path); }, options, out);
   API_IMPL_END
 }
 #endif
 
+ORT_API_STATUS_IMPL(OrtCreateInferenceSessionFromArray, _In_ OrtEnv* env, _In_ const void* model_data,
+                    size_t model_data_len, _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out) {
+  API_IMPL_BEGIN
+  if (model_data_len > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return CreateONNXStatus(ORT_INVALID_ARGUMENT, "model_data_len is too large");
+  }
+  return CreateInferenceSessionImpl(
+      env,
+      [model_data, model_data_len](::onnxruntime::InferenceSession& sess) {
+        return sess.Load(model_data, static_cast<int>(model_data_len));
+      },
+      options, out);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtCreatePreparedModel, _In_ OrtEnv*, _In_ const void* model_data, size_t model_data_len,
+                    _Out_ OrtPreparedModel** out) {
+  API_IMPL_BEGIN
+  std::shared_ptr<const ::onnxruntime::PreparedModel> prepared_model;
+  auto status = ::onnxruntime::PreparedModel::Create(model_data, model_data_len, prepared_model);
+  if (!status.IsOK())
+    return ToONNXStatus(status);
+  *out = reinterpret_cast<OrtPreparedModel*>(new std::shared_ptr<const ::onnxruntime::PreparedModel>(prepared_model));
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtCreateInferenceSessionFromPreparedModel, _In_ OrtEnv* env, _In_ const OrtPreparedModel* model,
+                    _In_ const OrtSessionOptions* options, _Out_ ONNXSession** out) {
+  API_IMPL_BEGIN
+  const auto& prepared_model = *reinterpret_cast<const std::shared_ptr<const ::onnxruntime::PreparedModel>*>(model);
+  return CreateInferenceSessionImpl(
+      env, [&prepared_model](::onnxruntime::InferenceSession& sess) { return sess.Load(prepared_model); },
+      options, out);
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtRunInference, _In_ ONNXSession* sess,
                     _In_ OrtRunOptions* run_options,
                     _In_ const char* const* input_names, _In_ const ONNXValue* const* input, size_t input_len,
@@ -542,6 +584,30 @@ ORT_API_STATUS_IMPL(OrtInferenceSessionGetOutputCount, _In_ const ONNXSession* s
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtInferenceSessionGetAllocatorStats, _In_ const ONNXSession* sess, _In_ const OrtAllocatorInfo* info,
+                    _Out_ OrtAllocatorStats* out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  ::onnxruntime::AllocatorStats stats;
+  auto status = session->GetAllocatorStats(*info, &stats);
+  if (!status.IsOK())
+    return ToONNXStatus(status);
+  out->num_allocs = stats.num_allocs;
+  out->bytes_in_use = stats.bytes_in_use;
+  out->total_allocated_bytes = stats.total_allocated_bytes;
+  out->max_bytes_in_use = stats.max_bytes_in_use;
+  out->max_alloc_size = stats.max_alloc_size;
+  out->bytes_limit = stats.bytes_limit;
+  out->num_thread_cache_hits = stats.num_thread_cache_hits;
+  out->bytes_in_thread_caches = stats.bytes_in_thread_caches;
+  out->num_regions_released = stats.num_regions_released;
+  out->bytes_released = stats.bytes_released;
+  out->num_extends = stats.num_extends;
+  out->largest_free_block = stats.largest_free_block;
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtInferenceSessionGetInputTypeInfo, _In_ const ONNXSession* sess, size_t index, _Out_ struct OrtTypeInfo** out) {
   API_IMPL_BEGIN
   auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
@@ -634,6 +700,7 @@ ORT_API_STATUS_IMPL(OrtInferenceSessionGetOutputName, _In_ const ONNXSession* se
 
 DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION(ONNXValue, MLValue)
 DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION(ONNXSession, ::onnxruntime::InferenceSession)
+DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION(OrtPreparedModel, std::shared_ptr<const ::onnxruntime::PreparedModel>)
 DEFINE_RELEASE_ONNX_RUNTIME_OBJECT_FUNCTION_FOR_ARRAY(ONNXStatus, char)
 
 ORT_API(void, ReleaseONNXEnv, OrtEnv* env) {
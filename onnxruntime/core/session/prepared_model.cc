@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/prepared_model.h"
+
+#include <limits>
+
+namespace onnxruntime {
+common::Status PreparedModel::Create(const void* model_data, size_t model_data_len,
+                                     std::shared_ptr<const PreparedModel>& prepared_model) {
+  if (model_data == nullptr) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "model_data is null");
+  }
+  if (model_data_len > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "model_data_len is too large");
+  }
+
+  std::shared_ptr<PreparedModel> result(new PreparedModel());
+  if (!result->model_proto_.ParseFromArray(model_data, static_cast<int>(model_data_len))) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_PROTOBUF,
+                          "Failed to load model because protobuf parsing failed.");
+  }
+
+  ORT_RETURN_IF_ERROR(SharedInitializedTensors::Create(*result->model_proto_.mutable_graph(), result->initializers_));
+
+  prepared_model = std::move(result);
+  return common::Status::OK();
+}
+
+std::unique_ptr<ONNX_NAMESPACE::ModelProto> PreparedModel::CopyModelProto() const {
+  auto model_proto = std::make_unique<ONNX_NAMESPACE::ModelProto>(model_proto_);
+  initializers_->RestorePayloads(*model_proto->mutable_graph());
+  return model_proto;
+}
+}  // namespace onnxruntime
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+
+#include "core/common/common.h"
+#include "core/framework/shared_initialized_tensors.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+/**
+An immutable, parsed ONNX model whose initializers are deserialized once.
+Sessions loaded from the same PreparedModel share the memory of the initializers they place on CPU.
+The weights are only held by the deserialized tensors, not by the ModelProto as well.
+*/
+class PreparedModel {
+ public:
+  // parse the serialized ModelProto in model_data and deserialize its initializers.
+  static common::Status Create(const void* model_data, size_t model_data_len,
+                               std::shared_ptr<const PreparedModel>& prepared_model);
+
+  // the ModelProto without the payloads of the initializers held by Initializers().
+  const ONNX_NAMESPACE::ModelProto& GetModelProto() const noexcept { return model_proto_; }
+
+  // a complete copy of the ModelProto for a session to load.
+  std::unique_ptr<ONNX_NAMESPACE::ModelProto> CopyModelProto() const;
+
+  const SharedInitializedTensors& Initializers() const noexcept { return *initializers_; }
+
+ private:
+  PreparedModel() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PreparedModel);
+
+  ONNX_NAMESPACE::ModelProto model_proto_;
+  std::shared_ptr<SharedInitializedTensors> initializers_;
+};
+}  // namespace onnxruntime
@@ -71,6 +71,42 @@ const DataTypeImpl* NumpyToOnnxRuntimeTensorType(int numpy_type) {
   }
 }
 
+// Frees the buffer of a tensor wrapping the data of a numpy array in place,
+// by releasing the reference to the array the tensor holds.
+class NumpyArrayBufferOwner : public IAllocator {
+ public:
+  // takes over the reference to array
+  NumpyArrayBufferOwner(PyArrayObject* array, const OrtAllocatorInfo& info) : array_(array), info_(info) {}
+
+  ~NumpyArrayBufferOwner() override {
+    ReleaseArray();
+  }
+
+  void* Alloc(size_t /*size*/) override {
+    throw std::runtime_error("NumpyArrayBufferOwner does not allocate memory.");
+  }
+
+  void Free(void* /*p*/) override {
+    ReleaseArray();
+  }
+
+  const OrtAllocatorInfo& Info() const override {
+    return info_;
+  }
+
+ private:
+  void ReleaseArray() {
+    if (array_ != nullptr) {
+      // the tensor may be released by an executor thread
+      py::gil_scoped_acquire gil;
+      Py_CLEAR(array_);
+    }
+  }
+
+  PyArrayObject* array_;
+  OrtAllocatorInfo info_;
+};
+
 bool PyObjectCheck_Array(PyObject* o) {
   return PyObject_HasAttrString(o, "__array_finalize__");
 }
@@ -94,6 +130,20 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
 
     TensorShape shape(dims);
     auto element_type = NumpyToOnnxRuntimeTensorType(npy_type);
+
+    if (npy_type != NPY_UNICODE && npy_type != NPY_STRING && npy_type != NPY_VOID && npy_type != NPY_OBJECT &&
+        PyArray_ISCARRAY_RO(darray)) {
+      // use the numpy buffer in place. the tensor keeps the array alive until it's released.
+      auto owner = std::make_shared<NumpyArrayBufferOwner>(darray, alloc->Info());
+      dref = true;
+      std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type, shape, PyArray_DATA(darray),
+                                                                  owner->Info(), owner);
+      p_mlvalue->Init(p_tensor.release(),
+                      DataTypeImpl::GetType<Tensor>(),
+                      DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+      return;
+    }
+
     void* buffer = alloc->Alloc(element_type->Size() * shape.Size());
 
     if (npy_type != NPY_UNICODE && npy_type != NPY_OBJECT) {
@@ -179,6 +229,33 @@ void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyAr
   }
 }
 
+void CreateTensorMLValueOnNumpyBuffer(const OrtAllocatorInfo& info, const std::string& name_output, py::object& value,
+                                      MLValue* p_mlvalue) {
+  if (!PyObjectCheck_Array(value.ptr())) {
+    throw std::runtime_error("Output '" + name_output + "' must be bound to a numpy array.");
+  }
+
+  PyArrayObject* array = reinterpret_cast<PyArrayObject*>(value.ptr());
+  const int npy_type = PyArray_TYPE(array);
+  if (npy_type == NPY_UNICODE || npy_type == NPY_STRING || npy_type == NPY_VOID || npy_type == NPY_OBJECT ||
+      !PyArray_ISCARRAY(array)) {
+    throw std::runtime_error("Output '" + name_output +
+                             "' must be bound to a writeable, C-contiguous numpy array of a numeric type.");
+  }
+
+  int ndim = PyArray_NDIM(array);
+  npy_intp* npy_dims = PyArray_DIMS(array);
+  std::vector<int64_t> dims(npy_dims, npy_dims + ndim);
+
+  Py_INCREF(array);
+  auto owner = std::make_shared<NumpyArrayBufferOwner>(array, info);
+  std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(NumpyToOnnxRuntimeTensorType(npy_type), TensorShape(dims),
+                                                              PyArray_DATA(array), owner->Info(), owner);
+  p_mlvalue->Init(p_tensor.release(),
+                  DataTypeImpl::GetType<Tensor>(),
+                  DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+}
+
 std::string _get_type_name(int64_t&) {
   return std::string("int64_t");
 }
@@ -26,5 +26,10 @@ int OnnxRuntimeTensorToNumpyType(const DataTypeImpl* tensor_type);
 
 void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue);
 
+// Creates a tensor using the buffer of a writeable, C-contiguous numeric numpy array in place,
+// for kernels to write an output into. The tensor keeps a reference to the array.
+void CreateTensorMLValueOnNumpyBuffer(const OrtAllocatorInfo& info, const std::string& name_output, py::object& value,
+                                      MLValue* p_mlvalue);
+
 }  // namespace python
 }  // namespace onnxruntime
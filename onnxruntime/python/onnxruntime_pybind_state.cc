@@ -42,6 +42,7 @@
 
 #define BACKEND_DEVICE BACKEND_PROC BACKEND_MKLDNN BACKEND_MKLML BACKEND_OPENBLAS
 #include "core/session/onnxruntime_cxx_api.h"
+#include "core/session/IOBinding.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/cpu_provider_factory.h"
 
@@ -121,7 +122,14 @@ void AddNonTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs)
   }
 }
 
-void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
+// Keeps the MLValue a numpy output array points into alive, and the session it came from,
+// as the value may be one of its initializers.
+struct NumpyOutputOwner {
+  MLValue value;
+  py::object session;
+};
+
+void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs, const py::object& session) {
   const Tensor& rtensor = val.Get<Tensor>();
   std::vector<npy_intp> npy_dims;
   const TensorShape& shape = rtensor.Shape();
@@ -132,6 +140,22 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
 
   MLDataType dtype = rtensor.DataType();
   const int numpy_type = OnnxRuntimeTensorToNumpyType(dtype);
+
+  if (numpy_type != NPY_OBJECT && rtensor.OwnsBuffer()) {
+    // hand the tensor buffer to numpy without a copy. the array owns the MLValue through a capsule.
+    py::capsule base(new NumpyOutputOwner{val, session},
+                     [](void* p) { delete static_cast<NumpyOutputOwner*>(p); });
+    py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+        shape.NumDimensions(), npy_dims.data(), numpy_type, const_cast<void*>(rtensor.DataRaw(dtype))));
+    if (!obj) {
+      throw py::error_already_set();
+    }
+    // steals the reference to base
+    PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), base.release().ptr());
+    pyobjs.push_back(obj);
+    return;
+  }
+
   py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNew(
       shape.NumDimensions(), npy_dims.data(), numpy_type));
 
@@ -151,6 +175,22 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
   pyobjs.push_back(obj);
 }
 
+// IOBinding of a session with the numpy arrays its outputs are bound to.
+// Bound arrays are used in place, so runs with the same binding reuse them.
+struct SessionIOBinding {
+  explicit SessionIOBinding(InferenceSession* sess) : session(sess) {
+    auto status = sess->NewIOBinding(&binding);
+    if (!status.IsOK()) {
+      throw std::runtime_error(status.ToString().c_str());
+    }
+  }
+
+  InferenceSession* session;
+  std::unique_ptr<IOBinding> binding;
+  // array each output is bound to, None for outputs bound by name only
+  std::unordered_map<std::string, py::object> output_arrays;
+};
+
 class SessionObjectInitializer {
  public:
   typedef const SessionOptions& Arg1;
@@ -376,10 +416,14 @@ including arg name, arg type (contains both type and shape).)pbdoc")
         std::vector<MLValue> fetches;
         common::Status status;
 
-        if (run_options != nullptr) {
-          status = sess->Run(*run_options, feeds, output_names, &fetches);
-        } else {
-          status = sess->Run(feeds, output_names, &fetches);
+        {
+          // let other python threads run while the model runs
+          py::gil_scoped_release release;
+          if (run_options != nullptr) {
+            status = sess->Run(*run_options, feeds, output_names, &fetches);
+          } else {
+            status = sess->Run(feeds, output_names, &fetches);
+          }
         }
 
         if (!status.IsOK()) {
@@ -389,15 +433,38 @@ including arg name, arg type (contains both type and shape).)pbdoc")
 
         std::vector<py::object> rfetch;
         rfetch.reserve(fetches.size());
+        py::object session = py::cast(sess, py::return_value_policy::reference);
         for (auto _ : fetches) {
           if (_.IsTensor()) {
-            AddTensorAsPyObj(_, rfetch);
+            AddTensorAsPyObj(_, rfetch, session);
           } else {
             AddNonTensorAsPyObj(_, rfetch);
           }
         }
         return rfetch;
       })
+      .def("run_with_iobinding", [](InferenceSession* sess, SessionIOBinding* io_binding, RunOptions* run_options = nullptr) -> void {
+        // outputs bound by name only get new values on every run
+        for (const auto& output : io_binding->output_arrays) {
+          if (output.second.is_none()) {
+            io_binding->binding->BindOutput(output.first, MLValue());
+          }
+        }
+
+        common::Status status;
+        {
+          py::gil_scoped_release release;
+          if (run_options != nullptr) {
+            status = sess->Run(*run_options, *io_binding->binding);
+          } else {
+            status = sess->Run(*io_binding->binding);
+          }
+        }
+
+        if (!status.IsOK()) {
+          throw std::runtime_error("Method run_with_iobinding failed due to: " + status.ToString());
+        }
+      })
       .def("end_profiling", [](InferenceSession* sess) -> std::string {
         return sess->EndProfiling();
       })
@@ -427,6 +494,58 @@ including arg name, arg type (contains both type and shape).)pbdoc")
       });
 }
 
+void addIoBindingMethods(py::module& m) {
+  py::class_<SessionIOBinding>(m, "SessionIOBinding", R"pbdoc(Inputs and outputs bound to a session for run_with_iobinding.)pbdoc")
+      .def(py::init<InferenceSession*>(), py::keep_alive<1, 2>())
+      .def("bind_input", [](SessionIOBinding* io_binding, const std::string& name, py::object value) -> void {
+        MLValue ml_value;
+        CreateGenericMLValue(GetAllocator(), name, value, &ml_value);
+        auto status = io_binding->binding->BindInput(name, ml_value);
+        if (!status.IsOK()) {
+          throw std::runtime_error("Error when binding input: " + status.ToString());
+        }
+      })
+      .def("bind_output", [](SessionIOBinding* io_binding, const std::string& name, py::object value) -> void {
+        MLValue ml_value;
+        if (!value.is_none()) {
+          CreateTensorMLValueOnNumpyBuffer(GetAllocator()->Info(), name, value, &ml_value);
+        }
+        auto status = io_binding->binding->BindOutput(name, ml_value);
+        if (!status.IsOK()) {
+          throw std::runtime_error("Error when binding output: " + status.ToString());
+        }
+        io_binding->output_arrays[name] = value;
+      }, py::arg("name"), py::arg("value") = py::none())
+      .def("clear_binding_inputs", [](SessionIOBinding* io_binding) -> void {
+        io_binding->binding->ClearInputs();
+      })
+      .def("clear_binding_outputs", [](SessionIOBinding* io_binding) -> void {
+        io_binding->binding->ClearOutputs();
+        io_binding->output_arrays.clear();
+      })
+      .def("get_outputs", [](SessionIOBinding* io_binding) -> std::vector<py::object> {
+        const auto& names = io_binding->binding->GetOutputNames();
+        auto& outputs = io_binding->binding->GetOutputs();
+        py::object session = py::cast(io_binding->session, py::return_value_policy::reference);
+
+        std::vector<py::object> rfetch;
+        rfetch.reserve(outputs.size());
+        for (size_t i = 0; i < outputs.size(); ++i) {
+          const auto& array = io_binding->output_arrays.at(names[i]);
+          if (!array.is_none()) {
+            rfetch.push_back(array);
+          } else if (!outputs[i].IsAllocated()) {
+            rfetch.push_back(py::none());
+          } else if (outputs[i].IsTensor()) {
+            AddTensorAsPyObj(outputs[i], rfetch, session);
+          } else {
+            AddNonTensorAsPyObj(outputs[i], rfetch);
+          }
+        }
+        return rfetch;
+      });
+}
+
 PYBIND11_MODULE(onnxruntime_pybind11_state, m) {
   m.doc() = "pybind11 stateful interface to ONNX runtime";
 
@@ -453,6 +572,7 @@ PYBIND11_MODULE(onnxruntime_pybind11_state, m) {
 
   addGlobalMethods(m);
   addObjectMethods(m);
+  addIoBindingMethods(m);
 }
 
 }  // namespace python
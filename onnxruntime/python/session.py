@@ -61,6 +61,11 @@ class InferenceSession:
         ::
 
             sess.run([output_name], {input_name: x})
+
+        C-contiguous numeric arrays are read in place and must not be modified
+        while the run is in progress. The GIL is released during the run,
+        so several threads can run the same session concurrently.
+        Numeric outputs are returned without a copy.
         """
         num_required_inputs = len(self._inputs_meta)
         num_inputs = len(input_feed)
@@ -71,6 +76,26 @@ class InferenceSession:
             output_names = [output.name for output in self._outputs_meta]
         return self._sess.run(output_names, input_feed, run_options)
 
+    def io_binding(self):
+        "Return an :class:`onnxruntime.IOBinding` to bind inputs and outputs of this session."
+        return IOBinding(self)
+
+    def run_with_iobinding(self, iobinding, run_options=None):
+        """
+        Compute the predictions with the inputs and outputs of a binding.
+
+        :param iobinding: See :class:`onnxruntime.IOBinding`.
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+
+        ::
+
+            binding = sess.io_binding()
+            binding.bind_input(input_name, x)
+            binding.bind_output(output_name, y)
+            sess.run_with_iobinding(binding)
+        """
+        self._sess.run_with_iobinding(iobinding._iobinding, run_options)
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -79,3 +104,41 @@ class InferenceSession:
         :meth:`onnxruntime.SessionOptions.enable_profiling`.
         """
         return self._sess.end_profiling()
+
+
+class IOBinding:
+    """
+    Inputs and outputs bound to a session. The binding can be run many times
+    with :meth:`InferenceSession.run_with_iobinding`.
+
+    Numeric C-contiguous arrays are used in place: update them in place
+    between runs instead of binding new arrays. Outputs bound to an array
+    are written into it, so runs with the same shapes allocate no outputs.
+    """
+    def __init__(self, session):
+        self._iobinding = C.SessionIOBinding(session._sess)
+
+    def bind_input(self, name, value):
+        """
+        :param name: input name
+        :param value: input value, as for :meth:`InferenceSession.run`
+        """
+        self._iobinding.bind_input(name, value)
+
+    def bind_output(self, name, value=None):
+        """
+        :param name: output name
+        :param value: writeable C-contiguous numpy array with the type and shape of the output,
+            or None to get a new value on every run
+        """
+        self._iobinding.bind_output(name, value)
+
+    def clear_binding_inputs(self):
+        self._iobinding.clear_binding_inputs()
+
+    def clear_binding_outputs(self):
+        self._iobinding.clear_binding_outputs()
+
+    def get_outputs(self):
+        "Return the outputs of the last run, in the order they were bound."
+        return self._iobinding.get_outputs()
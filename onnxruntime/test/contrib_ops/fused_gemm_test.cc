@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// A * B + C with A of {2, 3}, B of {3, 2} and a bias C of {2}, followed by the activation.
+void RunFusedGemmTest(const std::string& activation, const std::vector<float>& activation_params,
+                      const std::function<float(float)>& expected_activation) {
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("activation", activation);
+  if (!activation_params.empty()) {
+    test.AddAttribute("activation_params", activation_params);
+  }
+
+  test.AddInput<float>("A", {2, 3}, {1.0f, 2.0f, 3.0f, -4.0f, -5.0f, -6.0f});
+  test.AddInput<float>("B", {3, 2}, {1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f});
+  test.AddInput<float>("C", {2}, {0.5f, -1.0f});
+
+  std::vector<float> expected{4.5f, 4.0f, -9.5f, -12.0f};
+  for (auto& value : expected) {
+    value = expected_activation(value);
+  }
+  test.AddOutput<float>("Y", {2, 2}, expected);
+  test.Run();
+}
+}  // namespace
+
+TEST(FusedGemmTest, Relu) {
+  RunFusedGemmTest("Relu", {}, [](float x) { return std::max(x, 0.0f); });
+}
+
+TEST(FusedGemmTest, LeakyRelu) {
+  RunFusedGemmTest("LeakyRelu", {0.1f}, [](float x) { return x >= 0.0f ? x : 0.1f * x; });
+}
+
+TEST(FusedGemmTest, Sigmoid) {
+  RunFusedGemmTest("Sigmoid", {}, [](float x) { return 1.0f / (1.0f + std::exp(-x)); });
+}
+
+TEST(FusedGemmTest, Tanh) {
+  RunFusedGemmTest("Tanh", {}, [](float x) { return std::tanh(x); });
+}
+
+TEST(FusedGemmTest, Clip) {
+  RunFusedGemmTest("Clip", {-10.0f, 4.2f}, [](float x) { return std::min(std::max(x, -10.0f), 4.2f); });
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/mlas/inc/mlas.h"
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ContribOpTest, NchwcConv_ZeroFilter) {
+  const int64_t block = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  OpTester test("NchwcConv", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {1, block, 2, 2}, std::vector<float>(block * 4, 1.0f));
+  test.AddInput<float>("W", {block, block, 1, 1}, std::vector<float>(block * block, 0.0f), true);
+  test.AddOutput<float>("Y", {1, block, 2, 2}, std::vector<float>(block * 4, 0.0f));
+  test.Run();
+}
+
+TEST(ContribOpTest, NchwcConv_OutputChannelsNotBlocked) {
+  // the input channels are a multiple of the block size, the output channels are not
+  const int64_t block = static_cast<int64_t>(MlasNchwcGetBlockSize());
+  OpTester test("NchwcConv", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {1, block, 2, 2}, std::vector<float>(block * 4, 1.0f));
+  test.AddInput<float>("W", {1, block, 1, 1}, std::vector<float>(block, 0.0f), true);
+  test.AddOutput<float>("Y", {1, 1, 2, 2}, std::vector<float>(4, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "NchwcConv filter channels must be multiples of the block size");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -149,6 +149,7 @@ class PlannerTest : public ::testing::Test {
 
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel_;    // a variadic kernel with no-aliasing and no-in-place
 
   std::unordered_map<std::string, onnxruntime::NodeArg*> name_to_arg_;
   std::vector<std::unique_ptr<UnaryNode>> nodes_;
@@ -163,6 +164,7 @@ class PlannerTest : public ::testing::Test {
   PlannerTest() : model_("test"), graph_{model_.MainGraph()}, state_{execution_providers_} {
     std_kernel_ = KernelDefBuilder().SetName("Transpose").Build();
     in_place_kernel_ = KernelDefBuilder().SetName("Clip").MayInplace(0, 0).Build();
+    concat_kernel_ = KernelDefBuilder().SetName("Concat").Build();
     CPUExecutionProviderInfo epi;
     auto execution_provider = std::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -193,6 +195,18 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*in_place_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddConcatNode(std::initializer_list<std::string> inputs, std::string& output, int64_t axis) {
+    std::vector<onnxruntime::NodeArg*> input_args;
+    for (auto& input : inputs) input_args.push_back(Arg(input));
+    std::vector<onnxruntime::NodeArg*> output_args{Arg(output)};
+    auto* p_node = &graph_.AddNode("node" + std::to_string(NodeCounter::Next()), "Concat", "test op",
+                                   input_args, output_args);
+    p_node->AddAttribute("axis", axis);
+    p_node->SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+    kernel_bindings_.emplace_back(p_node, *concat_kernel_);
+    return p_node;
+  }
+
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def) {
     auto info = std::make_unique<OpKernelInfo>(*p_node, kernel_def, *execution_providers_.Get(*p_node), state_);
     auto dummy = std::make_unique<DummyOpKernel>(*info);
@@ -247,6 +261,20 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckReusedBuffer(const std::string& name, const std::string& reused_name, size_t offset) {
+    int id, reused_id;
+    index(name, id);
+    index(reused_name, reused_id);
+    EXPECT_EQ(plan_->allocation_plan[id].reused_buffer, reused_id) << "Error in reused buffer for " << name;
+    EXPECT_EQ(plan_->allocation_plan[id].reused_buffer_offset, offset) << "Error in reused buffer offset for " << name;
+  }
+
+  void CheckAllocateEarly(const std::string& name, bool allocate_early) {
+    int id;
+    index(name, id);
+    EXPECT_EQ(plan_->allocation_plan[id].allocate_early, allocate_early) << "Error in allocate_early for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -409,6 +437,74 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// InPlaceConcatTest: Check that Concat inputs are placed in the Concat output when the
+// dimensions before the concat axis are all 1.
+TEST_F(PlannerTest, InPlaceConcatTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), A("A"), B("B"), C("C"), Y("Y");
+
+  // graph structure:
+  AddNormalNode(X1, A);           // X1: input; A: temporary
+  AddNormalNode(X2, B);           // X2: input; B: temporary
+  AddConcatNode({A, B}, C, -2);   // C: temporary
+  AddNormalNode(C, Y);            // Y: output
+
+  // simulate shape-inference results:
+  Shape shape_a{1, 2, 4};
+  Shape shape_b{1, 3, 4};
+  Shape shape_c{1, 5, 4};
+  SetShape({{X1, &shape_a.value}, {A, &shape_a.value}, {X2, &shape_b.value}, {B, &shape_b.value},
+            {C, &shape_c.value}, {Y, &shape_c.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(A, AllocKind::kReuse);
+  CheckAllocKind(B, AllocKind::kReuse);
+  CheckAllocKind(C, AllocKind::kAllocate);
+  CheckAllocKind(Y, AllocKind::kAllocateOutput);
+  CheckReusedBuffer(A, C, 0);
+  CheckReusedBuffer(B, C, 2 * 4 * sizeof(float));
+  CheckAllocateEarly(C, true);
+
+  // A and B live in C's buffer, which is freed after its last use
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {});
+  CheckFreed(3, {C});
+}
+
+// InPlaceConcatStridedTest: Check that Concat inputs are copied when their slices of the
+// Concat output are not contiguous.
+TEST_F(PlannerTest, InPlaceConcatStridedTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), A("A"), B("B"), C("C"), Y("Y");
+
+  // graph structure:
+  AddNormalNode(X1, A);
+  AddNormalNode(X2, B);
+  AddConcatNode({A, B}, C, 1);
+  AddNormalNode(C, Y);
+
+  // simulate shape-inference results:
+  Shape shape_a{2, 2, 4};
+  Shape shape_b{2, 3, 4};
+  Shape shape_c{2, 5, 4};
+  SetShape({{X1, &shape_a.value}, {A, &shape_a.value}, {X2, &shape_b.value}, {B, &shape_b.value},
+            {C, &shape_c.value}, {Y, &shape_c.value}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(A, AllocKind::kAllocate);
+  CheckAllocKind(B, AllocKind::kAllocate);
+  CheckAllocKind(C, AllocKind::kAllocate);
+  CheckAllocateEarly(C, false);
+
+  CheckFreed(2, {A, B});
+  CheckFreed(3, {C});
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -3,7 +3,10 @@
 
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
+#include <condition_variable>
 #include <cstdlib>
+#include <mutex>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -234,5 +237,226 @@ TEST(BFCArenaTest, TestReserve) {
   a.GetStats(&stats);
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
+
+TEST(BFCArenaTest, ThreadCacheRecyclesChunks) {
+  ArenaConfig config;
+  config.thread_cache_bytes = 4096;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  void* first_ptr = a.Alloc(1000);
+  a.Free(first_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+
+  // same size class comes back from the cache
+  void* second_ptr = a.Alloc(1020);
+  EXPECT_EQ(first_ptr, second_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  // larger than the cache limit, goes straight back to the bins
+  void* big_ptr = a.Alloc(8192);
+  a.Free(big_ptr);
+  a.Free(second_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+
+  a.Shrink();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheCrossThreadFree) {
+  ArenaConfig config;
+  config.thread_cache_bytes = 1 << 16;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  void* ptr = a.Alloc(512);
+  std::thread([&a, ptr]() { a.Free(ptr); }).join();
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+
+  // the address is handed out again by another thread and freed here; it must go back to the arena
+  void* other_ptr = nullptr;
+  std::thread([&a, &other_ptr]() { other_ptr = a.Alloc(512); }).join();
+  EXPECT_EQ(ptr, other_ptr);
+  a.Free(other_ptr);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheRequestedSize) {
+  ArenaConfig config;
+  config.thread_cache_bytes = 4096;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  void* first_ptr = a.Alloc(1000);
+  EXPECT_EQ(a.RequestedSize(first_ptr), 1000);
+  a.Free(first_ptr);
+
+  void* second_ptr = a.Alloc(1020);
+  EXPECT_EQ(first_ptr, second_ptr);
+  EXPECT_EQ(a.RequestedSize(second_ptr), 1020);
+  a.Free(second_ptr);
+}
+
+TEST(BFCArenaTest, ShrinkFlushesCachesOfOtherThreads) {
+  ArenaConfig config;
+  config.thread_cache_bytes = 1 << 16;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  // the worker parks a chunk in its cache and stays alive, like a thread of a pool
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool cached = false;
+  bool done = false;
+  std::thread worker([&]() {
+    a.Free(a.Alloc(512));
+    std::unique_lock<std::mutex> lock(mutex);
+    cached = true;
+    cv.notify_all();
+    cv.wait(lock, [&]() { return done; });
+  });
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() { return cached; });
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 512);
+
+  a.Shrink();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  cv.notify_all();
+  worker.join();
+}
+
+TEST(BFCArenaTest, ShrinkReleasesFreeRegions) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  void* small_ptr = a.Alloc(1024);
+  void* large_ptr = a.Alloc(1 << 24);
+  a.Free(large_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  int64_t total_allocated_bytes = stats.total_allocated_bytes;
+
+  // the region holding small_ptr is still in use
+  a.Shrink();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions_released, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 1048576);
+  EXPECT_EQ(stats.bytes_released, total_allocated_bytes - 1048576);
+
+  a.Free(small_ptr);
+  a.Shrink();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions_released, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
+
+TEST(BFCArenaTest, ShrinkThreshold) {
+  ArenaConfig config;
+  config.shrink_threshold_bytes = 1 << 20;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  void* small_ptr = a.Alloc(1024);
+  a.Free(small_ptr);
+
+  // a single 1MB region stays below the threshold
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions_released, 0);
+
+  void* large_ptr = a.Alloc(1 << 24);
+  a.Free(large_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_regions_released, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 1048576);
+}
+
+TEST(BFCArenaTest, ExtendStrategy) {
+  ArenaConfig config;
+  config.initial_chunk_bytes = 1 << 16;
+  config.extend_strategy = ArenaExtendStrategy::kSameAsRequested;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  void* first_ptr = a.Alloc(1024);
+  void* second_ptr = a.Alloc(1 << 20);
+  void* third_ptr = a.Alloc(1000);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_extends, 2);
+  EXPECT_EQ(stats.total_allocated_bytes, (1 << 16) + (1 << 20));
+
+  a.Free(first_ptr);
+  a.Free(second_ptr);
+  a.Free(third_ptr);
+
+  config.extend_strategy = ArenaExtendStrategy::kFixedIncrement;
+  config.extend_increment_bytes = 1 << 18;
+  BFCArena b(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  first_ptr = b.Alloc(1 << 16);
+  second_ptr = b.Alloc(1024);
+  third_ptr = b.Alloc(1 << 20);
+
+  b.GetStats(&stats);
+  EXPECT_EQ(stats.num_extends, 3);
+  EXPECT_EQ(stats.total_allocated_bytes, (1 << 16) + (1 << 18) + (1 << 20));
+
+  b.Free(first_ptr);
+  b.Free(second_ptr);
+  b.Free(third_ptr);
+}
+
+TEST(BFCArenaTest, ConfigMemoryLimit) {
+  ArenaConfig config;
+  config.max_mem = 1 << 20;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, config);
+
+  EXPECT_EQ(a.Max(), 1 << 20);
+  EXPECT_EQ(nullptr, a.Alloc(2 << 20));
+}
+
+TEST(BFCArenaTest, ReserveCapacity) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  EXPECT_TRUE(a.ReserveCapacity(3 << 20));
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_extends, 1);
+  EXPECT_GE(stats.largest_free_block, 3 << 20);
+
+  // served from the reserved region
+  void* ptr = a.Alloc(3 << 20);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_extends, 1);
+  a.Free(ptr);
+
+  EXPECT_FALSE(a.ReserveCapacity(size_t{1} << 31));
+}
 }  // namespace test
 }  // namespace onnxruntime
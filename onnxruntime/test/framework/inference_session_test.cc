@@ -17,12 +17,14 @@
 #include "core/framework/session_state.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/compute_capability.h"
+#include "core/framework/customregistry.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/session/IOBinding.h"
+#include "core/session/prepared_model.h"
 #include "test/capturing_sink.h"
 #include "test/test_environment.h"
 #include "test/providers/provider_test_utils.h"
@@ -466,11 +468,15 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   std::string line;
 
   std::vector<std::string> tags = {"pid", "dur", "ts", "ph", "X", "name", "args"};
+  // the phases of session initialization, in the order they run
+  std::vector<std::string> init_phases = {"graph_transformation", "graph_partitioning", "graph_resolve",
+                                          "execution_planning", "initializer_loading", "kernel_creation",
+                                          "session_initialization"};
   int count = 0;
   while (std::getline(profile, line)) {
     if (count == 0) {
       ASSERT_TRUE(line.find("[") != string::npos);
-    } else if (count <= 7) {
+    } else if (count <= 13) {
       for (auto& s : tags) {
         ASSERT_TRUE(line.find(s) != string::npos);
       }
@@ -480,6 +486,8 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
 
     if (count == 1) {
       ASSERT_TRUE(line.find("model_loading_uri") != string::npos);
+    } else if (count >= 2 && count < 2 + static_cast<int>(init_phases.size())) {
+      ASSERT_TRUE(line.find(init_phases[count - 2]) != string::npos);
     }
     count++;
   }
@@ -625,6 +633,101 @@ TEST(InferenceSessionTests, TestWithIstream) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, TestWithArray) {
+  std::ifstream model_file_stream(MODEL_URI, ios::in | ios::binary);
+  ASSERT_TRUE(model_file_stream.good());
+  std::string model_data{std::istreambuf_iterator<char>(model_file_stream), std::istreambuf_iterator<char>()};
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestWithArray";
+
+  InferenceSession session_object{so};
+  ASSERT_TRUE(session_object.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "InferenceSessionTests.TestWithArray";
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, TestWithPreparedModel) {
+  std::ifstream model_file_stream(MODEL_URI, ios::in | ios::binary);
+  ASSERT_TRUE(model_file_stream.good());
+  std::string model_data{std::istreambuf_iterator<char>(model_file_stream), std::istreambuf_iterator<char>()};
+
+  std::shared_ptr<const PreparedModel> prepared_model;
+  ASSERT_TRUE(PreparedModel::Create(model_data.data(), model_data.size(), prepared_model).IsOK());
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestWithPreparedModel";
+
+  // the sessions keep what they use of the prepared model alive
+  InferenceSession session_object_1{so};
+  InferenceSession session_object_2{so};
+  ASSERT_TRUE(session_object_1.Load(prepared_model).IsOK());
+  ASSERT_TRUE(session_object_2.Load(prepared_model).IsOK());
+  prepared_model.reset();
+  ASSERT_TRUE(session_object_1.Initialize().IsOK());
+  ASSERT_TRUE(session_object_2.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "InferenceSessionTests.TestWithPreparedModel";
+  RunModel(session_object_1, run_options);
+  RunModel(session_object_2, run_options);
+}
+
+TEST(InferenceSessionTests, PreparedModelHoldsWeightsOnce) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& w = graph.GetOrCreateNodeArg("W", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add", "Add", "", {&x, &w}, {&y});
+
+  TensorProto weights;
+  weights.set_name("W");
+  weights.set_data_type(TensorProto_DataType_FLOAT);
+  weights.add_dims(3);
+  for (float value : {1.0f, 2.0f, 3.0f}) weights.add_float_data(value);
+  graph.AddInitializedTensor(weights);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+  std::shared_ptr<const PreparedModel> prepared_model;
+  ASSERT_TRUE(PreparedModel::Create(model_data.data(), model_data.size(), prepared_model).IsOK());
+
+  // the weights are only held by the deserialized tensor
+  EXPECT_EQ(prepared_model->Initializers().GetStats().bytes_in_use, 3 * sizeof(float));
+  const auto& initializers = prepared_model->GetModelProto().graph().initializer();
+  ASSERT_EQ(initializers.size(), 1);
+  EXPECT_FALSE(initializers[0].has_raw_data());
+  EXPECT_EQ(initializers[0].float_data_size(), 0);
+  EXPECT_EQ(prepared_model->CopyModelProto()->graph().initializer(0).raw_data().size(), 3 * sizeof(float));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.PreparedModelHoldsWeightsOnce";
+  for (int i = 0; i < 2; ++i) {
+    InferenceSession session_object{so};
+    ASSERT_TRUE(session_object.Load(prepared_model).IsOK());
+    ASSERT_TRUE(session_object.Initialize().IsOK());
+
+    MLValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {3}, {10.0f, 20.0f, 30.0f},
+                         &ml_value);
+    NameMLValMap feeds{{"X", ml_value}};
+    std::vector<MLValue> fetches;
+    ASSERT_TRUE(session_object.Run(RunOptions(), feeds, {"Y"}, &fetches).IsOK());
+    VerifyOutputs(fetches, {3}, {11.0f, 22.0f, 33.0f});
+  }
+}
+
 TEST(InferenceSessionTests, TestRegisterExecutionProvider) {
   SessionOptions so;
 
@@ -935,6 +1038,276 @@ TEST(InferenceSessionTests, TestOptionalInputs) {
   EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("Missing required inputs: required_input"));
 }
 
+// Abs kernel that may run in place and records whether it did
+class InPlaceRecordingAbsKernel : public OpKernel {
+ public:
+  InPlaceRecordingAbsKernel(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override {
+    const auto* X = context->Input<Tensor>(0);
+    auto* Y = context->Output(0, X->Shape());
+    ran_in_place = X->DataRaw() == Y->DataRaw();
+    const float* x = X->template Data<float>();
+    float* y = Y->template MutableData<float>();
+    for (int64_t i = 0; i < X->Shape().Size(); ++i) {
+      y[i] = std::abs(x[i]);
+    }
+    return Status::OK();
+  }
+
+  static bool ran_in_place;
+};
+
+bool InPlaceRecordingAbsKernel::ran_in_place = false;
+
+// The Concat output is allocated early and its statically shaped inputs are written into it.
+// A consumer reusing the Concat output in place must still do so at runtime.
+TEST(InferenceSessionTests, InPlaceConcatPreservesConsumerReuse) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  auto make_type = [](std::initializer_list<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    return type;
+  };
+  TypeProto type_a = make_type({1, 2, 2});
+  TypeProto type_b = make_type({1, 1, 2});
+
+  auto& x1 = graph.GetOrCreateNodeArg("X1", &type_a);
+  auto& x2 = graph.GetOrCreateNodeArg("X2", &type_b);
+  auto& a = graph.GetOrCreateNodeArg("A", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("B", nullptr);
+  auto& c = graph.GetOrCreateNodeArg("C", nullptr);
+  auto& d = graph.GetOrCreateNodeArg("D", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+
+  graph.AddNode("neg1", "Neg", "", {&x1}, {&a});
+  graph.AddNode("neg2", "Neg", "", {&x2}, {&b});
+  graph.AddNode("concat", "Concat", "", {&a, &b}, {&c}).AddAttribute("axis", int64_t{1});
+  graph.AddNode("abs", "Abs", "", {&c}, {&d});
+  graph.AddNode("neg3", "Neg", "", {&d}, {&y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  std::shared_ptr<CustomRegistry> registry = std::make_shared<CustomRegistry>();
+  KernelDefBuilder def;
+  def.SetName("Abs")
+      .SetDomain(onnxruntime::kOnnxDomain)
+      .SinceVersion(6)
+      .Provider(onnxruntime::kCpuExecutionProvider)
+      .MayInplace(0, 0)
+      .TypeConstraint("T", DataTypeImpl::GetTensorType<float>());
+  ASSERT_TRUE(registry->RegisterCustomKernel(def, [](const OpKernelInfo& info) -> OpKernel* {
+                        return new InPlaceRecordingAbsKernel(info);
+                      })
+                  .IsOK());
+
+  SessionOptions so;
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.RegisterCustomRegistry(registry).IsOK());
+  std::stringstream model_stream;
+  model.ToProto().SerializeToOstream(&model_stream);
+  ASSERT_TRUE(session_object.Load(model_stream).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::vector<float> values_x1 = {1.0f, -2.0f, 3.0f, -4.0f};
+  std::vector<float> values_x2 = {-5.0f, 6.0f};
+  MLValue ml_value_x1, ml_value_x2;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2, 2}, values_x1, &ml_value_x1);
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 2}, values_x2, &ml_value_x2);
+  NameMLValMap feeds{{"X1", ml_value_x1}, {"X2", ml_value_x2}};
+
+  // run twice so that the run using the traced memory pattern is covered too
+  for (int run = 0; run < 2; ++run) {
+    InPlaceRecordingAbsKernel::ran_in_place = false;
+    std::vector<MLValue> fetches;
+    ASSERT_TRUE(session_object.Run(RunOptions(), feeds, {"Y"}, &fetches).IsOK());
+    VerifyOutputs(fetches, {1, 3, 2}, {-1.0f, -2.0f, -3.0f, -4.0f, -5.0f, -6.0f});
+    EXPECT_TRUE(InPlaceRecordingAbsKernel::ran_in_place) << "run " << run;
+  }
+}
+
+// The N x N MatMul output grows quadratically with the symbolic dimension N. The pattern derived from
+// the runs with N = 2 and N = 4 mispredicts its size for N = 8, which must be traced again.
+TEST(InferenceSessionTests, SymbolicMemoryPatternRetracedOnMismatch) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  TypeProto type_a;
+  type_a.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_a.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  type_a.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto type_b;
+  type_b.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_b.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  type_b.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+
+  auto& a = graph.GetOrCreateNodeArg("A", &type_a);
+  auto& b = graph.GetOrCreateNodeArg("B", &type_b);
+  auto& c = graph.GetOrCreateNodeArg("C", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("matmul", "MatMul", "", {&a, &b}, {&c});
+  graph.AddNode("reduce", "ReduceSum", "", {&c}, {&y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kWARNING, false, LoggingManager::InstanceType::Temporal);
+
+  SessionOptions so;
+  so.session_logid = "SymbolicMemoryPatternRetracedOnMismatch";
+  InferenceSession session_object{so, logging_manager.get()};
+  std::stringstream model_stream;
+  model.ToProto().SerializeToOstream(&model_stream);
+  ASSERT_TRUE(session_object.Load(model_stream).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  for (int64_t n : {2, 4, 8, 8, 8, 16}) {
+    std::vector<float> values(static_cast<size_t>(n), 1.0f);
+    MLValue ml_value_a, ml_value_b;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {n, 1}, values, &ml_value_a);
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, n}, values, &ml_value_b);
+    NameMLValMap feeds{{"A", ml_value_a}, {"B", ml_value_b}};
+
+    std::vector<MLValue> fetches;
+    ASSERT_TRUE(session_object.Run(RunOptions(), feeds, {"Y"}, &fetches).IsOK());
+    VerifyOutputs(fetches, {1, 1}, {static_cast<float>(n * n)});
+  }
+
+  // only the first run with N = 8 used the mispredicted pattern. the trace of the second one replaced it,
+  // and told the pattern derived for N = 16 to leave the MatMul output to the allocator.
+  const auto& msgs = capturing_sink->Messages();
+  auto num_mismatches = std::count_if(msgs.begin(), msgs.end(), [](const std::string& msg) {
+    return msg.find("fall back to default allocation behavior") != std::string::npos;
+  });
+  EXPECT_EQ(num_mismatches, 1);
+}
+
+// The map fed to DictVectorizer doesn't keep the run from producing a memory pattern, which the second run uses.
+TEST(InferenceSessionTests, MemoryPatternWithMapInput) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  domain_to_version[onnxruntime::kMLDomain] = 1;
+  Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  TypeProto map_type;
+  map_type.mutable_map_type()->set_key_type(TensorProto_DataType_STRING);
+  map_type.mutable_map_type()->mutable_value_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& m = graph.GetOrCreateNodeArg("M", &map_type);
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& v = graph.GetOrCreateNodeArg("V", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("vectorize", "DictVectorizer", "", {&m}, {&v}, nullptr, onnxruntime::kMLDomain)
+      .AddAttribute("string_vocabulary", std::vector<std::string>{"a", "b"});
+  graph.AddNode("add", "Add", "", {&v, &x}, {&y});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kVERBOSE, false, LoggingManager::InstanceType::Temporal);
+
+  SessionOptions so;
+  so.session_logid = "MemoryPatternWithMapInput";
+  InferenceSession session_object{so, logging_manager.get()};
+  std::stringstream model_stream;
+  model.ToProto().SerializeToOstream(&model_stream);
+  ASSERT_TRUE(session_object.Load(model_stream).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  auto map = std::make_unique<std::map<std::string, float>>();
+  (*map)["b"] = 2.0f;
+  MLValue ml_value_m;
+  ml_value_m.Init(map.release(), DataTypeImpl::GetType<std::map<std::string, float>>(),
+                  DataTypeImpl::GetType<std::map<std::string, float>>()->GetDeleteFunc());
+  MLValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2}, {1.0f, 1.0f},
+                       &ml_value_x);
+  NameMLValMap feeds{{"M", ml_value_m}, {"X", ml_value_x}};
+
+  for (int run = 0; run < 2; ++run) {
+    std::vector<MLValue> fetches;
+    status = session_object.Run(RunOptions(), feeds, {"Y"}, &fetches);
+    ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+    VerifyOutputs(fetches, {1, 2}, {1.0f, 3.0f});
+  }
+
+  // the pattern traced by the first run is cached and used by the second one instead of tracing again
+  const auto& msgs = capturing_sink->Messages();
+  auto num_patterns = std::count_if(msgs.begin(), msgs.end(), [](const std::string& msg) {
+    return msg.find("Memory pattern for") != std::string::npos;
+  });
+  EXPECT_EQ(num_patterns, 1);
+}
+
+// Reshape fails on the zero filled shape input of the first prewarm run. Initialize skips it and succeeds.
+TEST(InferenceSessionTests, MemoryPatternPrewarmSkipsFailedRun) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  TypeProto type_x;
+  type_x.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  TypeProto type_s;
+  type_s.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  type_s.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("rank");
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type_x);
+  auto& shape = graph.GetOrCreateNodeArg("S", &type_s);
+  auto& r = graph.GetOrCreateNodeArg("R", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("reshape", "Reshape", "", {&x, &shape}, {&r});
+  graph.AddNode("abs", "Abs", "", {&r}, {&y});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  auto capturing_sink = new CapturingSink();
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(capturing_sink), logging::Severity::kWARNING, false, LoggingManager::InstanceType::Temporal);
+
+  SessionOptions so;
+  so.session_logid = "MemoryPatternPrewarmSkipsFailedRun";
+  // a shape of [0] keeps the first dimension only, which doesn't hold the 6 elements. [0, 0] keeps both.
+  so.mem_pattern_prewarm_shapes.push_back({{"X", {2, 3}}, {"S", {1}}});
+  so.mem_pattern_prewarm_shapes.push_back({{"X", {2, 3}}, {"S", {2}}});
+  InferenceSession session_object{so, logging_manager.get()};
+  std::stringstream model_stream;
+  model.ToProto().SerializeToOstream(&model_stream);
+  ASSERT_TRUE(session_object.Load(model_stream).IsOK());
+  auto status = session_object.Initialize();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  const auto& msgs = capturing_sink->Messages();
+  auto num_skipped = std::count_if(msgs.begin(), msgs.end(), [](const std::string& msg) {
+    return msg.find("Could not generate memory patterns for prewarm shapes") != std::string::npos;
+  });
+  EXPECT_EQ(num_skipped, 1);
+
+  MLValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3},
+                       {1.0f, -2.0f, 3.0f, -4.0f, 5.0f, -6.0f}, &ml_value_x);
+  MLValue ml_value_s;
+  CreateMLValue<int64_t>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1}, {6}, &ml_value_s);
+  NameMLValMap feeds{{"X", ml_value_x}, {"S", ml_value_s}};
+  std::vector<MLValue> fetches;
+  status = session_object.Run(RunOptions(), feeds, {"Y"}, &fetches);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  VerifyOutputs(fetches, {6}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+}
+
 TEST(ExecutionProviderTest, FunctionTest) {
   onnxruntime::Model model("graph_1");
   auto& graph = model.MainGraph();
@@ -1111,5 +1484,100 @@ TEST(ExecutionProviderTest, FunctionInlineTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
+namespace {
+// an execution provider that takes no nodes, to have a session with a provider besides CPU
+class NoCapabilityExecutionProvider : public FuseExecutionProvider {
+ public:
+  std::vector<std::unique_ptr<ComputeCapability>>
+  GetCapability(const onnxruntime::GraphViewer& /*graph*/,
+                const std::vector<const KernelRegistry*>& /*kernel_registries*/) const override {
+    return {};
+  }
+};
+
+// runs Y = Relu(A * B + C) and returns whether the Gemm and the Relu ran as a FusedGemm node
+bool RunGemmRelu(const SessionOptions& so, std::unique_ptr<IExecutionProvider> provider) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  Model model("test", true, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  auto add_initializer = [&graph](const std::string& name, const std::vector<int64_t>& dims,
+                                  const std::vector<float>& values) {
+    TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) tensor_proto.add_dims(dim);
+    for (auto value : values) tensor_proto.add_float_data(value);
+    graph.AddInitializedTensor(tensor_proto);
+  };
+  add_initializer("B", {3, 2}, {1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f});
+  add_initializer("C", {2}, {0.5f, -2.0f});
+
+  auto tensor_type = [](const std::vector<int64_t>& dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    return type;
+  };
+  auto a_type = tensor_type({2, 3});
+  auto b_type = tensor_type({3, 2});
+  auto c_type = tensor_type({2});
+  auto y_type = tensor_type({2, 2});
+  auto& a = graph.GetOrCreateNodeArg("A", &a_type);
+  auto& b = graph.GetOrCreateNodeArg("B", &b_type);
+  auto& c = graph.GetOrCreateNodeArg("C", &c_type);
+  auto& g = graph.GetOrCreateNodeArg("G", &y_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &y_type);
+  graph.AddNode("gemm", "Gemm", "", {&a, &b, &c}, {&g});
+  graph.AddNode("relu", "Relu", "", {&g}, {&y});
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  SessionOptions profiled_so = so;
+  profiled_so.enable_profiling = true;
+  profiled_so.profile_file_prefix = "onnxruntime_gemm_fusion_test";
+  InferenceSession session_object{profiled_so};
+  if (provider) {
+    EXPECT_TRUE(session_object.RegisterExecutionProvider(std::move(provider)).IsOK());
+  }
+  std::stringstream s1;
+  model.ToProto().SerializeToOstream(&s1);
+  status = session_object.Load(s1);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  status = session_object.Initialize();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  MLValue ml_value_a;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 3},
+                       {1.0f, -2.0f, 3.0f, -4.0f, 5.0f, -6.0f}, &ml_value_a);
+  NameMLValMap feeds{{"A", ml_value_a}};
+  std::vector<MLValue> fetches;
+  status = session_object.Run(RunOptions(), feeds, {"Y"}, &fetches);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  VerifyOutputs(fetches, {2, 2}, {4.5f, 0.0f, 0.0f, 0.0f});
+
+  std::ifstream profile(session_object.EndProfiling());
+  std::string line;
+  bool fused = false;
+  while (std::getline(profile, line)) {
+    fused = fused || line.find("FusedGemm") != string::npos;
+  }
+  return fused;
+}
+}  // namespace
+
+TEST(InferenceSessionTests, GemmActivationFusion) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.GemmActivationFusion";
+  EXPECT_TRUE(RunGemmRelu(so, nullptr));
+
+  // FusedGemm only has a CPU kernel, so the Gemm isn't fused if another provider could take it
+  EXPECT_FALSE(RunGemmRelu(so, std::make_unique<NoCapabilityExecutionProvider>()));
+
+  so.enable_gemm_fusion = false;
+  EXPECT_FALSE(RunGemmRelu(so, nullptr));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
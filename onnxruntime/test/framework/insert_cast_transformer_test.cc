@@ -5,6 +5,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/insert_cast_transformer.h"
 #include "core/graph/model.h"
+#include "core/util/math.h"
 #include "gtest/gtest.h"
 #include "test_utils.h"
 
@@ -117,5 +118,58 @@ TEST(TransformerTest, InsertCastAllCPUTest) {
     EXPECT_EQ((*it).OpType(), "Cast");
   }
 }
+
+TEST(TransformerTest, KeepFloat16WeightsTest) {
+  auto model = std::make_shared<onnxruntime::Model>("test");
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float_16;
+  tensor_float_16.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  TypeProto input_type = tensor_float_16;
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  onnxruntime::NodeArg i1_def("I1", &input_type),
+      w1_def("W1", &tensor_float_16),
+      o1_def("O1", &tensor_float_16),
+      o2_def("O2", &tensor_float_16);
+
+  TensorProto weights;
+  weights.set_name("W1");
+  weights.set_data_type(TensorProto_DataType_FLOAT16);
+  weights.add_dims(3);
+  weights.add_dims(4);
+  for (int i = 0; i < 12; ++i) {
+    weights.add_int32_data(math::floatToHalf(static_cast<float>(i)));
+  }
+  graph.AddInitializedTensor(weights);
+
+  graph.AddNode("node1", "MatMul", "cpu operator1", ArgMap{&i1_def, &w1_def}, ArgMap{&o1_def});
+  graph.AddNode("node2", "Relu", "cpu operator2", ArgMap{&o1_def}, ArgMap{&o2_def});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  auto cpu_execution_provider = TestCPUExecutionProvider();
+  InsertCastTransformer transformer("Test", true);
+  transformer.AddKernelRegistry(*cpu_execution_provider->GetKernelRegistry().get());
+
+  bool modified = false;
+  status = transformer.Apply(graph, modified);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_TRUE(modified);
+
+  // the weights are read by the FusedGemm directly, only the activations are cast
+  std::map<std::string, int> op_counts;
+  for (auto& node : graph.Nodes()) {
+    op_counts[node.OpType()]++;
+    if (node.OpType() == "FusedGemm") {
+      EXPECT_EQ(node.InputDefs()[1]->Name(), "W1");
+      EXPECT_EQ(node.GetExecutionProviderType(), kCpuExecutionProvider);
+    }
+  }
+  EXPECT_EQ(op_counts["MatMul"], 0);
+  EXPECT_EQ(op_counts["FusedGemm"], 1);
+  EXPECT_EQ(op_counts["Cast"], 2);
+}
 }  // namespace test
 }  // namespace onnxruntime
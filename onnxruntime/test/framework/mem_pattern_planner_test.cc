@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/symbolic_mem_pattern.h"
 #include "gtest/gtest.h"
 
 namespace onnxruntime {
@@ -29,10 +30,128 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
 
   pattern = planner.GenerateMemPattern();
 
-  EXPECT_EQ(pattern.PeakSize(), 1024 + 256 + 512 + 1024 + 512);
-  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024 + 256 + 512 + 1024);
-  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024 + 256 + 512);
-  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024);
+  // offsets planned again with the lifetimes, down to the lower bound
+  // instead of the 1024 + 256 + 512 + 1024 + 512 bytes needed while tracing
+  EXPECT_EQ(pattern.LowerBoundSize(), 1024 + 512 + 1024 + 512);
+  EXPECT_EQ(pattern.PeakSize(), 1024 + 512 + 1024 + 512);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024);
+  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024 + 1024);
+  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024 + 1024 + 512);
+  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024 + 600);
+}
+
+TEST(MemPatternPlannerTest, PackByLifetimeTest) {
+  MemPatternPlanner planner;
+  planner.TraceAllocation(0, 100);
+  planner.TraceAllocation(1, 50);
+  planner.TraceFree(0);
+  // doesn't fit in the block freed by 0 while tracing
+  planner.TraceAllocation(2, 150);
+  planner.TraceFree(1);
+  planner.TraceFree(2);
+
+  auto pattern = planner.GenerateMemPattern();
+
+  EXPECT_EQ(pattern.LowerBoundSize(), 200);
+  EXPECT_EQ(pattern.PeakSize(), 200);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 0);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 150);
+}
+
+static std::unique_ptr<MemoryPatternGroup> TraceScaledPatterns(int64_t scale) {
+  MemPatternPlanner planner;
+  planner.TraceAllocation(0, 100 + 10 * scale);
+  planner.TraceAllocation(1, 64 * scale);
+  // not affine in scale
+  planner.TraceAllocation(2, scale * scale + scale / 2);
+  planner.TraceFree(0);
+  planner.TraceAllocation(3, 16 * scale);
+
+  auto group = std::make_unique<MemoryPatternGroup>();
+  group->locations.push_back(OrtAllocatorInfo(CPU, OrtArenaAllocator));
+  group->patterns.push_back(planner.GenerateMemPattern());
+  return group;
+}
+
+TEST(MemPatternPlannerTest, SymbolicPatternTest) {
+  auto group2 = TraceScaledPatterns(2);
+  auto group4 = TraceScaledPatterns(4);
+  auto symbolic = SymbolicMemoryPatternGroup::Create(*group2, 2, *group4, 4);
+  ASSERT_TRUE(symbolic != nullptr);
+
+  auto group8 = symbolic->Instantiate(8);
+  auto expected = TraceScaledPatterns(8);
+  ASSERT_EQ(group8->locations.size(), 1u);
+  EXPECT_EQ(group8->locations[0], expected->locations[0]);
+
+  const auto& pattern = group8->patterns[0];
+  const auto& expected_pattern = expected->patterns[0];
+  for (int idx : {0, 1, 3}) {
+    ASSERT_TRUE(pattern.GetBlock(idx) != nullptr);
+    EXPECT_EQ(pattern.GetBlock(idx)->size_, expected_pattern.GetBlock(idx)->size_);
+  }
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 180);
+  // the freed block of value 0 is reused
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 0);
+  EXPECT_TRUE(pattern.GetBlock(2) == nullptr);
+  EXPECT_EQ(pattern.PeakSize(), 180 + 512);
+}
+
+static std::unique_ptr<MemoryPatternGroup> TraceQuadraticPatterns(int64_t scale) {
+  MemPatternPlanner planner;
+  planner.TraceAllocation(0, 64 * scale);
+  // e.g. a seq_len x seq_len attention matrix. two traces fit it with an affine size too.
+  planner.TraceAllocation(1, 4 * scale * scale);
+  planner.TraceFree(0);
+  planner.TraceAllocation(2, 32 * scale);
+
+  auto group = std::make_unique<MemoryPatternGroup>();
+  group->locations.push_back(OrtAllocatorInfo(CPU, OrtArenaAllocator));
+  group->patterns.push_back(planner.GenerateMemPattern());
+  return group;
+}
+
+TEST(MemPatternPlannerTest, SymbolicPatternRefinedByQuadraticSize) {
+  auto group2 = TraceQuadraticPatterns(2);
+  auto group4 = TraceQuadraticPatterns(4);
+  auto symbolic = SymbolicMemoryPatternGroup::Create(*group2, 2, *group4, 4);
+  ASSERT_TRUE(symbolic != nullptr);
+
+  // 16 and 64 bytes at scales 2 and 4 predict 160 bytes at scale 8, the real size is 256
+  auto group8 = symbolic->Instantiate(8);
+  ASSERT_TRUE(group8->patterns[0].GetBlock(1) != nullptr);
+  EXPECT_EQ(group8->patterns[0].GetBlock(1)->size_, 160);
+
+  // a trace at a third scale drops the mispredicted allocation
+  ASSERT_TRUE(symbolic->Refine(*TraceQuadraticPatterns(8), 8));
+  auto group16 = symbolic->Instantiate(16);
+  auto expected = TraceQuadraticPatterns(16);
+  const auto& pattern = group16->patterns[0];
+  EXPECT_TRUE(pattern.GetBlock(1) == nullptr);
+  for (int idx : {0, 2}) {
+    ASSERT_TRUE(pattern.GetBlock(idx) != nullptr);
+    EXPECT_EQ(pattern.GetBlock(idx)->size_, expected->patterns[0].GetBlock(idx)->size_);
+  }
+
+  // a trace of another sequence of allocations is rejected
+  EXPECT_FALSE(symbolic->Refine(*TraceScaledPatterns(8), 8));
+}
+
+TEST(MemPatternPlannerTest, SymbolicPatternMismatchedTraces) {
+  auto group2 = TraceScaledPatterns(2);
+
+  MemPatternPlanner planner;
+  planner.TraceAllocation(0, 140);
+  auto other = std::make_unique<MemoryPatternGroup>();
+  other->locations.push_back(OrtAllocatorInfo(CPU, OrtArenaAllocator));
+  other->patterns.push_back(planner.GenerateMemPattern());
+
+  EXPECT_TRUE(SymbolicMemoryPatternGroup::Create(*group2, 2, *other, 4) == nullptr);
+  EXPECT_TRUE(SymbolicMemoryPatternGroup::Create(*group2, 2, *group2, 2) == nullptr);
 }
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef USE_MKLDNN
+
+#include <thread>
+
+#include "core/providers/mkldnn/mkldnn_common.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+struct TestPrimitive {
+  explicit TestPrimitive(int64_t value) : value(value) {}
+  int64_t value;
+};
+
+using TestPrimitivePool = mkl_dnn::PrimitivePool<TestPrimitive>;
+
+mkl_dnn::PrimitiveKey Key(int64_t value) {
+  mkl_dnn::PrimitiveKey key;
+  key.Append(value);
+  return key;
+}
+
+void Add(int64_t value) {
+  auto* primitive = TestPrimitivePool::SetPrimitive(Key(value), std::make_unique<TestPrimitive>(value));
+  ASSERT_NE(primitive, nullptr);
+  EXPECT_EQ(primitive->value, value);
+}
+}  // namespace
+
+TEST(MklDnnPrimitivePoolTest, EvictsLeastRecentlyUsed) {
+  const int64_t capacity = static_cast<int64_t>(TestPrimitivePool::kPrimitivePoolCapacity);
+  const auto initial_stats = TestPrimitivePool::GetStats();
+  for (int64_t i = 0; i < capacity; ++i) {
+    Add(i);
+  }
+  for (int64_t i = capacity - 1; i >= 0; --i) {
+    auto* primitive = TestPrimitivePool::GetPrimitive(Key(i));
+    ASSERT_NE(primitive, nullptr);
+    EXPECT_EQ(primitive->value, i);
+  }
+
+  // the lookups above made 0 the most recently used and capacity - 1 the least recently used
+  Add(capacity);
+  EXPECT_EQ(TestPrimitivePool::GetPrimitive(Key(capacity - 1)), nullptr);
+  EXPECT_NE(TestPrimitivePool::GetPrimitive(Key(capacity - 2)), nullptr);
+  EXPECT_NE(TestPrimitivePool::GetPrimitive(Key(capacity)), nullptr);
+
+  // a lookup makes the primitive the most recently used, so the next eviction takes the one after it
+  Add(capacity + 1);
+  EXPECT_EQ(TestPrimitivePool::GetPrimitive(Key(capacity - 3)), nullptr);
+  EXPECT_NE(TestPrimitivePool::GetPrimitive(Key(capacity - 2)), nullptr);
+  EXPECT_NE(TestPrimitivePool::GetPrimitive(Key(0)), nullptr);
+
+  // the capacity lookups after filling the pool and 4 lookups after the evictions found their primitive
+  const auto stats = TestPrimitivePool::GetStats();
+  EXPECT_EQ(stats.hits - initial_stats.hits, static_cast<uint64_t>(capacity + 4));
+  EXPECT_EQ(stats.misses - initial_stats.misses, 2u);
+  EXPECT_EQ(stats.evictions - initial_stats.evictions, 2u);
+}
+
+TEST(MklDnnPrimitivePoolTest, PoolsAreThreadLocal) {
+  Add(-1);
+  ASSERT_NE(TestPrimitivePool::GetPrimitive(Key(-1)), nullptr);
+
+  std::thread thread([]() {
+    EXPECT_EQ(TestPrimitivePool::GetPrimitive(Key(-1)), nullptr);
+
+    // the counters are per thread too
+    const auto stats = TestPrimitivePool::GetStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.evictions, 0u);
+  });
+  thread.join();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // USE_MKLDNN
@@ -0,0 +1,240 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef USE_MKLDNN
+
+#include <random>
+#include <thread>
+
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "core/providers/mkldnn/mkldnn_subgraph.h"
+#include "core/session/inference_session.h"
+#include "test/test_environment.h"
+#include "test/util/include/default_providers.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+namespace {
+void AddInitializer(Graph& graph, const std::string& name, const std::vector<int64_t>& dims,
+                    std::default_random_engine& rng) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  int64_t size = 1;
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+    size *= dim;
+  }
+  for (int64_t i = 0; i < size; ++i) {
+    tensor_proto.add_float_data(dist(rng));
+  }
+  graph.AddInitializedTensor(tensor_proto);
+}
+
+TypeProto FloatTensorType(const std::vector<int64_t>& dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return type;
+}
+
+// X -> Conv(bias) -> MaxPool -> Conv -> AveragePool -> LRN -> Y, all of which can run in one subgraph
+void CreateCnnModel(Model& model) {
+  auto& graph = model.MainGraph();
+  std::default_random_engine rng(123);
+
+  AddInitializer(graph, "W0", {8, 3, 3, 3}, rng);
+  AddInitializer(graph, "B0", {8}, rng);
+  AddInitializer(graph, "W1", {8, 8, 3, 3}, rng);
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto arg = [&graph, &float_tensor](const std::string& name) { return &graph.GetOrCreateNodeArg(name, &float_tensor); };
+  auto x_type = FloatTensorType({1, 3, 14, 14});
+  auto* x = &graph.GetOrCreateNodeArg("X", &x_type);
+
+  std::vector<int64_t> pads{1, 1, 1, 1};
+  graph.AddNode("conv0", "Conv", "", {x, arg("W0"), arg("B0")}, {arg("C0")}).AddAttribute("pads", pads);
+  auto& max_pool = graph.AddNode("max_pool", "MaxPool", "", {arg("C0")}, {arg("P0")});
+  max_pool.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+  max_pool.AddAttribute("strides", std::vector<int64_t>{2, 2});
+  graph.AddNode("conv1", "Conv", "", {arg("P0"), arg("W1")}, {arg("C1")}).AddAttribute("pads", pads);
+  auto& average_pool = graph.AddNode("average_pool", "AveragePool", "", {arg("C1")}, {arg("P1")});
+  average_pool.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+  average_pool.AddAttribute("pads", pads);
+  auto& lrn = graph.AddNode("lrn", "LRN", "", {arg("P1")}, {arg("Y")});
+  lrn.AddAttribute("size", int64_t{3});
+  lrn.AddAttribute("alpha", 0.0001f);
+  lrn.AddAttribute("beta", 0.75f);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+std::unique_ptr<InferenceSession> CreateSession(bool use_mkldnn) {
+  Model model("MklDnnSubgraphTest");
+  CreateCnnModel(model);
+
+  SessionOptions so;
+  so.session_logid = "MklDnnSubgraphTest";
+  auto session_object = std::make_unique<InferenceSession>(so, &DefaultLoggingManager());
+  if (use_mkldnn) {
+    EXPECT_TRUE(session_object->RegisterExecutionProvider(DefaultMkldnnExecutionProvider()).IsOK());
+  }
+
+  std::stringstream s1;
+  model.ToProto().SerializeToOstream(&s1);
+  auto status = session_object->Load(s1);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  status = session_object->Initialize();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  return session_object;
+}
+
+std::vector<float> Run(InferenceSession& session_object, const std::vector<float>& input) {
+  MLValue input_mlvalue;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault),
+                       {1, 3, 14, 14}, input, &input_mlvalue);
+  NameMLValMap feeds{{"X", input_mlvalue}};
+  std::vector<MLValue> fetches;
+
+  auto status = session_object.Run(RunOptions(), feeds, {"Y"}, &fetches);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  if (!status.IsOK()) {
+    return {};
+  }
+
+  const auto& output = fetches[0].Get<Tensor>();
+  EXPECT_EQ(output.Shape().GetDims(), std::vector<int64_t>({1, 8, 7, 7}));
+  const float* data = output.Data<float>();
+  return std::vector<float>(data, data + output.Shape().Size());
+}
+
+std::vector<float> RandomInput(unsigned seed) {
+  std::default_random_engine rng(seed);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> input(3 * 14 * 14);
+  for (auto& value : input) {
+    value = dist(rng);
+  }
+  return input;
+}
+
+void ExpectNear(const std::vector<float>& expected, const std::vector<float>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-4f) << "at " << i;
+  }
+}
+}  // namespace
+
+TEST(MklDnnSubgraphTest, PartitionsConnectedNodes) {
+  Model model("MklDnnSubgraphTest");
+  auto& graph = model.MainGraph();
+  std::default_random_engine rng(123);
+  AddInitializer(graph, "W0", {4, 3, 3, 3}, rng);
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto arg = [&graph, &float_tensor](const std::string& name) { return &graph.GetOrCreateNodeArg(name, &float_tensor); };
+  auto x_type = FloatTensorType({1, 3, 8, 8});
+  auto w1_type = FloatTensorType({4, 4, 3, 3});
+  auto* x = &graph.GetOrCreateNodeArg("X", &x_type);
+  auto* w1 = &graph.GetOrCreateNodeArg("W1", &w1_type);
+
+  // conv0 and max_pool form a subgraph. conv1 has a filter that isn't an initializer, so it isn't part of one,
+  // and lrn is left alone as the node producing its input isn't in a subgraph.
+  std::vector<int64_t> pads{1, 1, 1, 1};
+  graph.AddNode("conv0", "Conv", "", {x, arg("W0")}, {arg("C0")}).AddAttribute("pads", pads);
+  graph.AddNode("relu", "Relu", "", {arg("C0")}, {arg("R0")});
+  auto& max_pool = graph.AddNode("max_pool", "MaxPool", "", {arg("C0")}, {arg("P0")});
+  max_pool.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+  max_pool.AddAttribute("strides", std::vector<int64_t>{2, 2});
+  graph.AddNode("conv1", "Conv", "", {arg("P0"), w1}, {arg("C1")}).AddAttribute("pads", pads);
+  auto& lrn = graph.AddNode("lrn", "LRN", "", {arg("C1")}, {arg("Y")});
+  lrn.AddAttribute("size", int64_t{3});
+  lrn.AddAttribute("alpha", 0.0001f);
+  lrn.AddAttribute("beta", 0.75f);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  GraphViewer graph_viewer(graph);
+  std::unordered_set<NodeIndex> candidates;
+  std::unordered_map<std::string, NodeIndex> node_indices;
+  for (auto& node : graph.Nodes()) {
+    node_indices[node.Name()] = node.Index();
+    if (node.OpType() != "Relu") {
+      candidates.insert(node.Index());
+    }
+  }
+
+  auto capabilities = mkl_dnn::GetSubgraphCapabilities(graph_viewer, candidates);
+  ASSERT_EQ(capabilities.size(), 1u);
+
+  const auto& sub_graph = *capabilities[0]->sub_graph;
+  EXPECT_EQ(sub_graph.nodes, std::vector<NodeIndex>({node_indices["conv0"], node_indices["max_pool"]}));
+  const auto* meta_def = sub_graph.GetMetaDef();
+  ASSERT_NE(meta_def, nullptr);
+  EXPECT_EQ(meta_def->inputs, std::vector<std::string>({"X", "W0"}));
+  // C0 is also used by relu outside of the subgraph
+  EXPECT_EQ(meta_def->outputs, std::vector<std::string>({"C0", "P0"}));
+
+  // no subgraph of a single node
+  candidates.erase(node_indices["max_pool"]);
+  EXPECT_TRUE(mkl_dnn::GetSubgraphCapabilities(graph_viewer, candidates).empty());
+}
+
+TEST(MklDnnSubgraphTest, MatchesCpuResults) {
+  auto cpu_session = CreateSession(false);
+  auto mkldnn_session = CreateSession(true);
+
+  // the second input has other values but the same shape, so the primitives of the first run are reused
+  for (unsigned seed : {456u, 789u}) {
+    auto input = RandomInput(seed);
+    ExpectNear(Run(*cpu_session, input), Run(*mkldnn_session, input));
+  }
+}
+
+TEST(MklDnnSubgraphTest, ConcurrentRuns) {
+  auto cpu_session = CreateSession(false);
+  auto mkldnn_session = CreateSession(true);
+
+  const int num_threads = 4;
+  std::vector<std::vector<float>> inputs;
+  std::vector<std::vector<float>> expected;
+  for (int i = 0; i < num_threads; ++i) {
+    inputs.push_back(RandomInput(100 + i));
+    expected.push_back(Run(*cpu_session, inputs.back()));
+  }
+
+  std::vector<std::vector<float>> actual(num_threads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (int run = 0; run < 10; ++run) {
+        actual[i] = Run(*mkldnn_session, inputs[i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < num_threads; ++i) {
+    ExpectNear(expected[i], actual[i]);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // USE_MKLDNN
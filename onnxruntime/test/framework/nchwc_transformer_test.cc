@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+
+#include "core/framework/nchwc_transformer.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "test/test_environment.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+namespace {
+void AddFilter(Graph& graph, const std::string& name, const std::vector<int64_t>& dims, std::default_random_engine& rng) {
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  int64_t size = 1;
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+    size *= dim;
+  }
+  for (int64_t i = 0; i < size; ++i) {
+    tensor_proto.add_float_data(dist(rng));
+  }
+  graph.AddInitializedTensor(tensor_proto);
+}
+
+// X -> Conv(3 to 8 channels) -> Conv(8 to 16) -> Relu -> Conv(16 to 16) -> Add(residual) -> MaxPool -> Y
+// The first Conv has 3 input channels, so it stays NCHW and the blocked subgraph starts at its output.
+void CreateCnnModel(Model& model) {
+  auto& graph = model.MainGraph();
+  std::default_random_engine rng(123);
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : {1, 3, 14, 14}) {
+    input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  AddFilter(graph, "W0", {8, 3, 3, 3}, rng);
+  AddFilter(graph, "W1", {16, 8, 3, 3}, rng);
+  AddFilter(graph, "B1", {16}, rng);
+  AddFilter(graph, "W2", {16, 16, 3, 3}, rng);
+
+  auto arg = [&graph, &float_tensor](const std::string& name) { return &graph.GetOrCreateNodeArg(name, &float_tensor); };
+  auto* x = &graph.GetOrCreateNodeArg("X", &input_type);
+
+  std::vector<int64_t> pads{1, 1, 1, 1};
+  graph.AddNode("conv0", "Conv", "", {x, arg("W0")}, {arg("C0")}).AddAttribute("pads", pads);
+  graph.AddNode("conv1", "Conv", "", {arg("C0"), arg("W1"), arg("B1")}, {arg("C1")}).AddAttribute("pads", pads);
+  graph.AddNode("relu", "Relu", "", {arg("C1")}, {arg("R1")});
+  graph.AddNode("conv2", "Conv", "", {arg("R1"), arg("W2")}, {arg("C2")}).AddAttribute("pads", pads);
+  graph.AddNode("add", "Add", "", {arg("C2"), arg("R1")}, {arg("A")});
+  auto& pool = graph.AddNode("pool", "MaxPool", "", {arg("A")}, {arg("Y")});
+  pool.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+  pool.AddAttribute("strides", std::vector<int64_t>{2, 2});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+std::vector<float> RunCnnModel(bool enable_nchwc_layout, const std::vector<float>& input) {
+  Model model("NchwcTransformerTest");
+  CreateCnnModel(model);
+
+  SessionOptions so;
+  so.session_logid = "NchwcTransformerTest";
+  so.enable_nchwc_layout = enable_nchwc_layout;
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  std::stringstream s1;
+  model.ToProto().SerializeToOstream(&s1);
+  auto status = session_object.Load(s1);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  status = session_object.Initialize();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  MLValue input_mlvalue;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault),
+                       {1, 3, 14, 14}, input, &input_mlvalue);
+  NameMLValMap feeds{{"X", input_mlvalue}};
+  std::vector<MLValue> fetches;
+
+  RunOptions run_options;
+  status = session_object.Run(run_options, feeds, {"Y"}, &fetches);
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  if (!status.IsOK()) {
+    return {};
+  }
+
+  const auto& output = fetches[0].Get<Tensor>();
+  EXPECT_EQ(output.Shape().GetDims(), std::vector<int64_t>({1, 16, 7, 7}));
+  const float* data = output.Data<float>();
+  return std::vector<float>(data, data + output.Shape().Size());
+}
+}  // namespace
+
+TEST(NchwcTransformerTest, ConvertsCnnSubgraph) {
+  Model model("NchwcTransformerTest");
+  CreateCnnModel(model);
+  auto& graph = model.MainGraph();
+
+  NchwcTransformer transformer;
+  bool modified = false;
+  auto status = transformer.Apply(graph, modified);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_TRUE(modified);
+
+  std::map<std::string, int> op_counts;
+  for (auto& node : graph.Nodes()) {
+    op_counts[node.OpType()]++;
+  }
+  EXPECT_EQ(op_counts["Conv"], 1);
+  EXPECT_EQ(op_counts["ReorderInput"], 1);
+  EXPECT_EQ(op_counts["NchwcConv"], 2);
+  EXPECT_EQ(op_counts["Relu"], 1);
+  EXPECT_EQ(op_counts["Add"], 1);
+  EXPECT_EQ(op_counts["MaxPool"], 0);
+  EXPECT_EQ(op_counts["NchwcMaxPool"], 1);
+  EXPECT_EQ(op_counts["ReorderOutput"], 1);
+
+  // nothing left to convert
+  modified = false;
+  status = transformer.Apply(graph, modified);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_FALSE(modified);
+}
+
+TEST(NchwcTransformerTest, MatchesNchwResults) {
+  std::default_random_engine rng(456);
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  std::vector<float> input(3 * 14 * 14);
+  for (auto& value : input) {
+    value = dist(rng);
+  }
+
+  auto expected = RunCnnModel(false, input);
+  auto actual = RunCnnModel(true, input);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-4f) << "at " << i;
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
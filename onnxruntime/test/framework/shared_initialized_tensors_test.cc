@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initialized_tensors.h"
+
+#include "core/graph/onnx_protobuf.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static ONNX_NAMESPACE::TensorProto CreateFloatTensorProto(const std::string& name, const std::vector<float>& values,
+                                                          bool raw) {
+  ONNX_NAMESPACE::TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_proto.add_dims(static_cast<int64_t>(values.size()));
+  if (raw) {
+    tensor_proto.set_raw_data(values.data(), values.size() * sizeof(float));
+  } else {
+    for (float value : values) {
+      tensor_proto.add_float_data(value);
+    }
+  }
+  return tensor_proto;
+}
+
+static std::vector<float> GetValues(const MLValue& value) {
+  const auto& tensor = value.Get<Tensor>();
+  const float* data = tensor.Data<float>();
+  return std::vector<float>(data, data + tensor.Shape().Size());
+}
+
+TEST(SharedInitializedTensorsTest, ProcessWideTensorsAreKeyedByContent) {
+  auto shared_tensors = SharedInitializedTensors::GetProcessWide();
+  const auto initial_stats = shared_tensors->GetStats();
+
+  // same content under other names and in both payload representations, and a different content
+  auto a = CreateFloatTensorProto("a", {1.f, 2.f, 3.f, 4.f}, true);
+  auto b = CreateFloatTensorProto("b", {1.f, 2.f, 3.f, 4.f}, false);
+  auto c = CreateFloatTensorProto("c", {1.f, 2.f, 3.f, 5.f}, true);
+
+  SharedInitializedTensors::Reference ref_a, ref_b, ref_c;
+  ASSERT_TRUE(shared_tensors->Acquire(a, ref_a).IsOK());
+  ASSERT_TRUE(shared_tensors->Acquire(b, ref_b).IsOK());
+  ASSERT_TRUE(shared_tensors->Acquire(c, ref_c).IsOK());
+  ASSERT_TRUE(ref_a != nullptr);
+  ASSERT_TRUE(ref_c != nullptr);
+
+  EXPECT_EQ(ref_a.get(), ref_b.get());
+  EXPECT_NE(ref_a.get(), ref_c.get());
+  EXPECT_EQ(shared_tensors->Find(b), ref_a.get());
+  EXPECT_EQ(GetValues(*ref_c), std::vector<float>({1.f, 2.f, 3.f, 5.f}));
+
+  auto stats = SharedInitializedTensors::GetProcessWideStats();
+  EXPECT_EQ(stats.num_tensors, initial_stats.num_tensors + 2);
+  EXPECT_EQ(stats.num_references, initial_stats.num_references + 3);
+  EXPECT_EQ(stats.bytes_in_use, initial_stats.bytes_in_use + 8 * sizeof(float));
+  EXPECT_EQ(stats.bytes_saved, initial_stats.bytes_saved + 4 * sizeof(float));
+
+  // a tensor is held as long as it's referenced
+  ref_a.reset();
+  EXPECT_EQ(shared_tensors->Find(a), ref_b.get());
+  ref_b.reset();
+  ref_c.reset();
+  EXPECT_EQ(shared_tensors->Find(a), nullptr);
+
+  stats = SharedInitializedTensors::GetProcessWideStats();
+  EXPECT_EQ(stats.num_tensors, initial_stats.num_tensors);
+  EXPECT_EQ(stats.num_references, initial_stats.num_references);
+  EXPECT_EQ(stats.bytes_in_use, initial_stats.bytes_in_use);
+  EXPECT_EQ(stats.bytes_saved, initial_stats.bytes_saved);
+}
+
+TEST(SharedInitializedTensorsTest, StringTensorsAreNotShared) {
+  ONNX_NAMESPACE::TensorProto tensor_proto;
+  tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+  tensor_proto.add_dims(1);
+  tensor_proto.add_string_data("a");
+
+  SharedInitializedTensors::Reference reference;
+  ASSERT_TRUE(SharedInitializedTensors::GetProcessWide()->Acquire(tensor_proto, reference).IsOK());
+  EXPECT_TRUE(reference == nullptr);
+}
+
+TEST(SharedInitializedTensorsTest, CreateCoversSubgraphs) {
+  ONNX_NAMESPACE::GraphProto graph_proto;
+  *graph_proto.add_initializer() = CreateFloatTensorProto("w", {1.f, 2.f}, false);
+
+  auto* node = graph_proto.add_node();
+  node->set_op_type("If");
+  auto* then_branch = node->add_attribute();
+  then_branch->set_name("then_branch");
+  then_branch->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_GRAPH);
+  *then_branch->mutable_g()->add_initializer() = CreateFloatTensorProto("w_then", {3.f, 4.f, 5.f}, true);
+  auto* else_branch = node->add_attribute();
+  else_branch->set_name("else_branch");
+  else_branch->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_GRAPH);
+  *else_branch->mutable_g()->add_initializer() = CreateFloatTensorProto("w_else", {1.f, 2.f}, true);
+
+  const ONNX_NAMESPACE::GraphProto original = graph_proto;
+  std::shared_ptr<SharedInitializedTensors> shared_tensors;
+  ASSERT_TRUE(SharedInitializedTensors::Create(graph_proto, shared_tensors).IsOK());
+
+  // the payloads are held by the tensors only, and w_else has the content of w
+  const auto& then_proto = graph_proto.node(0).attribute(0).g().initializer(0);
+  const auto& else_proto = graph_proto.node(0).attribute(1).g().initializer(0);
+  EXPECT_EQ(graph_proto.initializer(0).float_data_size(), 0);
+  EXPECT_FALSE(then_proto.has_raw_data());
+  EXPECT_FALSE(else_proto.has_raw_data());
+
+  auto stats = shared_tensors->GetStats();
+  EXPECT_EQ(stats.num_tensors, 2u);
+  EXPECT_EQ(stats.bytes_in_use, 5 * sizeof(float));
+  EXPECT_EQ(stats.bytes_saved, 2 * sizeof(float));
+
+  const auto& original_then = original.node(0).attribute(0).g().initializer(0);
+  const auto& original_else = original.node(0).attribute(1).g().initializer(0);
+  ASSERT_NE(shared_tensors->Find(original_then), nullptr);
+  EXPECT_EQ(GetValues(*shared_tensors->Find(original_then)), std::vector<float>({3.f, 4.f, 5.f}));
+  EXPECT_EQ(shared_tensors->Find(original_else), shared_tensors->Find(original.initializer(0)));
+
+  // a changed initializer isn't matched
+  EXPECT_EQ(shared_tensors->Find(CreateFloatTensorProto("w", {1.f, 3.f}, false)), nullptr);
+
+  ONNX_NAMESPACE::GraphProto restored = graph_proto;
+  shared_tensors->RestorePayloads(restored);
+  EXPECT_EQ(shared_tensors->Find(restored.initializer(0)), shared_tensors->Find(original.initializer(0)));
+  EXPECT_EQ(restored.node(0).attribute(0).g().initializer(0).raw_data(), original_then.raw_data());
+  EXPECT_EQ(restored.node(0).attribute(1).g().initializer(0).raw_data(), original_else.raw_data());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
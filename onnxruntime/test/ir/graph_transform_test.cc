@@ -11,6 +11,8 @@
 #include "core/graph/conv_mul_fusion.h"
 #include "core/graph/conv_add_fusion.h"
 #include "core/graph/conv_activation_fusion.h"
+#include "core/graph/matmul_add_fusion.h"
+#include "core/graph/gemm_activation_fusion.h"
 #include "core/platform/env.h"
 
 #include "test/capturing_sink.h"
@@ -194,5 +196,61 @@ TEST(GraphTransformationTests, FuseConvAddMul3D) {
   ASSERT_TRUE(session_object.Initialize().IsOK());
 }
 
+TEST(GraphTransformationTests, FuseMatMulAddActivation) {
+  // X -> MatMul(W) -> Add(B) -> LeakyRelu -> Y
+  Model model("FuseMatMulAddActivation");
+  auto& graph = model.MainGraph();
+
+  TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  TensorProto w;
+  w.set_name("W");
+  w.set_data_type(TensorProto_DataType_FLOAT);
+  w.add_dims(3);
+  w.add_dims(5);
+  for (int i = 0; i < 15; ++i) {
+    w.add_float_data(static_cast<float>(i % 7) - 3.f);
+  }
+  graph.AddInitializedTensor(w);
+  TensorProto b;
+  b.set_name("B");
+  b.set_data_type(TensorProto_DataType_FLOAT);
+  b.add_dims(5);
+  for (int i = 0; i < 5; ++i) {
+    b.add_float_data(static_cast<float>(i) - 2.f);
+  }
+  graph.AddInitializedTensor(b);
+
+  auto arg = [&graph, &float_tensor](const std::string& name) { return &graph.GetOrCreateNodeArg(name, &float_tensor); };
+  graph.AddNode("matmul", "MatMul", "", {&graph.GetOrCreateNodeArg("X", &x_type), arg("W")}, {arg("M")});
+  graph.AddNode("add", "Add", "", {arg("M"), arg("B")}, {arg("A")});
+  graph.AddNode("leakyrelu", "LeakyRelu", "", {arg("A")}, {arg("Y")}).AddAttribute("alpha", 0.25f);
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  bool modified = false;
+  ASSERT_TRUE(MatMulAddFusion().Apply(graph, modified).IsOK());
+  EXPECT_TRUE(modified);
+  modified = false;
+  ASSERT_TRUE(GemmActivationFusion().Apply(graph, modified).IsOK());
+  EXPECT_TRUE(modified);
+
+  std::map<std::string, int> op_counts;
+  for (auto& node : graph.Nodes()) {
+    op_counts[node.OpType()]++;
+  }
+  EXPECT_EQ(op_counts.size(), 1u);
+  ASSERT_EQ(op_counts["FusedGemm"], 1);
+
+  const Node& fused_gemm = *graph.Nodes().begin();
+  EXPECT_EQ(fused_gemm.GetAttributes().at("activation").s(), "LeakyRelu");
+  EXPECT_EQ(fused_gemm.GetAttributes().at("activation_params").floats(0), 0.25f);
+  EXPECT_EQ(fused_gemm.OutputDefs()[0]->Name(), "Y");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
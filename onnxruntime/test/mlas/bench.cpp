@@ -0,0 +1,348 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bench.cpp
+
+Abstract:
+
+    This module implements benchmarks of the MLAS library.
+
+    The convolution benchmarks run each shape with the parameters selected by
+    the heuristics of MlasConvPrepare and with the parameters selected by
+    autotuning, and report the selected algorithm and thread stride as
+    counters.
+
+--*/
+
+#include <algorithm>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mlas.h>
+
+static
+std::vector<float>
+MakeBuffer(
+    size_t Elements
+    )
+{
+    std::vector<float> Buffer(Elements);
+
+    //
+    // Fill the buffer with a repeating pattern of small values so that the
+    // activation routines see a spread of inputs.
+    //
+
+    for (size_t i = 0; i < Elements; i++) {
+        Buffer[i] = float(int(i % 47) - 23) / 8.0f;
+    }
+
+    return Buffer;
+}
+
+//
+// Single precision matrix/matrix multiply. The arguments are M, N, K and
+// whether the B matrix is transposed.
+//
+
+static
+void
+BM_Sgemm(
+    benchmark::State& state
+    )
+{
+    const size_t M = size_t(state.range(0));
+    const size_t N = size_t(state.range(1));
+    const size_t K = size_t(state.range(2));
+    const CBLAS_TRANSPOSE TransB = state.range(3) != 0 ? CblasTrans : CblasNoTrans;
+
+    std::vector<float> A = MakeBuffer(M * K);
+    std::vector<float> B = MakeBuffer(K * N);
+    std::vector<float> C(M * N);
+
+    const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    for (auto _ : state) {
+        MlasSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, A.data(), K, B.data(), ldb, 0.0f, C.data(), N);
+    }
+
+    state.counters["GFLOPS"] = benchmark::Counter(2.0 * M * N * K,
+        benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1000);
+}
+
+static
+void
+SgemmArguments(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"M", "N", "K", "TransB"});
+
+    for (int64_t TransB : {0, 1}) {
+        for (int64_t M : {1, 16, 64, 256, 1024}) {
+            for (int64_t NK : {64, 256, 1024}) {
+                b->Args({M, NK, NK, TransB});
+            }
+        }
+        b->Args({1, 1000, 2048, TransB});
+        b->Args({128, 3072, 768, TransB});
+    }
+}
+
+BENCHMARK(BM_Sgemm)->Apply(SgemmArguments)->UseRealTime();
+
+//
+// Two dimensional convolution. The arguments are the batch count, the group
+// count, the input channels and filter count per group, the input height and
+// width, the kernel size, the stride and whether autotuning is enabled.
+//
+
+static
+void
+BM_Conv2D(
+    benchmark::State& state
+    )
+{
+    const size_t BatchCount = size_t(state.range(0));
+    const size_t GroupCount = size_t(state.range(1));
+    const size_t InputChannels = size_t(state.range(2));
+    const size_t FilterCount = size_t(state.range(3));
+    const int64_t InputHeight = state.range(4);
+    const int64_t InputWidth = state.range(5);
+    const int64_t KernelSize = state.range(6);
+    const int64_t Stride = state.range(7);
+    const bool Autotune = state.range(8) != 0;
+
+    const int64_t Pad = KernelSize / 2;
+    const int64_t OutputHeight = (InputHeight + 2 * Pad - KernelSize) / Stride + 1;
+    const int64_t OutputWidth = (InputWidth + 2 * Pad - KernelSize) / Stride + 1;
+
+    const int64_t InputShape[] = {InputHeight, InputWidth};
+    const int64_t KernelShape[] = {KernelSize, KernelSize};
+    const int64_t DilationShape[] = {1, 1};
+    const int64_t Padding[] = {Pad, Pad, Pad, Pad};
+    const int64_t StrideShape[] = {Stride, Stride};
+    const int64_t OutputShape[] = {OutputHeight, OutputWidth};
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvSetAutotuning(Autotune);
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels,
+        InputShape, KernelShape, DilationShape, Padding, StrideShape, OutputShape,
+        FilterCount, nullptr, &WorkingBufferSize);
+    MlasConvSetAutotuning(false);
+
+    std::vector<float> Input = MakeBuffer(BatchCount * GroupCount * InputChannels * InputHeight * InputWidth);
+    std::vector<float> Filter = MakeBuffer(GroupCount * FilterCount * InputChannels * KernelSize * KernelSize);
+    std::vector<float> Bias = MakeBuffer(GroupCount * FilterCount);
+    std::vector<float> WorkingBuffer(std::max<size_t>(WorkingBufferSize, 1));
+    std::vector<float> Output(BatchCount * GroupCount * FilterCount * OutputHeight * OutputWidth);
+
+    for (auto _ : state) {
+        MlasConv(&Parameters, Input.data(), Filter.data(), Bias.data(), WorkingBuffer.data(), Output.data());
+    }
+
+    state.counters["Algorithm"] = double(Parameters.Algorithm);
+    state.counters["ThreadStrideN"] =
+        (Parameters.Algorithm == MlasConvAlgorithmExpandThenGemmSegmented) ?
+        double(Parameters.u.ExpandThenGemmSegmented.ThreadStrideN) : 0.0;
+    state.counters["GFLOPS"] = benchmark::Counter(
+        2.0 * BatchCount * GroupCount * FilterCount * OutputHeight * OutputWidth * Parameters.K,
+        benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1000);
+}
+
+static
+void
+Conv2DArguments(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"N", "G", "Cpg", "Mpg", "H", "W", "K", "S", "Autotune"});
+
+    for (int64_t Autotune : {0, 1}) {
+        b->Args({1, 1, 3, 64, 224, 224, 7, 2, Autotune});
+        b->Args({1, 1, 64, 64, 56, 56, 3, 1, Autotune});
+        b->Args({1, 1, 128, 128, 28, 28, 3, 1, Autotune});
+        b->Args({1, 1, 256, 256, 14, 14, 3, 1, Autotune});
+        b->Args({1, 1, 512, 512, 7, 7, 3, 1, Autotune});
+        b->Args({1, 1, 256, 64, 56, 56, 1, 1, Autotune});
+        b->Args({1, 1, 64, 256, 56, 56, 1, 1, Autotune});
+        b->Args({1, 32, 1, 1, 112, 112, 3, 1, Autotune});
+        b->Args({8, 1, 64, 64, 56, 56, 3, 1, Autotune});
+    }
+}
+
+BENCHMARK(BM_Conv2D)->Apply(Conv2DArguments)->UseRealTime();
+
+//
+// Two dimensional convolution in the NCHWc layout. The arguments are the
+// same as BM_Conv2D without the group count and autotuning.
+//
+
+static
+void
+BM_NchwcConv2D(
+    benchmark::State& state
+    )
+{
+    const int64_t BatchCount = state.range(0);
+    const int64_t InputChannels = state.range(1);
+    const int64_t FilterCount = state.range(2);
+    const int64_t InputHeight = state.range(3);
+    const int64_t InputWidth = state.range(4);
+    const int64_t KernelSize = state.range(5);
+    const int64_t Stride = state.range(6);
+
+    const int64_t Pad = KernelSize / 2;
+    const int64_t OutputHeight = (InputHeight + 2 * Pad - KernelSize) / Stride + 1;
+    const int64_t OutputWidth = (InputWidth + 2 * Pad - KernelSize) / Stride + 1;
+
+    const int64_t InputShape[] = {BatchCount, InputChannels, InputHeight, InputWidth};
+    const int64_t FilterShape[] = {FilterCount, InputChannels, KernelSize, KernelSize};
+    const int64_t KernelShape[] = {KernelSize, KernelSize};
+    const int64_t DilationShape[] = {1, 1};
+    const int64_t Padding[] = {Pad, Pad, Pad, Pad};
+    const int64_t StrideShape[] = {Stride, Stride};
+    const int64_t OutputShape[] = {BatchCount, FilterCount, OutputHeight, OutputWidth};
+
+    std::vector<float> Input = MakeBuffer(BatchCount * InputChannels * InputHeight * InputWidth);
+    std::vector<float> Filter = MakeBuffer(FilterCount * InputChannels * KernelSize * KernelSize);
+    std::vector<float> Bias = MakeBuffer(FilterCount);
+    std::vector<float> NchwcFilter(Filter.size());
+    std::vector<float> Output(BatchCount * FilterCount * OutputHeight * OutputWidth);
+
+    MlasReorderFilterOIHWBiBo(FilterShape, Filter.data(), NchwcFilter.data());
+
+    for (auto _ : state) {
+        MlasNchwcConv(InputShape, KernelShape, DilationShape, Padding, StrideShape, OutputShape,
+            Input.data(), NchwcFilter.data(), Bias.data(), Output.data());
+    }
+
+    state.counters["GFLOPS"] = benchmark::Counter(
+        2.0 * BatchCount * FilterCount * OutputHeight * OutputWidth * InputChannels * KernelSize * KernelSize,
+        benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1000);
+}
+
+static
+void
+NchwcConv2DArguments(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"N", "C", "M", "H", "W", "K", "S"});
+
+    b->Args({1, 64, 64, 56, 56, 3, 1});
+    b->Args({1, 128, 128, 28, 28, 3, 1});
+    b->Args({1, 256, 256, 14, 14, 3, 1});
+    b->Args({1, 512, 512, 7, 7, 3, 1});
+    b->Args({1, 256, 64, 56, 56, 1, 1});
+    b->Args({1, 64, 256, 56, 56, 1, 1});
+    b->Args({8, 64, 64, 56, 56, 3, 1});
+}
+
+BENCHMARK(BM_NchwcConv2D)->Apply(NchwcConv2DArguments)->UseRealTime();
+
+//
+// Two dimensional pooling. The arguments are the pooling kind, the channel
+// count, the input height and width, the kernel size and the stride.
+//
+
+static
+void
+BM_Pool2D(
+    benchmark::State& state
+    )
+{
+    const MLAS_POOLING_KIND PoolingKind = MLAS_POOLING_KIND(state.range(0));
+    const int64_t Channels = state.range(1);
+    const int64_t InputHeight = state.range(2);
+    const int64_t InputWidth = state.range(3);
+    const int64_t KernelSize = state.range(4);
+    const int64_t Stride = state.range(5);
+
+    const int64_t OutputHeight = (InputHeight - KernelSize) / Stride + 1;
+    const int64_t OutputWidth = (InputWidth - KernelSize) / Stride + 1;
+
+    const int64_t InputShape[] = {1, Channels, InputHeight, InputWidth};
+    const int64_t KernelShape[] = {KernelSize, KernelSize};
+    const int64_t Padding[] = {0, 0, 0, 0};
+    const int64_t StrideShape[] = {Stride, Stride};
+    const int64_t OutputShape[] = {1, Channels, OutputHeight, OutputWidth};
+
+    std::vector<float> Input = MakeBuffer(Channels * InputHeight * InputWidth);
+    std::vector<float> Output(Channels * OutputHeight * OutputWidth);
+
+    for (auto _ : state) {
+        MlasPool(PoolingKind, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input.data(), Output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(Input.size() * sizeof(float)));
+}
+
+static
+void
+Pool2DArguments(
+    benchmark::internal::Benchmark* b
+    )
+{
+    b->ArgNames({"Kind", "C", "H", "W", "K", "S"});
+
+    for (int64_t PoolingKind : {MlasMaximumPooling, MlasAveragePoolingExcludePad}) {
+        b->Args({PoolingKind, 64, 112, 112, 3, 2});
+        b->Args({PoolingKind, 256, 56, 56, 2, 2});
+        b->Args({PoolingKind, 2048, 7, 7, 7, 1});
+    }
+}
+
+BENCHMARK(BM_Pool2D)->Apply(Pool2DArguments)->UseRealTime();
+
+//
+// Elementwise activation routines. The argument is the element count.
+//
+
+static
+void
+BM_Logistic(
+    benchmark::State& state
+    )
+{
+    const size_t N = size_t(state.range(0));
+
+    std::vector<float> Input = MakeBuffer(N);
+    std::vector<float> Output(N);
+
+    for (auto _ : state) {
+        MlasComputeLogistic(Input.data(), Output.data(), N);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(N));
+}
+
+BENCHMARK(BM_Logistic)->RangeMultiplier(16)->Range(256, 1 << 20);
+
+static
+void
+BM_Tanh(
+    benchmark::State& state
+    )
+{
+    const size_t N = size_t(state.range(0));
+
+    std::vector<float> Input = MakeBuffer(N);
+    std::vector<float> Output(N);
+
+    for (auto _ : state) {
+        MlasComputeTanh(Input.data(), Output.data(), N);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(N));
+}
+
+BENCHMARK(BM_Tanh)->RangeMultiplier(16)->Range(256, 1 << 20);
+
+BENCHMARK_MAIN();
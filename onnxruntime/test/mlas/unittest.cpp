@@ -17,7 +17,9 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -367,6 +369,391 @@ ExecuteSgemmTests(
     }
 }
 
+float
+ReferenceActivation(
+    const MLAS_ACTIVATION* Activation,
+    float Value
+    )
+{
+    switch (Activation->ActivationKind) {
+        case MlasReluActivation:
+            return (Value >= 0.0f) ? Value : 0.0f;
+        case MlasLeakyReluActivation:
+            return (Value >= 0.0f) ? Value : Value * Activation->Parameters.LeakyRelu.alpha;
+        case MlasClipActivation:
+            return std::min(std::max(Value, Activation->Parameters.Clip.minimum), Activation->Parameters.Clip.maximum);
+        case MlasEluActivation:
+            return (Value >= 0.0f) ? Value : Activation->Parameters.Elu.alpha * (std::exp(Value) - 1.0f);
+        case MlasSeluActivation:
+            return Activation->Parameters.Selu.gamma * ((Value > 0.0f) ? Value :
+                Activation->Parameters.Selu.alpha * (std::exp(Value) - 1.0f));
+        case MlasHardSigmoidActivation:
+            return std::max(std::min(Value * Activation->Parameters.HardSigmoid.alpha +
+                Activation->Parameters.HardSigmoid.beta, 1.0f), 0.0f);
+        case MlasSoftsignActivation:
+            return Value / (std::fabs(Value) + 1.0f);
+        case MlasThresholdedReluActivation:
+            return (Value > Activation->Parameters.ThresholdedRelu.alpha) ? Value : 0.0f;
+        default:
+            return Value;
+    }
+}
+
+void
+TrialSgemmActivation(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_ACTIVATION* Activation
+    )
+{
+    MatrixGuardBuffer BufferA(M * K, true);
+    MatrixGuardBuffer BufferB(K * N, true);
+    MatrixGuardBuffer BufferBias(N, true);
+    MatrixGuardBuffer BufferC(M * N, false);
+    MatrixGuardBuffer BufferCReference(M * N, false);
+
+    const float* A = BufferA.GetBuffer(M * K);
+    const float* B = BufferB.GetBuffer(K * N);
+    const float* Bias = BufferBias.GetBuffer(N);
+    float* C = BufferC.GetBuffer(M * N);
+    float* CReference = BufferCReference.GetBuffer(M * N);
+
+    MlasSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, B, N, 0.0f, C, N, Bias, Activation);
+    ReferenceSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, B, N, 0.0f, CReference, N);
+
+    for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+            CReference[m * N + n] = ReferenceActivation(Activation, CReference[m * N + n] + Bias[n]);
+        }
+    }
+
+    if (memcmp(C, CReference, M * N * sizeof(float)) != 0) {
+        printf("mismatch activation %d: M=%zd, N=%zd, K=%zd!\n", int(Activation->ActivationKind), M, N, K);
+    }
+}
+
+void
+ExecuteActivationTests(
+    void
+    )
+{
+    MLAS_ACTIVATION Activations[7];
+
+    Activations[0].ActivationKind = MlasIdentityActivation;
+    Activations[1].ActivationKind = MlasReluActivation;
+    Activations[2].ActivationKind = MlasLeakyReluActivation;
+    Activations[2].Parameters.LeakyRelu.alpha = 0.25f;
+    Activations[3].ActivationKind = MlasClipActivation;
+    Activations[3].Parameters.Clip.minimum = -100.0f;
+    Activations[3].Parameters.Clip.maximum = 200.0f;
+    Activations[4].ActivationKind = MlasHardSigmoidActivation;
+    Activations[4].Parameters.HardSigmoid.alpha = 0.0078125f;
+    Activations[4].Parameters.HardSigmoid.beta = 0.5f;
+    Activations[5].ActivationKind = MlasSoftsignActivation;
+    Activations[6].ActivationKind = MlasThresholdedReluActivation;
+    Activations[6].Parameters.ThresholdedRelu.alpha = 40.0f;
+
+    for (size_t a = 0; a < _countof(Activations); a++) {
+        for (size_t M = 1; M < 40; M += 3) {
+            for (size_t N = 1; N < 300; N += 17) {
+                TrialSgemmActivation(M, N, 7, &Activations[a]);
+                TrialSgemmActivation(M, N, 300, &Activations[a]);
+            }
+        }
+        TrialSgemmActivation(256, 512, 64, &Activations[a]);
+        TrialSgemmActivation(512, 256, 64, &Activations[a]);
+    }
+
+    //
+    // The transcendental activations share their vector implementations with
+    // the elementwise routine, so compare against that applied after the bias.
+    //
+
+    static const MLAS_ACTIVATION_KIND TranscendentalKinds[] = { MlasLogisticActivation, MlasTanhActivation,
+        MlasEluActivation, MlasSeluActivation };
+
+    const size_t M = 7;
+    const size_t N = 45;
+
+    MatrixGuardBuffer BufferBias(M, true);
+    MatrixGuardBuffer BufferInput(M * N, true);
+    MatrixGuardBuffer BufferOutput(M * N, false);
+    MatrixGuardBuffer BufferOutputReference(M * N, false);
+
+    const float* Bias = BufferBias.GetBuffer(M);
+    const float* Input = BufferInput.GetBuffer(M * N);
+    float* Output = BufferOutput.GetBuffer(M * N);
+    float* OutputReference = BufferOutputReference.GetBuffer(M * N);
+
+    for (size_t k = 0; k < _countof(TranscendentalKinds); k++) {
+
+        MLAS_ACTIVATION Activation;
+        Activation.ActivationKind = TranscendentalKinds[k];
+        Activation.Parameters.Selu.alpha = 1.5f;
+        Activation.Parameters.Selu.gamma = 1.25f;
+
+        for (size_t i = 0; i < M * N; i++) {
+            Output[i] = Input[i] * 0.125f;
+            OutputReference[i] = Input[i] * 0.125f + Bias[i / N];
+        }
+
+        MlasActivation(&Activation, Output, Bias, M, N, N);
+
+        MlasComputeActivation(&Activation, OutputReference, OutputReference, M * N);
+
+        if (memcmp(Output, OutputReference, M * N * sizeof(float)) != 0) {
+            printf("mismatch activation %d!\n", int(TranscendentalKinds[k]));
+        }
+    }
+}
+
+bool
+CloseEnough(
+    float Value,
+    float Reference,
+    float MinimumMagnitude
+    )
+{
+    if (std::isnan(Reference)) {
+        return std::isnan(Value);
+    }
+
+    if (std::isinf(Reference)) {
+        return Value == Reference;
+    }
+
+    const float Tolerance = 4.0f * std::numeric_limits<float>::epsilon();
+
+    return std::fabs(Value - Reference) <= Tolerance * std::max(std::fabs(Reference), MinimumMagnitude);
+}
+
+void
+TrialComputeActivation(
+    const MLAS_ACTIVATION* Activation,
+    size_t N
+    )
+{
+    std::vector<float> Input(N);
+    std::vector<float> Output(N);
+
+    for (size_t i = 0; i < N; i++) {
+        Input[i] = float(int(i % 2001) - 1000) * 0.01f;
+    }
+
+    MlasComputeActivation(Activation, Input.data(), Output.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        //
+        // The exponential based activations compute exp(x) - 1, so compare
+        // against the error of a unit magnitude result near zero.
+        //
+
+        if (!CloseEnough(Output[i], ReferenceActivation(Activation, Input[i]), 1.0f)) {
+            printf("mismatch compute activation %d: N=%zd, x=%g!\n", int(Activation->ActivationKind), N, Input[i]);
+            break;
+        }
+    }
+
+    //
+    // Verify that the activation can be computed in place.
+    //
+
+    MlasComputeActivation(Activation, Input.data(), Input.data(), N);
+
+    if (memcmp(Input.data(), Output.data(), N * sizeof(float)) != 0) {
+        printf("mismatch compute activation in place %d: N=%zd!\n", int(Activation->ActivationKind), N);
+    }
+}
+
+void
+TrialComputeFunction(
+    const char* Name,
+    void (MLASCALL *ComputeRoutine)(const float* Input, float* Output, size_t N),
+    float (*ReferenceRoutine)(float Value),
+    const std::vector<float>& Input
+    )
+{
+    const size_t N = Input.size();
+
+    std::vector<float> Output(N);
+
+    ComputeRoutine(Input.data(), Output.data(), N);
+
+    for (size_t i = 0; i < N; i++) {
+        if (!CloseEnough(Output[i], ReferenceRoutine(Input[i]), std::numeric_limits<float>::min())) {
+            printf("mismatch %s: x=%g, result=%g, expected=%g!\n", Name, Input[i], Output[i], ReferenceRoutine(Input[i]));
+            break;
+        }
+    }
+}
+
+void
+ExecuteComputeTests(
+    void
+    )
+{
+    MLAS_ACTIVATION Activations[9];
+
+    Activations[0].ActivationKind = MlasReluActivation;
+    Activations[1].ActivationKind = MlasLeakyReluActivation;
+    Activations[1].Parameters.LeakyRelu.alpha = 0.01f;
+    Activations[2].ActivationKind = MlasClipActivation;
+    Activations[2].Parameters.Clip.minimum = -1.0f;
+    Activations[2].Parameters.Clip.maximum = 6.0f;
+    Activations[3].ActivationKind = MlasEluActivation;
+    Activations[3].Parameters.Elu.alpha = 1.0f;
+    Activations[4].ActivationKind = MlasSeluActivation;
+    Activations[4].Parameters.Selu.alpha = 1.67326319217681884765625f;
+    Activations[4].Parameters.Selu.gamma = 1.05070102214813232421875f;
+    Activations[5].ActivationKind = MlasHardSigmoidActivation;
+    Activations[5].Parameters.HardSigmoid.alpha = 0.2f;
+    Activations[5].Parameters.HardSigmoid.beta = 0.5f;
+    Activations[6].ActivationKind = MlasSoftsignActivation;
+    Activations[7].ActivationKind = MlasThresholdedReluActivation;
+    Activations[7].Parameters.ThresholdedRelu.alpha = 1.0f;
+    Activations[8].ActivationKind = MlasIdentityActivation;
+
+    for (size_t a = 0; a < _countof(Activations); a++) {
+        for (size_t N = 1; N < 64; N++) {
+            TrialComputeActivation(&Activations[a], N);
+        }
+        TrialComputeActivation(&Activations[a], 1000003);
+    }
+
+    //
+    // Sweep the exponential across its full range, including the results in
+    // the denormal range and the overflow to infinity.
+    //
+
+    std::vector<float> Input;
+
+    for (float x = -110.0f; x < 90.0f; x += 0.0137f) {
+        Input.push_back(x);
+    }
+    Input.push_back(std::numeric_limits<float>::infinity());
+    Input.push_back(-std::numeric_limits<float>::infinity());
+
+    TrialComputeFunction("exp", MlasComputeExp, [](float x) { return std::exp(x); }, Input);
+
+    //
+    // Sweep the logarithm across the powers of two of the denormal and normal
+    // ranges and the special values.
+    //
+
+    Input.clear();
+
+    for (float x = std::numeric_limits<float>::denorm_min(); x < 1e38f; x *= 1.0137f) {
+        Input.push_back(x);
+        x = std::max(x, std::nextafter(x, 1.0f));
+    }
+    Input.push_back(0.0f);
+    Input.push_back(-0.0f);
+    Input.push_back(-1.0f);
+    Input.push_back(std::numeric_limits<float>::infinity());
+    Input.push_back(std::numeric_limits<float>::quiet_NaN());
+
+    TrialComputeFunction("log", MlasComputeLog, [](float x) { return std::log(x); }, Input);
+
+    Input.clear();
+
+    for (float x = -6.0f; x < 6.0f; x += 0.00137f) {
+        Input.push_back(x);
+    }
+
+    TrialComputeFunction("erf", MlasComputeErf, [](float x) { return std::erf(x); }, Input);
+}
+
+MLAS_FP16
+ConvertFloatToHalf(
+    float Value
+    )
+{
+    //
+    // The tests only convert small integers, which are exactly representable
+    // as normal half-precision values.
+    //
+
+    uint32_t Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+
+    uint32_t Sign = (Bits >> 16) & 0x8000;
+
+    if ((Bits & 0x7FFFFFFF) == 0) {
+        return MLAS_FP16(Sign);
+    }
+
+    uint32_t Exponent = ((Bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t Mantissa = (Bits >> 13) & 0x3FF;
+
+    return MLAS_FP16(Sign | (Exponent << 10) | Mantissa);
+}
+
+void
+TrialSgemmHalf(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float beta
+    )
+{
+    MatrixGuardBuffer BufferA(M * K, true);
+    MatrixGuardBuffer BufferB(K * N, true);
+    MatrixGuardBuffer BufferC(M * N, false);
+    MatrixGuardBuffer BufferCReference(M * N, false);
+
+    const float* A = BufferA.GetBuffer(M * K);
+    const float* B = BufferB.GetBuffer(K * N);
+    float* C = BufferC.GetBuffer(M * N);
+    float* CReference = BufferCReference.GetBuffer(M * N);
+
+    std::vector<MLAS_FP16> HalfB(K * N);
+
+    for (size_t i = 0; i < K * N; i++) {
+        HalfB[i] = ConvertFloatToHalf(B[i]);
+    }
+
+    for (size_t f = 0; f < M * N; f++) {
+        C[f] = -0.5f;
+        CReference[f] = -0.5f;
+    }
+
+    size_t lda = (TransA == CblasNoTrans) ? K : M;
+    size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    MlasSgemm(TransA, TransB, M, N, K, 1.0f, A, lda, HalfB.data(), ldb, beta, C, N, nullptr, nullptr);
+    ReferenceSgemm(TransA, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, CReference, N);
+
+    for (size_t f = 0; f < M * N; f++) {
+        if (C[f] != CReference[f]) {
+            printf("mismatch half TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, beta=%f!\n", TransA, TransB, M, N, K, beta);
+            break;
+        }
+    }
+}
+
+void
+ExecuteSgemmHalfTests(
+    void
+    )
+{
+    for (size_t M = 1; M < 20; M += 3) {
+        for (size_t N = 1; N < 100; N += 7) {
+            for (size_t K = 1; K < 300; K += 37) {
+                TrialSgemmHalf(CblasNoTrans, CblasNoTrans, M, N, K, 0.0f);
+                TrialSgemmHalf(CblasNoTrans, CblasTrans, M, N, K, 0.0f);
+                TrialSgemmHalf(CblasTrans, CblasNoTrans, M, N, K, 1.0f);
+                TrialSgemmHalf(CblasTrans, CblasTrans, M, N, K, 1.0f);
+            }
+        }
+    }
+
+    TrialSgemmHalf(CblasNoTrans, CblasNoTrans, 128, 768, 512, 0.0f);
+    TrialSgemmHalf(CblasNoTrans, CblasTrans, 128, 768, 512, 0.0f);
+}
+
 void
 ReferenceConv2D(
     size_t BatchCount,
@@ -512,6 +899,7 @@ TrialConv2D(
                     StrideShape,
                     OutputShape,
                     FilterCount,
+                    nullptr,
                     &WorkingBufferSize);
 
     size_t OutputHeight = size_t(OutputHeight64);
@@ -567,6 +955,165 @@ TrialConv2D(
             BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
             KernelHeight, KernelWidth);
     }
+
+    //
+    // Run again with a fused activation. The fill values keep the products
+    // exact, so the results must match the reference exactly.
+    //
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasLeakyReluActivation;
+    Activation.Parameters.LeakyRelu.alpha = 0.5f;
+
+    Parameters.Activation = &Activation;
+
+    MlasConv(&Parameters,
+             Input,
+             Filter,
+             Bias,
+             BufferWorking.GetBuffer(WorkingBufferSize),
+             Output);
+
+    Parameters.Activation = nullptr;
+
+    for (size_t i = 0; i < OutputBufferElements; i++) {
+        float Expected = (OutputReference[i] >= 0.0f) ? OutputReference[i] : OutputReference[i] * 0.5f;
+        if (Output[i] != Expected) {
+            printf("mismatch with activation: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+                BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+                KernelHeight, KernelWidth);
+            break;
+        }
+    }
+
+    //
+    // Run again with the filter transformed ahead of time, if the algorithm
+    // transforms the filter.
+    //
+
+    size_t TransformedFilterElements = MlasConvGetTransformedFilterSize(&Parameters);
+
+    if (TransformedFilterElements > 0) {
+
+        MatrixGuardBuffer BufferTransformedFilter(TransformedFilterElements, false);
+        float* TransformedFilter = BufferTransformedFilter.GetBuffer(TransformedFilterElements);
+
+        MlasConvTransformFilter(&Parameters, Filter, TransformedFilter);
+        MlasConvSetTransformedFilter(&Parameters, TransformedFilter, &WorkingBufferSize);
+
+        MlasConv(&Parameters,
+                 Input,
+                 nullptr,
+                 Bias,
+                 BufferWorking.GetBuffer(WorkingBufferSize),
+                 Output);
+
+        if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+            printf("mismatch with transformed filter: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+                BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+                KernelHeight, KernelWidth);
+        }
+    }
+}
+
+void
+TrialConv1D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t InputWidth,
+    size_t FilterCount,
+    size_t KernelWidth,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightWidth,
+    size_t DilationWidth,
+    size_t StrideWidth
+    )
+{
+    int64_t OutputWidth64 =
+        ((int64_t(InputWidth) + int64_t(PaddingLeftWidth) + int64_t(PaddingRightWidth)) -
+        (int64_t(DilationWidth) * (int64_t(KernelWidth) - 1) + 1)) / int64_t(StrideWidth) + 1;
+
+    if (OutputWidth64 <= 0) {
+        return;
+    }
+
+    int64_t InputShape[] = { int64_t(InputWidth) };
+    int64_t KernelShape[] = { int64_t(KernelWidth) };
+    int64_t DilationShape[] = { int64_t(DilationWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftWidth), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideWidth) };
+    int64_t OutputShape[] = { OutputWidth64 };
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters,
+                    1,
+                    BatchCount,
+                    GroupCount,
+                    InputChannels,
+                    InputShape,
+                    KernelShape,
+                    DilationShape,
+                    Padding,
+                    StrideShape,
+                    OutputShape,
+                    FilterCount,
+                    nullptr,
+                    &WorkingBufferSize);
+
+    size_t OutputWidth = size_t(OutputWidth64);
+
+    size_t InputBufferElements = BatchCount * GroupCount * InputChannels * InputWidth;
+    size_t FilterBufferElements = GroupCount * FilterCount * InputChannels * KernelWidth;
+    size_t BiasBufferElements = GroupCount * FilterCount;
+    size_t OutputBufferElements = BatchCount * GroupCount * FilterCount * OutputWidth;
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferFilter(FilterBufferElements, true);
+    MatrixGuardBuffer BufferBias(BiasBufferElements, true);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+    MatrixGuardBuffer BufferWorking(WorkingBufferSize, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
+    const float* Bias = BufferBias.GetBuffer(BiasBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+    MlasConv(&Parameters,
+             Input,
+             Filter,
+             Bias,
+             BufferWorking.GetBuffer(WorkingBufferSize),
+             Output);
+
+    //
+    // A 1D convolution is equivalent to a 2D convolution with a unit height.
+    //
+
+    ReferenceConv2D(BatchCount,
+                    GroupCount,
+                    InputChannels,
+                    1, InputWidth,
+                    FilterCount,
+                    1, KernelWidth,
+                    0, PaddingLeftWidth,
+                    1, DilationWidth,
+                    1, StrideWidth,
+                    1, OutputWidth,
+                    Input,
+                    Filter,
+                    Bias,
+                    OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch conv1d: batch=%zd,group=%zd,input(%zd,%zd),filter=%zd,kernel=%zd,pad=%zd,%zd,dilation=%zd,stride=%zd!!!\n",
+            BatchCount, GroupCount, InputChannels, InputWidth, FilterCount, KernelWidth,
+            PaddingLeftWidth, PaddingRightWidth, DilationWidth, StrideWidth);
+    }
 }
 
 void
@@ -597,6 +1144,53 @@ ExecuteConvTests(
         TrialConv2D(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
     }
 
+    for (unsigned i = 1; i <= 40; i += 3) {
+        TrialConv2D(1, 1, 16, i, i, 16, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        TrialConv2D(2, 3, 24, i, i + 3, 40, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1);
+        TrialConv2D(1, 1, 64, i + 2, i, 128, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1);
+    }
+
+    //
+    // Run shapes with the algorithms picked by autotuning, twice so that the
+    // second pass uses the choices cached by the first.
+    //
+
+    MlasConvSetAutotuning(true);
+
+    for (unsigned pass = 0; pass < 2; pass++) {
+        for (unsigned i = 1; i <= 40; i += 13) {
+            TrialConv2D(1, 1, 16, i, i, 16, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+            TrialConv2D(2, 3, 24, i, i + 3, 40, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1);
+            TrialConv2D(1, 1, 64, i + 2, i, 128, 3, 3, 2, 2, 2, 2, 1, 1, 2, 2);
+        }
+    }
+
+    MlasConvSetAutotuning(false);
+
+    for (unsigned i = 1; i <= 64; i += 7) {
+        for (unsigned k = 1; k <= 5; k += 2) {
+            for (unsigned d = 1; d <= 2; d++) {
+                for (unsigned s = 1; s <= 2; s++) {
+                    TrialConv1D(1, 1, 16, i, 32, k, k / 2, k / 2, d, s);
+                    TrialConv1D(2, 2, 8, i, 12, k, 0, 1, d, s);
+                    TrialConv1D(1, 16, 1, i, 1, k, k / 2, 0, d, s);
+                }
+            }
+        }
+    }
+
+    for (unsigned i = 1; i <= 40; i += 3) {
+        for (unsigned k = 3; k <= 5; k += 2) {
+            for (unsigned d = 1; d <= 2; d++) {
+                for (unsigned s = 1; s <= 3; s++) {
+                    TrialConv2D(2, 24, 1, i, i + 5, 1, k, k, k / 2, k / 2, k / 2, k / 2, d, d, s, s);
+                    TrialConv2D(1, 8, 1, i, i, 2, k, k, 0, 1, 1, 0, d, d, s, s);
+                    TrialConv2D(1, 8, 1, i + 5, i, 1, k, 1, 1, 0, 1, 0, d, d, s, 1);
+                }
+            }
+        }
+    }
+
     for (unsigned ic = 0; ic < _countof(cs); ic++) {
         for (unsigned ih = 0; ih < _countof(is); ih++) {
             for (unsigned iw = 0; iw < _countof(is); iw++) {
@@ -631,6 +1225,218 @@ ExecuteConvTests(
     }
 }
 
+void
+ReferenceConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output
+    )
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t KernelSize = Parameters->KernelSize;
+
+    const size_t* is = Parameters->InputShape;
+    const size_t* os = Parameters->OutputShape;
+    const size_t* ks = Parameters->KernelShape;
+    const size_t* ds = Parameters->DilationShape;
+    const size_t* ss = Parameters->StrideShape;
+    const size_t* ps = Parameters->Padding;
+
+    for (size_t b = 0; b < Parameters->BatchCount; b++) {
+        for (size_t g = 0; g < Parameters->GroupCount; g++) {
+
+            const float* filter = Filter + g * InputChannels * FilterCount * KernelSize;
+
+            for (size_t f = 0; f < FilterCount; f++) {
+
+                float* output = Output + f * OutputSize;
+                float BiasValue = (Bias != nullptr) ? Bias[g * FilterCount + f] : 0.0f;
+
+                for (size_t o = 0; o < OutputSize; o++) {
+                    output[o] = BiasValue;
+                }
+
+                for (size_t c = 0; c < InputChannels; c++) {
+
+                    const float* input = Input + c * InputSize;
+                    const float* weights = filter + (c * FilterCount + f) * KernelSize;
+
+                    for (size_t id = 0; id < is[0]; id++) {
+                        for (size_t ih = 0; ih < is[1]; ih++) {
+                            for (size_t iw = 0; iw < is[2]; iw++) {
+                                for (size_t kd = 0; kd < ks[0]; kd++) {
+                                    for (size_t kh = 0; kh < ks[1]; kh++) {
+                                        for (size_t kw = 0; kw < ks[2]; kw++) {
+
+                                            int64_t od = int64_t(id * ss[0] + kd * ds[0]) - int64_t(ps[0]);
+                                            int64_t oh = int64_t(ih * ss[1] + kh * ds[1]) - int64_t(ps[1]);
+                                            int64_t ow = int64_t(iw * ss[2] + kw * ds[2]) - int64_t(ps[2]);
+
+                                            if (od < 0 || od >= int64_t(os[0]) || oh < 0 || oh >= int64_t(os[1]) ||
+                                                ow < 0 || ow >= int64_t(os[2])) {
+                                                continue;
+                                            }
+
+                                            output[(size_t(od) * os[1] + size_t(oh)) * os[2] + size_t(ow)] +=
+                                                input[(id * is[1] + ih) * is[2] + iw] *
+                                                weights[(kd * ks[1] + kh) * ks[2] + kw];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            Input += InputChannels * InputSize;
+            Output += FilterCount * OutputSize;
+        }
+    }
+}
+
+void
+TrialConvTranspose(
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const size_t* InputShape,
+    size_t FilterCount,
+    const size_t* KernelShape,
+    size_t PaddingLeft,
+    size_t PaddingRight,
+    size_t OutputPadding,
+    size_t Dilation,
+    size_t Stride
+    )
+{
+    int64_t InputShape64[3];
+    int64_t KernelShape64[3];
+    int64_t DilationShape64[3];
+    int64_t Padding64[6];
+    int64_t StrideShape64[3];
+    int64_t OutputShape64[3];
+
+    size_t InputSize = 1;
+    size_t KernelSize = 1;
+    size_t OutputSize = 1;
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+
+        int64_t OutputExtent = int64_t((InputShape[dim] - 1) * Stride + Dilation * (KernelShape[dim] - 1) + 1 +
+            OutputPadding) - int64_t(PaddingLeft + PaddingRight);
+
+        if (OutputExtent <= 0) {
+            return;
+        }
+
+        InputShape64[dim] = int64_t(InputShape[dim]);
+        KernelShape64[dim] = int64_t(KernelShape[dim]);
+        DilationShape64[dim] = int64_t(Dilation);
+        Padding64[dim] = int64_t(PaddingLeft);
+        Padding64[dim + Dimensions] = int64_t(PaddingRight);
+        StrideShape64[dim] = int64_t(Stride);
+        OutputShape64[dim] = OutputExtent;
+
+        InputSize *= InputShape[dim];
+        KernelSize *= KernelShape[dim];
+        OutputSize *= size_t(OutputExtent);
+    }
+
+    MLAS_CONV_TRANSPOSE_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvTransposePrepare(&Parameters,
+                             Dimensions,
+                             BatchCount,
+                             GroupCount,
+                             InputChannels,
+                             InputShape64,
+                             KernelShape64,
+                             DilationShape64,
+                             Padding64,
+                             StrideShape64,
+                             OutputShape64,
+                             FilterCount,
+                             nullptr,
+                             &WorkingBufferSize);
+
+    size_t InputElements = BatchCount * GroupCount * InputChannels * InputSize;
+    size_t FilterElements = GroupCount * InputChannels * FilterCount * KernelSize;
+    size_t BiasElements = GroupCount * FilterCount;
+    size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    MatrixGuardBuffer BufferInput(InputElements, true);
+    MatrixGuardBuffer BufferFilter(FilterElements, true);
+    MatrixGuardBuffer BufferBias(BiasElements, true);
+    MatrixGuardBuffer BufferWorking(WorkingBufferSize, false);
+    MatrixGuardBuffer BufferOutput(OutputElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterElements);
+    const float* Bias = BufferBias.GetBuffer(BiasElements);
+    float* Working = BufferWorking.GetBuffer(WorkingBufferSize);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    MlasConvTranspose(&Parameters, Input, Filter, Bias, Working, Output);
+    ReferenceConvTranspose(&Parameters, Input, Filter, Bias, OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputElements * sizeof(float)) != 0) {
+        printf("mismatch conv transpose: dims=%zd, batch=%zd, group=%zd, input(%zd,%zd,%zd,%zd), filter=%zd, kernel(%zd,%zd,%zd), pad=%zd,%zd, outpad=%zd, dilation=%zd, stride=%zd!\n",
+            Dimensions, BatchCount, GroupCount, InputChannels, InputShape[0], (Dimensions > 1) ? InputShape[1] : 0,
+            (Dimensions > 2) ? InputShape[2] : 0, FilterCount, KernelShape[0], (Dimensions > 1) ? KernelShape[1] : 0,
+            (Dimensions > 2) ? KernelShape[2] : 0, PaddingLeft, PaddingRight, OutputPadding, Dilation, Stride);
+    }
+}
+
+void
+ExecuteConvTransposeTests(
+    void
+    )
+{
+    static const size_t Extents[] = { 1, 2, 5, 11 };
+    static const size_t Kernels[] = { 1, 2, 3, 4 };
+
+    for (size_t Dimensions = 1; Dimensions <= 3; Dimensions++) {
+        for (size_t e = 0; e < _countof(Extents); e++) {
+            for (size_t k = 0; k < _countof(Kernels); k++) {
+
+                size_t InputShape[3] = { Extents[e], Extents[e] + 2, Extents[e] + 1 };
+                size_t KernelShape[3] = { Kernels[k], Kernels[k], Kernels[k] };
+
+                for (size_t s = 1; s <= 3; s++) {
+                    for (size_t d = 1; d <= 2; d++) {
+                        for (size_t p = 0; p <= 1; p++) {
+                            for (size_t op = 0; op < s; op++) {
+                                TrialConvTranspose(Dimensions, 1, 1, 3, InputShape, 5, KernelShape, p, p, op, d, s);
+                                TrialConvTranspose(Dimensions, 2, 2, 2, InputShape, 3, KernelShape, p, 0, op, d, s);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // Larger shapes to exercise the threaded col2im step.
+    //
+
+    static const size_t LargeInputShape[] = { 28, 28 };
+    static const size_t LargeKernelShape[] = { 4, 4 };
+
+    TrialConvTranspose(2, 2, 1, 64, LargeInputShape, 32, LargeKernelShape, 1, 1, 0, 1, 2);
+    TrialConvTranspose(2, 1, 4, 16, LargeInputShape, 8, LargeKernelShape, 0, 0, 1, 1, 2);
+}
+
 void
 ReferenceMaximumPool2D(
     const int64_t* InputShape,
@@ -996,6 +1802,71 @@ TrialPool2D(
     }
 }
 
+void
+TrialPool1D(
+    size_t BatchCount,
+    size_t InputChannels,
+    size_t InputWidth,
+    size_t KernelWidth,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightWidth,
+    size_t StrideWidth
+    )
+{
+    int64_t InputShape[] = { int64_t(BatchCount), int64_t(InputChannels), int64_t(InputWidth) };
+    int64_t KernelShape[] = { int64_t(KernelWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftWidth), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideWidth) };
+    int64_t OutputShape[] = { int64_t(BatchCount), int64_t(InputChannels), 0 };
+
+    OutputShape[2] = (InputShape[2] + Padding[0] + Padding[1] - KernelShape[0]) / StrideShape[0] + 1;
+
+    //
+    // A 1D pooling operation is equivalent to a 2D pooling operation with a
+    // unit height.
+    //
+
+    int64_t InputShape2D[] = { InputShape[0], InputShape[1], 1, InputShape[2] };
+    int64_t KernelShape2D[] = { 1, KernelShape[0] };
+    int64_t Padding2D[] = { 0, Padding[0], 0, Padding[1] };
+    int64_t StrideShape2D[] = { 1, StrideShape[0] };
+
+    size_t InputBufferElements = size_t(InputShape[0] * InputShape[1] * InputShape[2]);
+    size_t OutputBufferElements = size_t(OutputShape[0] * OutputShape[1] * OutputShape[2]);
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+    MlasPool(MlasMaximumPooling, 1, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    ReferenceMaximumPool2D(InputShape2D, KernelShape2D, Padding2D, StrideShape2D, Input, OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: maximum input(%zd,%zd),kernel(%zd)!!!\n",
+            InputChannels, InputWidth, KernelWidth);
+    }
+
+    MlasPool(MlasAveragePoolingExcludePad, 1, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    ReferenceAveragePool2D(InputShape2D, KernelShape2D, Padding2D, StrideShape2D, Input, OutputReference, false);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: averageexcpad input(%zd,%zd),kernel(%zd)!!!\n",
+            InputChannels, InputWidth, KernelWidth);
+    }
+
+    MlasPool(MlasAveragePoolingIncludePad, 1, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    ReferenceAveragePool2D(InputShape2D, KernelShape2D, Padding2D, StrideShape2D, Input, OutputReference, true);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: averageincpad input(%zd,%zd),kernel(%zd)!!!\n",
+            InputChannels, InputWidth, KernelWidth);
+    }
+}
+
 void
 TrialPool3D(
     size_t BatchCount,
@@ -1063,6 +1934,28 @@ TrialPool3D(
     }
 }
 
+void
+ExecutePool1DTests(
+    void
+    )
+{
+    static const unsigned is[] = { 53, 17, 11, 5, 4, 3, 2, 1 };
+
+    for (unsigned iw = 0; iw < _countof(is); iw++) {
+        TrialPool1D(1, 1, is[iw], is[iw], 0, 0, 1);
+        for (unsigned kw = 1; kw <= 5; kw++) {
+            if (kw > is[iw]) break;
+            for (unsigned p0 = 0; p0 < kw; p0++) {
+                for (unsigned p1 = 0; p1 < kw; p1++) {
+                    for (unsigned sw = 1; sw <= 3; sw++) {
+                        TrialPool1D(2, 3, is[iw], kw, p0, p1, sw);
+                    }
+                }
+            }
+        }
+    }
+}
+
 void
 ExecutePool2DTests(
     void
@@ -1148,6 +2041,195 @@ ExecutePool3DTests(
     }
 }
 
+void
+TrialNchwcConv2D(
+    size_t BatchCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t FilterCount,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightHeight,
+    size_t PaddingRightWidth,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth
+    )
+{
+    int64_t OutputHeight64 =
+        ((int64_t(InputHeight) + int64_t(PaddingLeftHeight) + int64_t(PaddingRightHeight)) -
+        (int64_t(DilationHeight) * (int64_t(KernelHeight) - 1) + 1)) / int64_t(StrideHeight) + 1;
+    int64_t OutputWidth64 =
+        ((int64_t(InputWidth) + int64_t(PaddingLeftWidth) + int64_t(PaddingRightWidth)) -
+        (int64_t(DilationWidth) * (int64_t(KernelWidth) - 1) + 1)) / int64_t(StrideWidth) + 1;
+
+    if (OutputHeight64 <= 0 || OutputWidth64 <= 0) {
+        return;
+    }
+
+    int64_t InputShape[] = { int64_t(BatchCount), int64_t(InputChannels), int64_t(InputHeight), int64_t(InputWidth) };
+    int64_t FilterShape[] = { int64_t(FilterCount), int64_t(InputChannels), int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+    int64_t OutputShape[] = { int64_t(BatchCount), int64_t(FilterCount), OutputHeight64, OutputWidth64 };
+
+    size_t OutputHeight = size_t(OutputHeight64);
+    size_t OutputWidth = size_t(OutputWidth64);
+
+    size_t InputBufferElements = BatchCount * InputChannels * InputHeight * InputWidth;
+    size_t FilterBufferElements = FilterCount * InputChannels * KernelHeight * KernelWidth;
+    size_t OutputBufferElements = BatchCount * FilterCount * OutputHeight * OutputWidth;
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferFilter(FilterBufferElements, true);
+    MatrixGuardBuffer BufferBias(FilterCount, true);
+    MatrixGuardBuffer BufferNchwcInput(InputBufferElements, false);
+    MatrixGuardBuffer BufferNchwcFilter(FilterBufferElements, false);
+    MatrixGuardBuffer BufferNchwcOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
+    const float* Bias = BufferBias.GetBuffer(FilterCount);
+    float* NchwcInput = BufferNchwcInput.GetBuffer(InputBufferElements);
+    float* NchwcFilter = BufferNchwcFilter.GetBuffer(FilterBufferElements);
+    float* NchwcOutput = BufferNchwcOutput.GetBuffer(OutputBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+    MlasReorderInput(InputShape, Input, NchwcInput);
+    MlasReorderFilterOIHWBiBo(FilterShape, Filter, NchwcFilter);
+
+    MlasNchwcConv(InputShape, KernelShape, DilationShape, Padding, StrideShape, OutputShape,
+        NchwcInput, NchwcFilter, Bias, NchwcOutput);
+
+    MlasReorderOutput(OutputShape, NchwcOutput, Output);
+
+    ReferenceConv2D(BatchCount,
+                    1,
+                    InputChannels,
+                    InputHeight, InputWidth,
+                    FilterCount,
+                    KernelHeight, KernelWidth,
+                    PaddingLeftHeight, PaddingLeftWidth,
+                    DilationHeight, DilationWidth,
+                    StrideHeight, StrideWidth,
+                    OutputHeight, OutputWidth,
+                    Input,
+                    Filter,
+                    Bias,
+                    OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: nchwc batch=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd),dilation(%zd,%zd),stride(%zd,%zd)!!!\n",
+            BatchCount, InputChannels, InputHeight, InputWidth, FilterCount, KernelHeight, KernelWidth,
+            DilationHeight, DilationWidth, StrideHeight, StrideWidth);
+    }
+}
+
+void
+TrialNchwcPool2D(
+    size_t BatchCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingLeftHeight,
+    size_t PaddingLeftWidth,
+    size_t PaddingRightHeight,
+    size_t PaddingRightWidth,
+    size_t StrideHeight,
+    size_t StrideWidth
+    )
+{
+    int64_t InputShape[] = { int64_t(BatchCount), int64_t(InputChannels), int64_t(InputHeight), int64_t(InputWidth) };
+    int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+    int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+    int64_t OutputShape[] = { int64_t(BatchCount), int64_t(InputChannels), 0, 0 };
+
+    OutputShape[2] = (InputShape[2] + Padding[0] + Padding[2] - KernelShape[0]) / StrideShape[0] + 1;
+    OutputShape[3] = (InputShape[3] + Padding[1] + Padding[3] - KernelShape[1]) / StrideShape[1] + 1;
+
+    size_t InputBufferElements = size_t(InputShape[0] * InputShape[1] * InputShape[2] * InputShape[3]);
+    size_t OutputBufferElements = size_t(OutputShape[0] * OutputShape[1] * OutputShape[2] * OutputShape[3]);
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferNchwcInput(InputBufferElements, false);
+    MatrixGuardBuffer BufferNchwcOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    float* NchwcInput = BufferNchwcInput.GetBuffer(InputBufferElements);
+    float* NchwcOutput = BufferNchwcOutput.GetBuffer(OutputBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+    MlasReorderInput(InputShape, Input, NchwcInput);
+
+    static const MLAS_POOLING_KIND PoolingKinds[] = { MlasMaximumPooling, MlasAveragePoolingExcludePad, MlasAveragePoolingIncludePad };
+
+    for (unsigned k = 0; k < _countof(PoolingKinds); k++) {
+
+        MlasNchwcPool(PoolingKinds[k], InputShape, KernelShape, Padding, StrideShape, OutputShape, NchwcInput, NchwcOutput);
+        MlasReorderOutput(OutputShape, NchwcOutput, Output);
+
+        if (PoolingKinds[k] == MlasMaximumPooling) {
+            ReferenceMaximumPool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference);
+        } else {
+            ReferenceAveragePool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference,
+                PoolingKinds[k] == MlasAveragePoolingIncludePad);
+        }
+
+        if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+            printf("mismatch: nchwc kind=%d input(%zd,%zd,%zd),kernel(%zd,%zd)!!!\n",
+                int(PoolingKinds[k]), InputChannels, InputHeight, InputWidth, KernelHeight, KernelWidth);
+        }
+    }
+}
+
+void
+ExecuteNchwcTests(
+    void
+    )
+{
+    const size_t BlockSize = MlasNchwcGetBlockSize();
+
+    static const unsigned is[] = { 29, 14, 7, 3, 1 };
+
+    for (unsigned ih = 0; ih < _countof(is); ih++) {
+        for (unsigned iw = 0; iw < _countof(is); iw++) {
+            fprintf(stderr, "Handling nchwc %dx%d\n", is[ih], is[iw]);
+            for (unsigned k = 1; k <= 5; k += 2) {
+                for (unsigned p = 0; p <= k / 2; p++) {
+                    for (unsigned d = 1; d <= 2; d++) {
+                        for (unsigned s = 1; s <= 2; s++) {
+                            TrialNchwcConv2D(1, BlockSize, is[ih], is[iw], 2 * BlockSize, k, k, p, p, p, p, d, d, s, s);
+                            TrialNchwcConv2D(2, 2 * BlockSize, is[ih], is[iw], 3 * BlockSize, k, k, p, p + 1, p + 1, p, d, d, s, s);
+                        }
+                    }
+                    if (k <= is[ih] && k <= is[iw] && p < k) {
+                        TrialNchwcPool2D(2, 2 * BlockSize, is[ih], is[iw], k, k, p, p, p, p, 1, 1);
+                        TrialNchwcPool2D(1, BlockSize, is[ih], is[iw], k, k, p, 0, 0, p, 2, 2);
+                    }
+                }
+            }
+        }
+    }
+
+    TrialNchwcConv2D(1, 8 * BlockSize, 56, 56, 8 * BlockSize, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    TrialNchwcConv2D(1, 8 * BlockSize, 56, 56, 32 * BlockSize, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
+}
+
 #if 0
 #if defined(_WIN32)
 
@@ -1235,7 +2317,13 @@ main(
     )
 {
 //    ExecuteSgemmTests();
+    ExecuteActivationTests();
+    ExecuteComputeTests();
+    ExecuteSgemmHalfTests();
     ExecuteConvTests();
+    ExecuteConvTransposeTests();
+    ExecuteNchwcTests();
+    ExecutePool1DTests();
 //    ExecutePool2DTests();
 //    ExecutePool3DTests();
 //    EvaluateThreadingPerformance();
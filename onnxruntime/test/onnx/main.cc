@@ -268,8 +268,6 @@ int real_main(int argc, char* argv[]) {
       {"PReLU_3d_multiparam", "disable reason"},
       {"PoissonNLLLLoss_no_reduce", "disable reason"},
       {"Softsign", "disable reason"},
-      {"convtranspose_1d", "disable reason"},
-      {"convtranspose_3d", "disable reason"},
       {"dynamic_slice", "disable reason"},
       {"dynamic_slice_default_axes", "disable reason"},
       {"dynamic_slice_end_out_of_bounds", "disable reason"},
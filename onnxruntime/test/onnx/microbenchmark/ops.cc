@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Single node benchmarks of the CPU kernels, each run through an InferenceSession (*_Session) and through the kernel
+// directly (*_Kernel). The args of a benchmark are the shape parameters of the node, covering CNN, NLP and
+// classical ML models. Use --benchmark_out=<file> --benchmark_out_format=json to keep the results for comparison.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/constants.h>
+
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::microbenchmark;
+
+#define BENCHMARK_OP(NAME, ARGS)                             \
+  static void BM_##NAME##_Session(benchmark::State& state) { \
+    RunSession(state, Create##NAME(state));                  \
+  }                                                          \
+  BENCHMARK(BM_##NAME##_Session) ARGS;                       \
+  static void BM_##NAME##_Kernel(benchmark::State& state) {  \
+    RunKernel(state, Create##NAME(state));                   \
+  }                                                          \
+  BENCHMARK(BM_##NAME##_Kernel) ARGS;
+
+// N, C, H, W, M (output channels), K (kernel size), stride
+static SingleNodeModel CreateConv(const benchmark::State& state) {
+  const int64_t n = state.range(0), c = state.range(1), h = state.range(2), w = state.range(3);
+  const int64_t m = state.range(4), k = state.range(5), stride = state.range(6);
+  SingleNodeModel model("Conv");
+  model.AddInput("X", {n, c, h, w})
+      .AddInput("W", {m, c, k, k})
+      .AddInput("B", {m})
+      .AddOutput("Y")
+      .AddAttribute("kernel_shape", std::vector<int64_t>{k, k})
+      .AddAttribute("strides", std::vector<int64_t>{stride, stride})
+      .AddAttribute("pads", std::vector<int64_t>{k / 2, k / 2, k / 2, k / 2});
+  return model;
+}
+BENCHMARK_OP(Conv, ->Args({1, 3, 224, 224, 64, 7, 2})
+                       ->Args({1, 64, 56, 56, 64, 3, 1})
+                       ->Args({1, 256, 14, 14, 256, 1, 1})
+                       ->Args({8, 128, 28, 28, 128, 3, 1}))
+
+// M, K, N
+static SingleNodeModel CreateGemm(const benchmark::State& state) {
+  const int64_t m = state.range(0), k = state.range(1), n = state.range(2);
+  SingleNodeModel model("Gemm");
+  model.AddInput("A", {m, k}).AddInput("B", {k, n}).AddInput("C", {n}).AddOutput("Y");
+  return model;
+}
+BENCHMARK_OP(Gemm, ->Args({1, 2048, 1000})->Args({64, 1024, 1024})->Args({128, 768, 3072}))
+
+// batch, M, K, N
+static SingleNodeModel CreateMatMul(const benchmark::State& state) {
+  const int64_t batch = state.range(0), m = state.range(1), k = state.range(2), n = state.range(3);
+  SingleNodeModel model("MatMul");
+  model.AddInput("A", {batch, m, k}).AddInput("B", {batch, k, n}).AddOutput("Y");
+  return model;
+}
+BENCHMARK_OP(MatMul, ->Args({1, 128, 768, 768})->Args({12, 128, 64, 128})->Args({12, 128, 128, 64}))
+
+// N, D
+static SingleNodeModel CreateSoftmax(const benchmark::State& state) {
+  SingleNodeModel model("Softmax");
+  model.AddInput("X", {state.range(0), state.range(1)}).AddOutput("Y");
+  return model;
+}
+BENCHMARK_OP(Softmax, ->Args({1, 1000})->Args({64, 1000})->Args({1536, 128}))
+
+// N, C, H, W. B is broadcast along N, H and W
+static SingleNodeModel CreateAddBroadcast(const benchmark::State& state) {
+  const int64_t n = state.range(0), c = state.range(1), h = state.range(2), w = state.range(3);
+  SingleNodeModel model("Add");
+  model.AddInput("A", {n, c, h, w}).AddInput("B", {c, 1, 1}).AddOutput("Y");
+  return model;
+}
+BENCHMARK_OP(AddBroadcast, ->Args({1, 64, 56, 56})->Args({8, 256, 14, 14}))
+
+// N, D. B is broadcast along N
+static SingleNodeModel CreateMulBroadcast(const benchmark::State& state) {
+  SingleNodeModel model("Mul");
+  model.AddInput("A", {state.range(0), state.range(1)}).AddInput("B", {state.range(1)}).AddOutput("Y");
+  return model;
+}
+BENCHMARK_OP(MulBroadcast, ->Args({128, 768})->Args({1024, 1024}))
+
+// N, C, H, W, reduced over H and W
+static SingleNodeModel CreateReduceMean(const benchmark::State& state) {
+  SingleNodeModel model("ReduceMean");
+  model.AddInput("X", {state.range(0), state.range(1), state.range(2), state.range(3)})
+      .AddOutput("Y")
+      .AddAttribute("axes", std::vector<int64_t>{2, 3});
+  return model;
+}
+BENCHMARK_OP(ReduceMean, ->Args({1, 2048, 7, 7})->Args({8, 512, 28, 28}))
+
+// N, D, reduced over D
+static SingleNodeModel CreateReduceSum(const benchmark::State& state) {
+  SingleNodeModel model("ReduceSum");
+  model.AddInput("X", {state.range(0), state.range(1)})
+      .AddOutput("Y")
+      .AddAttribute("axes", std::vector<int64_t>{1});
+  return model;
+}
+BENCHMARK_OP(ReduceSum, ->Args({128, 768})->Args({1, 1000000}))
+
+// N, C, H, W, transposed to NHWC
+static SingleNodeModel CreateTranspose(const benchmark::State& state) {
+  SingleNodeModel model("Transpose");
+  model.AddInput("X", {state.range(0), state.range(1), state.range(2), state.range(3)})
+      .AddOutput("Y")
+      .AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+  return model;
+}
+BENCHMARK_OP(Transpose, ->Args({1, 64, 56, 56})->Args({1, 12, 128, 64}))
+
+// number of inputs, N, C, H, W, concatenated along C
+static SingleNodeModel CreateConcat(const benchmark::State& state) {
+  const int64_t n = state.range(1), c = state.range(2), h = state.range(3), w = state.range(4);
+  SingleNodeModel model("Concat");
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    model.AddInput("X" + std::to_string(i), {n, c, h, w});
+  }
+  model.AddOutput("Y").AddAttribute("axis", static_cast<int64_t>(1));
+  return model;
+}
+BENCHMARK_OP(Concat, ->Args({2, 1, 128, 28, 28})->Args({4, 1, 64, 56, 56}))
+
+// vocabulary size, embedding size, number of indices
+static SingleNodeModel CreateGather(const benchmark::State& state) {
+  SingleNodeModel model("Gather");
+  model.AddInput("data", {state.range(0), state.range(1)})
+      .AddInt64Input("indices", {state.range(2)}, 0, state.range(0))
+      .AddOutput("Y")
+      .AddAttribute("axis", static_cast<int64_t>(0));
+  return model;
+}
+BENCHMARK_OP(Gather, ->Args({30522, 768, 128})->Args({1000, 64, 4096}))
+
+// sequence length, batch size, input size, hidden size
+static SingleNodeModel CreateRecurrent(const std::string& op_type, int64_t num_gates, const benchmark::State& state) {
+  const int64_t seq_length = state.range(0), batch_size = state.range(1);
+  const int64_t input_size = state.range(2), hidden_size = state.range(3);
+  SingleNodeModel model(op_type);
+  model.AddInput("X", {seq_length, batch_size, input_size})
+      .AddInput("W", {1, num_gates * hidden_size, input_size}, -0.1f, 0.1f)
+      .AddInput("R", {1, num_gates * hidden_size, hidden_size}, -0.1f, 0.1f)
+      .AddInput("B", {1, 2 * num_gates * hidden_size}, -0.1f, 0.1f)
+      .AddOutput("Y")
+      .AddAttribute("hidden_size", hidden_size);
+  return model;
+}
+
+static SingleNodeModel CreateLSTM(const benchmark::State& state) {
+  return CreateRecurrent("LSTM", 4, state);
+}
+BENCHMARK_OP(LSTM, ->Args({32, 1, 256, 256})->Args({128, 16, 128, 128}))
+
+static SingleNodeModel CreateGRU(const benchmark::State& state) {
+  return CreateRecurrent("GRU", 3, state);
+}
+BENCHMARK_OP(GRU, ->Args({32, 1, 256, 256})->Args({128, 16, 128, 128}))
+
+// number of trees, tree depth, batch size, number of features.
+// the trees are complete binary trees splitting on random features.
+static SingleNodeModel CreateTreeEnsembleRegressor(const benchmark::State& state) {
+  const int64_t num_trees = state.range(0), depth = state.range(1);
+  const int64_t batch_size = state.range(2), num_features = state.range(3);
+
+  std::vector<int64_t> tree_ids, node_ids, feature_ids, true_ids, false_ids;
+  std::vector<float> values;
+  std::vector<std::string> modes;
+  std::vector<int64_t> target_tree_ids, target_node_ids, target_ids;
+  std::vector<float> target_weights;
+  const int64_t num_nodes = (int64_t{1} << (depth + 1)) - 1;
+  const int64_t first_leaf = (int64_t{1} << depth) - 1;
+  for (int64_t tree = 0; tree < num_trees; ++tree) {
+    for (int64_t node = 0; node < num_nodes; ++node) {
+      tree_ids.push_back(tree);
+      node_ids.push_back(node);
+      const bool is_leaf = node >= first_leaf;
+      feature_ids.push_back(is_leaf ? 0 : (tree * 31 + node * 17) % num_features);
+      values.push_back(is_leaf ? 0.f : static_cast<float>((node * 37) % 200) / 100.f - 1.f);
+      modes.push_back(is_leaf ? "LEAF" : "BRANCH_LEQ");
+      true_ids.push_back(is_leaf ? 0 : 2 * node + 1);
+      false_ids.push_back(is_leaf ? 0 : 2 * node + 2);
+      if (is_leaf) {
+        target_tree_ids.push_back(tree);
+        target_node_ids.push_back(node);
+        target_ids.push_back(0);
+        target_weights.push_back(static_cast<float>(node - first_leaf) / num_nodes);
+      }
+    }
+  }
+
+  SingleNodeModel model("TreeEnsembleRegressor", kMLDomain);
+  model.AddInput("X", {batch_size, num_features})
+      .AddOutput("Y")
+      .AddAttribute("n_targets", static_cast<int64_t>(1))
+      .AddAttribute("aggregate_function", std::string("SUM"))
+      .AddAttribute("nodes_treeids", tree_ids)
+      .AddAttribute("nodes_nodeids", node_ids)
+      .AddAttribute("nodes_featureids", feature_ids)
+      .AddAttribute("nodes_values", values)
+      .AddAttribute("nodes_modes", modes)
+      .AddAttribute("nodes_truenodeids", true_ids)
+      .AddAttribute("nodes_falsenodeids", false_ids)
+      .AddAttribute("target_treeids", target_tree_ids)
+      .AddAttribute("target_nodeids", target_node_ids)
+      .AddAttribute("target_ids", target_ids)
+      .AddAttribute("target_weights", target_weights);
+  return model;
+}
+BENCHMARK_OP(TreeEnsembleRegressor, ->Args({100, 6, 1, 20})->Args({100, 6, 1000, 20})->Args({500, 8, 100, 100}))
@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "single_node_model.h"
+
+#include <random>
+
+#include <core/framework/execution_frame.h>
+#include <core/framework/execution_providers.h>
+#include <core/framework/insert_cast_transformer.h>
+#include <core/framework/kernel_registry_manager.h>
+#include <core/framework/op_kernel.h>
+#include <core/framework/session_state.h>
+#include <core/framework/session_state_initializer.h>
+#include <core/graph/graph_transformer_mgr.h>
+#include <core/graph/model.h>
+#include <core/providers/cpu/cpu_execution_provider.h>
+#include <core/session/inference_session.h>
+
+namespace onnxruntime {
+namespace microbenchmark {
+
+template <typename T, typename Distribution>
+static MLValue CreateRandomTensor(const std::vector<int64_t>& dims, Distribution distribution) {
+  // a fixed seed, so runs are comparable
+  static std::default_random_engine generator{1234};
+  static AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+
+  TensorShape shape(dims);
+  auto tensor = std::make_unique<Tensor>(DataTypeImpl::GetType<T>(), shape,
+                                         allocator->Alloc(shape.Size() * sizeof(T)), allocator->Info(), allocator);
+  T* data = tensor->template MutableData<T>();
+  for (int64_t i = 0; i < shape.Size(); ++i) {
+    data[i] = static_cast<T>(distribution(generator));
+  }
+
+  return MLValue(tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+}
+
+SingleNodeModel::SingleNodeModel(const std::string& op_type, const std::string& domain)
+    : op_type_(op_type), domain_(domain) {
+}
+
+SingleNodeModel& SingleNodeModel::AddInput(const std::string& name, const std::vector<int64_t>& dims,
+                                           float low, float high) {
+  inputs_.push_back({name, ONNX_NAMESPACE::TensorProto_DataType_FLOAT});
+  feeds_[name] = CreateRandomTensor<float>(dims, std::uniform_real_distribution<float>(low, high));
+  return *this;
+}
+
+SingleNodeModel& SingleNodeModel::AddInt64Input(const std::string& name, const std::vector<int64_t>& dims,
+                                                int64_t low, int64_t high) {
+  inputs_.push_back({name, ONNX_NAMESPACE::TensorProto_DataType_INT64});
+  feeds_[name] = CreateRandomTensor<int64_t>(dims, std::uniform_int_distribution<int64_t>(low, high - 1));
+  return *this;
+}
+
+SingleNodeModel& SingleNodeModel::AddMissingInput() {
+  inputs_.push_back({"", ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED});
+  return *this;
+}
+
+SingleNodeModel& SingleNodeModel::AddOutput(const std::string& name, ONNX_NAMESPACE::TensorProto_DataType type) {
+  outputs_.push_back({name, type});
+  output_names_.push_back(name);
+  return *this;
+}
+
+common::Status SingleNodeModel::ToProto(ONNX_NAMESPACE::ModelProto& model_proto) const {
+  Model model("microbenchmark", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 9}, {kMLDomain, 1}});
+  Graph& graph = model.MainGraph();
+
+  std::vector<ONNX_NAMESPACE::TypeProto> types(inputs_.size() + outputs_.size());
+  auto create_args = [&graph, &types](const std::vector<ArgInfo>& args, size_t first_type) {
+    std::vector<NodeArg*> node_args;
+    for (size_t i = 0; i < args.size(); ++i) {
+      if (args[i].name.empty()) {
+        node_args.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+        continue;
+      }
+      auto& type = types[first_type + i];
+      type.mutable_tensor_type()->set_elem_type(args[i].type);
+      node_args.push_back(&graph.GetOrCreateNodeArg(args[i].name, &type));
+    }
+    return node_args;
+  };
+
+  auto input_args = create_args(inputs_, 0);
+  auto output_args = create_args(outputs_, inputs_.size());
+  Node& node = graph.AddNode("node", op_type_, "", input_args, output_args, nullptr, domain_);
+  for (const auto& set_attribute : attribute_setters_) {
+    set_attribute(node);
+  }
+
+  ORT_RETURN_IF_ERROR(graph.Resolve());
+  model_proto = model.ToProto();
+  return common::Status::OK();
+}
+
+void RunSession(benchmark::State& state, const SingleNodeModel& model) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  auto status = model.ToProto(model_proto);
+  std::string model_data;
+  if (status.IsOK() && !model_proto.SerializeToString(&model_data)) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to serialize the model");
+  }
+
+  SessionOptions so;
+  so.session_logid = "microbenchmark";
+  InferenceSession session{so};
+  if (status.IsOK()) status = session.Load(model_data.data(), static_cast<int>(model_data.size()));
+  if (status.IsOK()) status = session.Initialize();
+
+  std::vector<MLValue> fetches;
+  for (auto _ : state) {
+    if (status.IsOK()) status = session.Run(model.Feeds(), model.OutputNames(), &fetches);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+void RunKernel(benchmark::State& state, const SingleNodeModel& model) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  auto status = model.ToProto(model_proto);
+  if (!status.IsOK()) {
+    state.SkipWithError(status.ErrorMessage().c_str());
+    return;
+  }
+
+  Model kernel_model(model_proto);
+  Graph& graph = kernel_model.MainGraph();
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+
+  // initialize the session state the way InferenceSession does, to get the kernel of the node
+  ExecutionProviders execution_providers;
+  status = execution_providers.Add(kCpuExecutionProvider,
+                                   std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo()));
+  KernelRegistryManager kernel_registry_manager;
+  kernel_registry_manager.RegisterKernels(execution_providers);
+  InsertCastTransformer insert_cast_transformer{"CastFloat16Transformer"};
+  insert_cast_transformer.AddKernelRegistries(kernel_registry_manager.GetAllKernelRegistries());
+  GraphTransformerManager graph_transformation_mgr{0};
+
+  SessionState session_state{execution_providers};
+  profiling::Profiler profiler;
+  session_state.SetProfiler(profiler);
+  std::map<OrtAllocatorInfo, BufferUniquePtr> weights_buffers;
+  SessionStateInitializer session_initializer{graph, session_state, execution_providers,
+                                              kernel_registry_manager, logger};
+  if (status.IsOK()) status = graph.Resolve();
+  if (status.IsOK()) status = session_initializer.CreatePlan(graph_transformation_mgr, insert_cast_transformer, {}, true);
+  if (status.IsOK()) status = session_initializer.InitializeAndSave(false, weights_buffers);
+  if (!status.IsOK()) {
+    state.SkipWithError(status.ErrorMessage().c_str());
+    return;
+  }
+
+  const auto& execution_plan = session_state.GetExecutionPlan()->execution_plan;
+  if (execution_plan.size() != 1) {
+    state.SkipWithError("the graph has more than one node after it was transformed");
+    return;
+  }
+  const OpKernel* kernel = session_state.GetKernel(execution_plan[0].node_index);
+
+  std::vector<MLValue> fetches;
+  for (auto _ : state) {
+    ExecutionFrame frame{model.Feeds(), model.OutputNames(), fetches, session_state};
+    OpKernelContext context{&frame, kernel, logger};
+    status = kernel->Compute(&context);
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+}  // namespace microbenchmark
+}  // namespace onnxruntime
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <core/common/status.h>
+#include <core/framework/ml_value.h>
+#include <core/graph/graph.h>
+#include <core/graph/onnx_protobuf.h>
+
+namespace onnxruntime {
+namespace microbenchmark {
+
+// A model with a single node, to benchmark the kernel of the node.
+// Every input of the node is a graph input fed with random values.
+class SingleNodeModel {
+ public:
+  SingleNodeModel(const std::string& op_type, const std::string& domain = "");
+
+  // add a float input with random values in [low, high)
+  SingleNodeModel& AddInput(const std::string& name, const std::vector<int64_t>& dims,
+                            float low = -1.f, float high = 1.f);
+
+  // add an int64 input with random values in [low, high)
+  SingleNodeModel& AddInt64Input(const std::string& name, const std::vector<int64_t>& dims,
+                                 int64_t low, int64_t high);
+
+  // add an optional input that isn't given
+  SingleNodeModel& AddMissingInput();
+
+  SingleNodeModel& AddOutput(const std::string& name,
+                             ONNX_NAMESPACE::TensorProto_DataType type = ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  template <typename T>
+  SingleNodeModel& AddAttribute(const std::string& name, const T& value) {
+    attribute_setters_.push_back([name, value](Node& node) { node.AddAttribute(name, value); });
+    return *this;
+  }
+
+  // build the ModelProto of the model
+  common::Status ToProto(ONNX_NAMESPACE::ModelProto& model_proto) const;
+
+  const std::unordered_map<std::string, MLValue>& Feeds() const noexcept { return feeds_; }
+  const std::vector<std::string>& OutputNames() const noexcept { return output_names_; }
+
+ private:
+  struct ArgInfo {
+    std::string name;
+    ONNX_NAMESPACE::TensorProto_DataType type;
+  };
+
+  std::string op_type_;
+  std::string domain_;
+  std::vector<ArgInfo> inputs_;
+  std::vector<ArgInfo> outputs_;
+  std::vector<std::function<void(Node&)>> attribute_setters_;
+  std::unordered_map<std::string, MLValue> feeds_;
+  std::vector<std::string> output_names_;
+};
+
+// run the model through an InferenceSession in every iteration
+void RunSession(benchmark::State& state, const SingleNodeModel& model);
+
+// run the kernel of the node directly in every iteration, without the executor and the session
+void RunKernel(benchmark::State& state, const SingleNodeModel& model);
+
+}  // namespace microbenchmark
+}  // namespace onnxruntime
@@ -34,12 +34,18 @@ namespace perftest {
       "\t-s: Show statistics result, like P75, P90.\n"
       "\t-v: Show verbose information.\n"
       "\t-x: Use parallel executor, default (without -x): sequential executor.\n"
+      "\t-c [concurrent_session_runs]: Specifies the number of client threads running the session concurrently. Default:1.\n"
+      "\t-q [target_qps]: Sends requests at this rate (open loop) instead of sending the next one when a thread is done.\n"
+      "\t\tLatency is then measured from the time a request is scheduled. The requests are sent by the -c threads,\n"
+      "\t\tso a rate they can't keep up with queues the requests, and a warning is printed. Default:0 (closed loop).\n"
+      "\t-w [warm_up_runs]: Specifies the runs per client thread excluded from the results. Default:1.\n"
+      "\t-j: Print a JSON summary of the latency percentiles and throughput.\n"
       "\t-h: help\n");
 }
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, char* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, "m:e:r:t:p:xvhs")) != -1) {
+  while ((ch = getopt(argc, argv, "m:e:r:t:p:c:q:w:xvhsj")) != -1) {
     switch (ch) {
       case 'm':
         if (!strcmp(optarg, "duration")) {
@@ -87,6 +93,32 @@ namespace perftest {
       case 'x':
         test_config.run_config.enable_sequential_execution = false;
         break;
+      case 'c': {
+        // parsed signed, so a negative count is rejected rather than wrapping around to a huge one
+        const long concurrent_session_runs = strtol(optarg, nullptr, 10);
+        if (concurrent_session_runs <= 0) {
+          return false;
+        }
+        test_config.run_config.concurrent_session_runs = static_cast<size_t>(concurrent_session_runs);
+        break;
+      }
+      case 'q':
+        test_config.run_config.target_qps = strtod(optarg, nullptr);
+        if (test_config.run_config.target_qps < 0) {
+          return false;
+        }
+        break;
+      case 'w': {
+        const long warm_up_runs = strtol(optarg, nullptr, 10);
+        if (warm_up_runs < 0) {
+          return false;
+        }
+        test_config.run_config.warm_up_runs = static_cast<size_t>(warm_up_runs);
+        break;
+      }
+      case 'j':
+        test_config.run_config.f_dump_json_summary = true;
+        break;
       case '?':
       case 'h':
       default:
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "performance_runner.h"
+#include <atomic>
+#include <thread>
 #include "TestCase.h"
 #include <experimental/filesystem>
 #ifdef _MSC_VER
@@ -22,32 +24,150 @@ Status PerformanceRunner::Run() {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
 
-  // warm up
-  RunOneIteration(true /*isWarmup*/);
+  const auto& run_config = performance_test_config_.run_config;
+  const bool concurrent = run_config.concurrent_session_runs > 1 || run_config.target_qps > 0;
 
-  if (!performance_test_config_.run_config.profile_file.empty())
-    session_object_->StartProfiling(performance_test_config_.run_config.profile_file);
+  // warm up. the concurrent mode warms up each of its IOBindings.
+  if (!concurrent) {
+    for (size_t i = 0; i < run_config.warm_up_runs; i++) {
+      ORT_RETURN_IF_ERROR(RunOneIteration(true /*isWarmup*/));
+    }
+  }
+
+  if (!run_config.profile_file.empty())
+    session_object_->StartProfiling(run_config.profile_file);
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(RunFixDuration());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RunRepeatedTimes());
-      break;
-    default:
+  if (concurrent) {
+    if (run_config.test_mode != TestMode::kFixDurationMode && run_config.test_mode != TestMode::KFixRepeatedTimesMode)
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    ORT_RETURN_IF_ERROR(RunConcurrently());
+  } else {
+    switch (run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(RunFixDuration());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RunRepeatedTimes());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
+    performance_result_.wall_time_cost = performance_result_.total_time_cost;
   }
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
 
-  if (!performance_test_config_.run_config.profile_file.empty())
+  if (!run_config.profile_file.empty())
     session_object_->EndProfiling();
 
   std::cout << "Total time cost:" << performance_result_.total_time_cost << std::endl
             << "Total iterations:" << performance_result_.time_costs.size() << std::endl
             << "Average time cost:" << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms" << std::endl;
+  if (concurrent) {
+    std::cout << "Wall time cost:" << performance_result_.wall_time_cost << std::endl
+              << "Throughput:" << performance_result_.time_costs.size() / performance_result_.wall_time_cost << " qps" << std::endl;
+  }
+  if (run_config.f_dump_json_summary) {
+    performance_result_.DumpJsonSummary(std::cout, run_config);
+  }
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunConcurrently() {
+  using Clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+  const size_t num_threads = run_config.concurrent_session_runs;
+
+  // IOBinding isn't thread safe, so every thread gets its own
+  std::vector<std::unique_ptr<IOBinding>> io_bindings(num_threads);
+  for (auto& io_binding : io_bindings) {
+    ORT_RETURN_IF_ERROR(CreateIOBinding(io_binding));
+    for (size_t i = 0; i < run_config.warm_up_runs; i++) {
+      ORT_RETURN_IF_ERROR(session_object_->Run(*io_binding));
+    }
+  }
+
+  const bool fixed_duration = run_config.test_mode == TestMode::kFixDurationMode;
+  std::atomic<size_t> next_request{0};
+  std::atomic<bool> failed{false};
+  std::vector<std::vector<double>> time_costs(num_threads);
+  std::vector<Status> statuses(num_threads);
+
+  const auto start = Clock::now();
+  const auto deadline = start + std::chrono::seconds(run_config.duration_in_seconds);
+  auto client = [&](size_t thread_index) {
+    while (!failed) {
+      const size_t request = next_request++;
+      if (!fixed_duration && request >= run_config.repeated_times)
+        break;
+
+      // in open loop mode a request is due at a fixed time, and its latency includes the time it waited for a
+      // free thread.
+      auto scheduled = Clock::now();
+      if (run_config.target_qps > 0) {
+        scheduled = start + std::chrono::duration_cast<Clock::duration>(
+                                std::chrono::duration<double>(request / run_config.target_qps));
+        std::this_thread::sleep_until(scheduled);
+      }
+      if (fixed_duration && scheduled >= deadline)
+        break;
+
+      Status status = session_object_->Run(*io_bindings[thread_index]);
+      if (!status.IsOK()) {
+        statuses[thread_index] = status;
+        failed = true;
+        break;
+      }
+
+      std::chrono::duration<double> duration_seconds = Clock::now() - scheduled;
+      time_costs[thread_index].push_back(duration_seconds.count());
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; i++) {
+    threads.emplace_back(client, i);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> wall_time = Clock::now() - start;
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  for (const auto& thread_time_costs : time_costs) {
+    for (double time_cost : thread_time_costs) {
+      performance_result_.time_costs.push_back(time_cost);
+      performance_result_.total_time_cost += time_cost;
+    }
+  }
+  performance_result_.wall_time_cost = wall_time.count();
+
+  // the rate isn't capped to what the threads can serve: requests they can't keep up with wait for a free thread,
+  // which shows in the latencies. say so, as more threads are needed to measure the session at that rate.
+  if (run_config.target_qps > 0 && performance_result_.wall_time_cost > 0) {
+    const double achieved_qps = performance_result_.time_costs.size() / performance_result_.wall_time_cost;
+    if (achieved_qps < run_config.target_qps * 0.95) {
+      LOGF_DEFAULT(WARNING,
+                   "%zu threads sent %.2f qps instead of the target %.2f qps, latencies include the time requests "
+                   "waited for a free thread. Use more threads (-c) to send requests at the target rate.",
+                   num_threads, achieved_qps, run_config.target_qps);
+    }
+  }
+  return Status::OK();
+}
+
+Status PerformanceRunner::CreateIOBinding(std::unique_ptr<IOBinding>& io_binding) const {
+  ORT_RETURN_IF_ERROR(session_object_->NewIOBinding(&io_binding));
+  for (const auto& feed : feeds_) {
+    ORT_RETURN_IF_ERROR(io_binding->BindInput(feed.first, feed.second));
+  }
+  for (const auto& output_name : output_names_) {
+    ORT_RETURN_IF_ERROR(io_binding->BindOutput(output_name, MLValue()));
+  }
   return Status::OK();
 }
 
@@ -102,9 +222,8 @@ bool PerformanceRunner::Initialize() {
     return false;
   }
 
-  std::unordered_map<std::string, ::onnxruntime::MLValue> feeds;
-  test_case->LoadTestData(0 /* id */, feeds, true);
-  for (auto feed : feeds) {
+  test_case->LoadTestData(0 /* id */, feeds_, true);
+  for (auto feed : feeds_) {
     io_binding_->BindInput(feed.first, feed.second);
   }
   auto outputs = session_object_->GetModelOutputs();
@@ -121,6 +240,7 @@ bool PerformanceRunner::Initialize() {
     auto output = outputs.second->at(i_output);
     if (!output) continue;
     io_binding_->BindOutput(output->Name(), output_mlvalues[i_output]);
+    output_names_.push_back(output->Name());
   }
 
   return true;
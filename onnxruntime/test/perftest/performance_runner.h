@@ -4,9 +4,12 @@
 #pragma once
 
 #include <fstream>
+#include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
 
 // onnxruntime dependencies
 #include <core/common/common.h>
@@ -23,13 +26,85 @@
 namespace onnxruntime {
 namespace perftest {
 
+// escape s to be written as a JSON string
+inline std::string EscapeJsonString(const std::string& s) {
+  std::string escaped;
+  escaped.reserve(s.size());
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\b':
+        escaped += "\\b";
+        break;
+      case '\f':
+        escaped += "\\f";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\r':
+        escaped += "\\r";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+          escaped += buffer;
+        } else {
+          escaped += c;
+        }
+        break;
+    }
+  }
+  return escaped;
+}
+
 struct PerformanceResult {
   size_t peak_workingset_size{0};
   short average_CPU_usage{0};
   double total_time_cost{0};
+  // wall clock time of the measured runs, less than total_time_cost if they ran concurrently
+  double wall_time_cost{0};
   std::vector<double> time_costs;
   std::string model_name;
 
+  void DumpJsonSummary(std::ostream& out, const RunConfig& run_config) const {
+    std::vector<double> sorted_time = time_costs;
+    std::sort(sorted_time.begin(), sorted_time.end());
+    auto percentile = [&sorted_time](double p) {
+      if (sorted_time.empty()) return 0.0;
+      return sorted_time[std::min(sorted_time.size() - 1, static_cast<size_t>(sorted_time.size() * p))];
+    };
+
+    const size_t iterations = time_costs.size();
+    out << "{\"model_name\":\"" << EscapeJsonString(model_name) << "\""
+        << ",\"sequential_execution\":" << (run_config.enable_sequential_execution ? "true" : "false")
+        << ",\"concurrent_session_runs\":" << run_config.concurrent_session_runs
+        << ",\"target_qps\":" << run_config.target_qps
+        << ",\"iterations\":" << iterations
+        << ",\"wall_time_sec\":" << wall_time_cost
+        << ",\"throughput_qps\":" << (wall_time_cost > 0 ? iterations / wall_time_cost : 0.0)
+        << ",\"latency_sec\":{"
+        << "\"average\":" << (iterations > 0 ? total_time_cost / iterations : 0.0)
+        << ",\"p50\":" << percentile(0.5)
+        << ",\"p90\":" << percentile(0.9)
+        << ",\"p99\":" << percentile(0.99)
+        << ",\"p999\":" << percentile(0.999)
+        << ",\"max\":" << (sorted_time.empty() ? 0.0 : sorted_time.back())
+        << "}"
+        << ",\"peak_workingset_size\":" << peak_workingset_size
+        << ",\"average_cpu_usage\":" << average_CPU_usage
+        << "}" << std::endl;
+  }
+
   void DumpToFile(const std::string& path, bool f_include_statistics = false) const {
     std::ofstream outfile;
     outfile.open(path, std::ofstream::out | std::ofstream::app);
@@ -79,6 +154,9 @@ class PerformanceRunner {
  private:
   bool Initialize();
 
+  // create an IOBinding with the test inputs and the model outputs bound to it
+  Status CreateIOBinding(std::unique_ptr<IOBinding>& io_binding) const;
+
   inline Status RunOneIteration(bool isWarmup = false) {
     auto start = std::chrono::high_resolution_clock::now();
     ORT_RETURN_IF_ERROR(session_object_->Run(*io_binding_));
@@ -110,12 +188,17 @@ class PerformanceRunner {
     return Status::OK();
   }
 
+  // run the session from concurrent_session_runs threads, for the duration or the repeated times of the test mode
+  Status RunConcurrently();
+
  private:
   PerformanceResult performance_result_;
   PerformanceTestConfig performance_test_config_;
 
   std::shared_ptr<::onnxruntime::InferenceSession> session_object_;
   std::unique_ptr<IOBinding> io_binding_;
+  std::unordered_map<std::string, MLValue> feeds_;
+  std::vector<std::string> output_names_;
 };
 }  // namespace perftest
 }  // namespace onnxruntime
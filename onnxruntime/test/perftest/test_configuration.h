@@ -41,6 +41,10 @@ struct RunConfig {
   bool f_dump_statistics{false};
   bool f_verbose{false};
   bool enable_sequential_execution{true};
+  size_t concurrent_session_runs{1};  // number of client threads running the session concurrently
+  double target_qps{0};               // if > 0, requests are sent at this rate regardless of when others complete
+  size_t warm_up_runs{1};             // runs per client thread excluded from the results
+  bool f_dump_json_summary{false};
 };
 
 struct PerformanceTestConfig {
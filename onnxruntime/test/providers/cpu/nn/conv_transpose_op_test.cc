@@ -16,6 +16,7 @@ struct ConvTransposeOpAttributes {
   vector<int64_t> pads;
   vector<int64_t> strides;
   int64_t group;
+  vector<int64_t> dilations;
 };
 
 void TestConvTransposeOp(const ConvTransposeOpAttributes& attributes,
@@ -36,6 +37,9 @@ void TestConvTransposeOp(const ConvTransposeOpAttributes& attributes,
   test.AddAttribute("pads", attributes.pads);
   test.AddAttribute("strides", attributes.strides);
   test.AddAttribute("group", attributes.group);
+  if (!attributes.dilations.empty()) {
+    test.AddAttribute("dilations", attributes.dilations);
+  }
 
   ORT_ENFORCE(inputs.size() <= 3, "Our name array is only setup to handle 3 inputs");
   const char* szNames[] = {"X", "W", "B"};
@@ -334,5 +338,68 @@ TEST(ConvTransposeTest, ConvTranspose_onnx_group) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+TEST(ConvTransposeTest, ConvTranspose_1D) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{3},     // kernel_shape
+      {},                     // output_padding
+      {},                     // output_shape
+      vector<int64_t>{0, 0},  // pads
+      vector<int64_t>{1},     // strides
+      1                       // group
+  };
+  vector<float> X = {0.0f, 1.0f, 2.0f};
+  vector<int64_t> X_shape = {1, 1, 3};
+  vector<float> W = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+  vector<int64_t> W_shape = {1, 2, 3};
+  vector<float> B = {1.0f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {1, 2, 5};
+  auto expected_vals = {1.0f, 2.0f, 4.0f, 4.0f, 3.0f,
+                        -1.0f, 0.0f, 2.0f, 2.0f, 1.0f};
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
+TEST(ConvTransposeTest, ConvTranspose_3D) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{2, 2, 2},           // kernel_shape
+      {},                                 // output_padding
+      {},                                 // output_shape
+      vector<int64_t>{0, 0, 0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1, 1},           // strides
+      1                                   // group
+  };
+  vector<float> X = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+  vector<int64_t> X_shape = {1, 1, 2, 2, 2};
+  vector<float> W = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+  vector<int64_t> W_shape = {1, 1, 2, 2, 2};
+  vector<int64_t> Y_shape = {1, 1, 3, 3, 3};
+  auto expected_vals = {0.0f, 1.0f, 2.0f, 2.0f, 10.0f, 10.0f, 6.0f, 17.0f, 12.0f,
+                        4.0f, 18.0f, 16.0f, 28.0f, 84.0f, 60.0f, 32.0f, 82.0f, 52.0f,
+                        20.0f, 49.0f, 30.0f, 58.0f, 138.0f, 82.0f, 42.0f, 97.0f, 56.0f};
+  TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
+}
+
+TEST(ConvTransposeTest, ConvTranspose_Dilation) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{2, 2},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{1, 1},        // strides
+      1,                            // group
+      vector<int64_t>{2, 2}         // dilations
+  };
+  vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f};
+  vector<int64_t> X_shape = {1, 1, 2, 2};
+  vector<float> W = {1.0f, 1.0f, 1.0f, 1.0f};
+  vector<int64_t> W_shape = {1, 1, 2, 2};
+  vector<int64_t> Y_shape = {1, 1, 4, 4};
+  auto expected_vals = {1.0f, 2.0f, 1.0f, 2.0f,
+                        3.0f, 4.0f, 3.0f, 4.0f,
+                        1.0f, 2.0f, 1.0f, 2.0f,
+                        3.0f, 4.0f, 3.0f, 4.0f};
+  TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -271,6 +271,34 @@ TEST(GatherOpTest, Gather_axis1_indices2d_string) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"0", "1",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int64_t>("indices", {3}, {2LL, 0LL, 1LL});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"20", "21",
+                               "0", "1",
+                               "10", "11"});
+  test.Run();
+}
+
+TEST(GatherOpTest, Gather_axis1_consecutive_indices) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 1LL);
+  test.AddInput<float>("data", {2, 4, 2},
+                       {0.0f, 0.1f, 1.0f, 1.1f, 2.0f, 2.1f, 3.0f, 3.1f,
+                        10.0f, 10.1f, 11.0f, 11.1f, 12.0f, 12.1f, 13.0f, 13.1f});
+  test.AddInput<int64_t>("indices", {6}, {1LL, 2LL, 3LL, 0LL, 1LL, 1LL});
+  test.AddOutput<float>("output", {2, 6, 2},
+                        {1.0f, 1.1f, 2.0f, 2.1f, 3.0f, 3.1f, 0.0f, 0.1f, 1.0f, 1.1f, 1.0f, 1.1f,
+                         11.0f, 11.1f, 12.0f, 12.1f, 13.0f, 13.1f, 10.0f, 10.1f, 11.0f, 11.1f, 11.0f, 11.1f});
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "core/providers/cpu/tensor/upsample.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -8,6 +11,89 @@
 namespace onnxruntime {
 namespace test {
 
+namespace {
+// the output of nearest mode computed element by element, to check the row and plane decomposition of the kernel
+template <typename T>
+std::vector<T> UpsampleNearestReference(const std::vector<T>& X, const std::vector<int64_t>& dims,
+                                        const std::vector<float>& scales, const std::vector<int64_t>& Y_dims) {
+  const int64_t n_dim = static_cast<int64_t>(dims.size());
+  int64_t size = 1;
+  for (auto dim : Y_dims) {
+    size *= dim;
+  }
+
+  std::vector<T> Y(size);
+  for (int64_t i = 0; i < size; i++) {
+    int64_t remaining = i;
+    int64_t input_index = 0;
+    int64_t input_pitch = 1;
+    for (int64_t j = n_dim - 1; j >= 0; j--) {
+      const int64_t y = remaining % Y_dims[j];
+      remaining /= Y_dims[j];
+      input_index += std::min(static_cast<int64_t>(y / scales[j]), dims[j] - 1) * input_pitch;
+      input_pitch *= dims[j];
+    }
+    Y[i] = X[input_index];
+  }
+  return Y;
+}
+
+// the output of linear mode computed element by element for an NCHW tensor, to check the row cache of the kernel
+template <typename T>
+std::vector<T> UpsampleBilinearReference(const std::vector<T>& X, const std::vector<int64_t>& dims,
+                                         const std::vector<float>& scales, const std::vector<int64_t>& Y_dims) {
+  const int64_t H = dims[2], W = dims[3];
+  const int64_t output_height = Y_dims[2], output_width = Y_dims[3];
+
+  std::vector<T> Y;
+  for (int64_t plane = 0; plane < dims[0] * dims[1]; plane++) {
+    const T* X_plane = X.data() + plane * H * W;
+    for (int64_t y = 0; y < output_height; y++) {
+      const float in_y = std::min(y / scales[2], static_cast<float>(H - 1));
+      const int64_t y1 = std::min(static_cast<int64_t>(in_y), H - 1);
+      const int64_t y2 = std::min(y1 + 1, H - 1);
+      const float dy1 = y1 == y2 ? 0.5f : std::abs(in_y - y1);
+      const float dy2 = y1 == y2 ? 0.5f : std::abs(in_y - y2);
+      for (int64_t x = 0; x < output_width; x++) {
+        const float in_x = std::min(x / scales[3], static_cast<float>(W - 1));
+        const int64_t x1 = std::min(static_cast<int64_t>(in_x), W - 1);
+        const int64_t x2 = std::min(x1 + 1, W - 1);
+        const float dx1 = x1 == x2 ? 0.5f : std::abs(in_x - x1);
+        const float dx2 = x1 == x2 ? 0.5f : std::abs(in_x - x2);
+        Y.push_back(static_cast<T>(dx2 * dy2 * X_plane[y1 * W + x1] + dx1 * dy2 * X_plane[y1 * W + x2] +
+                                   dx2 * dy1 * X_plane[y2 * W + x1] + dx1 * dy1 * X_plane[y2 * W + x2]));
+      }
+    }
+  }
+  return Y;
+}
+
+template <typename T>
+void RunUpsampleReferenceTest(const std::string& mode, const std::vector<int64_t>& dims,
+                              const std::vector<float>& scales) {
+  OpTester test("Upsample");
+  test.AddAttribute("mode", mode);
+  test.AddAttribute("scales", scales);
+
+  int64_t size = 1;
+  std::vector<int64_t> Y_dims;
+  for (size_t i = 0; i < dims.size(); i++) {
+    size *= dims[i];
+    Y_dims.push_back(static_cast<int64_t>(scales[i] * dims[i]));
+  }
+  std::vector<T> X(size);
+  for (int64_t i = 0; i < size; i++) {
+    X[i] = static_cast<T>((i * 7) % 23 - 11);
+  }
+  test.AddInput<T>("X", dims, X);
+
+  test.AddOutput<T>("Y", Y_dims,
+                    mode == "nearest" ? UpsampleNearestReference(X, dims, scales, Y_dims)
+                                      : UpsampleBilinearReference(X, dims, scales, Y_dims));
+  test.Run();
+}
+}  // namespace
+
 TEST(UpsampleOpTest, UpsampleOpNearestTest) {
   OpTester test("Upsample");
 
@@ -350,5 +436,80 @@ TEST(UpsampleOpTest, UpsampleOpNearest2XTest_opset9) {
   test.AddOutput<int32_t>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
   test.Run();
 }
+
+TEST(UpsampleOpTest, UpsampleOpNearestTest_NonIntegerScales) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 1.0f, 1.5f, 2.5f};
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("scales", scales);
+
+  const int64_t N = 1, C = 1, H = 2, W = 2;
+  std::vector<float> X = {1.0f, 3.0f,
+                          3.0f, 5.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+
+  std::vector<float> Y = {
+      1.0f, 1.0f, 1.0f, 3.0f, 3.0f,
+      1.0f, 1.0f, 1.0f, 3.0f, 3.0f,
+      3.0f, 3.0f, 3.0f, 5.0f, 5.0f};
+
+  test.AddOutput<float>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
+  test.Run();
+}
+
+TEST(UpsampleOpTest, UpsampleOpNearestTest_3D) {
+  OpTester test("Upsample");
+
+  // the width isn't scaled, so the source rows are copied as a whole
+  std::vector<float> scales{1.0f, 2.0f, 1.0f};
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("scales", scales);
+
+  const int64_t C = 2, H = 2, W = 2;
+  std::vector<float> X = {1.0f, 3.0f,
+                          3.0f, 5.0f,
+
+                          3.0f, 5.0f,
+                          7.0f, 9.0f};
+
+  test.AddInput<float>("X", {C, H, W}, X);
+
+  std::vector<float> Y = {
+      1.0f, 3.0f,
+      1.0f, 3.0f,
+      3.0f, 5.0f,
+      3.0f, 5.0f,
+
+      3.0f, 5.0f,
+      3.0f, 5.0f,
+      7.0f, 9.0f,
+      7.0f, 9.0f};
+
+  test.AddOutput<float>("Y", {C, (int64_t)(H * scales[1]), W}, Y);
+  test.Run();
+}
+
+TEST(UpsampleOpTest, UpsampleOpNearestTest_5D) {
+  // the outer dimensions are scaled too, so the planes read other source planes
+  RunUpsampleReferenceTest<float>("nearest", {2, 2, 3, 3, 2}, {1.0f, 2.0f, 1.5f, 2.0f, 1.0f});
+  RunUpsampleReferenceTest<float>("nearest", {1, 2, 2, 3, 4}, {2.0f, 1.0f, 2.5f, 1.0f, 1.5f});
+}
+
+TEST(UpsampleOpTest, UpsampleOpNearestTest_NonIntegerScales_int32) {
+  RunUpsampleReferenceTest<int32_t>("nearest", {2, 3, 5, 3}, {1.0f, 1.0f, 1.7f, 2.5f});
+}
+
+TEST(UpsampleOpTest, UpsampleOpBilinearTest_NonIntegerScales) {
+  // adjacent output rows read the same source rows, which are interpolated once
+  RunUpsampleReferenceTest<float>("linear", {2, 3, 3, 4}, {1.0f, 1.0f, 2.5f, 1.5f});
+  RunUpsampleReferenceTest<float>("linear", {1, 2, 5, 3}, {1.0f, 1.0f, 3.0f, 1.0f});
+}
+
+TEST(UpsampleOpTest, UpsampleOpBilinearTest_NonIntegerScales_int32) {
+  RunUpsampleReferenceTest<int32_t>("linear", {2, 3, 3, 4}, {1.0f, 1.0f, 2.5f, 1.5f});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
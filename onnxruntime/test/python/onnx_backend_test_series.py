@@ -22,8 +22,6 @@ backend_test.exclude(r'(test_acosh_cpu.*'
 '|test_asinh_example_cpu.*'
 '|test_atanh_cpu.*'
 '|test_atanh_example_cpu.*'
-'|test_convtranspose_1d_cpu.*'
-'|test_convtranspose_3d_cpu.*'
 '|test_cosh_cpu.*'
 '|test_cosh_example_cpu.*'
 '|test_dynamic_slice_cpu.*'
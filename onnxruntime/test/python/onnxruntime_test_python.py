@@ -40,6 +40,28 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelWithIOBinding(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        y = np.zeros((3, 2), dtype=np.float32)
+        binding = sess.io_binding()
+        binding.bind_input("X", x)
+        binding.bind_output("Y", y)
+        sess.run_with_iobinding(binding)
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+        self.assertIs(binding.get_outputs()[0], y)
+
+        # bound arrays are reused by the next run
+        x *= 2
+        sess.run_with_iobinding(binding)
+        np.testing.assert_allclose(output_expected * 4, y, rtol=1e-05, atol=1e-08)
+
+        binding.clear_binding_outputs()
+        binding.bind_output("Y")
+        sess.run_with_iobinding(binding)
+        np.testing.assert_allclose(output_expected * 4, binding.get_outputs()[0], rtol=1e-05, atol=1e-08)
+
     def testRunModelFromBytes(self):
         with open(self.get_name("mul_1.pb"), "rb") as f:
             content = f.read()